@@ -0,0 +1,198 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/srsran.h"
+
+#define MAX_EARFCN 64
+
+/*
+ * Searches the cells of a list of EARFCNs in a wideband capture, all of them in parallel.
+ */
+
+char*    input_file_name = NULL;
+char*    earfcn_list     = NULL;
+double   srate_hz        = 23.04e6;
+int      center_earfcn   = -1;
+int      nof_frames      = 20;
+int      nof_threads     = 3;
+uint32_t max_frames_pss  = 8;
+uint32_t max_frames_pbch = 8;
+
+void usage(char* prog)
+{
+  printf("Usage: %s [scnwpbv] -i input_file -e earfcn_list\n", prog);
+  printf("\t-e comma separated list of DL EARFCNs to search\n");
+  printf("\t-s capture sampling rate in Hz, a multiple of 1.92 MHz [Default %.2f MHz]\n", srate_hz / 1e6);
+  printf("\t-c DL EARFCN of the capture center frequency [Default first EARFCN in the list]\n");
+  printf("\t-n number of radio frames read from the capture [Default %d]\n", nof_frames);
+  printf("\t-w number of threads besides the main one [Default %d]\n", nof_threads);
+  printf("\t-p maximum number of 5 ms frames to search the PSS [Default %d]\n", max_frames_pss);
+  printf("\t-b maximum number of 10 ms frames to decode the MIB, 0 disables it [Default %d]\n", max_frames_pbch);
+  printf("\t-v srsran_verbose\n");
+}
+
+void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "iescnwpbv")) != -1) {
+    switch (opt) {
+      case 'i':
+        input_file_name = argv[optind];
+        break;
+      case 'e':
+        earfcn_list = argv[optind];
+        break;
+      case 's':
+        srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 'c':
+        center_earfcn = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_frames = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'w':
+        nof_threads = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'p':
+        max_frames_pss = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        max_frames_pbch = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        srsran_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+  if (!input_file_name || !earfcn_list) {
+    usage(argv[0]);
+    exit(-1);
+  }
+}
+
+int main(int argc, char** argv)
+{
+  srsran_filesource_t              fsrc;
+  srsran_ue_cellsearch_wb_t        cs;
+  srsran_ue_cellsearch_wb_cfg_t    cfg = {};
+  srsran_ue_cellsearch_wb_result_t results[MAX_EARFCN];
+  uint32_t                         earfcn[MAX_EARFCN];
+  uint32_t                         nof_earfcn = 0;
+  struct timeval                   tdata[3];
+
+  parse_args(argc, argv);
+
+  for (char* tok = strtok(earfcn_list, ","); tok != NULL && nof_earfcn < MAX_EARFCN; tok = strtok(NULL, ",")) {
+    earfcn[nof_earfcn++] = (uint32_t)strtol(tok, NULL, 10);
+  }
+  if (nof_earfcn == 0) {
+    ERROR("No EARFCN to search");
+    exit(-1);
+  }
+  if (center_earfcn < 0) {
+    center_earfcn = (int)earfcn[0];
+  }
+
+  double center_freq_hz = srsran_band_fd((uint32_t)center_earfcn) * 1e6;
+  for (uint32_t i = 0; i < nof_earfcn; i++) {
+    bzero(&results[i], sizeof(srsran_ue_cellsearch_wb_result_t));
+    results[i].freq_offset_hz = (float)(srsran_band_fd(earfcn[i]) * 1e6 - center_freq_hz);
+    if (fabs(results[i].freq_offset_hz) > srate_hz / 2) {
+      ERROR("EARFCN %d is out of the capture bandwidth", earfcn[i]);
+      exit(-1);
+    }
+  }
+
+  uint32_t nof_samples = (uint32_t)(nof_frames * srate_hz / 100);
+  cf_t*    input       = srsran_vec_cf_malloc(nof_samples);
+  if (!input) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  if (srsran_filesource_init(&fsrc, input_file_name, SRSRAN_COMPLEX_FLOAT_BIN)) {
+    ERROR("Error opening file %s", input_file_name);
+    exit(-1);
+  }
+  int n = srsran_filesource_read(&fsrc, input, nof_samples);
+  srsran_filesource_free(&fsrc);
+  if (n <= 0) {
+    ERROR("Error reading file %s", input_file_name);
+    exit(-1);
+  }
+  nof_samples = (uint32_t)n;
+
+  cfg.max_frames_pss       = max_frames_pss;
+  cfg.nof_valid_pss_frames = max_frames_pss / 2;
+  cfg.max_frames_pbch      = max_frames_pbch;
+  if (srsran_ue_cellsearch_wb_init(&cs, srate_hz, (uint32_t)nof_threads, &cfg)) {
+    ERROR("Error initiating wideband cell search");
+    exit(-1);
+  }
+
+  gettimeofday(&tdata[1], NULL);
+  if (srsran_ue_cellsearch_wb_scan(&cs, input, nof_samples, results, nof_earfcn)) {
+    ERROR("Error scanning the capture");
+    exit(-1);
+  }
+  gettimeofday(&tdata[2], NULL);
+  get_time_interval(tdata);
+
+  for (uint32_t i = 0; i < nof_earfcn; i++) {
+    srsran_ue_cellsearch_wb_result_t* r = &results[i];
+    printf("EARFCN %5d (%.1f MHz): ", earfcn[i], srsran_band_fd(earfcn[i]));
+    if (r->nof_cells < 0) {
+      printf("Error\n");
+    } else if (r->nof_cells == 0) {
+      printf("No cell found\n");
+    } else {
+      for (uint32_t j = 0; j < SRSRAN_NOF_NID_2; j++) {
+        if (r->found_cells[j].psr > 0) {
+          printf("PCI=%d, PSR=%.1f, CFO=%+.1f kHz; ",
+                 r->found_cells[j].cell_id,
+                 r->found_cells[j].psr,
+                 r->found_cells[j].cfo / 1000);
+        }
+      }
+      if (r->mib_found) {
+        printf("MIB: PCI=%d, PRB=%d, ports=%d, SFN=%d", r->cell.id, r->cell.nof_prb, r->cell.nof_ports, r->sfn);
+      }
+      printf("\n");
+    }
+  }
+  printf("Searched %d EARFCNs in %ld us\n", nof_earfcn, tdata[0].tv_sec * 1000000 + tdata[0].tv_usec);
+
+  srsran_ue_cellsearch_wb_free(&cs);
+  free(input);
+
+  printf("Ok\n");
+  exit(0);
+}
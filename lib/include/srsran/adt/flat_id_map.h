@@ -0,0 +1,233 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_FLAT_ID_MAP_H
+#define SRSRAN_FLAT_ID_MAP_H
+
+#include "expected.h"
+#include "srsran/common/srsran_assert.h"
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace srsran {
+
+/**
+ * Map of IDs to objects, with no bound on the number of objects. The objects are stored contiguously, in insertion
+ * order until an erasure moves the last object to the freed position. The IDs are looked up in an open addressing
+ * index of positions with linear probing.
+ * Insertions and erasures invalidate the iterators and the references to the objects, objects that must keep their
+ * address should be stored by pointer
+ * @tparam K type of ID/key
+ * @tparam T object being inserted
+ */
+template <typename K, typename T>
+class flat_id_map
+{
+  static_assert(std::is_integral<K>::value and std::is_unsigned<K>::value, "Map key must be an unsigned integer");
+
+  using obj_t = std::pair<K, T>;
+
+  // Position of the object plus one, so that zero marks an empty slot
+  using slot_t = uint32_t;
+
+public:
+  using key_type        = K;
+  using mapped_type     = T;
+  using value_type      = std::pair<K, T>;
+  using difference_type = std::ptrdiff_t;
+  using iterator        = typename std::vector<obj_t>::iterator;
+  using const_iterator  = typename std::vector<obj_t>::const_iterator;
+
+  explicit flat_id_map(size_t initial_capacity = 16)
+  {
+    objs.reserve(initial_capacity);
+    resize_index(initial_capacity);
+  }
+
+  bool   contains(K id) const { return find_slot(id) < slots.size(); }
+  size_t count(K id) const { return contains(id) ? 1 : 0; }
+
+  bool insert(K id, const T& obj)
+  {
+    if (contains(id)) {
+      return false;
+    }
+    emplace_(id, obj);
+    return true;
+  }
+  srsran::expected<iterator, T> insert(K id, T&& obj)
+  {
+    if (contains(id)) {
+      return srsran::expected<iterator, T>(std::move(obj));
+    }
+    emplace_(id, std::move(obj));
+    return objs.end() - 1;
+  }
+
+  bool erase(K id)
+  {
+    size_t slot = find_slot(id);
+    if (slot >= slots.size()) {
+      return false;
+    }
+    erase_slot(slot);
+    return true;
+  }
+
+  /// Returns the iterator to the object that follows the erased one, which is moved to the erased position
+  iterator erase(iterator it)
+  {
+    srsran_assert(it >= objs.begin() and it < objs.end(), "Iterator out-of-bounds");
+    size_t pos = it - objs.begin();
+    erase_slot(find_slot(it->first));
+    return objs.begin() + pos;
+  }
+
+  void clear()
+  {
+    objs.clear();
+    std::fill(slots.begin(), slots.end(), 0);
+  }
+
+  /// Reserves space for nof_objs objects, so that no memory is allocated until there are more
+  void reserve(size_t nof_objs)
+  {
+    objs.reserve(nof_objs);
+    if (2 * nof_objs > slots.size()) {
+      resize_index(2 * nof_objs);
+    }
+  }
+
+  T& operator[](K id)
+  {
+    size_t slot = find_slot(id);
+    srsran_assert(slot < slots.size(), "Accessing non-existent ID=%zd", (size_t)id);
+    return objs[slots[slot] - 1].second;
+  }
+  const T& operator[](K id) const
+  {
+    size_t slot = find_slot(id);
+    srsran_assert(slot < slots.size(), "Accessing non-existent ID=%zd", (size_t)id);
+    return objs[slots[slot] - 1].second;
+  }
+
+  size_t size() const { return objs.size(); }
+  bool   empty() const { return objs.empty(); }
+  size_t capacity() const { return objs.capacity(); }
+
+  iterator       begin() { return objs.begin(); }
+  iterator       end() { return objs.end(); }
+  const_iterator begin() const { return objs.begin(); }
+  const_iterator end() const { return objs.end(); }
+
+  iterator find(K id)
+  {
+    size_t slot = find_slot(id);
+    return slot < slots.size() ? objs.begin() + (slots[slot] - 1) : objs.end();
+  }
+  const_iterator find(K id) const
+  {
+    size_t slot = find_slot(id);
+    return slot < slots.size() ? objs.begin() + (slots[slot] - 1) : objs.end();
+  }
+
+private:
+  // Multiplying by an odd constant is a bijection of the low bits, consecutive IDs never collide
+  size_t home_slot(K id) const { return (static_cast<size_t>(id) * 0x9E3779B1u) & (slots.size() - 1); }
+
+  /// Returns the index slot of the ID, or the number of slots if it is not present
+  size_t find_slot(K id) const
+  {
+    for (size_t i = home_slot(id);; i = (i + 1) & (slots.size() - 1)) {
+      if (slots[i] == 0) {
+        return slots.size();
+      }
+      if (objs[slots[i] - 1].first == id) {
+        return i;
+      }
+    }
+  }
+
+  size_t find_free_slot(K id) const
+  {
+    size_t i = home_slot(id);
+    while (slots[i] != 0) {
+      i = (i + 1) & (slots.size() - 1);
+    }
+    return i;
+  }
+
+  template <typename U>
+  void emplace_(K id, U&& obj)
+  {
+    // Keep the index at most half full, so that the probe sequences stay short
+    if (2 * (objs.size() + 1) > slots.size()) {
+      resize_index(2 * slots.size());
+    }
+    objs.emplace_back(id, std::forward<U>(obj));
+    slots[find_free_slot(id)] = objs.size();
+  }
+
+  void erase_slot(size_t slot)
+  {
+    size_t pos = slots[slot] - 1;
+
+    // Shift back the following entries of the probe sequence that can take the freed slot
+    size_t mask = slots.size() - 1;
+    size_t hole = slot;
+    for (size_t i = (slot + 1) & mask; slots[i] != 0; i = (i + 1) & mask) {
+      size_t home = home_slot(objs[slots[i] - 1].first);
+      if (((i - home) & mask) >= ((i - hole) & mask)) {
+        slots[hole] = slots[i];
+        hole        = i;
+      }
+    }
+    slots[hole] = 0;
+
+    // Move the last object to the freed position. It is reconstructed, the objects do not need to be assignable
+    if (pos != objs.size() - 1) {
+      slots[find_slot(objs.back().first)] = pos + 1;
+      objs[pos].~obj_t();
+      new (&objs[pos]) obj_t(std::move(objs.back()));
+    }
+    objs.pop_back();
+  }
+
+  void resize_index(size_t min_slots)
+  {
+    size_t nof_slots = 16;
+    while (nof_slots < min_slots) {
+      nof_slots *= 2;
+    }
+    slots.assign(nof_slots, 0);
+    for (size_t i = 0; i < objs.size(); ++i) {
+      slots[find_free_slot(objs[i].first)] = i + 1;
+    }
+  }
+
+  std::vector<obj_t>  objs;
+  std::vector<slot_t> slots;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_FLAT_ID_MAP_H
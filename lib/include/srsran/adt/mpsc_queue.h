@@ -0,0 +1,120 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_MPSC_QUEUE_H
+#define SRSRAN_MPSC_QUEUE_H
+
+#include "srsran/common/srsran_assert.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace srsran {
+
+/**
+ * Bounded lock-free queue with multiple producers and a single consumer. Each slot has a sequence number that tells
+ * whether it is free for the producer that claimed that position or whether it holds an object for the consumer.
+ * Producers claim positions with a CAS on the write index, and never wait for the consumer or for each other. A push
+ * to a full queue fails instead.
+ * @tparam T object stored in the queue. It must be default constructible and move assignable
+ */
+template <typename T>
+class mpsc_queue
+{
+  struct slot_t {
+    std::atomic<size_t> seq{0};
+    T                   obj;
+  };
+
+public:
+  /// The capacity is rounded up to a power of 2
+  explicit mpsc_queue(size_t capacity_) : mask(next_pow2(capacity_) - 1), slots(new slot_t[mask + 1])
+  {
+    for (size_t i = 0; i <= mask; ++i) {
+      slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+  /// Producer side. Returns false and leaves obj untouched if the queue is full
+  bool try_push(T& obj)
+  {
+    size_t  pos = write_pos.load(std::memory_order_relaxed);
+    slot_t* slot;
+    while (true) {
+      slot        = &slots[pos & mask];
+      size_t   seq = slot->seq.load(std::memory_order_acquire);
+      intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (dif == 0) {
+        if (write_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (dif < 0) {
+        // The slot still holds the object pushed one lap before
+        return false;
+      } else {
+        pos = write_pos.load(std::memory_order_relaxed);
+      }
+    }
+    slot->obj = std::move(obj);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer side. Returns false if the queue is empty or if the oldest push has not completed yet
+  bool try_pop(T& obj)
+  {
+    slot_t& slot = slots[read_pos & mask];
+    if (slot.seq.load(std::memory_order_acquire) != read_pos + 1) {
+      return false;
+    }
+    obj = std::move(slot.obj);
+    slot.seq.store(read_pos + mask + 1, std::memory_order_release);
+    read_pos++;
+    return true;
+  }
+
+  size_t capacity() const { return mask + 1; }
+
+private:
+  static size_t next_pow2(size_t n)
+  {
+    srsran_assert(n > 0, "Invalid queue capacity");
+    size_t ret = 1;
+    while (ret < n) {
+      ret *= 2;
+    }
+    return ret;
+  }
+
+  const size_t              mask;
+  std::unique_ptr<slot_t[]> slots;
+
+  // The indexes are written by different threads, keep them in different cache lines
+  std::atomic<size_t> write_pos{0};
+  char                padding[64];
+  size_t              read_pos = 0;
+};
+
+} // namespace srsran
+
+#endif // SRSRAN_MPSC_QUEUE_H
@@ -54,16 +54,17 @@ public:
   } cell_cfg_sib_t;
 
   struct sched_args_t {
-    std::string sched_policy         = "time_pf";
-    std::string sched_policy_args    = "2";
-    int         pdsch_mcs            = -1;
-    int         pdsch_max_mcs        = 28;
-    int         pusch_mcs            = -1;
-    int         pusch_max_mcs        = 28;
-    uint32_t    min_nof_ctrl_symbols = 1;
-    uint32_t    max_nof_ctrl_symbols = 3;
-    int         max_aggr_level       = 3;
-    bool        pucch_mux_enabled    = false;
+    std::string sched_policy           = "time_pf";
+    std::string sched_policy_args      = "2";
+    int         pdsch_mcs              = -1;
+    int         pdsch_max_mcs          = 28;
+    int         pusch_mcs              = -1;
+    int         pusch_max_mcs          = 28;
+    uint32_t    min_nof_ctrl_symbols   = 1;
+    uint32_t    max_nof_ctrl_symbols   = 3;
+    int         max_aggr_level         = 3;
+    bool        pucch_mux_enabled      = false;
+    bool        parallel_carrier_sched = false;
   };
 
   struct cell_cfg_t {
@@ -263,6 +264,13 @@ public:
 
   /******************* Scheduling Interface ***********************/
 
+  /*
+   * The UE feedback calls below (buffer states, HARQ ACKs, CSI, SR, BSR, PHR, SNR) may be queued and applied when
+   * the scheduler next runs. A queued call returns SRSRAN_SUCCESS before the RNTI is checked, so an unknown RNTI is
+   * only logged when the feedback is applied. For the same reason, dl_ack_info does not return the size of the
+   * ACKed TB.
+   */
+
   /**
    * Update the current RLC buffer state for a given user and bearer.
    *
@@ -133,6 +133,9 @@ typedef struct SRSRAN_API {
   uint32_t cfo_estimate_sf_mask;
   bool     sync_error_enable;
 
+  // Width in PRB of the frequency tiles for interpolating the resource grid in normal subframes, 0 disables tiling
+  uint32_t tile_nof_prb;
+
 } srsran_chest_dl_cfg_t;
 
 SRSRAN_API int srsran_chest_dl_init(srsran_chest_dl_t* q, uint32_t max_prb, uint32_t nof_rx_antennas);
@@ -47,6 +47,16 @@ SRSRAN_API void srsran_sequence_state_gen_f(srsran_sequence_state_t* s, float va
 
 SRSRAN_API void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length);
 
+/**
+ * Advances the state by length bits without generating them, the cost grows with log2(length)
+ */
+SRSRAN_API void srsran_sequence_state_jump(srsran_sequence_state_t* s, uint32_t length);
+
+/**
+ * Generates the next 32 bits of the sequence, the first one in the LSB, and advances the state by 32 bits
+ */
+SRSRAN_API uint32_t srsran_sequence_state_gen_word(srsran_sequence_state_t* s);
+
 typedef struct SRSRAN_API {
   uint8_t* c;
   uint8_t* c_bytes;
@@ -63,6 +73,45 @@ SRSRAN_API void srsran_sequence_free(srsran_sequence_t* q);
 
 SRSRAN_API int srsran_sequence_LTE_pr(srsran_sequence_t* q, uint32_t len, uint32_t seed);
 
+/**
+ * Least recently used cache of sequences, keyed by their seed (c_init) and length. It bounds the memory of the
+ * sequences that depend on the RNTI and slot while the most used ones are not generated again every TTI. Only the
+ * packed sequence bits are kept, up to max_len bits per entry.
+ *
+ * It is not thread safe, every worker shall own its cache.
+ */
+typedef struct SRSRAN_API {
+  uint32_t seed;
+  uint32_t len;
+  uint32_t prev;        // Next more recently used entry
+  uint32_t next;        // Next less recently used entry
+  uint32_t bucket_next; // Next entry in the same hash bucket
+} srsran_sequence_cache_entry_t;
+
+typedef struct SRSRAN_API {
+  srsran_sequence_cache_entry_t* entries;
+  uint8_t*                       bits; // Packed bits of every entry, max_len bits rounded up to bytes each
+  uint32_t*                      buckets;
+  uint32_t                       nof_buckets;
+  uint32_t                       max_entries;
+  uint32_t                       max_len;
+  uint32_t                       nof_entries;
+  uint32_t                       head; // Most recently used entry
+  uint32_t                       tail; // Least recently used entry
+  uint64_t                       nof_hits;
+  uint64_t                       nof_misses;
+} srsran_sequence_cache_t;
+
+SRSRAN_API int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t max_entries, uint32_t max_len);
+
+SRSRAN_API void srsran_sequence_cache_free(srsran_sequence_cache_t* q);
+
+/**
+ * Returns the sequence of the given seed and length packed as srsran_sequence_t c_bytes, it is generated if it is not
+ * in the cache. The returned bits are valid until the next call, and NULL on error or if len exceeds max_len.
+ */
+SRSRAN_API const uint8_t* srsran_sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t len);
+
 SRSRAN_API int srsran_sequence_set_LTE_pr(srsran_sequence_t* q, uint32_t len, uint32_t seed);
 
 SRSRAN_API void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint32_t seed);
@@ -86,6 +135,12 @@ SRSRAN_API int srsran_sequence_pdcch(srsran_sequence_t* seq, uint32_t nslot, uin
 SRSRAN_API int
 srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t nslot, uint32_t cell_id, uint32_t len);
 
+SRSRAN_API void srsran_sequence_pdsch_state_init(srsran_sequence_state_t* s,
+                                                 uint16_t                 rnti,
+                                                 int                      q,
+                                                 uint32_t                 nslot,
+                                                 uint32_t                 cell_id);
+
 SRSRAN_API void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
                                                  uint8_t*       out,
                                                  uint16_t       rnti,
@@ -147,6 +202,9 @@ srsran_sequence_pusch_gen_unpack(uint8_t* out, uint16_t rnti, uint32_t nslot, ui
 
 SRSRAN_API int srsran_sequence_pucch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id);
 
+SRSRAN_API const uint8_t*
+srsran_sequence_pucch_cache(srsran_sequence_cache_t* cache, uint16_t rnti, uint32_t nslot, uint32_t cell_id);
+
 SRSRAN_API int srsran_sequence_pmch(srsran_sequence_t* seq, uint32_t nslot, uint32_t mbsfn_id, uint32_t len);
 
 SRSRAN_API int srsran_sequence_npbch(srsran_sequence_t* seq, srsran_cp_t cp, uint32_t cell_id);
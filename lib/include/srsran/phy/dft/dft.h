@@ -24,6 +24,7 @@
 
 #include "srsran/config.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /**********************************************************************************************
  *  File:         dft.h
@@ -40,6 +41,11 @@
  *                norm   - Normalizes output (by sqrt(len) for complex, len for real).
  *                dc     - Handles insertion and removal of null DC carrier internally.
  *
+ *                Plans are shared process-wide: objects requesting the same transform on
+ *                buffers with the same alignment use a single FFTW plan, executed on
+ *                their own buffers. Plans are kept until the process exits, so they can be
+ *                warmed at startup with srsran_dft_plan_cache_warm().
+ *
  *  Reference:
  *********************************************************************************************/
 
@@ -102,6 +108,12 @@ SRSRAN_API int srsran_dft_replan_r(srsran_dft_plan_t* plan, int new_dft_points);
 
 SRSRAN_API void srsran_dft_plan_free(srsran_dft_plan_t* plan);
 
+/* Plan cache */
+
+SRSRAN_API int srsran_dft_plan_cache_warm(int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t mode);
+
+SRSRAN_API uint32_t srsran_dft_plan_cache_nof_plans();
+
 /* Set options */
 
 SRSRAN_API void srsran_dft_plan_set_mirror(srsran_dft_plan_t* plan, bool val);
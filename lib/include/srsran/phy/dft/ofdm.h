@@ -59,6 +59,7 @@ typedef struct SRSRAN_API {
   float       rx_window_offset; ///< DFT Window offset in CP portion (0-1), RX only
   uint32_t    symbol_sz;        ///< Symbol size, forces a given symbol size for the number of PRB
   bool        keep_dc;          ///< If true, it does not remove the DC
+  bool        fused;            ///< If true, the per-symbol processing around the DFT is done in a single pass
 } srsran_ofdm_cfg_t;
 
 /**
@@ -83,6 +84,10 @@ typedef struct SRSRAN_API {
   uint32_t          window_offset_n;
   cf_t*             shift_buffer;
   cf_t*             window_offset_buffer;
+  cf_t*             fused_shift;     ///< Frequency shift phase ramp of one DFT window, fused mode only
+  cf_t*             fused_gain;      ///< Per subcarrier Rx gain in output order, fused mode only
+  cf_t              fused_cp_gain;   ///< Tx cyclic prefix phase relative to the shifted symbol end, fused mode only
+  bool              fused_gain_en;   ///< Whether fused_gain needs to be applied
 } srsran_ofdm_t;
 
 /**
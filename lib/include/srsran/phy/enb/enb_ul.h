@@ -62,6 +62,14 @@ typedef struct SRSRAN_API {
 
 } srsran_enb_ul_t;
 
+/* PUSCH receiver that works on the resource grid of an eNb UL object. Each one has its own channel estimator and
+ * decoder, so several PUSCH of the same subframe can be decoded in parallel */
+typedef struct SRSRAN_API {
+  srsran_chest_ul_res_t chest_res;
+  srsran_chest_ul_t     chest;
+  srsran_pusch_t        pusch;
+} srsran_enb_ul_pusch_t;
+
 /* This function shall be called just after the initial synchronization */
 SRSRAN_API int srsran_enb_ul_init(srsran_enb_ul_t* q, cf_t* in_buffer, uint32_t max_prb);
 
@@ -84,4 +92,18 @@ SRSRAN_API int srsran_enb_ul_get_pusch(srsran_enb_ul_t*    q,
                                        srsran_pusch_cfg_t* cfg,
                                        srsran_pusch_res_t* res);
 
+SRSRAN_API int srsran_enb_ul_pusch_init(srsran_enb_ul_pusch_t* q, uint32_t max_prb);
+
+SRSRAN_API void srsran_enb_ul_pusch_free(srsran_enb_ul_pusch_t* q);
+
+SRSRAN_API int srsran_enb_ul_pusch_set_cell(srsran_enb_ul_pusch_t*             q,
+                                            srsran_cell_t                      cell,
+                                            srsran_refsignal_dmrs_pusch_cfg_t* pusch_cfg);
+
+SRSRAN_API int srsran_enb_ul_pusch_decode(srsran_enb_ul_pusch_t* q,
+                                          srsran_enb_ul_t*       enb_ul,
+                                          srsran_ul_sf_cfg_t*    ul_sf,
+                                          srsran_pusch_cfg_t*    cfg,
+                                          srsran_pusch_res_t*    res);
+
 #endif // SRSRAN_ENB_UL_H
@@ -42,6 +42,7 @@ typedef struct SRSRAN_API {
   uint32_t K;
   uint32_t framebits;
   bool     tail_biting;
+  bool     wava;
   float    gain_quant;
   int16_t  gain_quant_s;
   int (*decode)(void*, uint8_t*, uint8_t*, uint32_t);
@@ -60,6 +61,12 @@ SRSRAN_API int srsran_viterbi_init(srsran_viterbi_t*     q,
                                    uint32_t              max_frame_length,
                                    bool                  tail_bitting);
 
+/* Decodes tail-biting codes with the wrap-around Viterbi algorithm (WAVA) instead of decoding the block repeated 3
+ * times. Every pass starts from the path metrics of the previous one and the decoding stops as soon as the best path
+ * starts and ends in the same state, which usually happens in the first pass. The blocks that do not converge in 2
+ * passes take a third one and are decoded as the block repeated 3 times, at the same cost */
+SRSRAN_API void srsran_viterbi_set_wava(srsran_viterbi_t* q, bool enable);
+
 SRSRAN_API void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant);
 
 SRSRAN_API void srsran_viterbi_set_gain_quant_s(srsran_viterbi_t* q, int16_t gain_quant);
@@ -35,6 +35,11 @@
 #include "srsran/phy/fec/crc.h"
 #include "srsran/phy/fec/ldpc/base_graph.h"
 
+/*!
+ * \brief Maximum number of codeblocks an LDPC decoder can process at once (see srsran_ldpc_decoder_decode_batch_c()).
+ */
+#define SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE 32
+
 /*!
  * \brief Types of LDPC decoder.
  */
@@ -99,6 +104,16 @@ typedef struct SRSRAN_API {
                   uint8_t*,
                   uint32_t,
                   srsran_crc_t*); /*!< \brief Pointer to the decoding function (16-bit version). */
+
+  uint32_t batch_size; /*!< \brief Number of codeblocks the decoder can process at once. */
+  int (*decode_batch_c)(void*,
+                        const int8_t**,
+                        uint8_t**,
+                        uint32_t,
+                        uint32_t,
+                        srsran_crc_t*,
+                        int*); /*!< \brief Pointer to the batch decoding function (8-bit version), NULL if not
+                                  supported. */
 } srsran_ldpc_decoder_t;
 
 /*!
@@ -179,4 +194,27 @@ SRSRAN_API int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
                                                 uint32_t               cdwd_rm_length,
                                                 srsran_crc_t*          crc);
 
+/*!
+ * Decodes several codeblocks sharing the base graph, the lifting size and the rate-matched length, with 8-bit
+ * integer-valued LLRs. Decoders with small lifting sizes process up to \ref srsran_ldpc_decoder_t::batch_size
+ * codeblocks at once, packed in the same vector registers; otherwise, the codeblocks are decoded one after another.
+ * Either way, each codeblock gets the same result as with srsran_ldpc_decoder_decode_crc_c().
+ * \param[in] q A pointer to the LDPC decoder (a srsran_ldpc_decoder_t structure
+ *    instance) that carries out the decoding.
+ * \param[in] llrs The LLRs of each of the codewords to be decoded.
+ * \param[out] message The messages (uncoded bits) resulting from the decoding operation, one per codeword.
+ * \param[in] nof_cbs The number of codewords.
+ * \param[in] cdwd_rm_length The number of bits forming each codeword (after rate matching).
+ * \param[in,out] crc Code-block CRC object for early stop. Set for NULL to disable check
+ * \param[out] ret For each codeword, the number of used iterations, and 0 if CRC is provided and did not match
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_ldpc_decoder_decode_batch_c(srsran_ldpc_decoder_t* q,
+                                                  const int8_t**         llrs,
+                                                  uint8_t**              message,
+                                                  uint32_t               nof_cbs,
+                                                  uint32_t               cdwd_rm_length,
+                                                  srsran_crc_t*          crc,
+                                                  int*                   ret);
+
 #endif // SRSRAN_LDPCDECODER_H
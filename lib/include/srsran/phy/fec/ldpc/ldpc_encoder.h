@@ -39,10 +39,10 @@
  */
 typedef enum SRSRAN_API {
   SRSRAN_LDPC_ENCODER_C = 0, /*!< \brief Non-optimized encoder. */
-#if LV_HAVE_AVX2
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
   SRSRAN_LDPC_ENCODER_AVX2, /*!< \brief SIMD-optimized encoder. */
 #endif                      // LV_HAVE_AVX2
-#if LV_HAVE_AVX512
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_ISA_DISPATCH_AVX512)
   SRSRAN_LDPC_ENCODER_AVX512, /*!< \brief SIMD-optimized encoder. */
 #endif                        // LV_HAVE_AVX512
 } srsran_ldpc_encoder_type_t;
@@ -31,6 +31,7 @@
 #define SRSRAN_RM_TURBO_H
 
 #include "srsran/config.h"
+#include "srsran/phy/common/sequence.h"
 #include "srsran/phy/fec/turbo/turbodecoder.h"
 
 #ifndef SRSRAN_RX_NULL
@@ -86,4 +87,30 @@ SRSRAN_API int srsran_rm_turbo_rx_lut_(int16_t* input,
 SRSRAN_API int
 srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx);
 
+SRSRAN_API int srsran_rm_turbo_rx_lut_8bit_(int8_t*  input,
+                                            int8_t*  output,
+                                            uint32_t in_len,
+                                            uint32_t cb_idx,
+                                            uint32_t rv_idx,
+                                            uint32_t nof_subblocks);
+
+/**
+ * Undoes rate matching and scrambling in a single pass. Every input LLR is read once, its sign is changed according to
+ * the scrambling sequence, generated on the fly from the state seq, and it is soft-combined in the output buffer. The
+ * state is advanced past the input LLR.
+ */
+SRSRAN_API int srsran_rm_turbo_rx_lut_descramble(int16_t*                 input,
+                                                 int16_t*                 output,
+                                                 uint32_t                 in_len,
+                                                 uint32_t                 cb_idx,
+                                                 uint32_t                 rv_idx,
+                                                 srsran_sequence_state_t* seq);
+
+SRSRAN_API int srsran_rm_turbo_rx_lut_descramble_8bit(int8_t*                  input,
+                                                      int8_t*                  output,
+                                                      uint32_t                 in_len,
+                                                      uint32_t                 cb_idx,
+                                                      uint32_t                 rv_idx,
+                                                      srsran_sequence_state_t* seq);
+
 #endif // SRSRAN_RM_TURBO_H
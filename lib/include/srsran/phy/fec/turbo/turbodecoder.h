@@ -55,11 +55,24 @@
 #include "srsran/phy/fec/turbo/turbodecoder_impl.h"
 #undef LLR_IS_16BIT
 
-#define SRSRAN_TDEC_NOF_AUTO_MODES_8 2
-#define SRSRAN_TDEC_NOF_AUTO_MODES_16 3
+#define SRSRAN_TDEC_NOF_AUTO_MODES_8 3
+#define SRSRAN_TDEC_NOF_AUTO_MODES_16 4
+
+// Number of sub-block interleavers: 1, 8, 16, 32 and 64 sub-blocks
+#define SRSRAN_TDEC_NOF_SB_INTERLEAVERS 5
 
 typedef enum { SRSRAN_TDEC_8, SRSRAN_TDEC_16 } srsran_tdec_llr_type_t;
 
+/**
+ * Early stopping criteria evaluated by the decoder after every iteration. They complement the code block CRC check
+ * done by the caller, stopping the decoder when further iterations are unlikely to change the result.
+ */
+typedef enum {
+  SRSRAN_TDEC_EARLY_STOP_NONE = 0, ///< Run until the caller stops it (CRC) or the maximum number of iterations
+  SRSRAN_TDEC_EARLY_STOP_HD,       ///< Stop when the hard decisions are equal to the ones of the previous iteration
+  SRSRAN_TDEC_EARLY_STOP_LLR,      ///< Stop when the magnitude of all the a-posteriori LLR exceed a threshold
+} srsran_tdec_early_stop_t;
+
 typedef struct SRSRAN_API {
   uint32_t max_long_cb;
 
@@ -83,6 +96,10 @@ typedef struct SRSRAN_API {
 
   bool force_not_sb;
 
+  srsran_tdec_early_stop_t early_stop;
+  int16_t                  early_stop_llr_th;
+  uint8_t*                 prev_output;
+
   srsran_tdec_impl_type_t dec_type;
 
   srsran_tdec_llr_type_t current_llr_type;
@@ -90,7 +107,7 @@ typedef struct SRSRAN_API {
   uint32_t               current_long_cb;
   uint32_t               current_inter_idx;
   int                    current_cbidx;
-  srsran_tc_interl_t     interleaver[4][SRSRAN_NOF_TC_CB_SIZES];
+  srsran_tc_interl_t     interleaver[SRSRAN_TDEC_NOF_SB_INTERLEAVERS][SRSRAN_NOF_TC_CB_SIZES];
   int                    n_iter;
 } srsran_tdec_t;
 
@@ -106,6 +123,25 @@ SRSRAN_API int srsran_tdec_new_cb(srsran_tdec_t* h, uint32_t long_cb);
 
 SRSRAN_API int srsran_tdec_get_nof_iterations(srsran_tdec_t* h);
 
+/**
+ * Selects the early stopping criterion evaluated by srsran_tdec_early_stop() and srsran_tdec_run_all*().
+ *
+ * @param h Turbo decoder object
+ * @param criterion Early stopping criterion
+ * @param llr_th A-posteriori LLR magnitude threshold, only used by SRSRAN_TDEC_EARLY_STOP_LLR. It is expressed in the
+ * same units than the decoder input LLR and saturated to the 8-bit range for 8-bit decoders
+ */
+SRSRAN_API void srsran_tdec_set_early_stop(srsran_tdec_t* h, srsran_tdec_early_stop_t criterion, int16_t llr_th);
+
+/**
+ * Evaluates the early stopping criterion after an iteration.
+ *
+ * @param h Turbo decoder object
+ * @param output Hard decisions (packed bytes) given by the last iteration
+ * @return true if the decoder can stop iterating, false otherwise
+ */
+SRSRAN_API bool srsran_tdec_early_stop(srsran_tdec_t* h, const uint8_t* output);
+
 SRSRAN_API uint32_t srsran_tdec_autoimp_get_subblocks(uint32_t long_cb);
 
 SRSRAN_API uint32_t srsran_tdec_autoimp_get_subblocks_8bit(uint32_t long_cb);
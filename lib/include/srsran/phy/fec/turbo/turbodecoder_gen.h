@@ -44,7 +44,7 @@
 
 typedef struct SRSRAN_API {
   uint32_t max_long_cb;
-  int16_t* beta;
+  int32_t* beta;
 } tdec_gen_t;
 
 int  tdec_gen_init(void** h, uint32_t max_long_cb);
@@ -183,7 +183,7 @@
 #define use_saturated_add
 #define divide_output 1
 
-#define INF 0
+#define INF 64
 
 inline static simd_type_t simd_rb_shift_128(simd_type_t v, const int l)
 {
@@ -284,7 +284,7 @@ inline static simd_type_t simd_rb_shift_128(simd_type_t v, const int l)
                   0)
 #define simd_rb_shift simd_rb_shift_256
 
-#define INF 0
+#define INF 64
 
 #define normalize_max
 #define normalize_period 1
@@ -299,6 +299,110 @@ inline static simd_type_t simd_rb_shift_256(simd_type_t v, const int l)
   return _mm256_blendv_epi8(hi, low, _mm256_set1_epi32(0x00FF00FF));
 }
 
+#else
+#ifdef WINIMP_IS_AVX512_16
+
+#ifndef LV_HAVE_AVX512
+#error "Selected AVX512 window decoder but instruction set not supported"
+#endif
+
+#include <immintrin.h>
+
+#define WINIMP avx512_16
+#define nof_blocks 32
+
+#define llr_t int16_t
+
+// Sub-block boundaries are not guaranteed to be 64-byte aligned, use unaligned access
+#define simd_type_t __m512i
+#define simd_load _mm512_loadu_si512
+#define simd_store _mm512_storeu_si512
+#define simd_add _mm512_adds_epi16
+#define simd_sub _mm512_subs_epi16
+#define simd_max _mm512_max_epi16
+#define simd_set1 _mm512_set1_epi16
+#define simd_insert(v, x, i) _mm512_mask_set1_epi16(v, (__mmask32)1U << (i), x)
+#define simd_shuffle(v, f) f(v)
+#define move_right simd_move_right_512_16
+#define move_left simd_move_left_512_16
+#define simd_rb_shift _mm512_srai_epi16
+
+#define normalize_period 2
+#define win_overlap_len 40
+
+#define INF 10000
+
+// Moves every 16-bit element one position down (element i takes element i+1) across 128-bit lanes
+inline static simd_type_t simd_move_right_512_16(simd_type_t v)
+{
+  __m512i next_lane = _mm512_alignr_epi32(v, v, 4);
+  return _mm512_alignr_epi8(next_lane, v, 2);
+}
+
+// Moves every 16-bit element one position up (element i takes element i-1) across 128-bit lanes
+inline static simd_type_t simd_move_left_512_16(simd_type_t v)
+{
+  __m512i prev_lane = _mm512_alignr_epi32(v, v, 12);
+  return _mm512_alignr_epi8(v, prev_lane, 14);
+}
+
+#else
+#ifdef WINIMP_IS_AVX512_8
+
+#ifndef LV_HAVE_AVX512
+#error "Selected AVX512 window decoder but instruction set not supported"
+#endif
+
+#include <immintrin.h>
+
+#define WINIMP avx512_8
+#define nof_blocks 64
+
+#define llr_t int8_t
+
+// Sub-block boundaries are not guaranteed to be 64-byte aligned, use unaligned access
+#define simd_type_t __m512i
+#define simd_load _mm512_loadu_si512
+#define simd_store _mm512_storeu_si512
+#define simd_add _mm512_adds_epi8
+#define simd_sub _mm512_subs_epi8
+#define simd_max _mm512_max_epi8
+#define simd_set1 _mm512_set1_epi8
+#define simd_insert(v, x, i) _mm512_mask_set1_epi8(v, (__mmask64)1ULL << (i), x)
+#define simd_shuffle(v, f) f(v)
+#define move_right simd_move_right_512_8
+#define move_left simd_move_left_512_8
+#define simd_rb_shift simd_rb_shift_512
+
+#define INF 64
+
+#define normalize_max
+#define normalize_period 1
+#define win_overlap_len 40
+#define use_saturated_add
+#define divide_output 1
+
+inline static simd_type_t simd_rb_shift_512(simd_type_t v, const int l)
+{
+  __m512i low = _mm512_srai_epi16(_mm512_slli_epi16(v, 8), l + 8);
+  __m512i hi  = _mm512_srai_epi16(v, l);
+  return _mm512_mask_blend_epi8(0x5555555555555555ULL, hi, low);
+}
+
+// Moves every 8-bit element one position down (element i takes element i+1) across 128-bit lanes
+inline static simd_type_t simd_move_right_512_8(simd_type_t v)
+{
+  __m512i next_lane = _mm512_alignr_epi32(v, v, 4);
+  return _mm512_alignr_epi8(next_lane, v, 1);
+}
+
+// Moves every 8-bit element one position up (element i takes element i-1) across 128-bit lanes
+inline static simd_type_t simd_move_left_512_8(simd_type_t v)
+{
+  __m512i prev_lane = _mm512_alignr_epi32(v, v, 12);
+  return _mm512_alignr_epi8(v, prev_lane, 15);
+}
+
 #else
 #ifdef WINIMP_IS_NEON16
 #include <arm_neon.h>
@@ -407,6 +511,8 @@ inline static uint8x16_t v_load_s8(int i15,
 #endif
 #endif
 #endif
+#endif
+#endif
 
 typedef struct SRSRAN_API {
   uint32_t max_long_cb;
@@ -473,13 +579,13 @@ inline static llr_t MAKE_FUNC(sadd)(llr_t x, llr_t y)
   return x + y;
 #else
   int16_t z = (int16_t)x + y;
-  return z > 127 ? 127 : (int8_t)z;
+  return z > 127 ? 127 : z < -128 ? -128 : (int8_t)z;
 #endif
 }
 
 inline static void MAKE_FUNC(normalize)(uint32_t k, simd_type_t old[8])
 {
-  if ((k % normalize_period) == 0 && k != 0) {
+  if ((k % normalize_period) == 0) {
 #ifdef normalize_max
     simd_type_t m = simd_max(old[0], old[1]);
     for (int i = 2; i < 8; i++) {
@@ -544,6 +650,17 @@ static void MAKE_FUNC(beta_trellis)(llr_t* input, llr_t* parity, uint32_t long_c
         new[i] = m_b[i];
       old[i] = new[i];
     }
+#ifdef normalize_max
+    // Keep the metrics in range, as the estimated states of the other sub-blocks
+    llr_t m = old[0];
+    for (int i = 1; i < 8; i++) {
+      m = old[i] > m ? old[i] : m;
+    }
+    for (int i = 0; i < 8; i++) {
+      int16_t z = (int16_t)old[i] - m;
+      old[i]    = z < -128 ? -128 : (llr_t)z;
+    }
+#endif
   }
 }
 
@@ -908,6 +1025,21 @@ void MAKE_FUNC(
     INSERT8_INPUT(parity1, 24, 2);
 #endif
 
+#if nof_blocks >= 64
+    INSERT8_INPUT(syst, 32, 0);
+    INSERT8_INPUT(parity0, 32, 1);
+    INSERT8_INPUT(parity1, 32, 2);
+    INSERT8_INPUT(syst, 40, 0);
+    INSERT8_INPUT(parity0, 40, 1);
+    INSERT8_INPUT(parity1, 40, 2);
+    INSERT8_INPUT(syst, 48, 0);
+    INSERT8_INPUT(parity0, 48, 1);
+    INSERT8_INPUT(parity1, 48, 2);
+    INSERT8_INPUT(syst, 56, 0);
+    INSERT8_INPUT(parity0, 56, 1);
+    INSERT8_INPUT(parity1, 56, 2);
+#endif
+
     simd_store(systPtr++, syst);
     simd_store(parity0Ptr++, parity0);
     simd_store(parity1Ptr++, parity1);
@@ -23,7 +23,7 @@
  *  File:         demod_soft.h
  *
  *  Description:  Soft demodulator.
- *                Supports BPSK, QPSK, 16QAM and 64QAM.
+ *                Supports BPSK, QPSK, 16QAM, 64QAM and 256QAM.
  *
  *  Reference:    3GPP TS 36.211 version 10.0.0 Release 10 Sec. 7.1
  *****************************************************************************/
@@ -42,4 +42,18 @@ SRSRAN_API int srsran_demod_soft_demodulate_s(srsran_mod_t modulation, const cf_
 
 SRSRAN_API int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols, int8_t* llr, int nsymbols);
 
+/* Demodulate and descramble in a single pass. The scrambling sequence c holds +1 or -1 for every LLR, as the c_short
+ * and c_char arrays of srsran_sequence_t */
+SRSRAN_API int srsran_demod_soft_demodulate_s_descramble(srsran_mod_t modulation,
+                                                         const cf_t*  symbols,
+                                                         short*       llr,
+                                                         int          nsymbols,
+                                                         const short* c);
+
+SRSRAN_API int srsran_demod_soft_demodulate_b_descramble(srsran_mod_t  modulation,
+                                                         const cf_t*   symbols,
+                                                         int8_t*       llr,
+                                                         int           nsymbols,
+                                                         const int8_t* c);
+
 #endif // SRSRAN_DEMOD_SOFT_H
@@ -47,6 +47,26 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+/* Maximum number of different (location, size) candidates decoded in a subframe that are kept for reuse */
+#define SRSRAN_PDCCH_MAX_CACHED_DCI 64
+
+/* Result of decoding a candidate, reused by later searches in the same subframe */
+typedef struct SRSRAN_API {
+  srsran_dci_location_t location;
+  uint32_t              nof_bits;
+  bool                  decoded; // Set to false if the candidate was skipped
+  uint16_t              crc_rem;
+  uint8_t               payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_cached_dci_t;
+
+/* Blind search counters since the last call to srsran_pdcch_extract_llr() */
+typedef struct SRSRAN_API {
+  uint32_t nof_candidates; // Candidates requested through srsran_pdcch_decode_msg()
+  uint32_t nof_decodes;    // Candidates that ran the Viterbi decoder
+  uint32_t nof_pruned;     // Candidates skipped due to their low LLR reliability
+  uint32_t nof_cached;     // Candidates served from a previous decode of the same location and size
+} srsran_pdcch_search_metrics_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -67,6 +87,12 @@ typedef struct SRSRAN_API {
   float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
   float*   llr;
 
+  /* blind search state, valid until the next call to srsran_pdcch_extract_llr() */
+  float*                        cce_llr_abs;
+  srsran_pdcch_cached_dci_t     dci_cache[SRSRAN_PDCCH_MAX_CACHED_DCI];
+  uint32_t                      nof_cached_dci;
+  srsran_pdcch_search_metrics_t search_metrics;
+
   /* tx & rx objects */
   srsran_modem_table_t mod;
   srsran_sequence_t    seq[SRSRAN_NOF_SF_X_FRAME];
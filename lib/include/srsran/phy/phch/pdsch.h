@@ -68,13 +68,17 @@ typedef struct SRSRAN_API {
   /* tx & rx objects */
   srsran_modem_table_t mod[SRSRAN_MOD_NITEMS];
 
-  // EVM buffers, one for each codeword (avoid concurrency issue with coworker)
+  // EVM buffers, one for each codeword (avoid concurrency issue with the codeword pool)
   srsran_evm_buffer_t* evm_buffer[SRSRAN_MAX_CODEWORDS];
   float                avg_evm;
 
   srsran_sch_t dl_sch;
 
-  void* coworker_ptr;
+  /* Optional task pool for processing the codewords in parallel */
+  void* cw_pool_ptr;
+
+  /* Code block decoder threads of every SCH object, see srsran_sch_set_decoder_threads() */
+  uint32_t nof_decoder_threads;
 
 } srsran_pdsch_t;
 
@@ -92,7 +96,9 @@ SRSRAN_API int srsran_pdsch_init_enb(srsran_pdsch_t* q, uint32_t max_prb);
 SRSRAN_API void srsran_pdsch_free(srsran_pdsch_t* q);
 
 /* These functions modify the state of the object and may take some time */
-SRSRAN_API int srsran_pdsch_enable_coworker(srsran_pdsch_t* q);
+SRSRAN_API int srsran_pdsch_enable_cw_pool(srsran_pdsch_t* q);
+
+SRSRAN_API int srsran_pdsch_set_decoder_threads(srsran_pdsch_t* q, uint32_t nof_workers);
 
 SRSRAN_API int srsran_pdsch_set_cell(srsran_pdsch_t* q, srsran_cell_t cell);
 
@@ -225,6 +225,23 @@ SRSRAN_API int srsran_prach_detect_offset(srsran_prach_t* p,
                                           float*          peak_to_avg,
                                           uint32_t*       ind_len);
 
+/* Detection of one carrier in a batch, the fields follow the arguments of srsran_prach_detect_offset() */
+typedef struct SRSRAN_API {
+  srsran_prach_t* p;
+  uint32_t        freq_offset;
+  cf_t*           signal;
+  uint32_t        sig_len;
+  uint32_t*       indices;
+  float*          t_offsets;
+  float*          peak_to_avg;
+  uint32_t*       n_indices;
+} srsran_prach_detect_req_t;
+
+/* Detects the preambles of several carriers, each with its own PRACH object and configuration. The signals of all the
+ * carriers are transformed first and then correlated with the root sequences, sharing the ZC IFFT plan between the
+ * carriers with the same sequence length */
+SRSRAN_API int srsran_prach_detect_batch(srsran_prach_detect_req_t* reqs, uint32_t nof_reqs);
+
 SRSRAN_API void srsran_prach_set_detect_factor(srsran_prach_t* p, float factor);
 
 SRSRAN_API int srsran_prach_free(srsran_prach_t* p);
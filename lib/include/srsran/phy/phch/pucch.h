@@ -47,6 +47,9 @@
 #define SRSRAN_PUCCH3_NOF_BITS (4 * SRSRAN_NRE)
 #define SRSRAN_PUCCH_MAX_SYMBOLS (SRSRAN_PUCCH_N_SEQ * SRSRAN_PUCCH2_N_SF * SRSRAN_NOF_SLOTS_PER_SF)
 
+// Number of Format 2/3 scrambling sequences kept, one per RNTI and subframe
+#define SRSRAN_PUCCH_SEQ_CACHE_LEN (SRSRAN_NOF_SF_X_FRAME * 64)
+
 // PUCCH Format 1B Channel selection
 #define SRSRAN_PUCCH_CS_MAX_ACK 4
 #define SRSRAN_PUCCH_CS_MAX_CARRIERS 2
@@ -65,8 +68,8 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pucch_t cqi;
 
-  srsran_sequence_t seq_f2;
-  bool              is_ue;
+  srsran_sequence_cache_t seq_cache;
+  bool                    is_ue;
 
   int16_t  llr[SRSRAN_PUCCH3_NOF_BITS];
   uint8_t  bits_scram[SRSRAN_PUCCH_MAX_BITS];
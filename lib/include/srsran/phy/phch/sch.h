@@ -56,6 +56,10 @@ typedef struct SRSRAN_API {
 
   bool llr_is_8bit;
 
+  /* Turbo decoder early stopping criterion, checked on top of the code block CRC */
+  srsran_tdec_early_stop_t early_stop;
+  int16_t                  early_stop_llr_th;
+
   /* buffers */
   uint8_t*         cb_in;
   uint8_t*         parity_bits;
@@ -71,6 +75,9 @@ typedef struct SRSRAN_API {
 
   srsran_uci_cqi_pusch_t uci_cqi;
 
+  /* Optional pool of decoder contexts for decoding code blocks in parallel */
+  void* decoder_pool_ptr;
+
 } srsran_sch_t;
 
 SRSRAN_API int srsran_sch_init(srsran_sch_t* q);
@@ -81,6 +88,31 @@ SRSRAN_API void srsran_sch_set_max_noi(srsran_sch_t* q, uint32_t max_iterations)
 
 SRSRAN_API float srsran_sch_last_noi(srsran_sch_t* q);
 
+/**
+ * Selects the turbo decoder early stopping criterion for all the code block decoders of the SCH object. The code block
+ * CRC is checked after every iteration regardless of the criterion, a code block stopped by the criterion with a wrong
+ * CRC is considered lost.
+ *
+ * @param q SCH object
+ * @param criterion Turbo decoder early stopping criterion
+ * @param llr_th A-posteriori LLR magnitude threshold for SRSRAN_TDEC_EARLY_STOP_LLR
+ */
+SRSRAN_API void srsran_sch_set_early_stop(srsran_sch_t* q, srsran_tdec_early_stop_t criterion, int16_t llr_th);
+
+/**
+ * Enables parallel code block decoding. The calling thread and nof_workers additional threads, each of them with its
+ * own turbo decoder, share the rate-dematching, turbo decoding and CRC check of the code blocks of a transport block.
+ * When a code block fails, the remaining code blocks are only soft-combined and the transport block is reported as
+ * failed as soon as the running code blocks are finished.
+ *
+ * Setting nof_workers to 0 disables the pool and restores serial decoding.
+ *
+ * @param q SCH object
+ * @param nof_workers Number of additional decoder threads
+ * @return SRSRAN_SUCCESS if the pool is created successfully, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_sch_set_decoder_threads(srsran_sch_t* q, uint32_t nof_workers);
+
 SRSRAN_API int srsran_dlsch_encode(srsran_sch_t* q, srsran_pdsch_cfg_t* cfg, uint8_t* data, uint8_t* e_bits);
 
 SRSRAN_API int srsran_dlsch_encode2(srsran_sch_t*       q,
@@ -99,6 +131,20 @@ SRSRAN_API int srsran_dlsch_decode2(srsran_sch_t*       q,
                                     int                 codeword_idx,
                                     uint32_t            nof_layers);
 
+/**
+ * Decodes a scrambled codeword. The scrambling is removed while rate dematching each code block, so the LLR are read
+ * only once.
+ *
+ * @param seq Scrambling sequence state at the first bit of the codeword, NULL if e_bits are already descrambled
+ */
+SRSRAN_API int srsran_dlsch_decode2_descramble(srsran_sch_t*                  q,
+                                               srsran_pdsch_cfg_t*            cfg,
+                                               int16_t*                       e_bits,
+                                               uint8_t*                       data,
+                                               int                            codeword_idx,
+                                               uint32_t                       nof_layers,
+                                               const srsran_sequence_state_t* seq);
+
 SRSRAN_API int srsran_ulsch_encode(srsran_sch_t*       q,
                                    srsran_pusch_cfg_t* cfg,
                                    uint8_t*            data,
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         resampler_poly.h
+ *
+ *  Description:  Rational ratio polyphase resampler for converting between the
+ *                LTE sampling rates and the rates of RF frontends that cannot
+ *                generate them.
+ *
+ *  Reference:    Multirate Signal Processing for Communication Systems
+ *                fredric j. harris
+ *****************************************************************************/
+
+#ifndef SRSRAN_RESAMPLER_POLY_H
+#define SRSRAN_RESAMPLER_POLY_H
+
+#include <stdint.h>
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Default number of filter taps of every polyphase branch
+ */
+#define SRSRAN_RESAMPLER_POLY_DEFAULT_TAPS 32
+
+/**
+ * Maximum number of polyphase branches, it is the interpolation factor of the reduced input to output rate ratio
+ */
+#define SRSRAN_RESAMPLER_POLY_MAX_PHASES 2048
+
+/**
+ * Polyphase resampler internal state and filter bank
+ */
+typedef struct {
+  double   input_srate_hz;
+  double   output_srate_hz;
+  uint32_t interp;   ///< Interpolation factor L, also the number of polyphase branches
+  uint32_t decim;    ///< Decimation factor M
+  uint32_t nof_taps; ///< Number of taps of every branch, multiple of 4
+  float*   filter;   ///< Time reversed branches, every tap duplicated for the real and imaginary parts
+  cf_t*    buffer;   ///< Last nof_taps - 1 input samples followed by the block being processed
+  uint32_t phase;    ///< Branch of the next output sample
+  uint32_t offset;   ///< Input samples to skip before the next output sample
+} srsran_resampler_poly_t;
+
+/**
+ * Initialises a polyphase resampler from input_srate_hz to output_srate_hz. The ratio between both rates is reduced
+ * to L/M from their values rounded to the closest Hz, it fails if L exceeds SRSRAN_RESAMPLER_POLY_MAX_PHASES.
+ *
+ * The object is not initialised again if the rates and the number of taps have not changed.
+ *
+ * @param q Object pointer
+ * @param input_srate_hz Input sampling rate in Hz
+ * @param output_srate_hz Output sampling rate in Hz
+ * @param nof_taps Number of taps of every polyphase branch, it is rounded up to a multiple of 4. Longer filters have a
+ * sharper transition band at a higher computational cost
+ * @return SRSRAN_SUCCESS if no error, otherwise an SRSRAN error code
+ */
+SRSRAN_API int srsran_resampler_poly_init(srsran_resampler_poly_t* q,
+                                          double                   input_srate_hz,
+                                          double                   output_srate_hz,
+                                          uint32_t                 nof_taps);
+
+/**
+ * @brief Resets the filter memory and the phase of the resampler
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q);
+
+/**
+ * Get the minimum number of input samples that produces nof_output samples from the current state. When decimating
+ * these samples produce exactly nof_output samples, when interpolating they may produce up to L / M more
+ * @param q Object pointer
+ * @param nof_output Number of output samples
+ * @return The number of input samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output);
+
+/**
+ * Get the number of output samples produced by nof_input samples from the current state
+ * @param q Object pointer
+ * @param nof_input Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_get_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input);
+
+/**
+ * Get the filter group delay
+ * @param q Object pointer
+ * @return the delay in number of output samples
+ */
+SRSRAN_API double srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q);
+
+/**
+ * @brief Runs the polyphase resampler, the state is kept between calls so a stream can be resampled in blocks of any
+ * size
+ *
+ * @note Setting the input to NULL is equivalent of feeding zeroes
+ * @note Setting the output to NULL is equivalent of dropping output samples
+ *
+ * @param q Object pointer, make sure it has been initialised
+ * @param input Points at the input complex buffer
+ * @param output Points at the output complex buffer, it must fit srsran_resampler_poly_get_nof_output() samples
+ * @param nof_input Number of input samples
+ * @return The number of output samples
+ */
+SRSRAN_API uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q,
+                                              const cf_t*              input,
+                                              cf_t*                    output,
+                                              uint32_t                 nof_input);
+
+/**
+ * Free polyphase resampler buffers
+ * @param q Object pointer
+ */
+SRSRAN_API void srsran_resampler_poly_free(srsran_resampler_poly_t* q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_RESAMPLER_POLY_H
@@ -60,6 +60,16 @@
 
 #define SRSRAN_PSS_RETURN_PSR // If enabled returns peak to side-lobe ratio, otherwise returns absolute peak value
 
+#define SRSRAN_PSS_MAX_CFO_I 3 // Maximum number of integer CFO hypotheses in srsran_pss_find_pss_multi()
+
+/* Correlation peak for one N_id_2, as found by srsran_pss_find_pss_multi() */
+typedef struct SRSRAN_API {
+  int   peak_pos;   // Same as the value returned by srsran_pss_find_pss()
+  float peak_value; // Same as corr_peak_value in srsran_pss_find_pss()
+  float peak_abs;   // Absolute value of the correlation peak
+  int   cfo_i;      // Integer CFO hypothesis, in subcarriers, with the highest peak
+} srsran_pss_peak_t;
+
 /* Low-level API */
 typedef struct SRSRAN_API {
 
@@ -99,6 +109,13 @@ typedef struct SRSRAN_API {
 
   bool chest_on_filter;
 
+  /* Replicas and correlation averages of srsran_pss_find_pss_multi(), for every N_id_2 and CFO hypothesis */
+  int      offset;
+  uint32_t nof_cfo_i;
+  int      cfo_i[SRSRAN_PSS_MAX_CFO_I];
+  cf_t*    multi_signal_freq[SRSRAN_NOF_NID_2][SRSRAN_PSS_MAX_CFO_I];
+  float*   multi_output_avg[SRSRAN_NOF_NID_2][SRSRAN_PSS_MAX_CFO_I];
+
 } srsran_pss_t;
 
 typedef enum { PSS_TX, PSS_RX } pss_direction_t;
@@ -137,6 +154,11 @@ SRSRAN_API int srsran_pss_set_N_id_2(srsran_pss_t* q, uint32_t N_id_2);
 
 SRSRAN_API int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_value);
 
+SRSRAN_API int srsran_pss_multi_enable(srsran_pss_t* q, const int* cfo_i, uint32_t nof_cfo_i);
+
+SRSRAN_API int
+srsran_pss_find_pss_multi(srsran_pss_t* q, const cf_t* input, srsran_pss_peak_t peaks[SRSRAN_NOF_NID_2]);
+
 SRSRAN_API int srsran_pss_chest(srsran_pss_t* q, const cf_t* input, cf_t ce[SRSRAN_PSS_LEN]);
 
 SRSRAN_API float srsran_pss_cfo_compute(srsran_pss_t* q, const cf_t* pss_recv);
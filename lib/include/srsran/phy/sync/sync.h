@@ -103,6 +103,12 @@ typedef struct SRSRAN_API {
   float cfo_pss_mean;
   int   cfo_i_value;
 
+  // PSS-based CFO and CP detection averages of each N_id_2, used by srsran_sync_find_multi()
+  float cfo_pss_mean_multi[SRSRAN_NOF_NID_2];
+  bool  cfo_pss_is_set_multi[SRSRAN_NOF_NID_2];
+  float M_norm_avg_multi[SRSRAN_NOF_NID_2];
+  float M_ext_avg_multi[SRSRAN_NOF_NID_2];
+
   float cfo_ema_alpha;
 
   uint32_t cfo_cp_nsymbols;
@@ -132,6 +138,20 @@ typedef enum {
   SRSRAN_SYNC_ERROR         = -1
 } srsran_sync_find_ret_t;
 
+/* Result of srsran_sync_find_multi() for one N_id_2 */
+typedef struct SRSRAN_API {
+  srsran_sync_find_ret_t ret;
+  uint32_t               peak_pos;
+  float                  peak_value; // Peak to side-lobe ratio, as srsran_sync_get_peak_value()
+  float                  peak_abs;   // Correlation power at the peak
+  int                    cell_id;    // -1 if the SSS was not detected
+  bool                   sss_detected;
+  uint32_t               sf_idx;
+  srsran_cp_t            cp;
+  srsran_frame_type_t    frame_type;
+  float                  cfo; // Normalised to the subcarrier spacing, as srsran_sync_get_cfo()
+} srsran_sync_multi_res_t;
+
 SRSRAN_API int srsran_sync_init(srsran_sync_t* q, uint32_t frame_size, uint32_t max_offset, uint32_t fft_size);
 
 SRSRAN_API int
@@ -149,6 +169,12 @@ SRSRAN_API srsran_sync_find_ret_t srsran_sync_find(srsran_sync_t* q,
                                                    uint32_t       find_offset,
                                                    uint32_t*      peak_position);
 
+/* Finds the PSS of the three N_id_2 at once around position find_offset, writing one result per N_id_2 */
+SRSRAN_API int srsran_sync_find_multi(srsran_sync_t*          q,
+                                      const cf_t*             input,
+                                      uint32_t                find_offset,
+                                      srsran_sync_multi_res_t res[SRSRAN_NOF_NID_2]);
+
 /* Estimates the CP length */
 SRSRAN_API srsran_cp_t srsran_sync_detect_cp(srsran_sync_t* q, const cf_t* input, uint32_t peak_pos);
 
@@ -73,7 +73,7 @@ typedef struct SRSRAN_API {
   uint32_t *mode_ntimes;
   uint8_t*  mode_counted;
 
-  srsran_ue_cellsearch_result_t* candidates;
+  srsran_ue_cellsearch_result_t* candidates; // max_frames candidates for each N_id_2
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         ue_cell_search_wb.h
+ *
+ *  Description:  Wideband cell scanner.
+ *
+ *                Searches the cells of several carriers contained in a single
+ *                wideband capture. Every carrier is shifted to baseband and
+ *                decimated to 1.92 MHz (SRSRAN_CS_SAMP_FREQ), then its PSS/SSS
+ *                are searched with the ue_cell_search object and the MIB of the
+ *                strongest cell is decoded with the ue_mib_sync object.
+ *
+ *                The carriers are processed in parallel by a task pool. The
+ *                capture sampling rate must be a multiple of 1.92 MHz and it is
+ *                read cyclically, so it should hold at least one radio frame.
+ *
+ *  Reference:
+ *****************************************************************************/
+
+#ifndef SRSRAN_UE_CELL_SEARCH_WB_H
+#define SRSRAN_UE_CELL_SEARCH_WB_H
+
+#include <stdbool.h>
+
+#include "srsran/config.h"
+#include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/ue/ue_mib.h"
+#include "srsran/phy/utils/task_pool.h"
+
+typedef struct SRSRAN_API {
+  uint32_t max_frames_pss;       // Maximum number of 5 ms frames scanned for the PSS/SSS of a carrier
+  uint32_t nof_valid_pss_frames; // Number of PSS/SSS detections averaged for each N_id_2
+  uint32_t max_frames_pbch;      // Maximum number of 10 ms frames to decode the MIB, 0 skips the MIB
+} srsran_ue_cellsearch_wb_cfg_t;
+
+typedef struct SRSRAN_API {
+  float                         freq_offset_hz; // Carrier frequency relative to the capture centre
+  int                           nof_cells;      // Number of N_id_2 with a cell, negative on error
+  srsran_ue_cellsearch_result_t found_cells[SRSRAN_NOF_NID_2];
+  uint32_t                      max_N_id_2; // N_id_2 of the strongest cell
+  bool                          mib_found;
+  srsran_cell_t                 cell; // Strongest cell, with the MIB fields if mib_found
+  uint32_t                      sfn;
+} srsran_ue_cellsearch_wb_result_t;
+
+/* Processing objects of a worker, used for one carrier at a time */
+typedef struct SRSRAN_API {
+  srsran_ue_cellsearch_t cs;
+  srsran_ue_mib_sync_t   ue_mib;
+  srsran_resampler_fft_t ddc;
+  cf_t*                  mix_buffer;
+  cf_t*                  buffer; // Carrier samples at 1.92 MHz
+  uint32_t               buffer_len;
+  uint32_t               buffer_max_len;
+  uint32_t               read_idx;
+} srsran_ue_cellsearch_wb_worker_t;
+
+typedef struct SRSRAN_API {
+  srsran_ue_cellsearch_wb_cfg_t     cfg;
+  double                            srate_hz;
+  uint32_t                          ratio;
+  srsran_task_pool_t                pool;
+  srsran_ue_cellsearch_wb_worker_t* workers;
+  uint32_t                          nof_workers;
+
+  /* Current capture */
+  const cf_t*                       input;
+  uint32_t                          nof_samples;
+  srsran_ue_cellsearch_wb_result_t* results;
+} srsran_ue_cellsearch_wb_t;
+
+/* Creates nof_threads threads besides the calling one, zero processes every carrier in the calling thread */
+SRSRAN_API int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t*           q,
+                                            double                               srate_hz,
+                                            uint32_t                             nof_threads,
+                                            const srsran_ue_cellsearch_wb_cfg_t* cfg);
+
+SRSRAN_API void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q);
+
+/* Searches the carriers at results[i].freq_offset_hz, for i < nof_carriers, in the capture input */
+SRSRAN_API int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t*        q,
+                                            const cf_t*                       input,
+                                            uint32_t                          nof_samples,
+                                            srsran_ue_cellsearch_wb_result_t* results,
+                                            uint32_t                          nof_carriers);
+
+#endif // SRSRAN_UE_CELL_SEARCH_WB_H
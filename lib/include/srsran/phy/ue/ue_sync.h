@@ -221,6 +221,12 @@ SRSRAN_API void srsran_ue_sync_set_agc_period(srsran_ue_sync_t* q, uint32_t peri
 SRSRAN_API int
 srsran_ue_sync_zerocopy(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CHANNELS], const uint32_t max_num_samples);
 
+/* Receives one frame and finds the PSS of the three N_id_2 in it, for scanning cells in a single pass */
+SRSRAN_API int srsran_ue_sync_find_multi(srsran_ue_sync_t*       q,
+                                         cf_t*                   input_buffer[SRSRAN_MAX_CHANNELS],
+                                         const uint32_t          max_num_samples,
+                                         srsran_sync_multi_res_t res[SRSRAN_NOF_NID_2]);
+
 SRSRAN_API void srsran_ue_sync_set_cfo_tol(srsran_ue_sync_t* q, float tol);
 
 SRSRAN_API void srsran_ue_sync_copy_cfo(srsran_ue_sync_t* q, srsran_ue_sync_t* src_obj);
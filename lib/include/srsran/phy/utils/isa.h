@@ -0,0 +1,76 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Runtime selection of the SIMD instruction set used by the PHY kernels.
+ *
+ * When the library is built with ENABLE_ISA_DISPATCH, the portable part of the code is compiled for the baseline ISA
+ * (SSE4.1) and the kernels are additionally compiled for AVX2 and AVX-512. The level returned by srsran_isa_get() is
+ * then used at startup and at object initialization to choose between them. In a regular build the level is capped
+ * to what the library was compiled for, so the same calls are valid (and cheap) in both cases.
+ *
+ * The environment variable SRSRAN_ISA (generic, neon, sse, avx, avx2 or avx512) lowers the selected level, which is
+ * useful for testing the narrower code paths on a wide machine.
+ */
+
+#ifndef SRSRAN_ISA_H
+#define SRSRAN_ISA_H
+
+#include "srsran/config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum SRSRAN_API {
+  SRSRAN_ISA_GENERIC = 0,
+  SRSRAN_ISA_NEON,
+  SRSRAN_ISA_SSE,
+  SRSRAN_ISA_AVX,
+  SRSRAN_ISA_AVX2,
+  SRSRAN_ISA_AVX512,
+} srsran_isa_t;
+
+/* Functions that are compiled for a wider ISA than the rest of the translation unit when dispatching at runtime */
+#ifdef SRSRAN_ISA_DISPATCH
+#define SRSRAN_ISA_TARGET(ISA) __attribute__((target(ISA)))
+#else /* SRSRAN_ISA_DISPATCH */
+#define SRSRAN_ISA_TARGET(ISA)
+#endif /* SRSRAN_ISA_DISPATCH */
+
+/* Highest ISA level supported by the running CPU */
+SRSRAN_API srsran_isa_t srsran_isa_detect();
+
+/* Highest ISA level the library has kernels for */
+SRSRAN_API srsran_isa_t srsran_isa_compiled();
+
+/* ISA level selected for the kernels: the minimum of the above, optionally lowered by SRSRAN_ISA */
+SRSRAN_API srsran_isa_t srsran_isa_get();
+
+SRSRAN_API const char* srsran_isa_to_string(srsran_isa_t isa);
+
+SRSRAN_API int srsran_isa_from_string(const char* str, srsran_isa_t* isa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_ISA_H
@@ -67,6 +67,18 @@ SRSRAN_API void srsran_mat_2x2_mmse_csi_gen(cf_t   y0,
 
 SRSRAN_API int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn);
 
+/* Generic implementation for the MMSE solver of up to 4 receive antennas and 4 layers, h[rx][layer] is the channel of
+ * each layer. A zero noise estimate gives the ZF solution. The CSI of each layer is 1 / inv(H' x H + No)[layer][layer],
+ * as for the 2x2 solvers. It inverts by Gauss-Jordan elimination and it is the reference for the SIMD implementation.
+ */
+SRSRAN_API void srsran_mat_4x4_mmse_csi_gen(const cf_t y[4],
+                                            cf_t       h[4][4],
+                                            cf_t       x[4],
+                                            float      csi[4],
+                                            uint32_t   nof_rx,
+                                            uint32_t   nof_layers,
+                                            float      noise_estimate);
+
 #ifdef LV_HAVE_SSE
 
 /* SSE implementation for complex reciprocal */
@@ -203,6 +215,96 @@ static inline void srsran_mat_2x2_mmse_simd(simd_cf_t  y0,
   srsran_mat_2x2_mmse_csi_simd(y0, y1, h00, h01, h10, h11, x0, x1, &csi0, &csi1, noise_estimate, norm);
 }
 
+/* Reciprocal refined with one Newton-Raphson iteration, the plain approximation is too coarse for chained divisions */
+static inline simd_f_t srsran_mat_f_rcp_simd(simd_f_t a)
+{
+  simd_f_t r = srsran_simd_f_rcp(a);
+  return srsran_simd_f_mul(r, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(a, r)));
+}
+
+static inline simd_f_t srsran_mat_cf_abs2_simd(simd_cf_t a)
+{
+  simd_f_t re = srsran_simd_cf_re(a);
+  simd_f_t im = srsran_simd_cf_im(a);
+  return srsran_simd_f_add(srsran_simd_f_mul(re, re), srsran_simd_f_mul(im, im));
+}
+
+/* Generic SIMD implementation for the MMSE solver of up to 4 receive antennas and 4 layers, see
+ * srsran_mat_4x4_mmse_csi_gen(). It solves with the LDL' decomposition of H' x H + No, which needs no pivoting.
+ */
+static inline void srsran_mat_4x4_mmse_csi_simd(const simd_cf_t y[4],
+                                                simd_cf_t       h[4][4],
+                                                simd_cf_t       x[4],
+                                                simd_f_t        csi[4],
+                                                uint32_t        nof_rx,
+                                                uint32_t        nof_layers,
+                                                float           noise_estimate)
+{
+  simd_cf_t a[4][4]; // Lower triangle of A, replaced by L
+  simd_f_t  d[4];
+  simd_f_t  d_rcp[4];
+  simd_cf_t z[4];
+
+  /* 1. A = H' x H (lower triangle) and Z = H' x Y */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    z[i] = srsran_simd_cf_zero();
+    for (uint32_t n = 0; n < nof_rx; n++) {
+      z[i] = srsran_simd_cf_add(z[i], srsran_simd_cf_conjprod(y[n], h[n][i]));
+    }
+    for (uint32_t j = 0; j <= i; j++) {
+      a[i][j] = srsran_simd_cf_zero();
+      for (uint32_t n = 0; n < nof_rx; n++) {
+        a[i][j] = srsran_simd_cf_add(a[i][j], srsran_simd_cf_conjprod(h[n][j], h[n][i]));
+      }
+    }
+  }
+
+  /* 2. A + No = L x D x L', L is unit lower triangular */
+  simd_f_t _noise_estimate = srsran_simd_f_set1(noise_estimate);
+  for (uint32_t j = 0; j < nof_layers; j++) {
+    d[j] = srsran_simd_f_add(srsran_simd_cf_re(a[j][j]), _noise_estimate);
+    for (uint32_t k = 0; k < j; k++) {
+      d[j] = srsran_simd_f_sub(d[j], srsran_simd_f_mul(srsran_mat_cf_abs2_simd(a[j][k]), d[k]));
+    }
+    d_rcp[j] = srsran_mat_f_rcp_simd(d[j]);
+
+    for (uint32_t i = j + 1; i < nof_layers; i++) {
+      simd_cf_t l = a[i][j];
+      for (uint32_t k = 0; k < j; k++) {
+        l = srsran_simd_cf_sub(l, srsran_simd_cf_mul(srsran_simd_cf_conjprod(a[i][k], a[j][k]), d[k]));
+      }
+      a[i][j] = srsran_simd_cf_mul(l, d_rcp[j]);
+    }
+  }
+
+  /* 3. Solve L x D x L' x X = Z by forward and backward substitution */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    for (uint32_t k = 0; k < i; k++) {
+      z[i] = srsran_simd_cf_sub(z[i], srsran_simd_cf_prod(a[i][k], z[k]));
+    }
+  }
+  for (int i = (int)nof_layers - 1; i >= 0; i--) {
+    x[i] = srsran_simd_cf_mul(z[i], d_rcp[i]);
+    for (uint32_t k = i + 1; k < nof_layers; k++) {
+      x[i] = srsran_simd_cf_sub(x[i], srsran_simd_cf_conjprod(x[k], a[k][i]));
+    }
+  }
+
+  /* 4. Extract CSI from the diagonal of inv(A + No) = inv(L)' x inv(D) x inv(L) */
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    simd_cf_t m[4];
+    simd_f_t  inv = d_rcp[l];
+    for (uint32_t i = l + 1; i < nof_layers; i++) {
+      m[i] = srsran_simd_cf_neg(a[i][l]);
+      for (uint32_t k = l + 1; k < i; k++) {
+        m[i] = srsran_simd_cf_sub(m[i], srsran_simd_cf_prod(a[i][k], m[k]));
+      }
+      inv = srsran_simd_f_add(inv, srsran_simd_f_mul(srsran_mat_cf_abs2_simd(m[i]), d_rcp[i]));
+    }
+    csi[l] = srsran_mat_f_rcp_simd(inv);
+  }
+}
+
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
 typedef struct {
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Fork-join task pool for the physical channel processing.
+ *
+ * A physical channel splits its work into independent jobs (codewords, code blocks...) and runs them with
+ * srsran_task_pool_run(). The jobs are claimed dynamically by the calling thread and the pool worker threads, and the
+ * call returns once all of them have finished. Every job receives the index of the worker running it, so the caller
+ * can keep one set of scratch objects (decoders, buffers) per worker: index 0 is always the calling thread and
+ * indexes 1 to nof_workers are the pool threads.
+ *
+ * A pool runs one batch of jobs at a time and it must be used from a single thread. Jobs may run batches in other
+ * pools.
+ */
+
+#ifndef SRSRAN_TASK_POOL_H
+#define SRSRAN_TASK_POOL_H
+
+#include "srsran/config.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef void (*srsran_task_pool_fn_t)(void* arg, uint32_t task_idx, uint32_t worker_idx);
+
+typedef struct SRSRAN_API {
+  void*    workers_ptr;
+  uint32_t nof_workers;
+
+  /* Current batch, protected by the mutex */
+  pthread_mutex_t       mutex;
+  pthread_cond_t        start_cvar;
+  pthread_cond_t        done_cvar;
+  srsran_task_pool_fn_t fn;
+  void*                 arg;
+  uint32_t              nof_tasks;
+  uint32_t              next_task;
+  uint32_t              nof_pending;
+  uint32_t              batch_id;
+  bool                  quit;
+} srsran_task_pool_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Creates nof_workers threads besides the calling one, zero workers runs every job in the calling thread */
+SRSRAN_API int srsran_task_pool_init(srsran_task_pool_t* q, uint32_t nof_workers);
+
+SRSRAN_API void srsran_task_pool_free(srsran_task_pool_t* q);
+
+SRSRAN_API uint32_t srsran_task_pool_nof_workers(const srsran_task_pool_t* q);
+
+/* Runs fn(arg, task_idx, worker_idx) for every task_idx in [0, nof_tasks) and waits for all of them */
+SRSRAN_API void srsran_task_pool_run(srsran_task_pool_t* q, uint32_t nof_tasks, srsran_task_pool_fn_t fn, void* arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SRSRAN_TASK_POOL_H
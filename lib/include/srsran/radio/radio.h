@@ -26,6 +26,7 @@
 #include "srsran/common/interfaces_common.h"
 #include "srsran/interfaces/radio_interfaces.h"
 #include "srsran/phy/resampling/resampler.h"
+#include "srsran/phy/resampling/resampler_poly.h"
 #include "srsran/phy/rf/rf.h"
 #include "srsran/radio/radio_base.h"
 #include "srsran/srslog/srslog.h"
@@ -95,20 +96,22 @@ public:
   static void rf_msg_callback(void* arg, srsran_rf_error_t error);
 
 private:
-  std::vector<srsran_rf_t>                                rf_devices  = {};
-  std::vector<srsran_rf_info_t>                           rf_info     = {};
-  std::vector<int32_t>                                    rx_offset_n = {};
-  rf_metrics_t                                            rf_metrics  = {};
-  srslog::basic_logger&                                   logger      = srslog::fetch_basic_logger("RF", false);
-  phy_interface_radio*                                    phy         = nullptr;
-  cf_t*                                                   zeros       = nullptr;
-  std::array<cf_t*, SRSRAN_MAX_CHANNELS>                  dummy_buffers;
-  std::mutex                                              tx_mutex;
-  std::mutex                                              rx_mutex;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      tx_buffer;
-  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>      rx_buffer;
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> interpolators = {};
-  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS> decimators    = {};
+  std::vector<srsran_rf_t>                                 rf_devices  = {};
+  std::vector<srsran_rf_info_t>                            rf_info     = {};
+  std::vector<int32_t>                                     rx_offset_n = {};
+  rf_metrics_t                                             rf_metrics  = {};
+  srslog::basic_logger&                                    logger      = srslog::fetch_basic_logger("RF", false);
+  phy_interface_radio*                                     phy         = nullptr;
+  cf_t*                                                    zeros       = nullptr;
+  std::array<cf_t*, SRSRAN_MAX_CHANNELS>                   dummy_buffers;
+  std::mutex                                               tx_mutex;
+  std::mutex                                               rx_mutex;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       tx_buffer;
+  std::array<std::vector<cf_t>, SRSRAN_MAX_CHANNELS>       rx_buffer;
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  interpolators = {};
+  std::array<srsran_resampler_fft_t, SRSRAN_MAX_CHANNELS>  decimators    = {};
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> tx_resamplers = {}; ///< Non integer Tx ratios
+  std::array<srsran_resampler_poly_t, SRSRAN_MAX_CHANNELS> rx_resamplers = {}; ///< Non integer Rx ratios
   bool decimator_busy = false; ///< Indicates the decimator is changing the rate
 
   rf_timestamp_t end_of_burst_time  = {};
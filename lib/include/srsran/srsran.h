@@ -39,6 +39,7 @@ extern "C" {
 #include "srsran/phy/utils/convolution.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/ringbuffer.h"
+#include "srsran/phy/utils/task_pool.h"
 #include "srsran/phy/utils/vector.h"
 
 #include "srsran/phy/common/phy_common.h"
@@ -115,6 +116,7 @@ extern "C" {
 #include "srsran/phy/phch/uci_nr.h"
 
 #include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
 #include "srsran/phy/ue/ue_dl.h"
 #include "srsran/phy/ue/ue_dl_nr.h"
 #include "srsran/phy/ue/ue_mib.h"
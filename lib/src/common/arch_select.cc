@@ -55,10 +55,13 @@ static __inline int __get_cpuid_count_redef(unsigned int  __leaf,
   return 1;
 }
 
-const char* x86_get_isa()
+// ISA levels from the widest to the narrowest, used as fallback order when a binary is missing
+static const char* x86_isa_levels[] = {"avx512", "avx2", "avx", "sse4.2", "generic"};
+
+int x86_get_isa_level()
 {
   int          ret       = 0;
-  int          has_sse42 = 0, has_avx = 0, has_avx2 = 0;
+  int          has_sse42 = 0, has_avx = 0, has_avx2 = 0, has_fma = 0, has_avx512 = 0;
   unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
 
   // query basic features
@@ -68,6 +71,9 @@ const char* x86_get_isa()
     has_sse42 = ecx & bit_SSE4_2;
 #endif
     has_avx   = ecx & bit_AVX;
+#ifdef bit_FMA
+    has_fma = ecx & bit_FMA;
+#endif
   }
 
   // query advanced features
@@ -75,32 +81,40 @@ const char* x86_get_isa()
   ret = __get_cpuid_count_redef(X86_CPUID_ADVANCED_LEAF, 0, &eax, &ebx, &ecx, &edx);
   if (ret) {
     has_avx2 = ebx & bit_AVX2;
+#ifdef bit_AVX512F
+    // Same AVX512 subsets the build enables: F, CD, BW and DQ
+    has_avx512 = (ebx & bit_AVX512F) && (ebx & bit_AVX512CD) && (ebx & bit_AVX512BW) && (ebx & bit_AVX512DQ);
+#endif
   }
 #endif
 
-  if (has_avx2) {
-    return "avx2";
+  if (has_avx512 && has_avx2 && has_fma) {
+    return 0;
+  } else if (has_avx2) {
+    return 1;
   } else if (has_avx) {
-    return "avx";
+    return 2;
   } else if (has_sse42) {
-    return "sse4.2";
+    return 3;
   } else {
-    return "generic";
+    return 4;
   }
 }
 #endif
 
 #ifdef IS_ARM
-const char* arm_get_isa()
+static const char* arm_isa_levels[] = {"neon", "generic"};
+
+int arm_get_isa_level()
 {
 #ifdef HAVE_NEONv8
   if (getauxval(AT_HWCAP) & USER_HWCAP_NEON) {
 #else
   if (getauxval(AT_HWCAP) & HWCAP_NEON) {
 #endif
-    return "neon";
+    return 0;
   } else {
-    return "generic";
+    return 1;
   }
 }
 #endif
@@ -109,14 +123,31 @@ int main(int argc, char* argv[])
 {
   char cmd[MAX_CMD_LEN];
 #ifdef IS_ARM
-  snprintf(cmd, MAX_CMD_LEN, "%s-%s", argv[0], arm_get_isa());
+  const char** levels     = arm_isa_levels;
+  int          nof_levels = sizeof(arm_isa_levels) / sizeof(arm_isa_levels[0]);
+  int          level      = arm_get_isa_level();
 #else
-  snprintf(cmd, MAX_CMD_LEN, "%s-%s", argv[0], x86_get_isa());
+  const char** levels     = x86_isa_levels;
+  int          nof_levels = sizeof(x86_isa_levels) / sizeof(x86_isa_levels[0]);
+  int          level      = x86_get_isa_level();
 #endif
 
-  // execute command with same argument
-  if (execvp(cmd, &argv[0]) == -1) {
-    fprintf(stderr, "%s: %s\n", cmd, strerror(errno));
-    exit(errno);
+  fprintf(stderr, "%s: detected ISA level %s\n", argv[0], levels[level]);
+
+  // Run the binary built for the detected level, falling back to narrower ones if it was not installed
+  int err = ENOENT;
+  for (int i = level; i < nof_levels; i++) {
+    snprintf(cmd, MAX_CMD_LEN, "%s-%s", argv[0], levels[i]);
+    fprintf(stderr, "%s: running %s\n", argv[0], cmd);
+
+    // execute command with same argument, it only returns on error
+    execvp(cmd, &argv[0]);
+    err = errno;
+    fprintf(stderr, "%s: %s\n", cmd, strerror(err));
+    if (err != ENOENT && err != EACCES) {
+      break;
+    }
   }
+
+  exit(err);
 }
@@ -434,6 +434,61 @@ static float estimate_noise_empty_sc(srsran_chest_dl_t* q, cf_t* input)
 }
 
 #define cesymb(i) ce[SRSRAN_RE_IDX(q->cell.nof_prb, i, 0)]
+#define interp_time(in0, in1, start, between, d, M)                                                                    \
+  srsran_interp_linear_vector3(&q->srsran_interp_linvec, in0, in1, start, between, d, M, true, len)
+
+/* Interpolates in the time domain between the symbols with references, only for the len subcarriers starting at ce */
+static void interpolate_pilots_time(srsran_chest_dl_t*     q,
+                                    srsran_dl_sf_cfg_t*    sf,
+                                    srsran_chest_dl_cfg_t* cfg,
+                                    cf_t*                  ce,
+                                    uint32_t               port_id,
+                                    uint32_t               nsymbols,
+                                    uint32_t               len)
+{
+  if (sf->sf_type == SRSRAN_SF_NORM && (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2)) {
+    // If we average per subframe, just copy the estimates in the time domain
+    for (uint32_t l = 1; l < 2 * SRSRAN_CP_NSYMB(q->cell.cp); l++) {
+      memcpy(&ce[l * SRSRAN_NRE * q->cell.nof_prb], ce, sizeof(cf_t) * len);
+    }
+  } else {
+    if (sf->sf_type == SRSRAN_SF_MBSFN) {
+      interp_time(&cesymb(0), &cesymb(2), NULL, &cesymb(1), 2, 1);
+      interp_time(&cesymb(2), &cesymb(6), NULL, &cesymb(3), 4, 3);
+      interp_time(&cesymb(6), &cesymb(10), NULL, &cesymb(7), 4, 3);
+      interp_time(&cesymb(6), &cesymb(10), &cesymb(10), &cesymb(11), 4, 1);
+    } else {
+      if (SRSRAN_CP_ISNORM(q->cell.cp)) {
+        if (port_id < 2) {
+          interp_time(&cesymb(0), &cesymb(4), NULL, &cesymb(1), 4, 3);
+          interp_time(&cesymb(4), &cesymb(7), NULL, &cesymb(5), 3, 2);
+          if (nsymbols == 4) {
+            interp_time(&cesymb(7), &cesymb(11), NULL, &cesymb(8), 4, 3);
+            interp_time(&cesymb(7), &cesymb(11), &cesymb(11), &cesymb(12), 4, 2);
+          } else {
+            interp_time(&cesymb(4), &cesymb(7), &cesymb(7), &cesymb(8), 3, 6);
+          }
+        } else {
+          interp_time(&cesymb(8), &cesymb(1), &cesymb(1), &cesymb(0), 7, 1);
+          interp_time(&cesymb(1), &cesymb(8), NULL, &cesymb(2), 7, 6);
+          interp_time(&cesymb(1), &cesymb(8), NULL, &cesymb(9), 7, 5);
+        }
+      } else {
+        if (port_id < 2) {
+          // TODO: TDD and extended cyclic prefix
+          interp_time(&cesymb(0), &cesymb(3), NULL, &cesymb(1), 3, 2);
+          interp_time(&cesymb(3), &cesymb(6), NULL, &cesymb(4), 3, 2);
+          interp_time(&cesymb(6), &cesymb(9), NULL, &cesymb(7), 3, 2);
+          interp_time(&cesymb(6), &cesymb(9), &cesymb(9), &cesymb(10), 3, 2);
+        } else {
+          interp_time(&cesymb(7), &cesymb(1), &cesymb(1), &cesymb(0), 6, 1);
+          interp_time(&cesymb(1), &cesymb(7), NULL, &cesymb(2), 6, 5);
+          interp_time(&cesymb(1), &cesymb(7), NULL, &cesymb(8), 6, 4);
+        }
+      }
+    }
+  }
+}
 
 static void interpolate_pilots(srsran_chest_dl_t*     q,
                                srsran_dl_sf_cfg_t*    sf,
@@ -509,49 +564,87 @@ static void interpolate_pilots(srsran_chest_dl_t*     q,
   }
 
   /* Now interpolate in the time domain between symbols */
-  if (sf->sf_type == SRSRAN_SF_NORM && (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2)) {
-    // If we average per subframe, just copy the estimates in the time domain
-    for (uint32_t l = 1; l < 2 * SRSRAN_CP_NSYMB(q->cell.cp); l++) {
-      memcpy(&ce[l * SRSRAN_NRE * q->cell.nof_prb], ce, sizeof(cf_t) * SRSRAN_NRE * q->cell.nof_prb);
+  interpolate_pilots_time(q, sf, cfg, ce, port_id, nsymbols, q->cell.nof_prb * SRSRAN_NRE);
+}
+
+/* Equivalent to srsran_interp_linear_offset() for the output subcarriers [k0, k0 + len) only */
+static void interpolate_freq_tile(const cf_t* pilots,
+                                  uint32_t    nof_pilots,
+                                  uint32_t    M,
+                                  uint32_t    off_st,
+                                  cf_t*       output,
+                                  uint32_t    k0,
+                                  uint32_t    len)
+{
+  uint32_t k      = k0;
+  uint32_t k_end  = k0 + len;
+  uint32_t k_last = off_st + (nof_pilots - 1) * M;
+  float    M_inv  = 1.0f / (float)M;
+  cf_t     diff   = pilots[1] - pilots[0];
+
+  // Extrapolate before the first pilot
+  for (; k < k_end && k < off_st; k++) {
+    output[k - k0] = pilots[0] - (off_st - k) * diff / M;
+  }
+
+  // Interpolate between pilots
+  while (k < k_end && k < k_last) {
+    uint32_t i       = (k - off_st) / M;
+    uint32_t seg_end = SRSRAN_MIN(k_end, off_st + (i + 1) * M);
+    diff             = (pilots[i + 1] - pilots[i]) * M_inv;
+    for (; k < seg_end; k++) {
+      output[k - k0] = pilots[i] + diff * (float)(k - off_st - i * M);
     }
-  } else {
-    if (sf->sf_type == SRSRAN_SF_MBSFN) {
-      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(2), &cesymb(1), 2, 1);
-      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(2), &cesymb(6), &cesymb(3), 4, 3);
-      srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(6), &cesymb(10), &cesymb(7), 4, 3);
-      srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(6), &cesymb(10), &cesymb(10), &cesymb(11), 4, 1);
+  }
+
+  // Extrapolate after the last pilot
+  diff = pilots[nof_pilots - 1] - pilots[nof_pilots - 2];
+  for (; k < k_end; k++) {
+    output[k - k0] = pilots[nof_pilots - 1] + (k - k_last) * diff / M;
+  }
+}
+
+/* Interpolates normal subframes in frequency tiles of cfg->tile_nof_prb, so that the frequency and time
+ * interpolation of each tile work on data that is still in cache instead of sweeping the whole grid twice */
+static void interpolate_pilots_tiled(srsran_chest_dl_t*     q,
+                                     srsran_dl_sf_cfg_t*    sf,
+                                     srsran_chest_dl_cfg_t* cfg,
+                                     cf_t*                  pilot_estimates,
+                                     cf_t*                  ce,
+                                     uint32_t               port_id)
+{
+  uint32_t nsymbols = srsran_refsignal_cs_nof_symbols(&q->csr_refs, sf, port_id);
+  uint32_t nof_prb  = q->cell.nof_prb;
+  uint32_t nre      = nof_prb * SRSRAN_NRE;
+  uint32_t tile_len = cfg->tile_nof_prb * SRSRAN_NRE;
+
+  for (uint32_t k0 = 0; k0 < nre; k0 += tile_len) {
+    uint32_t len = SRSRAN_MIN(tile_len, nre - k0);
+
+    if (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE && nsymbols > 1) {
+      interpolate_freq_tile(pilot_estimates, 4 * nof_prb, SRSRAN_NRE / 4, q->cell.id % 3, &ce[k0], k0, len);
+    } else if (cfg->estimator_alg == SRSRAN_ESTIMATOR_ALG_AVERAGE || nsymbols < 2) {
+      interpolate_freq_tile(pilot_estimates,
+                            2 * nof_prb,
+                            SRSRAN_NRE / 2,
+                            srsran_refsignal_cs_fidx(q->cell, 0, port_id, 0),
+                            &ce[k0],
+                            k0,
+                            len);
     } else {
-      if (SRSRAN_CP_ISNORM(q->cell.cp)) {
-        if (port_id < 2) {
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(4), &cesymb(1), 4, 3);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(4), &cesymb(7), &cesymb(5), 3, 2);
-          if (nsymbols == 4) {
-            srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(7), &cesymb(11), &cesymb(8), 4, 3);
-            srsran_interp_linear_vector2(
-                &q->srsran_interp_linvec, &cesymb(7), &cesymb(11), &cesymb(11), &cesymb(12), 4, 2);
-          } else {
-            srsran_interp_linear_vector2(
-                &q->srsran_interp_linvec, &cesymb(4), &cesymb(7), &cesymb(7), &cesymb(8), 3, 6);
-          }
-        } else {
-          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(8), &cesymb(1), &cesymb(1), &cesymb(0), 7, 1);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(8), &cesymb(2), 7, 6);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(8), &cesymb(9), 7, 5);
-        }
-      } else {
-        if (port_id < 2) {
-          // TODO: TDD and extended cyclic prefix
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(0), &cesymb(3), &cesymb(1), 3, 2);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(3), &cesymb(6), &cesymb(4), 3, 2);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(6), &cesymb(9), &cesymb(7), 3, 2);
-          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(6), &cesymb(9), &cesymb(9), &cesymb(10), 3, 2);
-        } else {
-          srsran_interp_linear_vector2(&q->srsran_interp_linvec, &cesymb(7), &cesymb(1), &cesymb(1), &cesymb(0), 6, 1);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(7), &cesymb(2), 6, 5);
-          srsran_interp_linear_vector(&q->srsran_interp_linvec, &cesymb(1), &cesymb(7), &cesymb(8), 6, 4);
-        }
+      for (uint32_t l = 0; l < nsymbols; l++) {
+        uint32_t row = srsran_refsignal_cs_nsymbol(l, q->cell.cp, port_id);
+        interpolate_freq_tile(&pilot_estimates[2 * nof_prb * l],
+                              2 * nof_prb,
+                              SRSRAN_NRE / 2,
+                              srsran_refsignal_cs_fidx(q->cell, l, port_id, 0),
+                              &ce[row * nre + k0],
+                              k0,
+                              len);
       }
     }
+
+    interpolate_pilots_time(q, sf, cfg, &ce[k0], port_id, nsymbols, len);
   }
 }
 
@@ -722,11 +815,15 @@ static void chest_interpolate_noise_est(srsran_chest_dl_t*     q,
     }
 
     /* Smooth estimates (if applicable) and interpolate */
-    if (cfg->filter_type == SRSRAN_CHEST_FILTER_NONE) {
-      interpolate_pilots(q, sf, cfg, q->pilot_estimates, ce, port_id);
-    } else {
+    cf_t* pilot_estimates = q->pilot_estimates;
+    if (cfg->filter_type != SRSRAN_CHEST_FILTER_NONE) {
       average_pilots(q, sf, cfg, q->pilot_estimates, q->pilot_estimates_average, port_id, filter, filter_len);
-      interpolate_pilots(q, sf, cfg, q->pilot_estimates_average, ce, port_id);
+      pilot_estimates = q->pilot_estimates_average;
+    }
+    if (cfg->tile_nof_prb > 0 && cfg->tile_nof_prb < q->cell.nof_prb && ch_mode == SRSRAN_SF_NORM) {
+      interpolate_pilots_tiled(q, sf, cfg, pilot_estimates, ce, port_id);
+    } else {
+      interpolate_pilots(q, sf, cfg, pilot_estimates, ce, port_id);
     }
 
     /* Estimate noise for PSS and EMPTY algorithms */
@@ -0,0 +1,208 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+static const uint32_t nof_ports_list[] = {1, 2, 4};
+static const uint32_t nof_rxant_list[] = {1, 2, 4};
+
+static uint32_t                        nof_prb         = 100;
+static uint32_t                        nof_repetitions = 100;
+static uint32_t                        tile_nof_prb    = 4;
+static srsran_chest_dl_estimator_alg_t estimator_alg   = SRSRAN_ESTIMATOR_ALG_INTERPOLATE;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nrta]\n", prog);
+  printf("\t-n Number of Resource blocks [Default %d]\n", nof_prb);
+  printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-t Tile width in PRB [Default %d]\n", tile_nof_prb);
+  printf("\t-a Estimator algorithm (average, interpolate) [Default interpolate]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nrta")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        tile_nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'a':
+        estimator_alg = srsran_chest_dl_str2estimator_alg(argv[optind]);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static double benchmark(srsran_chest_dl_t*     q,
+                        srsran_dl_sf_cfg_t*    sf,
+                        srsran_chest_dl_cfg_t* cfg,
+                        cf_t*                  input[SRSRAN_MAX_PORTS],
+                        srsran_chest_dl_res_t* res)
+{
+  // Warm up the caches and the result buffers
+  srsran_chest_dl_estimate_cfg(q, sf, cfg, input, res);
+
+  uint64_t t0 = time_ns();
+  for (uint32_t i = 0; i < nof_repetitions; i++) {
+    srsran_chest_dl_estimate_cfg(q, sf, cfg, input, res);
+  }
+  return (double)(time_ns() - t0) / nof_repetitions;
+}
+
+int main(int argc, char** argv)
+{
+  int                   ret        = SRSRAN_ERROR;
+  srsran_random_t       random_gen = srsran_random_init(0);
+  srsran_chest_dl_t     est        = {};
+  srsran_chest_dl_res_t res        = {};
+  srsran_chest_dl_res_t res_tiled  = {};
+
+  cf_t* input[SRSRAN_MAX_PORTS] = {};
+
+  parse_args(argc, argv);
+
+  uint32_t nof_re = SRSRAN_SF_LEN_RE(nof_prb, SRSRAN_CP_NORM);
+
+  if (srsran_chest_dl_init(&est, nof_prb, SRSRAN_MAX_PORTS) || srsran_chest_dl_res_init(&res, nof_prb) ||
+      srsran_chest_dl_res_init(&res_tiled, nof_prb)) {
+    ERROR("Error initializing channel estimator");
+    goto clean_exit;
+  }
+
+  srsran_dl_sf_cfg_t sf_cfg = {};
+  sf_cfg.tti                = 1;
+
+  srsran_chest_dl_cfg_t cfg = {};
+  cfg.estimator_alg         = estimator_alg;
+  cfg.noise_alg             = SRSRAN_NOISE_ALG_REFS;
+  cfg.filter_type           = SRSRAN_CHEST_FILTER_TRIANGLE;
+  cfg.filter_coef[0]        = 0.1f;
+
+  srsran_chest_dl_cfg_t cfg_tiled = cfg;
+  cfg_tiled.tile_nof_prb          = tile_nof_prb;
+
+  printf("%5s %5s  %12s %12s %6s  %9s\n", "ports", "rxant", "ns/RE", "ns/RE tiled", "gain", "max error");
+
+  for (uint32_t p = 0; p < sizeof(nof_ports_list) / sizeof(nof_ports_list[0]); p++) {
+    // The estimator is only reconfigured when the cell identifier changes
+    srsran_cell_t cell = {};
+    cell.nof_prb       = nof_prb;
+    cell.nof_ports     = nof_ports_list[p];
+    cell.id            = 1 + p;
+    cell.cp            = SRSRAN_CP_NORM;
+    if (srsran_chest_dl_set_cell(&est, cell)) {
+      ERROR("Error setting cell");
+      goto clean_exit;
+    }
+
+    for (uint32_t a = 0; a < sizeof(nof_rxant_list) / sizeof(nof_rxant_list[0]); a++) {
+      // The estimator is initialised for the maximum number of antennas, only the first ones are used
+      uint32_t nof_rxant  = nof_rxant_list[a];
+      est.nof_rx_antennas = nof_rxant;
+
+      // Random grid with the reference signals of every port on top
+      for (uint32_t i = 0; i < nof_rxant; i++) {
+        if (input[i] == NULL) {
+          input[i] = srsran_vec_cf_malloc(nof_re);
+          if (input[i] == NULL) {
+            ERROR("Error allocating input");
+            goto clean_exit;
+          }
+        }
+        srsran_random_uniform_complex_dist_vector(random_gen, input[i], nof_re, -0.1f, +0.1f);
+        for (uint32_t port_id = 0; port_id < cell.nof_ports; port_id++) {
+          srsran_refsignal_cs_put_sf(&est.csr_refs, &sf_cfg, port_id, input[i]);
+        }
+      }
+
+      double t_regular = benchmark(&est, &sf_cfg, &cfg, input, &res);
+      double t_tiled   = benchmark(&est, &sf_cfg, &cfg_tiled, input, &res_tiled);
+
+      // Maximum difference relative to the estimate RMS
+      float err = 0.0f;
+      for (uint32_t port_id = 0; port_id < cell.nof_ports; port_id++) {
+        for (uint32_t i = 0; i < nof_rxant; i++) {
+          cf_t* ce       = res.ce[port_id][i];
+          cf_t* ce_tiled = res_tiled.ce[port_id][i];
+          float rms      = sqrtf(srsran_vec_avg_power_cf(ce, nof_re));
+          for (uint32_t k = 0; k < nof_re; k++) {
+            err = SRSRAN_MAX(err, cabsf(ce[k] - ce_tiled[k]) / rms);
+          }
+        }
+      }
+
+      double nof_re_total = (double)nof_re * cell.nof_ports * nof_rxant;
+      printf("%5d %5d  %12.2f %12.2f %5.2fx  %9.2e\n",
+             cell.nof_ports,
+             nof_rxant,
+             t_regular / nof_re_total,
+             t_tiled / nof_re_total,
+             t_regular / t_tiled,
+             err);
+
+      if (isnan(err) || err > 1e-3f) {
+        ERROR("Tiled estimates differ from the regular ones for %d ports and %d antennas", cell.nof_ports, nof_rxant);
+        goto clean_exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_chest_dl_free(&est);
+  srsran_chest_dl_res_free(&res);
+  srsran_chest_dl_res_free(&res_tiled);
+  for (uint32_t i = 0; i < SRSRAN_MAX_PORTS; i++) {
+    if (input[i]) {
+      free(input[i]);
+    }
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
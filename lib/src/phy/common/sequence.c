@@ -146,6 +146,32 @@ static inline uint32_t sequence_gen_LTE_pr_memless_step_x2(uint32_t state)
 static uint32_t sequence_x1_init                    = 0;
 static uint32_t sequence_x2_init[SEQUENCE_SEED_LEN] = {};
 
+/**
+ * Static precomputed jumps
+ * ------------------------
+ *
+ * The same linearity applies to the state after any number of shifts. sequence_x1_jump[k][i] is the X1 state 2^k
+ * shifts after a state with only the bit i set, likewise sequence_x2_jump for X2. A jump of any length is the
+ * composition of the jumps of its bits set to one.
+ */
+#define SEQUENCE_JUMP_MAX_LOG2 (32)
+static uint32_t sequence_x1_jump[SEQUENCE_JUMP_MAX_LOG2][SEQUENCE_SEED_LEN] = {};
+static uint32_t sequence_x2_jump[SEQUENCE_JUMP_MAX_LOG2][SEQUENCE_SEED_LEN] = {};
+
+/**
+ * Below this length, stepping the sequences SEQUENCE_PAR_BITS at a time is faster than jumping
+ */
+#define SEQUENCE_JUMP_MIN_LEN (512U)
+
+static inline uint32_t sequence_jump_apply(const uint32_t* jump, uint32_t state)
+{
+  uint32_t x = 0;
+  for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+    x ^= jump[i] & (0U - ((state >> i) & 1U));
+  }
+  return x;
+}
+
 /**
  * C constructor, pre-computes X1 and X2 initial states
  */
@@ -165,6 +191,18 @@ __attribute__((constructor)) __attribute__((unused)) static void srsran_lte_pr_p
       sequence_x2_init[i] = sequence_gen_LTE_pr_memless_step_x2(sequence_x2_init[i]);
     }
   }
+
+  // Jump tables, a jump of 2^(k+1) shifts is two jumps of 2^k shifts
+  for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+    sequence_x1_jump[0][i] = sequence_gen_LTE_pr_memless_step_x1(1U << i);
+    sequence_x2_jump[0][i] = sequence_gen_LTE_pr_memless_step_x2(1U << i);
+  }
+  for (uint32_t k = 1; k < SEQUENCE_JUMP_MAX_LOG2; k++) {
+    for (uint32_t i = 0; i < SEQUENCE_SEED_LEN; i++) {
+      sequence_x1_jump[k][i] = sequence_jump_apply(sequence_x1_jump[k - 1], sequence_x1_jump[k - 1][i]);
+      sequence_x2_jump[k][i] = sequence_jump_apply(sequence_x2_jump[k - 1], sequence_x2_jump[k - 1][i]);
+    }
+  }
 }
 
 static uint32_t sequence_get_x2_init(uint32_t seed)
@@ -273,8 +311,23 @@ void srsran_sequence_state_gen_f(srsran_sequence_state_t* s, float value, float*
   }
 }
 
+void srsran_sequence_state_jump(srsran_sequence_state_t* s, uint32_t length)
+{
+  for (uint32_t k = 0; length != 0; k++, length >>= 1U) {
+    if (length & 1U) {
+      s->x1 = sequence_jump_apply(sequence_x1_jump[k], s->x1);
+      s->x2 = sequence_jump_apply(sequence_x2_jump[k], s->x2);
+    }
+  }
+}
+
 void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length)
 {
+  if (length >= SEQUENCE_JUMP_MIN_LEN) {
+    srsran_sequence_state_jump(s, length);
+    return;
+  }
+
   uint32_t i = 0;
   if (length >= SEQUENCE_PAR_BITS) {
     for (; i < length - (SEQUENCE_PAR_BITS - 1); i += SEQUENCE_PAR_BITS) {
@@ -291,6 +344,29 @@ void srsran_sequence_state_advance(srsran_sequence_state_t* s, uint32_t length)
   }
 }
 
+/**
+ * Computes 16 steps of the X1 and X2 sequences simultaneously
+ * @param s sequence state
+ * @return the 16 sequence bits before the step, the first one in the LSB
+ */
+static inline uint32_t sequence_state_step16(srsran_sequence_state_t* s)
+{
+  uint32_t c = (s->x1 ^ s->x2) & 0xffffU;
+
+  uint32_t f1 = s->x1 ^ (s->x1 >> 3U);
+  uint32_t f2 = s->x2 ^ (s->x2 >> 1U) ^ (s->x2 >> 2U) ^ (s->x2 >> 3U);
+  s->x1       = (s->x1 >> 16U) ^ ((f1 & 0xffffU) << (SEQUENCE_SEED_LEN - 16U));
+  s->x2       = (s->x2 >> 16U) ^ ((f2 & 0xffffU) << (SEQUENCE_SEED_LEN - 16U));
+
+  return c;
+}
+
+uint32_t srsran_sequence_state_gen_word(srsran_sequence_state_t* s)
+{
+  uint32_t c = sequence_state_step16(s);
+  return c | (sequence_state_step16(s) << 16U);
+}
+
 // static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
 int srsran_sequence_set_LTE_pr(srsran_sequence_t* q, uint32_t len, uint32_t seed)
 {
@@ -437,6 +513,150 @@ void srsran_sequence_free(srsran_sequence_t* q)
   bzero(q, sizeof(srsran_sequence_t));
 }
 
+#define SEQUENCE_CACHE_NONE (UINT32_MAX)
+
+static inline uint32_t sequence_cache_bucket(const srsran_sequence_cache_t* q, uint32_t seed, uint32_t len)
+{
+  return ((seed ^ (len << 16U) ^ (len >> 16U)) * 2654435761U) & (q->nof_buckets - 1);
+}
+
+int srsran_sequence_cache_init(srsran_sequence_cache_t* q, uint32_t max_entries, uint32_t max_len)
+{
+  if (q == NULL || max_entries == 0 || max_len == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_sequence_cache_t));
+
+  // As many buckets as entries, rounded up to a power of two, keeps the chains short
+  q->nof_buckets = 1;
+  while (q->nof_buckets < max_entries) {
+    q->nof_buckets <<= 1U;
+  }
+
+  q->entries = calloc(max_entries, sizeof(srsran_sequence_cache_entry_t));
+  q->bits    = calloc(max_entries, SRSRAN_CEIL(max_len, 8));
+  q->buckets = calloc(q->nof_buckets, sizeof(uint32_t));
+  if (q->entries == NULL || q->bits == NULL || q->buckets == NULL) {
+    srsran_sequence_cache_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < q->nof_buckets; i++) {
+    q->buckets[i] = SEQUENCE_CACHE_NONE;
+  }
+  q->max_entries = max_entries;
+  q->max_len     = max_len;
+  q->head        = SEQUENCE_CACHE_NONE;
+  q->tail        = SEQUENCE_CACHE_NONE;
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sequence_cache_free(srsran_sequence_cache_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+  if (q->entries) {
+    free(q->entries);
+  }
+  if (q->bits) {
+    free(q->bits);
+  }
+  if (q->buckets) {
+    free(q->buckets);
+  }
+  bzero(q, sizeof(srsran_sequence_cache_t));
+}
+
+static void sequence_cache_lru_remove(srsran_sequence_cache_t* q, uint32_t idx)
+{
+  srsran_sequence_cache_entry_t* e = &q->entries[idx];
+
+  if (e->prev != SEQUENCE_CACHE_NONE) {
+    q->entries[e->prev].next = e->next;
+  } else {
+    q->head = e->next;
+  }
+  if (e->next != SEQUENCE_CACHE_NONE) {
+    q->entries[e->next].prev = e->prev;
+  } else {
+    q->tail = e->prev;
+  }
+}
+
+static void sequence_cache_lru_push(srsran_sequence_cache_t* q, uint32_t idx)
+{
+  srsran_sequence_cache_entry_t* e = &q->entries[idx];
+
+  e->prev = SEQUENCE_CACHE_NONE;
+  e->next = q->head;
+  if (q->head != SEQUENCE_CACHE_NONE) {
+    q->entries[q->head].prev = idx;
+  } else {
+    q->tail = idx;
+  }
+  q->head = idx;
+}
+
+static void sequence_cache_bucket_remove(srsran_sequence_cache_t* q, uint32_t idx)
+{
+  srsran_sequence_cache_entry_t* e = &q->entries[idx];
+  uint32_t*                      n = &q->buckets[sequence_cache_bucket(q, e->seed, e->len)];
+
+  while (*n != idx) {
+    n = &q->entries[*n].bucket_next;
+  }
+  *n = e->bucket_next;
+}
+
+const uint8_t* srsran_sequence_cache_get(srsran_sequence_cache_t* q, uint32_t seed, uint32_t len)
+{
+  if (q == NULL || q->entries == NULL || len == 0 || len > q->max_len) {
+    return NULL;
+  }
+
+  // Look up the sequence
+  uint32_t bucket = sequence_cache_bucket(q, seed, len);
+  for (uint32_t idx = q->buckets[bucket]; idx != SEQUENCE_CACHE_NONE; idx = q->entries[idx].bucket_next) {
+    srsran_sequence_cache_entry_t* e = &q->entries[idx];
+    if (e->seed == seed && e->len == len) {
+      if (q->head != idx) {
+        sequence_cache_lru_remove(q, idx);
+        sequence_cache_lru_push(q, idx);
+      }
+      q->nof_hits++;
+      return &q->bits[idx * SRSRAN_CEIL(q->max_len, 8)];
+    }
+  }
+  q->nof_misses++;
+
+  // Take a free entry or evict the least recently used one
+  uint32_t idx;
+  if (q->nof_entries < q->max_entries) {
+    idx = q->nof_entries++;
+  } else {
+    idx = q->tail;
+    sequence_cache_lru_remove(q, idx);
+    sequence_cache_bucket_remove(q, idx);
+  }
+
+  // Applying the sequence to zeros gives its packed bits
+  srsran_sequence_cache_entry_t* e    = &q->entries[idx];
+  uint8_t*                       bits = &q->bits[idx * SRSRAN_CEIL(q->max_len, 8)];
+  memset(bits, 0, SRSRAN_CEIL(len, 8));
+  srsran_sequence_apply_packed(bits, bits, len, seed);
+  e->seed            = seed;
+  e->len             = len;
+  bucket             = sequence_cache_bucket(q, e->seed, e->len);
+  e->bucket_next     = q->buckets[bucket];
+  q->buckets[bucket] = idx;
+  sequence_cache_lru_push(q, idx);
+
+  return bits;
+}
+
 void srsran_sequence_apply_f(const float* in, float* out, uint32_t length, uint32_t seed)
 {
   uint32_t x1 = sequence_x1_init;           // X1 initial state is fix
@@ -19,10 +19,14 @@
  *
  */
 
+#include <inttypes.h>
+#include <string.h>
+
 #include "srsran/phy/common/sequence.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
 
 #define Nc 1600
 #define MAX_SEQ_LEN (256 * 1024)
@@ -192,6 +196,91 @@ static int test_sequence(srsran_sequence_t* sequence, uint32_t seed, uint32_t le
   return SRSRAN_SUCCESS;
 }
 
+static int test_jump(uint32_t seed, uint32_t offset)
+{
+  srsran_sequence_state_t stepped = {};
+  srsran_sequence_state_t jumped  = {};
+
+  srsran_sequence_state_init(&stepped, seed);
+  srsran_sequence_state_init(&jumped, seed);
+
+  // Step in chunks shorter than the jump threshold
+  for (uint32_t n = offset; n > 0;) {
+    uint32_t len = (n < 31) ? n : 31;
+    srsran_sequence_state_advance(&stepped, len);
+    n -= len;
+  }
+  srsran_sequence_state_jump(&jumped, offset);
+
+  if (stepped.x1 != jumped.x1 || stepped.x2 != jumped.x2) {
+    ERROR("Unmatched jump of %d bits with seed %08x", offset, seed);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_cache(uint32_t max_entries)
+{
+  int                     ret   = SRSRAN_ERROR;
+  srsran_sequence_cache_t cache = {};
+  srsran_sequence_t       gold  = {};
+
+  if (srsran_sequence_cache_init(&cache, max_entries, 48 + 3 * 100) != SRSRAN_SUCCESS) {
+    ERROR("Error initializing sequence cache");
+    return SRSRAN_ERROR;
+  }
+
+  // Cycles over twice as many sequences as fit in the cache, the first pass fills it
+  for (uint32_t pass = 0; pass < 3; pass++) {
+    for (uint32_t i = 0; i < 2 * max_entries; i++) {
+      uint32_t seed = 0x1234 + i;
+      uint32_t len  = 48 + (i % 4) * 100;
+
+      // The first half is requested every time, the second half only in the first pass
+      if (pass > 0 && i >= max_entries) {
+        continue;
+      }
+
+      const uint8_t* bits = srsran_sequence_cache_get(&cache, seed, len);
+      if (bits == NULL || srsran_sequence_LTE_pr(&gold, len, seed) != SRSRAN_SUCCESS) {
+        ERROR("Error getting sequence");
+        goto clean_exit;
+      }
+
+      if (memcmp(bits, gold.c_bytes, SRSRAN_CEIL(len, 8)) != 0) {
+        ERROR("Unmatched cached sequence %08x of length %d", seed, len);
+        goto clean_exit;
+      }
+    }
+  }
+
+  // Sequences longer than the entries do not fit
+  if (srsran_sequence_cache_get(&cache, 0x1234, 48 + 3 * 100 + 1) != NULL) {
+    ERROR("Unexpected cached sequence longer than the maximum length");
+    goto clean_exit;
+  }
+
+  // Every sequence of the first half is evicted by the second half in the first pass and generated again in the
+  // second pass, the third pass only hits
+  if (cache.nof_misses != 3 * max_entries || cache.nof_hits != max_entries) {
+    ERROR("Unexpected cache hits %" PRIu64 " and misses %" PRIu64, cache.nof_hits, cache.nof_misses);
+    goto clean_exit;
+  }
+
+  printf("Sequence cache of %d entries: %" PRIu64 " hits, %" PRIu64 " misses\n",
+         max_entries,
+         cache.nof_hits,
+         cache.nof_misses);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_sequence_cache_free(&cache);
+  srsran_sequence_free(&gold);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   uint32_t repetitions = 1;
@@ -233,9 +322,19 @@ int main(int argc, char** argv)
     test_sequence(&sequence, (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), length, repetitions);
   }
 
+  int ret = SRSRAN_SUCCESS;
+  for (uint32_t offset = 1; offset <= max_length && ret == SRSRAN_SUCCESS; offset = (offset * 3) / 2 + 1) {
+    ret = test_jump((uint32_t)srsran_random_uniform_int_dist(random_gen, 1, INT32_MAX), offset);
+  }
+
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_cache(16);
+  }
+
   // Free sequence object
   srsran_sequence_free(&sequence);
   srsran_random_free(random_gen);
 
-  return SRSRAN_SUCCESS;
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
 }
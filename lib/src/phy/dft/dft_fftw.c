@@ -53,6 +53,117 @@ static int get_fftw_wisdom_file(char* full_path, uint32_t n)
 
 static pthread_mutex_t fft_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/*
+ * Process-wide plan cache.
+ *
+ * An FFTW plan only depends on the transform geometry and on the alignment of the arrays it was created for, so all
+ * the objects requesting the same transform share a single plan and execute it on their own buffers through the
+ * new-array execute functions, which are thread-safe. Plans are created on first use and kept until the process
+ * exits: re-planning a size that any object has used before, or that was warmed at startup, is a table lookup.
+ *
+ * All the cache accesses are protected by fft_mutex, as the FFTW planner is not thread-safe either.
+ */
+#define DFT_PLAN_CACHE_MAX_NOF_PLANS 1024
+
+typedef struct {
+  srsran_dft_mode_t mode;
+  int               size;
+  int               sign; // FFTW_FORWARD/FFTW_BACKWARD for complex, FFTW_R2HC/FFTW_HC2R for real
+  int               istride;
+  int               ostride;
+  int               how_many;
+  int               idist;
+  int               odist;
+  bool              in_place;
+  int               in_align;
+  int               out_align;
+} dft_plan_key_t;
+
+typedef struct {
+  dft_plan_key_t key;
+  fftwf_plan     p;
+  uint32_t       nof_users;
+} dft_plan_cache_entry_t;
+
+static dft_plan_cache_entry_t dft_plan_cache[DFT_PLAN_CACHE_MAX_NOF_PLANS];
+static uint32_t               dft_plan_cache_nof_plans = 0;
+
+static void dft_plan_key_set_buffers(dft_plan_key_t* key, void* in, void* out)
+{
+  key->in_place  = (in == out);
+  key->in_align  = fftwf_alignment_of((float*)in);
+  key->out_align = fftwf_alignment_of((float*)out);
+}
+
+// Gets a plan from the cache or creates it on the given buffers, fft_mutex must be locked
+static fftwf_plan dft_plan_cache_get(const dft_plan_key_t* key, void* in, void* out)
+{
+  for (uint32_t i = 0; i < dft_plan_cache_nof_plans; i++) {
+    if (memcmp(&dft_plan_cache[i].key, key, sizeof(dft_plan_key_t)) == 0) {
+      dft_plan_cache[i].nof_users++;
+      return dft_plan_cache[i].p;
+    }
+  }
+
+  fftwf_plan p = NULL;
+  if (key->mode == SRSRAN_DFT_COMPLEX && key->how_many == 1 && key->istride == 1 && key->ostride == 1) {
+    p = fftwf_plan_dft_1d(key->size, in, out, key->sign, FFTW_TYPE);
+  } else if (key->mode == SRSRAN_DFT_COMPLEX) {
+    const fftwf_iodim iodim        = {key->size, key->istride, key->ostride};
+    const fftwf_iodim howmany_dims = {key->how_many, key->idist, key->odist};
+    p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in, out, key->sign, FFTW_TYPE);
+  } else {
+    p = fftwf_plan_r2r_1d(key->size, in, out, (fftwf_r2r_kind)key->sign, FFTW_TYPE);
+  }
+
+  // A full cache is not an error, the plan is just owned by the caller
+  if (p != NULL && dft_plan_cache_nof_plans < DFT_PLAN_CACHE_MAX_NOF_PLANS) {
+    dft_plan_cache_entry_t* e = &dft_plan_cache[dft_plan_cache_nof_plans++];
+    e->key                    = *key;
+    e->p                      = p;
+    e->nof_users              = 1;
+  }
+
+  return p;
+}
+
+// Releases a plan obtained from dft_plan_cache_get(), fft_mutex must be locked
+static void dft_plan_cache_put(fftwf_plan p)
+{
+  if (p == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < dft_plan_cache_nof_plans; i++) {
+    if (dft_plan_cache[i].p == p) {
+      if (dft_plan_cache[i].nof_users > 0) {
+        dft_plan_cache[i].nof_users--;
+      }
+      return;
+    }
+  }
+
+  fftwf_destroy_plan(p);
+}
+
+uint32_t srsran_dft_plan_cache_nof_plans()
+{
+  pthread_mutex_lock(&fft_mutex);
+  uint32_t n = dft_plan_cache_nof_plans;
+  pthread_mutex_unlock(&fft_mutex);
+  return n;
+}
+
+int srsran_dft_plan_cache_warm(int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t mode)
+{
+  srsran_dft_plan_t plan = {};
+  if (srsran_dft_plan(&plan, dft_points, dir, mode)) {
+    return SRSRAN_ERROR;
+  }
+  srsran_dft_plan_free(&plan);
+  return SRSRAN_SUCCESS;
+}
+
 // This function is called in the beggining of any executable where it is linked
 __attribute__((constructor)) static void srsran_dft_load()
 {
@@ -73,7 +184,21 @@ __attribute__((destructor)) static void srsran_dft_exit()
   get_fftw_wisdom_file(full_path, sizeof(full_path));
   fftwf_export_wisdom_to_filename(full_path);
 #endif
-  fftwf_cleanup();
+
+  // Objects with static storage may still hold plans, FFTW can only be cleaned up if none is in use
+  pthread_mutex_lock(&fft_mutex);
+  bool in_use = false;
+  for (uint32_t i = 0; i < dft_plan_cache_nof_plans; i++) {
+    in_use |= (dft_plan_cache[i].nof_users > 0);
+  }
+  if (!in_use) {
+    for (uint32_t i = 0; i < dft_plan_cache_nof_plans; i++) {
+      fftwf_destroy_plan(dft_plan_cache[i].p);
+    }
+    dft_plan_cache_nof_plans = 0;
+    fftwf_cleanup();
+  }
+  pthread_mutex_unlock(&fft_mutex);
 }
 
 int srsran_dft_plan(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir, srsran_dft_mode_t mode)
@@ -110,6 +235,46 @@ static void allocate(srsran_dft_plan_t* plan, int size_in, int size_out, int len
   plan->out = fftwf_malloc((size_t)size_out * len);
 }
 
+static fftwf_plan dft_plan_get(srsran_dft_mode_t mode,
+                               int               dft_points,
+                               srsran_dft_dir_t  dir,
+                               void*             in,
+                               void*             out,
+                               int               istride,
+                               int               ostride,
+                               int               how_many,
+                               int               idist,
+                               int               odist)
+{
+  dft_plan_key_t key = {};
+  key.mode           = mode;
+  key.size           = dft_points;
+  if (mode == SRSRAN_DFT_COMPLEX) {
+    key.sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
+  } else {
+    key.sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
+  }
+  key.istride  = istride;
+  key.ostride  = ostride;
+  key.how_many = how_many;
+  key.idist    = idist;
+  key.odist    = odist;
+  dft_plan_key_set_buffers(&key, in, out);
+
+  pthread_mutex_lock(&fft_mutex);
+  fftwf_plan p = dft_plan_cache_get(&key, in, out);
+  pthread_mutex_unlock(&fft_mutex);
+
+  return p;
+}
+
+static void dft_plan_put(fftwf_plan p)
+{
+  pthread_mutex_lock(&fft_mutex);
+  dft_plan_cache_put(p);
+  pthread_mutex_unlock(&fft_mutex);
+}
+
 int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
                              const int          new_dft_points,
                              cf_t*              in_buffer,
@@ -120,23 +285,16 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
                              int                idist,
                              int                odist)
 {
-  int sign = (plan->forward) ? FFTW_FORWARD : FFTW_BACKWARD;
-
-  const fftwf_iodim iodim        = {new_dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
-
-  pthread_mutex_lock(&fft_mutex);
-
-  /* Destroy current plan */
-  fftwf_destroy_plan(plan->p);
-
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
-
-  pthread_mutex_unlock(&fft_mutex);
+  /* Release current plan */
+  dft_plan_put(plan->p);
 
+  plan->p = dft_plan_get(
+      SRSRAN_DFT_COMPLEX, new_dft_points, plan->dir, in_buffer, out_buffer, istride, ostride, how_many, idist, odist);
   if (!plan->p) {
     return -1;
   }
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
   plan->size      = new_dft_points;
   plan->init_size = plan->size;
 
@@ -145,21 +303,13 @@ int srsran_dft_replan_guru_c(srsran_dft_plan_t* plan,
 
 int srsran_dft_replan_c(srsran_dft_plan_t* plan, const int new_dft_points)
 {
-  int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-
   // No change in size, skip re-planning
   if (plan->size == new_dft_points) {
     return 0;
   }
 
-  pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
-  }
-  plan->p = fftwf_plan_dft_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
-  pthread_mutex_unlock(&fft_mutex);
-
+  dft_plan_put(plan->p);
+  plan->p = dft_plan_get(SRSRAN_DFT_COMPLEX, new_dft_points, plan->dir, plan->in, plan->out, 1, 1, 1, 0, 0);
   if (!plan->p) {
     return -1;
   }
@@ -178,19 +328,15 @@ int srsran_dft_plan_guru_c(srsran_dft_plan_t* plan,
                            int                idist,
                            int                odist)
 {
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-
-  const fftwf_iodim iodim        = {dft_points, istride, ostride};
-  const fftwf_iodim howmany_dims = {how_many, idist, odist};
-
-  pthread_mutex_lock(&fft_mutex);
-
-  plan->p = fftwf_plan_guru_dft(1, &iodim, 1, &howmany_dims, in_buffer, out_buffer, sign, FFTW_TYPE);
+  plan->p = dft_plan_get(
+      SRSRAN_DFT_COMPLEX, dft_points, dir, in_buffer, out_buffer, istride, ostride, how_many, idist, odist);
   if (!plan->p) {
     return -1;
   }
-  pthread_mutex_unlock(&fft_mutex);
 
+  // The buffers belong to the caller, they are kept for executing the shared plan on them
+  plan->in        = in_buffer;
+  plan->out       = out_buffer;
   plan->size      = dft_points;
   plan->init_size = plan->size;
   plan->mode      = SRSRAN_DFT_COMPLEX;
@@ -209,13 +355,7 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 {
   allocate(plan, sizeof(fftwf_complex), sizeof(fftwf_complex), dft_points);
 
-  pthread_mutex_lock(&fft_mutex);
-
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_FORWARD : FFTW_BACKWARD;
-  plan->p  = fftwf_plan_dft_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
-
-  pthread_mutex_unlock(&fft_mutex);
-
+  plan->p = dft_plan_get(SRSRAN_DFT_COMPLEX, dft_points, dir, plan->in, plan->out, 1, 1, 1, 0, 0);
   if (!plan->p) {
     return -1;
   }
@@ -235,16 +375,8 @@ int srsran_dft_plan_c(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_
 
 int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
 {
-  int sign = (plan->dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
-
-  pthread_mutex_lock(&fft_mutex);
-  if (plan->p) {
-    fftwf_destroy_plan(plan->p);
-    plan->p = NULL;
-  }
-  plan->p = fftwf_plan_r2r_1d(new_dft_points, plan->in, plan->out, sign, FFTW_TYPE);
-  pthread_mutex_unlock(&fft_mutex);
-
+  dft_plan_put(plan->p);
+  plan->p = dft_plan_get(SRSRAN_REAL, new_dft_points, plan->dir, plan->in, plan->out, 1, 1, 1, 0, 0);
   if (!plan->p) {
     return -1;
   }
@@ -255,12 +387,8 @@ int srsran_dft_replan_r(srsran_dft_plan_t* plan, const int new_dft_points)
 int srsran_dft_plan_r(srsran_dft_plan_t* plan, const int dft_points, srsran_dft_dir_t dir)
 {
   allocate(plan, sizeof(float), sizeof(float), dft_points);
-  int sign = (dir == SRSRAN_DFT_FORWARD) ? FFTW_R2HC : FFTW_HC2R;
-
-  pthread_mutex_lock(&fft_mutex);
-  plan->p = fftwf_plan_r2r_1d(dft_points, plan->in, plan->out, sign, FFTW_TYPE);
-  pthread_mutex_unlock(&fft_mutex);
 
+  plan->p = dft_plan_get(SRSRAN_REAL, dft_points, dir, plan->in, plan->out, 1, 1, 1, 0, 0);
   if (!plan->p) {
     return -1;
   }
@@ -340,7 +468,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
   fftwf_complex* f_out = plan->out;
 
   copy_pre((uint8_t*)plan->in, (uint8_t*)in, sizeof(cf_t), plan->size, plan->forward, plan->mirror, plan->dc);
-  fftwf_execute(plan->p);
+  fftwf_execute_dft(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / sqrtf(plan->size);
     srsran_vec_sc_prod_cfc(f_out, norm, f_out, plan->size);
@@ -356,7 +484,7 @@ void srsran_dft_run_c(srsran_dft_plan_t* plan, const cf_t* in, cf_t* out)
 void srsran_dft_run_guru_c(srsran_dft_plan_t* plan)
 {
   if (plan->is_guru == true) {
-    fftwf_execute(plan->p);
+    fftwf_execute_dft(plan->p, plan->in, plan->out);
   } else {
     ERROR("srsran_dft_run_guru_c: the selected plan is not guru!");
   }
@@ -370,7 +498,7 @@ void srsran_dft_run_r(srsran_dft_plan_t* plan, const float* in, float* out)
   float* f_out = plan->out;
 
   memcpy(plan->in, in, sizeof(float) * plan->size);
-  fftwf_execute(plan->p);
+  fftwf_execute_r2r(plan->p, plan->in, plan->out);
   if (plan->norm) {
     norm = 1.0 / plan->size;
     srsran_vec_sc_prod_fff(f_out, norm, f_out, plan->size);
@@ -397,8 +525,7 @@ void srsran_dft_plan_free(srsran_dft_plan_t* plan)
     if (plan->out)
       fftwf_free(plan->out);
   }
-  if (plan->p)
-    fftwf_destroy_plan(plan->p);
+  dft_plan_cache_put(plan->p);
   pthread_mutex_unlock(&fft_mutex);
   bzero(plan, sizeof(srsran_dft_plan_t));
 }
@@ -35,6 +35,51 @@
 /* Uncomment next line for avoiding Guru DFT call */
 //#define AVOID_GURU
 
+/* In fused mode the frequency shift, DFT window offset compensation, normalization and subcarrier (de)mapping are
+ * folded around the DFT so every symbol is read and written once before and once after it:
+ *  - The frequency shift phase ramp restarts at every symbol, so it is applied to the DFT window samples only, with the
+ *    same vector for all symbols. Tx derives the cyclic prefix from the shifted symbol end with a constant phase.
+ *  - In Rx, the window offset compensation, the normalization and the phase of the shift at the DFT window start are
+ *    combined in a single gain per extracted subcarrier, applied while extracting them.
+ *  - In Tx, the normalization is applied to the occupied subcarriers while mapping them.
+ * MBSFN subframes always use the regular processing.
+ */
+static void ofdm_fused_update(srsran_ofdm_t* q)
+{
+  if (!q->cfg.fused || q->fused_shift == NULL) {
+    return;
+  }
+
+  uint32_t symbol_sz  = q->cfg.symbol_sz;
+  uint32_t nof_re     = q->nof_re;
+  uint32_t dc         = (q->fft_plan.dc) ? 1 : 0;
+  float    freq_shift = q->cfg.freq_shift_f;
+  bool     shift      = isnormal(freq_shift);
+  cf_t     gain       = q->fft_plan.norm ? 1.0f / sqrtf(symbol_sz) : 1.0f;
+
+  if (shift) {
+    for (uint32_t n = 0; n < symbol_sz; n++) {
+      q->fused_shift[n] = cexpf(I * 2.0f * M_PI * (float)n * freq_shift / (float)symbol_sz);
+    }
+    q->fused_cp_gain = cexpf(-I * 2.0f * M_PI * freq_shift);
+    gain *= cexpf(-I * 2.0f * M_PI * (float)q->window_offset_n * freq_shift / (float)symbol_sz);
+  }
+
+  for (uint32_t k = 0; k < nof_re; k++) {
+    uint32_t idx     = (k < nof_re / 2) ? symbol_sz - nof_re / 2 + k : dc + k - nof_re / 2;
+    q->fused_gain[k] = q->window_offset_n ? gain * q->window_offset_buffer[idx] : gain;
+  }
+
+  q->fused_gain_en = q->fft_plan.norm || q->window_offset_n || shift;
+}
+
+#ifndef AVOID_GURU
+static bool ofdm_fused_enabled(srsran_ofdm_t* q)
+{
+  return q->cfg.fused && !q->mbsfn_subframe;
+}
+#endif /* AVOID_GURU */
+
 static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft_dir_t dir)
 {
   // If the symbol size is not given, calculate in function of the number of resource blocks
@@ -114,6 +159,20 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
       return SRSRAN_ERROR;
     }
 
+    if (q->cfg.fused) {
+      if (q->fused_shift) {
+        free(q->fused_shift);
+        free(q->fused_gain);
+      }
+
+      q->fused_shift = srsran_vec_cf_malloc(symbol_sz);
+      q->fused_gain  = srsran_vec_cf_malloc(q->nof_re);
+      if (!q->fused_shift || !q->fused_gain) {
+        perror("malloc");
+        return SRSRAN_ERROR;
+      }
+    }
+
     q->max_prb = cfg->nof_prb;
   }
 
@@ -207,6 +266,7 @@ static int ofdm_init_mbsfn_(srsran_ofdm_t* q, srsran_ofdm_cfg_t* cfg, srsran_dft
   srsran_ofdm_set_freq_shift(q, q->cfg.freq_shift_f);
   srsran_dft_plan_set_norm(&q->fft_plan, q->cfg.normalize);
   srsran_dft_plan_set_dc(&q->fft_plan, (!cfg->keep_dc) && (!isnormal(q->cfg.freq_shift_f)));
+  ofdm_fused_update(q);
 
   return SRSRAN_SUCCESS;
 }
@@ -237,6 +297,12 @@ void srsran_ofdm_free_(srsran_ofdm_t* q)
   if (q->window_offset_buffer) {
     free(q->window_offset_buffer);
   }
+  if (q->fused_shift) {
+    free(q->fused_shift);
+  }
+  if (q->fused_gain) {
+    free(q->fused_gain);
+  }
   SRSRAN_MEM_ZERO(q, srsran_ofdm_t, 1);
 }
 
@@ -338,6 +404,7 @@ int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift)
   // Check if fft shift is required
   if (!isnormal(q->cfg.freq_shift_f)) {
     srsran_dft_plan_set_dc(&q->fft_plan, true);
+    ofdm_fused_update(q);
     return SRSRAN_SUCCESS;
   }
 
@@ -357,6 +424,7 @@ int srsran_ofdm_set_freq_shift(srsran_ofdm_t* q, float freq_shift)
 
   /* Disable DC carrier addition */
   srsran_dft_plan_set_dc(&q->fft_plan, false);
+  ofdm_fused_update(q);
 
   return SRSRAN_SUCCESS;
 }
@@ -421,6 +489,44 @@ static void ofdm_rx_slot(srsran_ofdm_t* q, int slot_in_sf)
 #endif
 }
 
+#ifndef AVOID_GURU
+static void ofdm_rx_slot_fused(srsran_ofdm_t* q, int slot_in_sf)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    nof_re    = q->nof_re;
+  uint32_t    dc        = (q->fft_plan.dc) ? 1 : 0;
+  cf_t*       input     = q->cfg.in_buffer + slot_in_sf * q->slot_sz;
+  cf_t*       output    = q->cfg.out_buffer + slot_in_sf * nof_re * q->nof_symbols;
+  cf_t*       tmp       = q->tmp;
+
+  // Shift only the DFT window samples
+  if (isnormal(q->cfg.freq_shift_f)) {
+    for (uint32_t i = 0; i < q->nof_symbols; i++) {
+      input += SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+      srsran_vec_prod_ccc(input - q->window_offset_n, q->fused_shift, input - q->window_offset_n, symbol_sz);
+      input += symbol_sz;
+    }
+  }
+
+  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+
+  // Extract the subcarriers applying the combined gain
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    if (q->fused_gain_en) {
+      srsran_vec_prod_ccc(&tmp[symbol_sz - nof_re / 2], q->fused_gain, output, nof_re / 2);
+      srsran_vec_prod_ccc(&tmp[dc], &q->fused_gain[nof_re / 2], &output[nof_re / 2], nof_re / 2);
+    } else {
+      memcpy(output, &tmp[symbol_sz - nof_re / 2], sizeof(cf_t) * nof_re / 2);
+      memcpy(&output[nof_re / 2], &tmp[dc], sizeof(cf_t) * nof_re / 2);
+    }
+
+    tmp += symbol_sz;
+    output += nof_re;
+  }
+}
+#endif /* AVOID_GURU */
+
 static void ofdm_rx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t i;
@@ -452,6 +558,15 @@ void srsran_ofdm_rx_slot_zerocopy(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 
 void srsran_ofdm_rx_sf(srsran_ofdm_t* q)
 {
+#ifndef AVOID_GURU
+  if (ofdm_fused_enabled(q)) {
+    for (uint32_t n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+      ofdm_rx_slot_fused(q, n);
+    }
+    return;
+  }
+#endif /* AVOID_GURU */
+
   if (isnormal(q->cfg.freq_shift_f)) {
     srsran_vec_prod_ccc(q->cfg.in_buffer, q->shift_buffer, q->cfg.in_buffer, q->sf_sz);
   }
@@ -535,6 +650,53 @@ static void ofdm_tx_slot(srsran_ofdm_t* q, int slot_in_sf)
 #endif
 }
 
+#ifndef AVOID_GURU
+static void ofdm_tx_slot_fused(srsran_ofdm_t* q, int slot_in_sf)
+{
+  uint32_t    symbol_sz = q->cfg.symbol_sz;
+  srsran_cp_t cp        = q->cfg.cp;
+  uint32_t    nof_re    = q->nof_re;
+  uint32_t    dc        = (q->fft_plan.dc) ? 1 : 0;
+  float       norm      = 1.0f / sqrtf(symbol_sz);
+  cf_t*       input     = q->cfg.in_buffer + slot_in_sf * nof_re * q->nof_symbols;
+  cf_t*       output    = q->cfg.out_buffer + slot_in_sf * q->slot_sz;
+  cf_t*       tmp       = q->tmp;
+
+  // Map the subcarriers, normalizing only the occupied ones
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    if (q->fft_plan.norm) {
+      srsran_vec_sc_prod_cfc(&input[nof_re / 2], norm, &tmp[dc], nof_re / 2);
+      srsran_vec_sc_prod_cfc(&input[0], norm, &tmp[symbol_sz - nof_re / 2], nof_re / 2);
+    } else {
+      memcpy(&tmp[dc], &input[nof_re / 2], sizeof(cf_t) * nof_re / 2);
+      memcpy(&tmp[symbol_sz - nof_re / 2], &input[0], sizeof(cf_t) * nof_re / 2);
+    }
+    if (dc) {
+      tmp[0] = 0.0f;
+    }
+
+    input += nof_re;
+    tmp += symbol_sz;
+  }
+
+  srsran_dft_run_guru_c(&q->fft_plan_sf[slot_in_sf]);
+
+  // Shift the symbol and add the cyclic prefix
+  for (uint32_t i = 0; i < q->nof_symbols; i++) {
+    uint32_t cp_len = SRSRAN_CP_ISNORM(cp) ? SRSRAN_CP_LEN_NORM(i, symbol_sz) : SRSRAN_CP_LEN_EXT(symbol_sz);
+
+    if (isnormal(q->cfg.freq_shift_f)) {
+      srsran_vec_prod_ccc(&output[cp_len], q->fused_shift, &output[cp_len], symbol_sz);
+      srsran_vec_sc_prod_ccc(&output[symbol_sz], q->fused_cp_gain, output, cp_len);
+    } else {
+      memcpy(output, &output[symbol_sz], sizeof(cf_t) * cp_len);
+    }
+
+    output += symbol_sz + cp_len;
+  }
+}
+#endif /* AVOID_GURU */
+
 void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 {
   uint32_t symbol_sz = q->cfg.symbol_sz;
@@ -557,11 +719,21 @@ void ofdm_tx_slot_mbsfn(srsran_ofdm_t* q, cf_t* input, cf_t* output)
 void srsran_ofdm_set_normalize(srsran_ofdm_t* q, bool normalize_enable)
 {
   srsran_dft_plan_set_norm(&q->fft_plan, normalize_enable);
+  ofdm_fused_update(q);
 }
 
 void srsran_ofdm_tx_sf(srsran_ofdm_t* q)
 {
   uint32_t n;
+#ifndef AVOID_GURU
+  if (ofdm_fused_enabled(q)) {
+    for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
+      ofdm_tx_slot_fused(q, n);
+    }
+    return;
+  }
+#endif /* AVOID_GURU */
+
   if (!q->mbsfn_subframe) {
     for (n = 0; n < SRSRAN_NOF_SLOTS_PER_SF; n++) {
       ofdm_tx_slot(q, n);
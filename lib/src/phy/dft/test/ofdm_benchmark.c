@@ -0,0 +1,253 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES_UNIT "cycles"
+static uint64_t cycles_now()
+{
+  return __rdtsc();
+}
+#else /* defined(__x86_64__) || defined(__i386__) */
+#define CYCLES_UNIT "ns"
+static uint64_t cycles_now()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+#endif /* defined(__x86_64__) || defined(__i386__) */
+
+static const uint32_t prb_list[] = {6, 15, 25, 50, 75, 100};
+
+static int         nof_prb          = -1;
+static int         nof_repetitions  = 1000;
+static float       rx_window_offset = 0.5f;
+static float       freq_shift_f     = 0.5f;
+static bool        normalize        = true;
+static srsran_cp_t cp               = SRSRAN_CP_NORM;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-n Number of Resource blocks [Default 6 to 100]\n");
+  printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
+  printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
+  printf("\t-d disable normalization [Default enabled]\n");
+  printf("\t-e extended cyclic prefix [Default Normal]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nrosde")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_prb = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (int)strtol(argv[optind], NULL, 10);
+        break;
+      case 'o':
+        rx_window_offset = SRSRAN_MIN(1.0f, SRSRAN_MAX(0.0f, strtof(argv[optind], NULL)));
+        break;
+      case 's':
+        freq_shift_f = SRSRAN_MIN(1.0f, SRSRAN_MAX(0.0f, strtof(argv[optind], NULL)));
+        break;
+      case 'd':
+        normalize = false;
+        break;
+      case 'e':
+        cp = SRSRAN_CP_EXT;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  srsran_ofdm_t tx;
+  srsran_ofdm_t rx;
+  cf_t*         tx_in;
+  cf_t*         tx_out;
+  cf_t*         rx_in;
+  cf_t*         rx_out;
+} ofdm_pair_t;
+
+static int ofdm_pair_init(ofdm_pair_t* q, uint32_t n_prb, bool fused)
+{
+  uint32_t n_re   = SRSRAN_SF_LEN_RE(n_prb, cp);
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB(n_prb);
+
+  q->tx_in  = srsran_vec_cf_malloc(n_re);
+  q->tx_out = srsran_vec_cf_malloc(sf_len);
+  q->rx_in  = srsran_vec_cf_malloc(sf_len);
+  q->rx_out = srsran_vec_cf_malloc(n_re);
+  if (!q->tx_in || !q->tx_out || !q->rx_in || !q->rx_out) {
+    return SRSRAN_ERROR;
+  }
+  srsran_vec_cf_zero(q->tx_out, sf_len);
+
+  srsran_ofdm_cfg_t cfg = {};
+  cfg.cp                = cp;
+  cfg.nof_prb           = n_prb;
+  cfg.normalize         = normalize;
+  cfg.fused             = fused;
+  cfg.in_buffer         = q->tx_in;
+  cfg.out_buffer        = q->tx_out;
+  cfg.freq_shift_f      = freq_shift_f;
+  if (srsran_ofdm_tx_init_cfg(&q->tx, &cfg)) {
+    return SRSRAN_ERROR;
+  }
+
+  cfg.in_buffer        = q->rx_in;
+  cfg.out_buffer       = q->rx_out;
+  cfg.freq_shift_f     = -freq_shift_f;
+  cfg.rx_window_offset = rx_window_offset;
+  if (srsran_ofdm_rx_init_cfg(&q->rx, &cfg)) {
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void ofdm_pair_free(ofdm_pair_t* q)
+{
+  srsran_ofdm_tx_free(&q->tx);
+  srsran_ofdm_rx_free(&q->rx);
+  free(q->tx_in);
+  free(q->tx_out);
+  free(q->rx_in);
+  free(q->rx_out);
+}
+
+static void benchmark(ofdm_pair_t* q, double* tx_cycles, double* rx_cycles)
+{
+  uint64_t t0 = cycles_now();
+  for (int i = 0; i < nof_repetitions; i++) {
+    srsran_ofdm_tx_sf(&q->tx);
+  }
+  uint64_t t1 = cycles_now();
+  for (int i = 0; i < nof_repetitions; i++) {
+    srsran_ofdm_rx_sf(&q->rx);
+  }
+  uint64_t t2 = cycles_now();
+
+  *tx_cycles = (double)(t1 - t0) / nof_repetitions;
+  *rx_cycles = (double)(t2 - t1) / nof_repetitions;
+}
+
+// Maximum difference relative to the reference RMS
+static float max_error(const cf_t* ref, const cf_t* x, uint32_t len)
+{
+  float err = 0.0f;
+  for (uint32_t i = 0; i < len; i++) {
+    err = SRSRAN_MAX(err, cabsf(ref[i] - x[i]));
+  }
+  return err / sqrtf(srsran_vec_avg_power_cf(ref, len));
+}
+
+int main(int argc, char** argv)
+{
+  int             ret        = SRSRAN_SUCCESS;
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  parse_args(argc, argv);
+
+  printf("%4s  %12s %12s %6s  %12s %12s %6s  %9s\n",
+         "PRB",
+         "Tx " CYCLES_UNIT,
+         "Tx fused",
+         "gain",
+         "Rx " CYCLES_UNIT,
+         "Rx fused",
+         "gain",
+         "max error");
+
+  for (uint32_t p = 0; p < sizeof(prb_list) / sizeof(prb_list[0]); p++) {
+    uint32_t n_prb  = (nof_prb > 0) ? (uint32_t)nof_prb : prb_list[p];
+    uint32_t n_re   = SRSRAN_SF_LEN_RE(n_prb, cp);
+    uint32_t sf_len = SRSRAN_SF_LEN_PRB(n_prb);
+
+    ofdm_pair_t legacy = {};
+    ofdm_pair_t fused  = {};
+    if (ofdm_pair_init(&legacy, n_prb, false) || ofdm_pair_init(&fused, n_prb, true)) {
+      ERROR("Error initialising OFDM for %d PRB", n_prb);
+      ret = SRSRAN_ERROR;
+      break;
+    }
+
+    // Both paths must produce the same signal, the Rx input is shifted in place so it is copied every time
+    srsran_random_uniform_complex_dist_vector(random_gen, legacy.tx_in, n_re, -1.0f, +1.0f);
+    srsran_vec_cf_copy(fused.tx_in, legacy.tx_in, n_re);
+    srsran_ofdm_tx_sf(&legacy.tx);
+    srsran_ofdm_tx_sf(&fused.tx);
+    srsran_vec_cf_copy(legacy.rx_in, legacy.tx_out, sf_len);
+    srsran_vec_cf_copy(fused.rx_in, legacy.tx_out, sf_len);
+    srsran_ofdm_rx_sf(&legacy.rx);
+    srsran_ofdm_rx_sf(&fused.rx);
+    float err = SRSRAN_MAX(max_error(legacy.tx_out, fused.tx_out, sf_len), max_error(legacy.rx_out, fused.rx_out, n_re));
+
+    double tx_legacy, rx_legacy, tx_fused, rx_fused;
+    benchmark(&legacy, &tx_legacy, &rx_legacy);
+    benchmark(&fused, &tx_fused, &rx_fused);
+
+    printf("%4d  %12.0f %12.0f %5.2fx  %12.0f %12.0f %5.2fx  %9.2e\n",
+           n_prb,
+           tx_legacy,
+           tx_fused,
+           tx_legacy / tx_fused,
+           rx_legacy,
+           rx_fused,
+           rx_legacy / rx_fused,
+           err);
+
+    ofdm_pair_free(&legacy);
+    ofdm_pair_free(&fused);
+
+    if (err > 1e-3f) {
+      ERROR("Fused OFDM output differs from the regular one for %d PRB", n_prb);
+      ret = SRSRAN_ERROR;
+      break;
+    }
+
+    if (nof_prb > 0) {
+      break;
+    }
+  }
+
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
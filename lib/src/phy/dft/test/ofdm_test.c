@@ -35,6 +35,7 @@ static int         nof_repetitions  = 1;
 static float       rx_window_offset = 0.5f;
 static float       freq_shift_f     = 0.0f;
 static uint32_t    force_symbol_sz  = 0;
+static bool        fused            = false;
 static double      elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 {
   if (ts_end->tv_usec > ts_start->tv_usec) {
@@ -55,12 +56,13 @@ static void usage(char* prog)
   printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-o rx window offset (portion of CP length) [Default %.1f]\n", rx_window_offset);
   printf("\t-s frequency shift (normalised with sampling rate) [Default %.1f]\n", freq_shift_f);
+  printf("\t-f use the fused OFDM processing [Default %s]\n", fused ? "true" : "false");
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "Nneros")) != -1) {
+  while ((opt = getopt(argc, argv, "Nnerosf")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (int)strtol(argv[optind], NULL, 10);
@@ -80,6 +82,9 @@ static void parse_args(int argc, char** argv)
       case 's':
         freq_shift_f = SRSRAN_MIN(1.0f, SRSRAN_MAX(0.0f, strtof(argv[optind], NULL)));
         break;
+      case 'f':
+        fused = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -130,6 +135,7 @@ int main(int argc, char** argv)
     ofdm_cfg.symbol_sz         = symbol_sz;
     ofdm_cfg.freq_shift_f      = freq_shift_f;
     ofdm_cfg.normalize         = true;
+    ofdm_cfg.fused             = fused;
     if (srsran_ofdm_tx_init_cfg(&ifft, &ofdm_cfg)) {
       ERROR("Error initializing iFFT");
       exit(-1);
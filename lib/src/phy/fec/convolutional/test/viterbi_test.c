@@ -36,6 +36,7 @@ static int      frame_length = 1000, nof_frames = 256;
 static float    ebno_db     = 100.0;
 static uint32_t seed        = 0;
 static bool     tail_biting = false;
+static bool     wava        = false;
 
 #define SNR_POINTS 10
 #define SNR_MIN 0.0
@@ -43,18 +44,19 @@ static bool     tail_biting = false;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nlest]\n", prog);
+  printf("Usage: %s [nlestw]\n", prog);
   printf("\t-n nof_frames [Default %d]\n", nof_frames);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
   printf("\t-s seed [Default 0=time]\n");
   printf("\t-t tail_bitting [Default %s]\n", tail_biting ? "yes" : "no");
+  printf("\t-w wrap-around decoding of tail_bitting [Default %s]\n", wava ? "yes" : "no");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nlste")) != -1) {
+  while ((opt = getopt(argc, argv, "nlstew")) != -1) {
     switch (opt) {
       case 'n':
         nof_frames = (int)strtol(argv[optind], NULL, 10);
@@ -71,6 +73,9 @@ void parse_args(int argc, char** argv)
       case 't':
         tail_biting = true;
         break;
+      case 'w':
+        wava = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -137,7 +142,11 @@ int main(int argc, char** argv)
   cod.R        = 3;
   coded_length = cod.R * (frame_length + ((cod.tail_biting) ? 0 : cod.K - 1));
   srsran_viterbi_init(&dec, SRSRAN_VITERBI_37, cod.poly, frame_length, cod.tail_biting);
-  printf("Convolutional Code 1/3 K=%d Tail bitting: %s\n", cod.K, cod.tail_biting ? "yes" : "no");
+  srsran_viterbi_set_wava(&dec, wava);
+  printf("Convolutional Code 1/3 K=%d Tail bitting: %s%s\n",
+         cod.K,
+         cod.tail_biting ? "yes" : "no",
+         cod.tail_biting && wava ? " (WAVA)" : "");
 
 #ifdef TEST_SSE
   srsran_viterbi_init_sse(&dec_sse, SRSRAN_VITERBI_37, cod.poly, frame_length, cod.tail_biting);
@@ -29,6 +29,7 @@
 #include "parity.h"
 #include "srsran/phy/fec/convolutional/viterbi.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 #include "viterbi37.h"
 
@@ -47,6 +48,24 @@
 
 //#undef LV_HAVE_SSE
 
+/* Writes the decoded data of a wrap-around (WAVA) pass. The first 6 bits of the chainback of the whole block are the
+ * starting state and the last 6 data bits are held by the final state. Returns true if the path is tail-biting, so no
+ * more passes are needed */
+static bool viterbi37_wava_output(const uint8_t* tmp, uint8_t* data, uint32_t frame_length, uint32_t end_state)
+{
+  uint32_t start_state = 0;
+  for (uint32_t i = 0; i < 6; i++) {
+    start_state = (start_state << 1) | tmp[i];
+  }
+
+  memcpy(data, &tmp[6], (frame_length - 6) * sizeof(uint8_t));
+  for (uint32_t i = 0; i < 6; i++) {
+    data[frame_length - 6 + i] = (uint8_t)((end_state >> (5 - i)) & 1);
+  }
+
+  return start_state == (end_state & 63);
+}
+
 int decode37(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
   srsran_viterbi_t* q = o;
@@ -62,7 +81,21 @@ int decode37(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
   init_viterbi37_port(q->ptr, q->tail_biting ? -1 : 0);
 
   /* Decode block */
-  if (q->tail_biting) {
+  if (q->tail_biting && q->wava && frame_length > q->K - 1) {
+    /* Every pass appends its decisions, the passes that do not converge are the tripled block */
+    bool tail_biting_found = false;
+    restart_viterbi37_port(q->ptr);
+    for (uint32_t i = 0; i < TB_ITER - 1 && !tail_biting_found; i++) {
+      update_viterbi37_blk_port(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_port(q->ptr, q->tmp, (i + 1) * frame_length, best_state);
+      tail_biting_found = viterbi37_wava_output(&q->tmp[i * frame_length], data, frame_length, best_state);
+    }
+    if (!tail_biting_found) {
+      update_viterbi37_blk_port(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_port(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+      memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length + 6], frame_length * sizeof(uint8_t));
+    }
+  } else if (q->tail_biting) {
     for (int i = 0; i < TB_ITER; i++) {
       memcpy(&q->tmp[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint8_t));
     }
@@ -93,7 +126,21 @@ int decode37_sse(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length
   init_viterbi37_sse(q->ptr, q->tail_biting ? -1 : 0);
 
   /* Decode block */
-  if (q->tail_biting) {
+  if (q->tail_biting && q->wava && frame_length > q->K - 1) {
+    /* Every pass appends its decisions, the passes that do not converge are the tripled block */
+    bool tail_biting_found = false;
+    restart_viterbi37_sse(q->ptr);
+    for (uint32_t i = 0; i < TB_ITER - 1 && !tail_biting_found; i++) {
+      update_viterbi37_blk_sse(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_sse(q->ptr, q->tmp, (i + 1) * frame_length, best_state);
+      tail_biting_found = viterbi37_wava_output(&q->tmp[i * frame_length], data, frame_length, best_state);
+    }
+    if (!tail_biting_found) {
+      update_viterbi37_blk_sse(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_sse(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+      memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length + 6], frame_length * sizeof(uint8_t));
+    }
+  } else if (q->tail_biting) {
     for (int i = 0; i < TB_ITER; i++) {
       memcpy(&q->tmp[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint8_t));
     }
@@ -141,7 +188,21 @@ int decode37_avx2_16bit(void* o, uint16_t* symbols, uint8_t* data, uint32_t fram
   init_viterbi37_avx2_16bit(q->ptr, q->tail_biting ? -1 : 0);
 
   /* Decode block */
-  if (q->tail_biting) {
+  if (q->tail_biting && q->wava && frame_length > q->K - 1) {
+    /* Every pass appends its decisions, the passes that do not converge are the tripled block */
+    bool tail_biting_found = false;
+    restart_viterbi37_avx2_16bit(q->ptr);
+    for (uint32_t i = 0; i < TB_ITER - 1 && !tail_biting_found; i++) {
+      update_viterbi37_blk_avx2_16bit(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_avx2_16bit(q->ptr, q->tmp, (i + 1) * frame_length, best_state);
+      tail_biting_found = viterbi37_wava_output(&q->tmp[i * frame_length], data, frame_length, best_state);
+    }
+    if (!tail_biting_found) {
+      update_viterbi37_blk_avx2_16bit(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_avx2_16bit(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+      memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length + 6], frame_length * sizeof(uint8_t));
+    }
+  } else if (q->tail_biting) {
     for (int i = 0; i < TB_ITER; i++) {
       memcpy(&q->tmp_s[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint16_t));
     }
@@ -188,7 +249,21 @@ int decode37_avx2(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_lengt
   /* Initialize Viterbi decoder */
   init_viterbi37_avx2(q->ptr, q->tail_biting ? -1 : 0);
   /* Decode block */
-  if (q->tail_biting) {
+  if (q->tail_biting && q->wava && frame_length > q->K - 1) {
+    /* Every pass appends its decisions, the passes that do not converge are the tripled block */
+    bool tail_biting_found = false;
+    restart_viterbi37_avx2(q->ptr);
+    for (uint32_t i = 0; i < TB_ITER - 1 && !tail_biting_found; i++) {
+      update_viterbi37_blk_avx2(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_avx2(q->ptr, q->tmp, (i + 1) * frame_length, best_state);
+      tail_biting_found = viterbi37_wava_output(&q->tmp[i * frame_length], data, frame_length, best_state);
+    }
+    if (!tail_biting_found) {
+      update_viterbi37_blk_avx2(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_avx2(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+      memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length + 6], frame_length * sizeof(uint8_t));
+    }
+  } else if (q->tail_biting) {
     for (int i = 0; i < TB_ITER; i++) {
       memcpy(&q->tmp[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint8_t));
     }
@@ -233,7 +308,21 @@ int decode37_neon(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_lengt
   init_viterbi37_neon(q->ptr, q->tail_biting ? -1 : 0);
 
   /* Decode block */
-  if (q->tail_biting) {
+  if (q->tail_biting && q->wava && frame_length > q->K - 1) {
+    /* Every pass appends its decisions, the passes that do not converge are the tripled block */
+    bool tail_biting_found = false;
+    restart_viterbi37_neon(q->ptr);
+    for (uint32_t i = 0; i < TB_ITER - 1 && !tail_biting_found; i++) {
+      update_viterbi37_blk_neon(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_neon(q->ptr, q->tmp, (i + 1) * frame_length, best_state);
+      tail_biting_found = viterbi37_wava_output(&q->tmp[i * frame_length], data, frame_length, best_state);
+    }
+    if (!tail_biting_found) {
+      update_viterbi37_blk_neon(q->ptr, symbols, frame_length, &best_state);
+      chainback_viterbi37_neon(q->ptr, q->tmp, TB_ITER * frame_length, best_state);
+      memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length + 6], frame_length * sizeof(uint8_t));
+    }
+  } else if (q->tail_biting) {
     for (int i = 0; i < TB_ITER; i++) {
       memcpy(&q->tmp[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint8_t));
     }
@@ -471,6 +560,11 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
 
 #endif
 
+void srsran_viterbi_set_wava(srsran_viterbi_t* q, bool enable)
+{
+  q->wava = enable;
+}
+
 void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant)
 {
   q->gain_quant = gain_quant;
@@ -493,14 +587,15 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
 #ifdef LV_HAVE_SSE
 
 #ifdef LV_HAVE_AVX2
+      if (srsran_isa_get() >= SRSRAN_ISA_AVX2) {
 #ifdef VITERBI_16
-      return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
+        return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
 #else
-      return init37_avx2(q, poly, max_frame_length, tail_bitting);
+        return init37_avx2(q, poly, max_frame_length, tail_bitting);
 #endif
-#else
-      return init37_sse(q, poly, max_frame_length, tail_bitting);
+      }
 #endif
+      return init37_sse(q, poly, max_frame_length, tail_bitting);
 #else
 #ifdef HAVE_NEON
       return init37_neon(q, poly, max_frame_length, tail_bitting);
@@ -532,6 +627,10 @@ int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
                              uint32_t              max_frame_length,
                              bool                  tail_bitting)
 {
+  if (srsran_isa_get() < SRSRAN_ISA_AVX2) {
+    ERROR("AVX2 Viterbi decoder not supported by this CPU");
+    return -1;
+  }
   return init37_avx2(q, poly, max_frame_length, tail_bitting);
 }
 #endif
@@ -565,12 +664,14 @@ int srsran_viterbi_decode_f(srsran_viterbi_t* q, float* symbols, uint8_t* data,
       }
     }
 #ifdef VITERBI_16
-    srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
-    return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
-#else
+    // The 16-bit decoder is only installed if the CPU supports it
+    if (q->decode_s) {
+      srsran_vec_quant_fus(symbols, q->symbols_us, q->gain_quant / max, 32767.5, 65535, len);
+      return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
+    }
+#endif
     srsran_vec_quant_fuc(symbols, q->symbols_uc, q->gain_quant / max, 127.5, 255, len);
     return srsran_viterbi_decode_uc(q, q->symbols_uc, data, frame_length);
-#endif
   } else {
     return q->decode_f(q, symbols, data, frame_length);
   }
@@ -597,12 +698,13 @@ int srsran_viterbi_decode_s(srsran_viterbi_t* q, int16_t* symbols, uint8_t* data
     }
   }
 #ifdef VITERBI_16
-  srsran_vec_quant_sus(symbols, q->symbols_us, 1, (float)INT16_MAX, UINT16_MAX, len);
-  return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
-#else
+  if (q->decode_s) {
+    srsran_vec_quant_sus(symbols, q->symbols_us, 1, (float)INT16_MAX, UINT16_MAX, len);
+    return srsran_viterbi_decode_us(q, q->symbols_us, data, frame_length);
+  }
+#endif
   srsran_vec_quant_suc(symbols, q->symbols_uc, (float)q->gain_quant / max, 127, 255, len);
   return srsran_viterbi_decode_uc(q, q->symbols_uc, data, frame_length);
-#endif
 }
 
 int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
@@ -28,6 +28,8 @@ void* create_viterbi37_port(int polys[3], uint32_t len);
 
 int init_viterbi37_port(void* p, int starting_state);
 
+void restart_viterbi37_port(void* p);
+
 int chainback_viterbi37_port(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
 
 void delete_viterbi37_port(void* p);
@@ -38,6 +40,8 @@ void* create_viterbi37_sse(int polys[3], uint32_t len);
 
 int init_viterbi37_sse(void* p, int starting_state);
 
+void restart_viterbi37_sse(void* p);
+
 void reset_blk_sse(void* p, int nbits);
 
 int chainback_viterbi37_sse(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
@@ -50,6 +54,8 @@ void* create_viterbi37_neon(int polys[3], uint32_t len);
 
 int init_viterbi37_neon(void* p, int starting_state);
 
+void restart_viterbi37_neon(void* p);
+
 void reset_blk_neon(void* p, int nbits);
 
 int chainback_viterbi37_neon(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
@@ -62,6 +68,8 @@ void* create_viterbi37_avx2(int polys[3], uint32_t len);
 
 int init_viterbi37_avx2(void* p, int starting_state);
 
+void restart_viterbi37_avx2(void* p);
+
 void reset_blk_avx2(void* p, int nbits);
 
 int chainback_viterbi37_avx2(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
@@ -74,6 +82,8 @@ void* create_viterbi37_avx2_16bit(int polys[3], uint32_t len);
 
 int init_viterbi37_avx2_16bit(void* p, int starting_state);
 
+void restart_viterbi37_avx2_16bit(void* p);
+
 void reset_blk_avx2_16bit(void* p, int nbits);
 
 int chainback_viterbi37_avx2_16bit(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
@@ -92,6 +92,17 @@ int init_viterbi37_neon(void* p, int starting_state)
   return 0;
 }
 
+/* Starts the passes over a tail-biting block keeping the path metrics. The decisions are stored after 6 empty ones so
+ * the chainback of the passes also yields the starting state */
+void restart_viterbi37_neon(void* p)
+{
+  struct v37* vp = p;
+
+  if (vp != NULL) {
+    vp->dp = vp->decisions + 6;
+  }
+}
+
 /* Create a new instance of a Viterbi decoder */
 void* create_viterbi37_neon(int polys[3], uint32_t len)
 {
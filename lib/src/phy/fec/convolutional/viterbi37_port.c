@@ -69,6 +69,17 @@ int init_viterbi37_port(void* p, int starting_state)
   return 0;
 }
 
+/* Starts the passes over a tail-biting block keeping the path metrics. The decisions are stored after 6 empty ones so
+ * the chainback of the passes also yields the starting state */
+void restart_viterbi37_port(void* p)
+{
+  struct v37* vp = p;
+
+  if (vp != NULL) {
+    vp->dp = vp->decisions + 6;
+  }
+}
+
 void set_viterbi37_polynomial_port(int polys[3])
 {
   int state;
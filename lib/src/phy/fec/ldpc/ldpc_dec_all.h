@@ -738,6 +738,28 @@ int update_ldpc_soft_bits_c_avx512(void* p, int i_layer, const int8_t (*these_va
  */
 int extract_ldpc_message_c_avx512(void* p, uint8_t* message, uint16_t liftK);
 
+/*!
+ * Initializes the inner registers of the optimized 8-bit integer-based LDPC decoder before
+ * decoding several codeblocks at once, one per block of \b ls lanes (LS <= \ref SRSRAN_AVX512_B_SIZE / 2).
+ * \param[in,out] p       A pointer to the decoder registers (an ldpc_regs_c_avx512 structure).
+ * \param[in]     llrs    The arrays of LLR values from the channel, one per codeblock.
+ * \param[in]     nof_cbs The number of codeblocks, not larger than SRSRAN_AVX512_B_SIZE / ls.
+ * \param[in]     ls      The lifting size.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int init_ldpc_dec_c_avx512_batch(void* p, const int8_t** llrs, uint32_t nof_cbs, uint16_t ls);
+
+/*!
+ * Returns the decoded message (hard bits) of one of the codeblocks decoded at once (optimized 8-bit version,
+ * LS <= \ref SRSRAN_AVX512_B_SIZE / 2).
+ * \param[in]  p       A pointer to the decoder registers (an ldpc_regs_c_avx512 structure).
+ * \param[in]  i_cb    The index of the codeblock within the batch.
+ * \param[out] message A pointer to the decoded message.
+ * \param[in]  liftK   The length of the decoded message.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int extract_ldpc_message_c_avx512_batch(void* p, uint32_t i_cb, uint8_t* message, uint16_t liftK);
+
 /*!
  * Creates the registers used by the optimized 8-bit-based implementation of the LDPC decoder
  * (flooded scheduling, LS > \ref SRSRAN_AVX512_B_SIZE).
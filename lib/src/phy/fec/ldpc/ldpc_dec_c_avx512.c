@@ -24,6 +24,10 @@
  * \brief Definition LDPC decoder inner functions working
  *    with 8-bit integer-valued LLRs (AVX512 version, lifting size < 64).
  *
+ * When the lifting size is small enough, each 512-bit line is split into SRSRAN_AVX512_B_SIZE / ls blocks of ls
+ * lanes, and every block can hold the lifted nodes of a different codeblock. Node rotations are carried out within
+ * each block, while all the other operations are lane-wise, so that the codeblocks are decoded independently.
+ *
  * Even if the inner representation is based on 8 bits, check-to-variable and
  * variable-to-check messages are actually represented with 7 bits, the
  * remaining bit is used to represent infinity.
@@ -83,7 +87,11 @@ struct ldpc_regs_c_avx512 {
   __m512i* this_c2v_epi8_to_free; /*!< \brief Helper register for the current c2v node with one extra __m512 allocated
                                      space. */
 
-  uint16_t ls;     /*!< \brief Lifting size. */
+  uint64_t rot_mask_lo[SRSRAN_AVX512_B_SIZE]; /*!< \brief Rotation masks (per shift) of the non-wrapping lanes. */
+  uint64_t rot_mask_hi[SRSRAN_AVX512_B_SIZE]; /*!< \brief Rotation masks (per shift) of the wrapping lanes. */
+
+  uint16_t ls;         /*!< \brief Lifting size. */
+  uint8_t  nof_blocks; /*!< \brief Number of blocks of ls lanes (i.e., codeblocks) fitting in a 512-bit line. */
   uint8_t  hrr;    /*!< \brief Number of variable nodes in the high-rate region (before lifting). */
   uint8_t  bgM;    /*!< \brief Number of check nodes (before lifting). */
   uint8_t  bgN;    /*!< \brief Number of variable nodes (before lifting). */
@@ -108,14 +116,15 @@ static void inner_var_to_check_c_avx512(const __m512i* x, const __m512i* y, __m5
 
 /*!
  * Rotate the contents of a node towards the right by \b shift chars, that is the
- * \b shift * 8 most significant bits become the least significant ones.
+ * \b shift * 8 most significant bits become the least significant ones. The rotation
+ * is carried out independently within each block of \b ls lanes.
  * \param[in]  mem_addr   The node to rotate.
  * \param[out] out        The rotated node.
- * \param[in]  shift      The order of the rotation in number of chars.
- * \param[in]  ls         The size of the node (lifting size).
- * \param[in]  n_subnodes The number of subnodes in each node.
+ * \param[in]  this_shift The order of the rotation in number of chars.
+ * \param[in]  vp         The decoder registers, holding the lifting size and the rotation masks.
  */
-static void rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t this_shift, uint16_t ls);
+static void
+rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t this_shift, const struct ldpc_regs_c_avx512* vp);
 
 /*!
  * Scale packed 8-bit integers in \b a by the scaling factor \b sf / #F2I.
@@ -165,10 +174,26 @@ void* create_ldpc_dec_c_avx512(uint8_t bgN, uint8_t bgM, uint16_t ls, float scal
   vp->this_c2v_epi8 =
       &vp->this_c2v_epi8_to_free[1]; //+1 to support reading negative position in this_c2v_epi8 at rotate_node_rigth
 
-  vp->bgM = bgM;
-  vp->bgN = bgN;
-  vp->hrr = hrr;
-  vp->ls  = ls;
+  vp->bgM        = bgM;
+  vp->bgN        = bgN;
+  vp->hrr        = hrr;
+  vp->ls         = ls;
+  vp->nof_blocks = SRSRAN_AVX512_B_SIZE / ls;
+
+  // For every shift, lanes taking the value of a lane of the same block are loaded at an offset of +shift, while
+  // lanes wrapping around the block are loaded at an offset of -(ls - shift)
+  for (uint16_t shift = 1; shift < ls; shift++) {
+    for (uint16_t i_block = 0; i_block < vp->nof_blocks; i_block++) {
+      for (uint16_t k = 0; k < ls; k++) {
+        uint64_t lane = 1ULL << (i_block * ls + k);
+        if (k < ls - shift) {
+          vp->rot_mask_lo[shift] |= lane;
+        } else {
+          vp->rot_mask_hi[shift] |= lane;
+        }
+      }
+    }
+  }
 
   vp->finalN = (bgN - 2) * ls;
   // correction > 1/16 to compensate the scaling error (2^16-1)/2^16 incurred in _mm512_scalei_epi8
@@ -232,6 +257,52 @@ int init_ldpc_dec_c_avx512(void* p, const int8_t* llrs, uint16_t ls)
   return 0;
 }
 
+int init_ldpc_dec_c_avx512_batch(void* p, const int8_t** llrs, uint32_t nof_cbs, uint16_t ls)
+{
+  struct ldpc_regs_c_avx512* vp = p;
+
+  if (p == NULL || llrs == NULL || nof_cbs == 0 || nof_cbs > vp->nof_blocks) {
+    return -1;
+  }
+
+  // First 2 punctured bits
+  int ini = SRSRAN_AVX512_B_SIZE + SRSRAN_AVX512_B_SIZE;
+  srsran_vec_i8_zero(vp->soft_bits.c, ini);
+
+  for (int i = 0; i < vp->finalN; i = i + ls) {
+    for (uint32_t i_cb = 0; i_cb < nof_cbs; i_cb++) {
+      srsran_vec_i8_copy(&vp->soft_bits.c[ini + i_cb * ls], &llrs[i_cb][i], ls);
+    }
+    srsran_vec_i8_zero(&vp->soft_bits.c[ini + nof_cbs * ls], SRSRAN_AVX512_B_SIZE - nof_cbs * ls);
+    ini = ini + SRSRAN_AVX512_B_SIZE;
+  }
+
+  SRSRAN_MEM_ZERO(vp->check_to_var, __m512i, (vp->hrr + 1) * vp->bgM);
+  SRSRAN_MEM_ZERO(vp->var_to_check, __m512i, vp->hrr + 1);
+
+  return 0;
+}
+
+int extract_ldpc_message_c_avx512_batch(void* p, uint32_t i_cb, uint8_t* message, uint16_t liftK)
+{
+  if (p == NULL) {
+    return -1;
+  }
+  struct ldpc_regs_c_avx512* vp = p;
+
+  if (i_cb >= vp->nof_blocks) {
+    return -1;
+  }
+
+  int ini = i_cb * vp->ls;
+  for (int i = 0; i < liftK; i = i + vp->ls) {
+    fec_avx512_hard_decision_c(&vp->soft_bits.c[ini], &message[i], vp->ls);
+    ini = ini + SRSRAN_AVX512_B_SIZE;
+  }
+
+  return 0;
+}
+
 int extract_ldpc_message_c_avx512(void* p, uint8_t* message, uint16_t liftK)
 {
   if (p == NULL) {
@@ -309,7 +380,7 @@ int update_ldpc_check_to_var_c_avx512(void*           p,
 
     this_rotated_v2c = vp->rotated_v2c + i;
 
-    rotate_node_right((uint8_t*)(vp->var_to_check + i_v2c_base), this_rotated_v2c, shift, vp->ls);
+    rotate_node_right((uint8_t*)(vp->var_to_check + i_v2c_base), this_rotated_v2c, shift, vp);
 
     prod_v2c_epi8 = _mm512_xor_si512(prod_v2c_epi8, *this_rotated_v2c);
 
@@ -354,7 +425,7 @@ int update_ldpc_check_to_var_c_avx512(void*           p,
     this_c2v_epi8[0] = _mm512_mask_sub_epi8(this_c2v_epi8[0], negmask, _mm512_setzero_si512(), this_c2v_epi8[0]);
 
     // rotating right LS - shift positions is the same as rotating left shift positions
-    rotate_node_right((uint8_t*)vp->this_c2v_epi8, this_check_to_var + i_v2c_base, (vp->ls - shift) % vp->ls, vp->ls);
+    rotate_node_right((uint8_t*)vp->this_c2v_epi8, this_check_to_var + i_v2c_base, (vp->ls - shift) % vp->ls, vp);
 
     current_var_index = (*these_var_indices)[(i + 1) % MAX_CNCT];
   }
@@ -428,28 +499,18 @@ inner_var_to_check_c_avx512(const __m512i* x, const __m512i* y, __m512i* z, cons
     z[i]      = _mm512_mask_blend_epi8(mask_epi8, _mm512_neg_infty8_epi8, z_epi8);
   }
 }
-static void rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t this_shift, uint16_t ls)
+static void
+rotate_node_right(const uint8_t* mem_addr, __m512i* out, uint16_t this_shift, const struct ldpc_regs_c_avx512* vp)
 {
   const __m512i MZERO = _mm512_set1_epi8(0);
 
-  uint16_t shift  = 0;
-  uint16_t _shift = 0;
-  uint64_t mask1  = 0;
-  uint64_t mask2  = 0;
-
   if (this_shift == 0) {
     out[0] = _mm512_loadu_si512(mem_addr);
   } else { // if the last is broken, take _shift bits from the end and "shift" bits from the begin.
+    uint16_t _shift = vp->ls - this_shift;
 
-    _shift = ls - this_shift;
-    shift  = SRSRAN_AVX512_B_SIZE - _shift;
-
-    mask1 = (1ULL << _shift) - 1; // i.e. 000001111 _shift =4
-    mask2 = (1ULL << shift) - 1;
-    mask2 = mask2 << _shift; //    i.e. 000110000  shift = 2, _shift = 4
-
-    out[0] = _mm512_mask_loadu_epi8(MZERO, mask1, mem_addr + this_shift);
-    out[0] = _mm512_mask_loadu_epi8(out[0], mask2, mem_addr - _shift);
+    out[0] = _mm512_mask_loadu_epi8(MZERO, vp->rot_mask_lo[this_shift], mem_addr + this_shift);
+    out[0] = _mm512_mask_loadu_epi8(out[0], vp->rot_mask_hi[this_shift], mem_addr - _shift);
   }
 }
 
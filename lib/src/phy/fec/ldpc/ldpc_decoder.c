@@ -37,6 +37,7 @@
 #include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/ldpc/ldpc_decoder.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
@@ -451,6 +452,71 @@ static void free_dec_c_avx512(void* o)
 /*! Carries out the decoding with 8-bit integer-valued LLRs (AVX512 implementation). */
 LDPC_DECODER_TEMPLATE(int8_t, c_avx512)
 
+/*! Carries out the decoding of several codeblocks at once with 8-bit integer-valued LLRs, each codeblock taking a
+ * different block of lanes of the 512-bit registers (AVX512 implementation). */
+static int decode_batch_c_avx512(void*         o,
+                                 const int8_t** llrs,
+                                 uint8_t**      message,
+                                 uint32_t       nof_cbs,
+                                 uint32_t       cdwd_rm_length,
+                                 srsran_crc_t*  crc,
+                                 int*           ret)
+{
+  srsran_ldpc_decoder_t* q = o;
+
+  /* Same codeword length adjustments as in the single codeblock decoder */
+  if (cdwd_rm_length > q->liftN - 2 * q->ls) {
+    cdwd_rm_length = q->liftN - 2 * q->ls;
+  }
+  if (cdwd_rm_length < (q->bgK + 2) * q->ls) {
+    cdwd_rm_length = (q->bgK + 2) * q->ls;
+  }
+  if (cdwd_rm_length % q->ls) {
+    cdwd_rm_length = (cdwd_rm_length / q->ls + 1) * q->ls;
+  }
+  if (init_ldpc_dec_c_avx512_batch(q->ptr, llrs, nof_cbs, q->ls) < 0) {
+    return -1;
+  }
+
+  uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;
+
+  uint32_t nof_pending = nof_cbs;
+  for (uint32_t i_cb = 0; i_cb < nof_cbs; i_cb++) {
+    ret[i_cb] = 0;
+  }
+
+  for (int i_iteration = 0; i_iteration < q->max_nof_iter && nof_pending > 0; i_iteration++) {
+    for (int i_layer = 0; i_layer < n_layers; i_layer++) {
+      update_ldpc_var_to_check_c_avx512(q->ptr, i_layer);
+      update_ldpc_check_to_var_c_avx512(q->ptr, i_layer, q->pcm + i_layer * q->bgN, q->var_indices + i_layer);
+      update_ldpc_soft_bits_c_avx512(q->ptr, i_layer, q->var_indices + i_layer);
+    }
+
+    if (crc != NULL) {
+      // Codeblocks keep the message of the iteration in which their CRC matched
+      for (uint32_t i_cb = 0; i_cb < nof_cbs; i_cb++) {
+        if (ret[i_cb] != 0) {
+          continue;
+        }
+        extract_ldpc_message_c_avx512_batch(q->ptr, i_cb, message[i_cb], q->liftK);
+        if (srsran_crc_match(crc, message[i_cb], q->liftK - crc->order)) {
+          ret[i_cb] = i_iteration + 1;
+          nof_pending--;
+        }
+      }
+    }
+  }
+
+  if (crc == NULL) {
+    for (uint32_t i_cb = 0; i_cb < nof_cbs; i_cb++) {
+      extract_ldpc_message_c_avx512_batch(q->ptr, i_cb, message[i_cb], q->liftK);
+      ret[i_cb] = q->max_nof_iter;
+    }
+  }
+
+  return 0;
+}
+
 /*! Initializes the decoder to work with 8-bit integer-valued LLRs (AVX512 implementation). */
 static int init_c_avx512(srsran_ldpc_decoder_t* q)
 {
@@ -464,6 +530,12 @@ static int init_c_avx512(srsran_ldpc_decoder_t* q)
 
   q->decode_c = decode_c_avx512;
 
+  // Pack several codeblocks in each 512-bit line when at least two of them fit
+  if (q->ls <= SRSRAN_AVX512_B_SIZE / 2) {
+    q->batch_size     = SRSRAN_MIN(SRSRAN_AVX512_B_SIZE / q->ls, SRSRAN_LDPC_DECODER_MAX_BATCH_SIZE);
+    q->decode_batch_c = decode_batch_c_avx512;
+  }
+
   return 0;
 }
 
@@ -537,6 +609,21 @@ static int init_c_avx512long_flood(srsran_ldpc_decoder_t* q)
 
 #endif // LV_HAVE_AVX512
 
+// The vectorized decoders may be compiled for a wider ISA than the one of the running CPU
+static bool decoder_type_supported(srsran_ldpc_decoder_type_t type)
+{
+  switch (type) {
+    case SRSRAN_LDPC_DECODER_C_AVX2:
+    case SRSRAN_LDPC_DECODER_C_AVX2_FLOOD:
+      return srsran_isa_get() >= SRSRAN_ISA_AVX2;
+    case SRSRAN_LDPC_DECODER_C_AVX512:
+    case SRSRAN_LDPC_DECODER_C_AVX512_FLOOD:
+      return srsran_isa_get() >= SRSRAN_ISA_AVX512;
+    default:
+      return true;
+  }
+}
+
 int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder_args_t* args)
 {
   if (q == NULL || args == NULL) {
@@ -555,6 +642,11 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
     return -1;
   }
 
+  if (!decoder_type_supported(type)) {
+    ERROR("LDPC decoder type %d not supported by this CPU (%s)", type, srsran_isa_to_string(srsran_isa_get()));
+    return -1;
+  }
+
   switch (bg) {
     case BG1:
       q->bgN = BG1Nfull;
@@ -606,6 +698,10 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   }
   q->scaling_fctr = scaling_fctr;
 
+  // Decoders process one codeblock at a time unless they enable batching
+  q->batch_size     = 1;
+  q->decode_batch_c = NULL;
+
   switch (type) {
     case SRSRAN_LDPC_DECODER_F:
       return init_f(q);
@@ -683,3 +779,36 @@ int srsran_ldpc_decoder_decode_crc_c(srsran_ldpc_decoder_t* q,
 {
   return q->decode_c(q, llrs, message, cdwd_rm_length, crc);
 }
+
+int srsran_ldpc_decoder_decode_batch_c(srsran_ldpc_decoder_t* q,
+                                       const int8_t**         llrs,
+                                       uint8_t**              message,
+                                       uint32_t               nof_cbs,
+                                       uint32_t               cdwd_rm_length,
+                                       srsran_crc_t*          crc,
+                                       int*                   ret)
+{
+  if (q == NULL || llrs == NULL || message == NULL || ret == NULL) {
+    return -1;
+  }
+
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < nof_cbs; i += count) {
+    count = SRSRAN_MIN(nof_cbs - i, q->batch_size);
+
+    if (q->decode_batch_c != NULL && count > 1) {
+      if (q->decode_batch_c(q, &llrs[i], &message[i], count, cdwd_rm_length, crc, &ret[i]) < 0) {
+        return -1;
+      }
+    } else {
+      for (uint32_t j = i; j < i + count; j++) {
+        ret[j] = q->decode_c(q, llrs[j], message[j], cdwd_rm_length, crc);
+        if (ret[j] < 0) {
+          return -1;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
@@ -37,6 +37,7 @@
 #include "srsran/phy/fec/ldpc/base_graph.h"
 #include "srsran/phy/fec/ldpc/ldpc_encoder.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 
 /*! Carries out the actual destruction of the memory allocated to the encoder. */
@@ -508,11 +509,33 @@ static int init_avx512long(srsran_ldpc_encoder_t* q)
 
 #endif
 
+// The vectorized encoders may be compiled for a wider ISA than the one of the running CPU
+static bool encoder_type_supported(srsran_ldpc_encoder_type_t type)
+{
+  switch (type) {
+#ifdef LV_HAVE_AVX2
+    case SRSRAN_LDPC_ENCODER_AVX2:
+      return srsran_isa_get() >= SRSRAN_ISA_AVX2;
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    case SRSRAN_LDPC_ENCODER_AVX512:
+      return srsran_isa_get() >= SRSRAN_ISA_AVX512;
+#endif // LV_HAVE_AVX512
+    default:
+      return true;
+  }
+}
+
 int srsran_ldpc_encoder_init(srsran_ldpc_encoder_t*     q,
                              srsran_ldpc_encoder_type_t type,
                              srsran_basegraph_t         bg,
                              uint16_t                   ls)
 {
+  if (!encoder_type_supported(type)) {
+    ERROR("LDPC encoder type %d not supported by this CPU (%s)", type, srsran_isa_to_string(srsran_isa_get()));
+    return -1;
+  }
+
   switch (bg) {
     case BG1:
       q->bgN = BG1Nfull;
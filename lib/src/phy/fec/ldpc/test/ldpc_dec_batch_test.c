@@ -0,0 +1,290 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_dec_batch_test.c
+ * \brief Throughput benchmark of the batched LDPC decoder against the single codeblock decoder.
+ *
+ * A number of random messages with a CRC attached are encoded, 2-PAM modulated and sent over an
+ * AWGN channel. The resulting 8-bit LLRs are decoded one codeblock at a time with
+ * srsran_ldpc_decoder_decode_crc_c() and all at once with srsran_ldpc_decoder_decode_batch_c().
+ * The test fails if the two decoders give different messages or iteration counts.
+ *
+ * Synopsis: **ldpc_dec_batch_test [options]**
+ *
+ * Options:
+ *  - **-b \<number\>** Base Graph (1 or 2. Default 1).
+ *  - **-l \<number\>** Lifting Size (according to 5GNR standard. Default 2).
+ *  - **-s \<number\>** SNR in dB (Default 3 dB).
+ *  - **-B \<number\>** Number of codewords decoded in each run (Default 64).
+ *  - **-R \<number\>** Number of runs (Default 100).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static srsran_basegraph_t base_graph = BG1; /*!< \brief Base Graph (BG1 or BG2). */
+static int                lift_size  = 2;   /*!< \brief Lifting Size. */
+static float              snr        = 3;   /*!< \brief Signal-to-Noise Ratio [dB]. */
+static int                nof_cbs    = 64;  /*!< \brief Number of codewords decoded in each run. */
+static int                nof_runs   = 100; /*!< \brief Number of runs. */
+#define MS_SF 0.75f                         /*!< \brief Scaling factor for the normalized min-sum decoding algorithm. */
+
+/*!
+ * \brief Prints test help when wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-bX] [-lX] [-sX] [-BX] [-RX]\n", prog);
+  printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
+  printf("\t-l Lifting Size [Default %d]\n", lift_size);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr);
+  printf("\t-B Number of codewords decoded in each run [Default %d]\n", nof_cbs);
+  printf("\t-R Number of runs [Default %d]\n", nof_runs);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "b:l:s:B:R:")) != -1) {
+    switch (opt) {
+      case 'b':
+        base_graph = (int)strtol(optarg, NULL, 10) - 1;
+        break;
+      case 'l':
+        lift_size = (int)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr = (float)strtod(optarg, NULL);
+        break;
+      case 'B':
+        nof_cbs = (int)strtol(optarg, NULL, 10);
+        break;
+      case 'R':
+        nof_runs = (int)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Main test function.
+ */
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_ldpc_encoder_t encoder = {};
+  if (srsran_ldpc_encoder_init(&encoder, SRSRAN_LDPC_ENCODER_C, base_graph, lift_size) != 0) {
+    ERROR("Error initialising encoder");
+    return SRSRAN_ERROR;
+  }
+
+  // Use the same decoder type as the NR shared channel
+  srsran_ldpc_decoder_args_t decoder_args = {};
+  decoder_args.type                       = SRSRAN_LDPC_DECODER_C;
+#ifdef LV_HAVE_AVX512
+  decoder_args.type = SRSRAN_LDPC_DECODER_C_AVX512;
+#else // LV_HAVE_AVX512
+#ifdef LV_HAVE_AVX2
+  decoder_args.type = SRSRAN_LDPC_DECODER_C_AVX2;
+#endif // LV_HAVE_AVX2
+#endif // LV_HAVE_AVX512
+  decoder_args.bg           = base_graph;
+  decoder_args.ls           = lift_size;
+  decoder_args.scaling_fctr = MS_SF;
+
+  srsran_ldpc_decoder_t decoder = {};
+  if (srsran_ldpc_decoder_init(&decoder, &decoder_args) != 0) {
+    ERROR("Error initialising decoder");
+    srsran_ldpc_encoder_free(&encoder);
+    return SRSRAN_ERROR;
+  }
+
+  int finalK = encoder.liftK;
+  int finalN = encoder.liftN - 2 * lift_size;
+
+  // Attach a CRC when the message is long enough, so that the decoders can stop early
+  srsran_crc_t  crc     = {};
+  srsran_crc_t* crc_ptr = NULL;
+  if (finalK >= 2 * 16) {
+    srsran_crc_init(&crc, SRSRAN_LTE_CRC16, 16);
+    crc_ptr = &crc;
+  }
+
+  printf("Test LDPC batch decoder:\n");
+  printf("  Base Graph      -> BG%d\n", encoder.bg + 1);
+  printf("  Lifting Size    -> %d\n", encoder.ls);
+  printf("  Lifted graph    -> M = %d, N = %d, K = %d\n", encoder.liftM, encoder.liftN, encoder.liftK);
+  printf("  Batch size      -> %d codeblocks\n", decoder.batch_size);
+  printf("  CRC             -> %s\n", crc_ptr ? "CRC16" : "none");
+  printf("  Signal-to-Noise Ratio -> %.2f dB\n\n", snr);
+
+  uint8_t*  messages_true   = srsran_vec_u8_malloc(finalK * nof_cbs);
+  uint8_t*  messages_single = srsran_vec_u8_malloc(finalK * nof_cbs);
+  uint8_t*  messages_batch  = srsran_vec_u8_malloc(finalK * nof_cbs);
+  uint8_t*  codewords       = srsran_vec_u8_malloc(finalN * nof_cbs);
+  float*    symbols         = srsran_vec_f_malloc(finalN * nof_cbs);
+  int8_t*   symbols_c       = srsran_vec_i8_malloc(finalN * nof_cbs);
+  int*      ret_single      = srsran_vec_malloc(sizeof(int) * nof_cbs);
+  int*      ret_batch       = srsran_vec_malloc(sizeof(int) * nof_cbs);
+  int8_t**  llr_ptr         = srsran_vec_malloc(sizeof(int8_t*) * nof_cbs);
+  uint8_t** message_ptr     = srsran_vec_malloc(sizeof(uint8_t*) * nof_cbs);
+  if (!messages_true || !messages_single || !messages_batch || !codewords || !symbols || !symbols_c || !ret_single ||
+      !ret_batch || !llr_ptr || !message_ptr) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  for (int i = 0; i < nof_cbs; i++) {
+    llr_ptr[i]     = symbols_c + i * finalN;
+    message_ptr[i] = messages_batch + i * finalK;
+  }
+
+  srsran_random_t random_gen    = srsran_random_init(0);
+  float           noise_std_dev = srsran_convert_dB_to_amplitude(-snr);
+  int8_t          inf7          = (1U << 6U) - 1;
+  float           gain_c        = inf7 * noise_std_dev / 8 / (1 / noise_std_dev + 2);
+
+  double elapsed_single = 0;
+  double elapsed_batch  = 0;
+  int    n_errors       = 0;
+  int    n_mismatches   = 0;
+
+  for (int i_run = 0; i_run < nof_runs; i_run++) {
+    // Generate, encode and modulate messages
+    for (int i = 0; i < nof_cbs; i++) {
+      uint8_t* msg = messages_true + i * finalK;
+      for (int j = 0; j < finalK; j++) {
+        msg[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      if (crc_ptr != NULL) {
+        srsran_crc_attach(crc_ptr, msg, finalK - crc_ptr->order);
+      }
+      srsran_ldpc_encoder_encode_rm(&encoder, msg, codewords + i * finalN, finalK, finalN);
+    }
+    for (int j = 0; j < finalN * nof_cbs; j++) {
+      symbols[j] = 1 - 2 * codewords[j];
+    }
+
+    // Apply AWGN and convert symbols into 8-bit LLRs
+    srsran_ch_awgn_f(symbols, symbols, noise_std_dev, finalN * nof_cbs);
+    srsran_vec_sc_prod_fff(symbols, 2 / (noise_std_dev * noise_std_dev), symbols, finalN * nof_cbs);
+    srsran_vec_quant_fc(symbols, symbols_c, gain_c, 0, inf7, finalN * nof_cbs);
+
+    struct timeval t[3];
+    gettimeofday(&t[1], NULL);
+    for (int i = 0; i < nof_cbs; i++) {
+      ret_single[i] = srsran_ldpc_decoder_decode_crc_c(
+          &decoder, symbols_c + i * finalN, messages_single + i * finalK, finalN, crc_ptr);
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_single += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
+    if (srsran_ldpc_decoder_decode_batch_c(
+            &decoder, (const int8_t**)llr_ptr, message_ptr, nof_cbs, finalN, crc_ptr, ret_batch) < SRSRAN_SUCCESS) {
+      ERROR("Error decoding batch");
+      srsran_random_free(random_gen);
+      goto clean_exit;
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_batch += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+    for (int i = 0; i < nof_cbs; i++) {
+      if (ret_single[i] != ret_batch[i] ||
+          memcmp(messages_single + i * finalK, messages_batch + i * finalK, finalK) != 0) {
+        n_mismatches++;
+      }
+      if (memcmp(messages_true + i * finalK, messages_single + i * finalK, finalK) != 0) {
+        n_errors++;
+      }
+    }
+  }
+  srsran_random_free(random_gen);
+
+  double nof_bits = (double)finalK * nof_cbs * nof_runs;
+  printf("  Single codeblock: %.2f Mbps\n", nof_bits / elapsed_single / 1e6);
+  printf("  Batch:            %.2f Mbps (x%.2f)\n", nof_bits / elapsed_batch / 1e6, elapsed_single / elapsed_batch);
+  printf("  WER: %.2e, mismatching codeblocks: %d\n", (double)n_errors / nof_cbs / nof_runs, n_mismatches);
+
+  ret = (n_mismatches == 0) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+
+clean_exit:
+  srsran_ldpc_encoder_free(&encoder);
+  srsran_ldpc_decoder_free(&decoder);
+  if (message_ptr) {
+    free(message_ptr);
+  }
+  if (llr_ptr) {
+    free(llr_ptr);
+  }
+  if (ret_batch) {
+    free(ret_batch);
+  }
+  if (ret_single) {
+    free(ret_single);
+  }
+  if (symbols_c) {
+    free(symbols_c);
+  }
+  if (symbols) {
+    free(symbols);
+  }
+  if (codewords) {
+    free(codewords);
+  }
+  if (messages_batch) {
+    free(messages_batch);
+  }
+  if (messages_single) {
+    free(messages_single);
+  }
+  if (messages_true) {
+    free(messages_true);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -43,6 +43,7 @@
 #include "polar_decoder_ssc_s.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 
 /*! SSC Polar decoder with float LLR inputs. */
 static int decode_ssc_f(void*           o,
@@ -215,6 +216,10 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
       return init_ssc_c(q);
 #ifdef LV_HAVE_AVX2
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
+      if (srsran_isa_get() < SRSRAN_ISA_AVX2) {
+        ERROR("AVX2 polar decoder not supported by this CPU");
+        return -1;
+      }
       return init_ssc_c_avx2(q);
 #endif
     default:
@@ -30,6 +30,7 @@
 #include "srsran/phy/fec/turbo/rm_turbo.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 
 #ifdef LV_HAVE_SSE
@@ -50,12 +51,14 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
 
 #ifdef LV_HAVE_AVX
 #include <x86intrin.h>
+SRSRAN_ISA_TARGET("avx")
 int srsran_rm_turbo_rx_lut_avx(int16_t*  input,
                                int16_t*  output,
                                uint16_t* deinter,
                                uint32_t  in_len,
                                uint32_t  cb_idx,
                                uint32_t  rv_idx);
+SRSRAN_ISA_TARGET("avx")
 int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
                                     int8_t*   output,
                                     uint16_t* deinter,
@@ -83,8 +86,14 @@ static bool                     rm_turbo_tables_generated = false;
 // Store deinterleaver version for sub-block turbo decoder
 #if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
 // Prepare bit for sub-block decoder processing. These are the nof subblock sizes
+#ifdef LV_HAVE_AVX512
+// The 8-bit AVX512 decoder uses 64 sub-blocks
+#define NOF_DEINTER_TABLE_SB_IDX 4
+const static int deinter_table_sb_idx[NOF_DEINTER_TABLE_SB_IDX] = {8, 16, 32, 64};
+#else
 #define NOF_DEINTER_TABLE_SB_IDX 3
 const static int deinter_table_sb_idx[NOF_DEINTER_TABLE_SB_IDX] = {8, 16, 32};
+#endif
 int              deinter_table_idx_from_sb_len(uint32_t nof_subblocks)
 {
   for (int i = 0; i < NOF_DEINTER_TABLE_SB_IDX; i++) {
@@ -261,6 +270,10 @@ static void interleave_table_sb(uint16_t* in, uint16_t* out, uint32_t cb_idx, ui
 {
   int long_cb = srsran_cbsegm_cbsize(cb_idx);
   int out_len = 3 * long_cb + 12;
+  // Short code blocks can not be split in nof_sb sub-blocks, these are never decoded by a sub-block decoder anyway
+  if (long_cb < nof_sb) {
+    nof_sb = 1;
+  }
   for (int i = 0; i < out_len; i++) {
     // Do not change tail bit order
     if (in[i] < 3 * long_cb) {
@@ -387,6 +400,23 @@ int srsran_rm_turbo_tx_lut(uint8_t* w_buff,
   }
 }
 
+/* Selects the deinterleaver table for the input order of a turbo decoder with nof_subblocks sub-blocks, 0 for none */
+static uint16_t* rm_turbo_rx_deinter(uint32_t cb_idx, uint32_t rv_idx, uint32_t nof_subblocks)
+{
+#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
+  int idx = deinter_table_idx_from_sb_len(nof_subblocks);
+  if (idx < 0) {
+    return deinterleaver[cb_idx][rv_idx];
+  } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
+    return deinterleaver_sb[idx][cb_idx][rv_idx];
+  }
+  ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
+  return NULL;
+#else
+  return deinterleaver[cb_idx][rv_idx];
+#endif
+}
+
 int srsran_rm_turbo_rx_lut(int16_t* input, int16_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
 {
   return srsran_rm_turbo_rx_lut_(input, output, in_len, cb_idx, rv_idx, true);
@@ -408,25 +438,17 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
                             bool     enable_input_tdec)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
-#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
-    int       cb_len  = srsran_cbsegm_cbsize(cb_idx);
-    int       idx     = deinter_table_idx_from_sb_len(srsran_tdec_autoimp_get_subblocks(cb_len));
-    uint16_t* deinter = NULL;
-    if (idx < 0 || !enable_input_tdec) {
-      deinter = deinterleaver[cb_idx][rv_idx];
-    } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
-      deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
-    } else {
-      ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
+    uint32_t  nof_sb  = enable_input_tdec ? srsran_tdec_autoimp_get_subblocks(srsran_cbsegm_cbsize(cb_idx)) : 0;
+    uint16_t* deinter = rm_turbo_rx_deinter(cb_idx, rv_idx, nof_sb);
+    if (deinter == NULL) {
       return -1;
     }
-#else
-    uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
-#endif
 
 #ifdef LV_HAVE_AVX
-    return srsran_rm_turbo_rx_lut_avx(input, output, deinter, in_len, cb_idx, rv_idx);
-#else
+    if (srsran_isa_get() >= SRSRAN_ISA_AVX) {
+      return srsran_rm_turbo_rx_lut_avx(input, output, deinter, in_len, cb_idx, rv_idx);
+    }
+#endif
 #ifdef LV_HAVE_SSE
     return srsran_rm_turbo_rx_lut_sse(input, output, deinter, in_len, cb_idx, rv_idx);
 #else
@@ -436,7 +458,6 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
       output[deinter[i % out_len]] += input[i];
     }
     return 0;
-#endif
 #endif
   } else {
     printf("Invalid inputs rv_idx=%d, cb_idx=%d\n", rv_idx, cb_idx);
@@ -445,23 +466,24 @@ int srsran_rm_turbo_rx_lut_(int16_t* input,
 }
 
 int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len, uint32_t cb_idx, uint32_t rv_idx)
+{
+  return srsran_rm_turbo_rx_lut_8bit_(
+      input, output, in_len, cb_idx, rv_idx, srsran_tdec_autoimp_get_subblocks_8bit(srsran_cbsegm_cbsize(cb_idx)));
+}
+
+/* Same as srsran_rm_turbo_rx_lut_8bit() for the input order of a decoder with nof_subblocks sub-blocks */
+int srsran_rm_turbo_rx_lut_8bit_(int8_t*  input,
+                                 int8_t*  output,
+                                 uint32_t in_len,
+                                 uint32_t cb_idx,
+                                 uint32_t rv_idx,
+                                 uint32_t nof_subblocks)
 {
   if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES) {
-#if SRSRAN_TDEC_EXPECT_INPUT_SB == 1
-    int       cb_len  = srsran_cbsegm_cbsize(cb_idx);
-    int       idx     = deinter_table_idx_from_sb_len(srsran_tdec_autoimp_get_subblocks_8bit(cb_len));
-    uint16_t* deinter = NULL;
-    if (idx < 0) {
-      deinter = deinterleaver[cb_idx][rv_idx];
-    } else if (idx < NOF_DEINTER_TABLE_SB_IDX) {
-      deinter = deinterleaver_sb[idx][cb_idx][rv_idx];
-    } else {
-      ERROR("Sub-block size index %d not supported in srsran_rm_turbo_rx_lut()", idx);
+    uint16_t* deinter = rm_turbo_rx_deinter(cb_idx, rv_idx, nof_subblocks);
+    if (deinter == NULL) {
       return -1;
     }
-#else
-    uint16_t* deinter = deinterleaver[cb_idx][rv_idx];
-#endif
 
     // TODO: AVX version of rm_turbo_rx_lut not working
     // Warning: Need to check if 8-bit sse version is correct
@@ -482,6 +504,199 @@ int srsran_rm_turbo_rx_lut_8bit(int8_t* input, int8_t* output, uint32_t in_len,
   }
 }
 
+#ifdef LV_HAVE_AVX2
+#define RM_TURBO_SCATTER_1(X, L, N) output[(uint16_t)_mm256_extract_epi16(L, N)] += (int16_t)_mm256_extract_epi16(X, N)
+#define RM_TURBO_SCATTER_16(X, L)                                                                                      \
+  do {                                                                                                                 \
+    RM_TURBO_SCATTER_1(X, L, 0);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 1);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 2);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 3);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 4);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 5);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 6);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 7);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 8);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 9);                                                                                       \
+    RM_TURBO_SCATTER_1(X, L, 10);                                                                                      \
+    RM_TURBO_SCATTER_1(X, L, 11);                                                                                      \
+    RM_TURBO_SCATTER_1(X, L, 12);                                                                                      \
+    RM_TURBO_SCATTER_1(X, L, 13);                                                                                      \
+    RM_TURBO_SCATTER_1(X, L, 14);                                                                                      \
+    RM_TURBO_SCATTER_1(X, L, 15);                                                                                      \
+  } while (0)
+
+/* The AVX2 kernels below process whole vectors and return how many LLR they did, the caller does the rest */
+SRSRAN_ISA_TARGET("avx2")
+static uint32_t rm_turbo_descramble_s_avx2(const int16_t* in, int16_t* out, uint32_t c, uint32_t n)
+{
+  uint32_t      j       = 0;
+  const __m256i bit_sel = _mm256_setr_epi16(
+      0x1, 0x2, 0x4, 0x8, 0x10, 0x20, 0x40, 0x80, 0x100, 0x200, 0x400, 0x800, 0x1000, 0x2000, 0x4000, (short)0x8000);
+  for (; j + 16 <= n; j += 16) {
+    // The sign is -1 for the set bits and +1 for the rest
+    __m256i mask = _mm256_set1_epi16((short)(c >> j));
+    mask         = _mm256_cmpeq_epi16(_mm256_and_si256(mask, bit_sel), bit_sel);
+    __m256i sign = _mm256_or_si256(mask, _mm256_set1_epi16(1));
+    _mm256_storeu_si256((__m256i*)&out[j], _mm256_sign_epi16(_mm256_loadu_si256((const __m256i*)&in[j]), sign));
+  }
+  return j;
+}
+
+SRSRAN_ISA_TARGET("avx2")
+static uint32_t rm_turbo_descramble_c_avx2(const int8_t* in, int8_t* out, uint32_t c, uint32_t n)
+{
+  if (n < 32) {
+    return 0;
+  }
+
+  // Every byte of c is spread over 8 bytes, then each of them keeps its bit
+  const __m256i bit_sel = _mm256_set1_epi64x(0x8040201008040201);
+  __m256i       mask    = _mm256_shuffle_epi8(_mm256_set1_epi32((int)c),
+                                     _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                                                      2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+  mask                  = _mm256_cmpeq_epi8(_mm256_and_si256(mask, bit_sel), bit_sel);
+  __m256i sign          = _mm256_or_si256(mask, _mm256_set1_epi8(1));
+  _mm256_storeu_si256((__m256i*)out, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*)in), sign));
+  return 32;
+}
+
+SRSRAN_ISA_TARGET("avx2")
+static uint32_t rm_turbo_scatter_s_avx2(const int16_t* llr, const uint16_t* deinter, int16_t* output, uint32_t n)
+{
+  uint32_t j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m256i xVal   = _mm256_loadu_si256((const __m256i*)&llr[j]);
+    __m256i lutVal = _mm256_loadu_si256((const __m256i*)&deinter[j]);
+    RM_TURBO_SCATTER_16(xVal, lutVal);
+  }
+  return j;
+}
+#endif /* LV_HAVE_AVX2 */
+
+/* Copies n <= 32 LLR negating the ones whose bit in the scrambling sequence word c is set */
+static inline void rm_turbo_descramble_s(const int16_t* in, int16_t* out, uint32_t c, uint32_t n, bool avx2)
+{
+  uint32_t j = 0;
+#ifdef LV_HAVE_AVX2
+  if (avx2) {
+    j = rm_turbo_descramble_s_avx2(in, out, c, n);
+  }
+#endif /* LV_HAVE_AVX2 */
+  for (; j < n; j++) {
+    int16_t m = -(int16_t)((c >> j) & 1U);
+    out[j]    = (int16_t)((in[j] ^ m) - m);
+  }
+}
+
+static inline void rm_turbo_descramble_c(const int8_t* in, int8_t* out, uint32_t c, uint32_t n, bool avx2)
+{
+  uint32_t j = 0;
+#ifdef LV_HAVE_AVX2
+  if (avx2) {
+    j = rm_turbo_descramble_c_avx2(in, out, c, n);
+  }
+#endif /* LV_HAVE_AVX2 */
+  for (; j < n; j++) {
+    int8_t m = -(int8_t)((c >> j) & 1U);
+    out[j]   = (int8_t)((in[j] ^ m) - m);
+  }
+}
+
+int srsran_rm_turbo_rx_lut_descramble(int16_t*                 input,
+                                      int16_t*                 output,
+                                      uint32_t                 in_len,
+                                      uint32_t                 cb_idx,
+                                      uint32_t                 rv_idx,
+                                      srsran_sequence_state_t* seq)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES && seq != NULL) {
+    uint32_t  nof_sb  = srsran_tdec_autoimp_get_subblocks(srsran_cbsegm_cbsize(cb_idx));
+    uint16_t* deinter = rm_turbo_rx_deinter(cb_idx, rv_idx, nof_sb);
+    if (deinter == NULL) {
+      return -1;
+    }
+
+    uint32_t out_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+    uint32_t k       = 0;
+    int16_t  llr[32];
+    bool     avx2 = srsran_isa_get() >= SRSRAN_ISA_AVX2;
+    for (uint32_t i = 0; i < in_len; i += 32) {
+      uint32_t c = srsran_sequence_state_gen_word(seq);
+      uint32_t n = SRSRAN_MIN(32, in_len - i);
+
+      rm_turbo_descramble_s(&input[i], llr, c, n, avx2);
+
+      if (k + n < out_len) {
+        uint32_t j = 0;
+#ifdef LV_HAVE_AVX2
+        if (avx2) {
+          j = rm_turbo_scatter_s_avx2(llr, &deinter[k], output, n);
+        }
+#endif /* LV_HAVE_AVX2 */
+        for (; j < n; j++) {
+          output[deinter[k + j]] += llr[j];
+        }
+        k += n;
+      } else {
+        // The circular buffer wraps within these LLR
+        for (uint32_t j = 0; j < n; j++) {
+          output[deinter[k]] += llr[j];
+          k = (k + 1 == out_len) ? 0 : k + 1;
+        }
+      }
+    }
+    return 0;
+  } else {
+    printf("Invalid inputs rv_idx=%d, cb_idx=%d\n", rv_idx, cb_idx);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
+int srsran_rm_turbo_rx_lut_descramble_8bit(int8_t*                  input,
+                                           int8_t*                  output,
+                                           uint32_t                 in_len,
+                                           uint32_t                 cb_idx,
+                                           uint32_t                 rv_idx,
+                                           srsran_sequence_state_t* seq)
+{
+  if (rv_idx < 4 && cb_idx < SRSRAN_NOF_TC_CB_SIZES && seq != NULL) {
+    uint32_t  nof_sb  = srsran_tdec_autoimp_get_subblocks_8bit(srsran_cbsegm_cbsize(cb_idx));
+    uint16_t* deinter = rm_turbo_rx_deinter(cb_idx, rv_idx, nof_sb);
+    if (deinter == NULL) {
+      return -1;
+    }
+
+    uint32_t out_len = 3 * srsran_cbsegm_cbsize(cb_idx) + 12;
+    uint32_t k       = 0;
+    int8_t   llr[32];
+    bool     avx2 = srsran_isa_get() >= SRSRAN_ISA_AVX2;
+    for (uint32_t i = 0; i < in_len; i += 32) {
+      uint32_t c = srsran_sequence_state_gen_word(seq);
+      uint32_t n = SRSRAN_MIN(32, in_len - i);
+
+      rm_turbo_descramble_c(&input[i], llr, c, n, avx2);
+
+      if (k + n < out_len) {
+        for (uint32_t j = 0; j < n; j++) {
+          output[deinter[k + j]] += llr[j];
+        }
+        k += n;
+      } else {
+        // The circular buffer wraps within these LLR
+        for (uint32_t j = 0; j < n; j++) {
+          output[deinter[k]] += llr[j];
+          k = (k + 1 == out_len) ? 0 : k + 1;
+        }
+      }
+    }
+    return 0;
+  } else {
+    printf("Invalid inputs rv_idx=%d, cb_idx=%d\n", rv_idx, cb_idx);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+}
+
 #ifdef LV_HAVE_SSE
 
 #define SAVE_OUTPUT_16_SSE(j)                                                                                          \
@@ -704,6 +919,7 @@ int srsran_rm_turbo_rx_lut_sse_8bit(int8_t*   input,
   l = (uint16_t)_mm256_extract_epi16(lutVal, j);                                                                       \
   output[l] += x;
 
+SRSRAN_ISA_TARGET("avx")
 int srsran_rm_turbo_rx_lut_avx(int16_t*  input,
                                int16_t*  output,
                                uint16_t* deinter,
@@ -820,6 +1036,7 @@ int srsran_rm_turbo_rx_lut_avx(int16_t*  input,
   l = (uint16_t)_mm256_extract_epi16(lutVal2, j);                                                                      \
   output[l] += x;
 
+SRSRAN_ISA_TARGET("avx")
 int srsran_rm_turbo_rx_lut_avx_8bit(int8_t*   input,
                                     int8_t*   output,
                                     uint16_t* deinter,
@@ -45,6 +45,10 @@ float   buff_f[BUFFSZ];
 float   bits_f[3 * 6144 + 12];
 short   bits2_s[3 * 6144 + 12];
 
+// The decoder input order may take the whole soft buffer
+short  rx_ref_s[SOFTBUFFER_SIZE], rx_fused_s[SOFTBUFFER_SIZE];
+int8_t rx_ref_c[SOFTBUFFER_SIZE], rx_fused_c[SOFTBUFFER_SIZE];
+
 void usage(char* prog)
 {
   printf("Usage: %s -c cb_idx -e nof_e_bits [-i rv_idx]\n", prog);
@@ -80,6 +84,9 @@ int main(int argc, char** argv)
   int      i;
   uint8_t *rm_bits, *rm_bits2, *rm_bits2_bytes;
   short*   rm_bits_s;
+  short*   rm_bits_scr_s;
+  int8_t*  rm_bits_c;
+  int8_t*  rm_bits_scr_c;
   float*   rm_bits_f;
 
   parse_args(argc, argv);
@@ -91,6 +98,13 @@ int main(int argc, char** argv)
     perror("malloc");
     exit(-1);
   }
+  rm_bits_scr_s = srsran_vec_i16_malloc(nof_e_bits);
+  rm_bits_c     = srsran_vec_i8_malloc(nof_e_bits);
+  rm_bits_scr_c = srsran_vec_i8_malloc(nof_e_bits);
+  if (!rm_bits_scr_s || !rm_bits_c || !rm_bits_scr_c) {
+    perror("malloc");
+    exit(-1);
+  }
   rm_bits_f = srsran_vec_f_malloc(nof_e_bits);
   if (!rm_bits_f) {
     perror("malloc");
@@ -188,12 +202,50 @@ int main(int argc, char** argv)
         }
       }
 
-      printf("OK RX\n");
+      printf("OK RX...");
+
+      // Descrambling while rate dematching must match descrambling the whole input first
+      uint32_t seed = (uint32_t)rand() & INT32_MAX;
+      for (int i = 0; i < nof_e_bits; i++) {
+        rm_bits_c[i] = (int8_t)rm_bits_s[i];
+      }
+      srsran_sequence_apply_s(rm_bits_s, rm_bits_scr_s, nof_e_bits, seed);
+      srsran_sequence_apply_c(rm_bits_c, rm_bits_scr_c, nof_e_bits, seed);
+
+      srsran_sequence_state_t seq = {};
+      bzero(rx_ref_s, sizeof(rx_ref_s));
+      bzero(rx_fused_s, sizeof(rx_fused_s));
+      srsran_rm_turbo_rx_lut(rm_bits_s, rx_ref_s, nof_e_bits, cb_idx, rv_idx);
+      srsran_sequence_state_init(&seq, seed);
+      srsran_rm_turbo_rx_lut_descramble(rm_bits_scr_s, rx_fused_s, nof_e_bits, cb_idx, rv_idx, &seq);
+
+      bzero(rx_ref_c, sizeof(rx_ref_c));
+      bzero(rx_fused_c, sizeof(rx_fused_c));
+      srsran_rm_turbo_rx_lut_8bit(rm_bits_c, rx_ref_c, nof_e_bits, cb_idx, rv_idx);
+      srsran_sequence_state_init(&seq, seed);
+      srsran_rm_turbo_rx_lut_descramble_8bit(rm_bits_scr_c, rx_fused_c, nof_e_bits, cb_idx, rv_idx, &seq);
+
+      for (int i = 0; i < SOFTBUFFER_SIZE; i++) {
+        if (rx_ref_s[i] != rx_fused_s[i] || rx_ref_c[i] != rx_fused_c[i]) {
+          printf("error RX descrambling in bit %d %d!=%d, %d!=%d\n",
+                 i,
+                 rx_ref_s[i],
+                 rx_fused_s[i],
+                 rx_ref_c[i],
+                 rx_fused_c[i]);
+          exit(-1);
+        }
+      }
+
+      printf("OK RX descrambling\n");
     }
   }
 
   srsran_rm_turbo_free_tables();
   free(rm_bits_s);
+  free(rm_bits_scr_s);
+  free(rm_bits_c);
+  free(rm_bits_scr_c);
   free(rm_bits_f);
   free(rm_bits);
   free(rm_bits2);
@@ -45,16 +45,33 @@ int nof_iterations  = MAX_ITERATIONS;
 int test_known_data = 0;
 int test_errors     = 0;
 int nof_repetitions = 1;
+int test_all_impl   = 0;
+
+float max_ber      = 1e-4;
+float max_ber_8bit = -1;
+float max_avg_its  = 0;
+
+srsran_tdec_early_stop_t early_stop    = SRSRAN_TDEC_EARLY_STOP_NONE;
+int16_t                  early_stop_th = 1000;
 
 srsran_tdec_impl_type_t tdec_type;
 
+static const char* tdec_type_str[SRSRAN_TDEC_NOF_IMP] = {
+    "Auto", "Generic", "SSE", "SSE-window", "NEON-window", "AVX-window", "SSE8-window", "AVX8-window", "AVX512-window",
+    "AVX512_8-window"};
+
+static bool tdec_type_is_8bit(srsran_tdec_impl_type_t type)
+{
+  return type == SRSRAN_TDEC_SSE8_WINDOW || type == SRSRAN_TDEC_AVX8_WINDOW || type == SRSRAN_TDEC_AVX512_8_WINDOW;
+}
+
 #define SNR_POINTS 4
 #define SNR_MIN 1.0
 #define SNR_MAX 8.0
 
 void usage(char* prog)
 {
-  printf("Usage: %s [kcinNledts]\n", prog);
+  printf("Usage: %s [kcinNledtbBIsaET]\n", prog);
   printf("\t-k Test with known data (ignores frame_length) [Default disabled]\n");
   printf("\t-c nof_cb in parallel [Default %d]\n", nof_cb);
   printf("\t-i nof_iterations [Default %d]\n", nof_iterations);
@@ -62,15 +79,24 @@ void usage(char* prog)
   printf("\t-N nof_repetitions [Default %d]\n", nof_repetitions);
   printf("\t-l frame_length [Default %d]\n", frame_length);
   printf("\t-e ebno in dB [Default scan]\n");
-  printf("\t-d Decoder implementation type: 0: Generic, 1: SSE, 2: SSE-window\n");
+  printf("\t-d Decoder implementation type:");
+  for (int i = 0; i < SRSRAN_TDEC_NOF_IMP; i++) {
+    printf(" %d: %s%s", i, tdec_type_str[i], i < SRSRAN_TDEC_NOF_IMP - 1 ? "," : "\n");
+  }
+  printf("\t-a Run all the decoder implementations supported by this build [Default disabled]\n");
+  printf("\t-E Early stop criterion: 0: None, 1: Hard decision, 2: LLR threshold [Default %d]\n", early_stop);
+  printf("\t-T Early stop LLR threshold [Default %d]\n", early_stop_th);
   printf("\t-t test: check errors on exit [Default disabled]\n");
+  printf("\t-b Maximum BER at the highest Eb/No when checking errors [Default %.0e]\n", max_ber);
+  printf("\t-B Maximum BER of the 8-bit decoders when checking errors [Default same as -b]\n");
+  printf("\t-I Maximum average number of iterations when checking errors (0: no check) [Default %.1f]\n", max_avg_its);
   printf("\t-s seed [Default 0=time]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "kcinNledts")) != -1) {
+  while ((opt = getopt(argc, argv, "kcinNledtbBIsaET")) != -1) {
     switch (opt) {
       case 'c':
         nof_cb = (int)strtol(argv[optind], NULL, 10);
@@ -87,6 +113,24 @@ void parse_args(int argc, char** argv)
       case 't':
         test_errors = 1;
         break;
+      case 'b':
+        max_ber = strtof(argv[optind], NULL);
+        break;
+      case 'B':
+        max_ber_8bit = strtof(argv[optind], NULL);
+        break;
+      case 'I':
+        max_avg_its = strtof(argv[optind], NULL);
+        break;
+      case 'a':
+        test_all_impl = 1;
+        break;
+      case 'E':
+        early_stop = (srsran_tdec_early_stop_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'T':
+        early_stop_th = (int16_t)strtol(argv[optind], NULL, 10);
+        break;
       case 'i':
         nof_iterations = (int)strtol(argv[optind], NULL, 10);
         break;
@@ -118,12 +162,14 @@ int main(int argc, char** argv)
   uint32_t        frame_cnt;
   float*          llr;
   short*          llr_s;
-  uint8_t*        llr_c;
-  uint8_t *       data_tx, *data_rx, *data_rx_bytes, *symbols;
-  float           var[SNR_POINTS];
+  int8_t *        llr_c, *llr_rm_c;
+  uint8_t *       data_tx, *data_rx, *data_rx_bytes, *symbols, *rm_bits, *w_buff;
+  float           ebno[SNR_POINTS], var[SNR_POINTS];
   uint32_t        snr_points;
   uint32_t        errors = 0;
-  uint32_t        coded_length;
+  uint32_t        iters  = 0;
+  uint32_t        coded_length, w_buff_len, sb_length;
+  int             ret = SRSRAN_SUCCESS;
   struct timeval  tdata[3];
   float           mean_usec;
   srsran_tdec_t   tdec;
@@ -147,6 +193,9 @@ int main(int argc, char** argv)
   }
 
   coded_length = 3 * (frame_length) + SRSRAN_TCOD_TOTALTAIL;
+  // Circular buffer of the rate matching, including the dummy bits, and input of the sub-block decoders
+  w_buff_len = 3 * (frame_length + SRSRAN_TCOD_TOTALTAIL + 32);
+  sb_length  = 3 * (frame_length + 32) + SRSRAN_TCOD_TOTALTAIL;
 
   printf("  Frame length: %d\n", frame_length);
   if (ebno_db < 100.0) {
@@ -185,113 +234,207 @@ int main(int argc, char** argv)
     perror("malloc");
     exit(-1);
   }
-  llr_c = srsran_vec_u8_malloc(coded_length);
+  llr_c = srsran_vec_i8_malloc(sb_length);
   if (!llr_c) {
     perror("malloc");
     exit(-1);
   }
+  llr_rm_c = srsran_vec_i8_malloc(coded_length);
+  if (!llr_rm_c) {
+    perror("malloc");
+    exit(-1);
+  }
+  rm_bits = srsran_vec_u8_malloc(coded_length);
+  if (!rm_bits) {
+    perror("malloc");
+    exit(-1);
+  }
+  w_buff = srsran_vec_u8_malloc(w_buff_len);
+  if (!w_buff) {
+    perror("malloc");
+    exit(-1);
+  }
 
   if (srsran_tcod_init(&tcod, frame_length)) {
     ERROR("Error initiating Turbo coder");
     exit(-1);
   }
+  srsran_rm_turbo_gentables();
 
 #ifdef HAVE_NEON
   tdec_type = SRSRAN_TDEC_NEON_WINDOW;
 #else
   // tdec_type = SRSRAN_TDEC_SSE_WINDOW;
 #endif
-  if (srsran_tdec_init_manual(&tdec, frame_length, tdec_type)) {
-    ERROR("Error initiating Turbo decoder");
-    exit(-1);
-  }
-
-  srsran_tdec_force_not_sb(&tdec);
 
   float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
   if (ebno_db == 100.0) {
     snr_points = SNR_POINTS;
     for (uint32_t i = 0; i < snr_points; i++) {
-      ebno_db = SNR_MIN + i * ebno_inc;
-      esno_db = ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f);
-      var[i]  = srsran_convert_dB_to_amplitude(-esno_db);
+      ebno[i] = SNR_MIN + i * ebno_inc;
     }
   } else {
-    esno_db    = ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f);
-    var[0]     = srsran_convert_dB_to_amplitude(-esno_db);
+    ebno[0]    = ebno_db;
     snr_points = 1;
   }
   for (uint32_t i = 0; i < snr_points; i++) {
-    mean_usec = 0;
-    errors    = 0;
-    frame_cnt = 0;
-    while (frame_cnt < nof_frames) {
-      /* generate data_tx */
-      for (uint32_t j = 0; j < frame_length; j++) {
+    // Noise standard deviation of the real valued BPSK symbols, N0/2 per dimension
+    esno_db = ebno[i] + srsran_convert_power_to_dB(1.0f / 3.0f);
+    var[i]  = srsran_convert_dB_to_amplitude(-esno_db) / sqrtf(2.0f);
+  }
+
+  int first_type = test_all_impl ? SRSRAN_TDEC_AUTO : tdec_type;
+  int last_type  = test_all_impl ? SRSRAN_TDEC_NOF_IMP - 1 : tdec_type;
+  for (int type = first_type; type <= last_type; type++) {
+    if (srsran_tdec_init_manual(&tdec, frame_length, (srsran_tdec_impl_type_t)type)) {
+      if (test_all_impl) {
+        // Implementation not supported by this build, skip it
+        continue;
+      }
+      ERROR("Error initiating Turbo decoder");
+      exit(-1);
+    }
+
+    bool     is_8bit       = tdec_type_is_8bit((srsran_tdec_impl_type_t)type);
+    uint32_t nof_subblocks = is_8bit ? tdec.nof_blocks8[0] : tdec.nof_blocks16[0];
+
+    // The window decoders split the code block in nof_subblocks sub-blocks of the same length
+    if (type != SRSRAN_TDEC_AUTO && nof_subblocks > 1 && frame_length % nof_subblocks) {
+      srsran_tdec_free(&tdec);
+      if (test_all_impl) {
+        printf("  Decoder: %s does not support frame length %d, skipping\n", tdec_type_str[type], frame_length);
+        continue;
+      }
+      ERROR("Decoder %s does not support frame length %d", tdec_type_str[type], frame_length);
+      exit(-1);
+    }
+
+    // The 8-bit decoders take their input in the sub-block order produced by the rate dematching, as in sch.c
+    if (!is_8bit) {
+      srsran_tdec_force_not_sb(&tdec);
+    }
+    srsran_tdec_set_early_stop(&tdec, early_stop, early_stop_th);
+
+    printf("  Decoder: %s (%d-bit)\n", tdec_type_str[type], is_8bit ? 8 : 16);
+
+    for (uint32_t i = 0; i < snr_points; i++) {
+      mean_usec = 0;
+      errors    = 0;
+      frame_cnt = 0;
+      iters     = 0;
+      while (frame_cnt < nof_frames) {
+        /* generate data_tx */
+        for (uint32_t j = 0; j < frame_length; j++) {
+          if (test_known_data) {
+            data_tx[j] = known_data[j];
+          } else {
+            data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+          }
+        }
+
+        /* coded BER */
         if (test_known_data) {
-          data_tx[j] = known_data[j];
+          for (uint32_t j = 0; j < coded_length; j++) {
+            symbols[j] = known_data_encoded[j];
+          }
         } else {
-          data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+          srsran_tcod_encode(&tcod, data_tx, symbols, frame_length);
+        }
+
+        if (is_8bit) {
+          // Transmit the whole circular buffer, every coded bit exactly once
+          srsran_rm_turbo_tx(w_buff, w_buff_len, symbols, coded_length, rm_bits, coded_length, 0);
+        } else {
+          memcpy(rm_bits, symbols, coded_length);
         }
-      }
 
-      /* coded BER */
-      if (test_known_data) {
         for (uint32_t j = 0; j < coded_length; j++) {
-          symbols[j] = known_data_encoded[j];
+          llr[j] = rm_bits[j] ? 1 : -1;
         }
-      } else {
-        srsran_tcod_encode(&tcod, data_tx, symbols, frame_length);
-      }
+        srsran_ch_awgn_f(llr, llr, var[i], coded_length);
 
-      for (uint32_t j = 0; j < coded_length; j++) {
-        llr[j] = symbols[j] ? 1 : -1;
-      }
-      srsran_ch_awgn_f(llr, llr, var[i], coded_length);
+        if (is_8bit) {
+          srsran_vec_convert_fb(llr, 20, llr_rm_c, coded_length);
+          srsran_vec_i8_zero(llr_c, sb_length);
+          srsran_rm_turbo_rx_lut_8bit_(
+              llr_rm_c, llr_c, coded_length, srsran_cbsegm_cbindex(frame_length), 0, nof_subblocks);
+        } else {
+          for (uint32_t j = 0; j < coded_length; j++) {
+            llr_s[j] = (int16_t)(100 * llr[j]);
+          }
+        }
 
-      for (uint32_t j = 0; j < coded_length; j++) {
-        llr_s[j] = (int16_t)(100 * llr[j]);
-      }
+        /* decoder */
+        srsran_tdec_new_cb(&tdec, frame_length);
 
-      /* decoder */
-      srsran_tdec_new_cb(&tdec, frame_length);
+        uint32_t t;
+        if (nof_iterations == -1) {
+          t = MAX_ITERATIONS;
+        } else {
+          t = nof_iterations;
+        }
 
-      uint32_t t;
-      if (nof_iterations == -1) {
-        t = MAX_ITERATIONS;
-      } else {
-        t = nof_iterations;
+        gettimeofday(&tdata[1], NULL);
+        for (int k = 0; k < nof_repetitions; k++) {
+          if (is_8bit) {
+            srsran_tdec_run_all_8bit(&tdec, llr_c, data_rx_bytes, t, frame_length);
+          } else {
+            srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+          }
+        }
+        gettimeofday(&tdata[2], NULL);
+        get_time_interval(tdata);
+        mean_usec = (tdata[0].tv_sec * 1e6 + tdata[0].tv_usec) / nof_repetitions;
+        iters += srsran_tdec_get_nof_iterations(&tdec);
+
+        frame_cnt++;
+        uint32_t errors_this = 0;
+        srsran_bit_unpack_vector(data_rx_bytes, data_rx, frame_length);
+
+        errors_this = srsran_bit_diff(data_tx, data_rx, frame_length);
+        // printf("error[%d]=%d\n", cb, errors_this);
+        errors += errors_this;
+        printf("Eb/No: %2.2f %10d/%d   ", ebno[i], frame_cnt, nof_frames);
+        printf("BER: %.2e  ", (float)errors / (nof_cb * frame_cnt * frame_length));
+        printf("%3.1f Mbps (%6.2f usec)  ", (float)(nof_cb * frame_length) / mean_usec, mean_usec);
+        printf("it=%.1f", (float)iters / frame_cnt);
+        printf("\r");
       }
+      printf("\n");
+    }
 
-      gettimeofday(&tdata[1], NULL);
-      for (int k = 0; k < nof_repetitions; k++) {
-        srsran_tdec_run_all(&tdec, llr_s, data_rx_bytes, t, frame_length);
+    printf("\n");
+    if (snr_points == 1) {
+      if (errors) {
+        printf("%d Errors\n", errors / nof_cb);
       }
-      gettimeofday(&tdata[2], NULL);
-      get_time_interval(tdata);
-      mean_usec = (tdata[0].tv_sec * 1e6 + tdata[0].tv_usec) / nof_repetitions;
-
-      frame_cnt++;
-      uint32_t errors_this = 0;
-      srsran_bit_unpack_vector(data_rx_bytes, data_rx, frame_length);
-
-      errors_this = srsran_bit_diff(data_tx, data_rx, frame_length);
-      // printf("error[%d]=%d\n", cb, errors_this);
-      errors += errors_this;
-      printf("Eb/No: %2.2f %10d/%d   ", SNR_MIN + i * ebno_inc, frame_cnt, nof_frames);
-      printf("BER: %.2e  ", (float)errors / (nof_cb * frame_cnt * frame_length));
-      printf("%3.1f Mbps (%6.2f usec)", (float)(nof_cb * frame_length) / mean_usec, mean_usec);
-      printf("\r");
     }
-    printf("\n");
-  }
 
-  printf("\n");
-  if (snr_points == 1) {
-    if (errors) {
-      printf("%d Errors\n", errors / nof_cb);
+    // The errors and iterations are the ones of the highest Eb/No
+    if (test_errors) {
+      float ber      = (float)errors / (nof_cb * nof_frames * frame_length);
+      float avg_its  = (float)iters / nof_frames;
+      float type_ber = (is_8bit && max_ber_8bit >= 0) ? max_ber_8bit : max_ber;
+      if (ber > type_ber) {
+        printf("Decoder %s: BER %.2e exceeds %.2e at Eb/No %.2f\n",
+               tdec_type_str[type],
+               ber,
+               type_ber,
+               ebno[snr_points - 1]);
+        ret = SRSRAN_ERROR;
+      }
+      if (max_avg_its > 0 && avg_its > max_avg_its) {
+        printf("Decoder %s: %.1f iterations on average exceed %.1f at Eb/No %.2f\n",
+               tdec_type_str[type],
+               avg_its,
+               max_avg_its,
+               ebno[snr_points - 1]);
+        ret = SRSRAN_ERROR;
+      }
     }
+
+    srsran_tdec_free(&tdec);
   }
 
   free(data_rx_bytes);
@@ -299,14 +442,17 @@ int main(int argc, char** argv)
   free(symbols);
   free(llr);
   free(llr_c);
+  free(llr_rm_c);
+  free(rm_bits);
+  free(w_buff);
   free(llr_s);
   free(data_rx);
 
-  srsran_tdec_free(&tdec);
   srsran_tcod_free(&tcod);
   srsran_random_free(random_gen);
+  srsran_rm_turbo_free_tables();
 
   printf("\n");
-  printf("Done\n");
-  exit(0);
+  printf("%s\n", ret ? "Error" : "Done");
+  exit(ret);
 }
@@ -22,9 +22,11 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <strings.h>
 
 #include "srsran/phy/fec/turbo/turbodecoder.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/srsran.h"
 
@@ -60,16 +62,9 @@ srsran_tdec_16bit_impl_t sse16_win_impl = {tdec_winsse16_init,
                                            tdec_winsse16_decision_byte};
 #endif
 
-/* AVX window implementation */
+/* AVX window implementation, see turbodecoder_avx2.c */
 #ifdef LV_HAVE_AVX2
-#define WINIMP_IS_AVX16
-#include "srsran/phy/fec/turbo/turbodecoder_win.h"
-#undef WINIMP_IS_AVX16
-srsran_tdec_16bit_impl_t avx16_win_impl = {tdec_winavx16_init,
-                                           tdec_winavx16_free,
-                                           tdec_winavx16_dec,
-                                           tdec_winavx16_extract_input,
-                                           tdec_winavx16_decision_byte};
+extern srsran_tdec_16bit_impl_t avx16_win_impl;
 #endif
 
 /* SSE window implementation */
@@ -85,16 +80,15 @@ srsran_tdec_8bit_impl_t sse8_win_impl = {tdec_winsse8_init,
                                          tdec_winsse8_decision_byte};
 #endif
 
-/* AVX window implementation */
+/* AVX window implementation, see turbodecoder_avx2.c */
 #ifdef LV_HAVE_AVX2
-#define WINIMP_IS_AVX8
-#include "srsran/phy/fec/turbo/turbodecoder_win.h"
-#undef WINIMP_IS_AVX8
-srsran_tdec_8bit_impl_t avx8_win_impl = {tdec_winavx8_init,
-                                         tdec_winavx8_free,
-                                         tdec_winavx8_dec,
-                                         tdec_winavx8_extract_input,
-                                         tdec_winavx8_decision_byte};
+extern srsran_tdec_8bit_impl_t avx8_win_impl;
+#endif
+
+/* AVX512 window implementation, see turbodecoder_avx512.c */
+#ifdef LV_HAVE_AVX512
+extern srsran_tdec_16bit_impl_t avx512_16_win_impl;
+extern srsran_tdec_8bit_impl_t  avx512_8_win_impl;
 #endif
 
 #ifdef HAVE_NEON
@@ -112,8 +106,10 @@ srsran_tdec_16bit_impl_t arm16_win_impl = {tdec_winarm16_init,
 #define AUTO_16_SSE 0
 #define AUTO_16_SSEWIN 1
 #define AUTO_16_AVXWIN 2
+#define AUTO_16_AVX512WIN 3
 #define AUTO_8_SSEWIN 0
 #define AUTO_8_AVXWIN 1
+#define AUTO_8_AVX512WIN 2
 #define AUTO_16_GEN 0
 #define AUTO_16_NEONWIN 1
 
@@ -134,6 +130,8 @@ int srsran_tdec_init(srsran_tdec_t* h, uint32_t max_long_cb)
 uint32_t interleaver_idx(uint32_t nof_subblocks)
 {
   switch (nof_subblocks) {
+    case 64:
+      return 4;
     case 32:
       return 3;
     case 16:
@@ -156,6 +154,15 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
 
   h->dec_type = dec_type;
 
+  // The AVX2 and AVX512 decoders may be compiled for a wider ISA than the one of the running CPU
+  if (((dec_type == SRSRAN_TDEC_AVX_WINDOW || dec_type == SRSRAN_TDEC_AVX8_WINDOW) &&
+       srsran_isa_get() < SRSRAN_ISA_AVX2) ||
+      ((dec_type == SRSRAN_TDEC_AVX512_WINDOW || dec_type == SRSRAN_TDEC_AVX512_8_WINDOW) &&
+       srsran_isa_get() < SRSRAN_ISA_AVX512)) {
+    ERROR("Error decoder %d not supported by this CPU (%s)", dec_type, srsran_isa_to_string(srsran_isa_get()));
+    goto clean_and_exit;
+  }
+
   // Set manual
   switch (dec_type) {
     case SRSRAN_TDEC_AUTO:
@@ -195,6 +202,16 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       h->current_llr_type = SRSRAN_TDEC_8;
       break;
 #endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_AVX512
+    case SRSRAN_TDEC_AVX512_WINDOW:
+      h->dec16[0]         = &avx512_16_win_impl;
+      h->current_llr_type = SRSRAN_TDEC_16;
+      break;
+    case SRSRAN_TDEC_AVX512_8_WINDOW:
+      h->dec8[0]          = &avx512_8_win_impl;
+      h->current_llr_type = SRSRAN_TDEC_8;
+      break;
+#endif /* LV_HAVE_AVX512 */
     default:
       ERROR("Error decoder %d not supported", dec_type);
       goto clean_and_exit;
@@ -242,6 +259,11 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
     perror("srsran_vec_malloc");
     goto clean_and_exit;
   }
+  h->prev_output = srsran_vec_u8_malloc(max_long_cb / 8 + 1);
+  if (!h->prev_output) {
+    perror("srsran_vec_malloc");
+    goto clean_and_exit;
+  }
 
   if (dec_type == SRSRAN_TDEC_AUTO) {
 #ifdef HAVE_NEON
@@ -252,9 +274,17 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
     h->dec16[AUTO_16_SSEWIN] = &sse16_win_impl;
     h->dec8[AUTO_8_SSEWIN]   = &sse8_win_impl;
 #ifdef LV_HAVE_AVX2
-    h->dec16[AUTO_16_AVXWIN] = &avx16_win_impl;
-    h->dec8[AUTO_8_AVXWIN]   = &avx8_win_impl;
+    if (srsran_isa_get() >= SRSRAN_ISA_AVX2) {
+      h->dec16[AUTO_16_AVXWIN] = &avx16_win_impl;
+      h->dec8[AUTO_8_AVXWIN]   = &avx8_win_impl;
+    }
 #endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_AVX512
+    if (srsran_isa_get() >= SRSRAN_ISA_AVX512) {
+      h->dec16[AUTO_16_AVX512WIN] = &avx512_16_win_impl;
+      h->dec8[AUTO_8_AVX512WIN]   = &avx512_8_win_impl;
+    }
+#endif /* LV_HAVE_AVX512 */
 #else  /* HAVE_NEON | LV_HAVE_SSE */
     h->dec16[AUTO_16_SSE]    = &gen_impl;
     h->dec16[AUTO_16_SSEWIN] = &gen_impl;
@@ -275,8 +305,14 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
       }
     }
 
-    // Compute 1 interleaver for each possible nof_subblocks (1, 8, 16 or 32)
-    for (int s = 0; s < 4; s++) {
+    // Compute 1 interleaver for each possible nof_subblocks (1, 8, 16, 32 or 64 if AVX512 is available)
+    int nof_interleavers = SRSRAN_TDEC_NOF_SB_INTERLEAVERS - 1;
+#ifdef LV_HAVE_AVX512
+    if (srsran_isa_get() >= SRSRAN_ISA_AVX512) {
+      nof_interleavers = SRSRAN_TDEC_NOF_SB_INTERLEAVERS;
+    }
+#endif
+    for (int s = 0; s < nof_interleavers; s++) {
       for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
         if (srsran_tc_interl_init(&h->interleaver[s][i], srsran_cbsegm_cbsize(i)) < 0) {
           goto clean_and_exit;
@@ -286,7 +322,7 @@ int srsran_tdec_init_manual(srsran_tdec_t* h, uint32_t max_long_cb, srsran_tdec_
     }
   } else {
     uint32_t nof_subblocks;
-    if (dec_type < SRSRAN_TDEC_SSE8_WINDOW) {
+    if (h->current_llr_type == SRSRAN_TDEC_16) {
       if ((h->nof_blocks16[0] = h->dec16[0]->tdec_init(&h->dec16_hdlr[0], h->max_long_cb)) < 0) {
         goto clean_and_exit;
       }
@@ -342,6 +378,9 @@ void srsran_tdec_free(srsran_tdec_t* h)
   if (h->input_conv) {
     free(h->input_conv);
   }
+  if (h->prev_output) {
+    free(h->prev_output);
+  }
 
   for (int td = 0; td < SRSRAN_TDEC_NOF_AUTO_MODES_8; td++) {
     if (h->dec8[td] && h->dec8_hdlr[td]) {
@@ -353,7 +392,7 @@ void srsran_tdec_free(srsran_tdec_t* h)
       h->dec16[td]->tdec_free(h->dec16_hdlr[td]);
     }
   }
-  for (int s = 0; s < 4; s++) {
+  for (int s = 0; s < SRSRAN_TDEC_NOF_SB_INTERLEAVERS; s++) {
     for (int i = 0; i < SRSRAN_NOF_TC_CB_SIZES; i++) {
       srsran_tc_interl_free(&h->interleaver[s][i]);
     }
@@ -380,8 +419,13 @@ static void tdec_decision_byte(srsran_tdec_t* h, uint8_t* output)
 /* Returns number of subblocks in automatic mode for this long_cb */
 uint32_t srsran_tdec_autoimp_get_subblocks(uint32_t long_cb)
 {
+#ifdef LV_HAVE_AVX512
+  if (srsran_isa_get() >= SRSRAN_ISA_AVX512 && !(long_cb % 32) && long_cb > 1600) {
+    return 32;
+  } else
+#endif
 #ifdef LV_HAVE_AVX2
-  if (!(long_cb % 16) && long_cb > 800) {
+  if (srsran_isa_get() >= SRSRAN_ISA_AVX2 && !(long_cb % 16) && long_cb > 800) {
     return 16;
   } else
 #endif
@@ -396,6 +440,8 @@ static int tdec_sb_idx(uint32_t long_cb)
 {
   uint32_t nof_sb = srsran_tdec_autoimp_get_subblocks(long_cb);
   switch (nof_sb) {
+    case 32:
+      return AUTO_16_AVX512WIN;
     case 16:
       return AUTO_16_AVXWIN;
     case 8:
@@ -409,8 +455,13 @@ static int tdec_sb_idx(uint32_t long_cb)
 
 uint32_t srsran_tdec_autoimp_get_subblocks_8bit(uint32_t long_cb)
 {
+#ifdef LV_HAVE_AVX512
+  if (srsran_isa_get() >= SRSRAN_ISA_AVX512 && !(long_cb % 64) && long_cb > 4096) {
+    return 64;
+  } else
+#endif
 #ifdef LV_HAVE_AVX2
-  if (!(long_cb % 32) && long_cb > 2048) {
+  if (srsran_isa_get() >= SRSRAN_ISA_AVX2 && !(long_cb % 32) && long_cb > 2048) {
     return 32;
   } else
 #endif
@@ -427,6 +478,8 @@ static int tdec_sb_idx_8(uint32_t long_cb)
 {
   uint32_t nof_sb = srsran_tdec_autoimp_get_subblocks_8bit(long_cb);
   switch (nof_sb) {
+    case 64:
+      return AUTO_8_AVX512WIN;
     case 32:
       return AUTO_8_AVXWIN;
     case 16:
@@ -471,6 +524,11 @@ static void tdec_iteration_8(srsran_tdec_t* h, int8_t* input)
     }
   } else {
     h->current_dec = 0;
+    if (h->current_llr_type == SRSRAN_TDEC_8) {
+      h->current_inter_idx = interleaver_idx(h->nof_blocks8[h->current_dec]);
+    } else {
+      h->current_inter_idx = interleaver_idx(h->nof_blocks16[h->current_dec]);
+    }
   }
 
   if (h->current_llr_type == SRSRAN_TDEC_16) {
@@ -524,6 +582,68 @@ int srsran_tdec_new_cb(srsran_tdec_t* h, uint32_t long_cb)
   return 0;
 }
 
+void srsran_tdec_set_early_stop(srsran_tdec_t* h, srsran_tdec_early_stop_t criterion, int16_t llr_th)
+{
+  h->early_stop        = criterion;
+  h->early_stop_llr_th = llr_th;
+}
+
+/* Returns true if the magnitude of all the a-posteriori LLR used for the last decision exceeds the threshold */
+static bool tdec_llr_above_th(srsran_tdec_t* h)
+{
+  void* llr = !(h->n_iter % 2) ? h->app1 : h->ext1;
+
+  if (h->current_llr_type == SRSRAN_TDEC_16) {
+    int16_t* llr_s = (int16_t*)llr;
+    for (uint32_t i = 0; i < h->current_long_cb; i++) {
+      if (abs(llr_s[i]) < h->early_stop_llr_th) {
+        return false;
+      }
+    }
+  } else {
+    int8_t* llr_c = (int8_t*)llr;
+    int     th    = SRSRAN_MIN(h->early_stop_llr_th, INT8_MAX);
+    for (uint32_t i = 0; i < h->current_long_cb; i++) {
+      if (abs(llr_c[i]) < th) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool srsran_tdec_early_stop(srsran_tdec_t* h, const uint8_t* output)
+{
+  bool     stop      = false;
+  uint32_t nof_bytes = h->current_long_cb / 8;
+
+  switch (h->early_stop) {
+    case SRSRAN_TDEC_EARLY_STOP_HD:
+      // The first iteration has no previous decisions to compare with
+      stop = h->n_iter > 1 && memcmp(h->prev_output, output, nof_bytes) == 0;
+      memcpy(h->prev_output, output, nof_bytes);
+      break;
+    case SRSRAN_TDEC_EARLY_STOP_LLR:
+      stop = tdec_llr_above_th(h);
+      break;
+    case SRSRAN_TDEC_EARLY_STOP_NONE:
+    default:
+      break;
+  }
+
+  return stop;
+}
+
+/* Decides the output bits and evaluates the early stopping criterion, only if a criterion is selected */
+static bool tdec_run_all_early_stop(srsran_tdec_t* h, uint8_t* output)
+{
+  if (h->early_stop == SRSRAN_TDEC_EARLY_STOP_NONE) {
+    return false;
+  }
+  tdec_decision_byte(h, output);
+  return srsran_tdec_early_stop(h, output);
+}
+
 void srsran_tdec_iteration(srsran_tdec_t* h, int16_t* input, uint8_t* output)
 {
   if (h->current_cbidx >= 0) {
@@ -541,7 +661,7 @@ int srsran_tdec_run_all(srsran_tdec_t* h, int16_t* input, uint8_t* output, uint3
 
   do {
     tdec_iteration_16(h, input);
-  } while (h->n_iter < nof_iterations);
+  } while (h->n_iter < nof_iterations && !tdec_run_all_early_stop(h, output));
 
   tdec_decision_byte(h, output);
 
@@ -569,7 +689,7 @@ int srsran_tdec_run_all_8bit(srsran_tdec_t* h,
 
   do {
     tdec_iteration_8(h, input);
-  } while (h->n_iter < nof_iterations);
+  } while (h->n_iter < nof_iterations && !tdec_run_all_early_stop(h, output));
 
   tdec_decision_byte(h, output);
 
@@ -41,9 +41,9 @@
 #if debug_enabled
 #define debug_state                                                                                                    \
   printf("k=%5d, in=%5d, pa=%3d, out=%5d, alpha=", k, x, parity[k - 1], out);                                          \
-  srsran_vec_fprint_s(stdout, alpha, 8);                                                                               \
+  srsran_vec_fprint_i(stdout, alpha, 8);                                                                               \
   printf(", beta=");                                                                                                   \
-  srsran_vec_fprint_s(stdout, &beta[8 * (k)], 8);                                                                      \
+  srsran_vec_fprint_i(stdout, &beta[8 * (k)], 8);                                                                      \
   printf("\n");
 #else
 #define debug_state
@@ -57,11 +57,11 @@
  ************************************************/
 static void map_gen_beta(tdec_gen_t* s, int16_t* input, int16_t* app, int16_t* parity, uint32_t long_cb)
 {
-  int16_t  m_b[8], new[8], old[8];
-  int16_t  x, y, xy;
+  int32_t  m_b[8], new[8], old[8];
+  int32_t  x, y, xy;
   int      k;
   uint32_t end  = long_cb + SRSRAN_TCOD_RATE;
-  int16_t* beta = s->beta;
+  int32_t* beta = s->beta;
   uint32_t i;
 
   for (i = 0; i < 8; i++) {
@@ -114,13 +114,13 @@ static void map_gen_beta(tdec_gen_t* s, int16_t* input, int16_t* app, int16_t* p
 static void
 map_gen_alpha(tdec_gen_t* s, int16_t* input, int16_t* app, int16_t* parity, int16_t* output, uint32_t long_cb)
 {
-  int16_t  m_b[8], new[8], old[8], max1[8], max0[8];
-  int16_t  m1, m0;
-  int16_t  x, y, xy;
-  int16_t  out;
+  int32_t  m_b[8], new[8], old[8], max1[8], max0[8];
+  int32_t  m1, m0;
+  int32_t  x, y, xy;
+  int32_t  out;
   uint32_t k;
   uint32_t end  = long_cb;
-  int16_t* beta = s->beta;
+  int32_t* beta = s->beta;
   uint32_t i;
 
   old[0] = 0;
@@ -129,7 +129,7 @@ map_gen_alpha(tdec_gen_t* s, int16_t* input, int16_t* app, int16_t* parity, int1
   }
 
 #if debug_enabled
-  int16_t alpha[8];
+  int32_t alpha[8];
 #endif
 
   for (k = 1; k < end + 1; k++) {
@@ -142,7 +142,7 @@ map_gen_alpha(tdec_gen_t* s, int16_t* input, int16_t* app, int16_t* parity, int1
     xy = x + y;
 
 #if debug_enabled
-    memcpy(alpha, old, sizeof(int16_t) * 8);
+    memcpy(alpha, old, sizeof(int32_t) * 8);
 #endif
 
     m_b[0] = old[0];
@@ -190,8 +190,9 @@ map_gen_alpha(tdec_gen_t* s, int16_t* input, int16_t* app, int16_t* parity, int1
       old[0] = 0;
     }
 
+    // The metrics are 32-bit, so that the extrinsic information does not wrap around when it grows at high SNR
     out           = m1 - m0;
-    output[k - 1] = out;
+    output[k - 1] = (int16_t)SRSRAN_MAX(SRSRAN_MIN(out, INT16_MAX), INT16_MIN);
 
     debug_state;
   }
@@ -203,7 +204,7 @@ int tdec_gen_init(void** hh, uint32_t max_long_cb)
 
   tdec_gen_t* h = (tdec_gen_t*)*hh;
 
-  h->beta = srsran_vec_i16_malloc((max_long_cb + SRSRAN_TCOD_TOTALTAIL + 1) * NUMSTATES);
+  h->beta = srsran_vec_i32_malloc((max_long_cb + SRSRAN_TCOD_TOTALTAIL + 1) * NUMSTATES);
   if (!h->beta) {
     perror("srsran_vec_malloc");
     return -1;
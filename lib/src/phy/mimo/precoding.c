@@ -62,6 +62,96 @@ int srsran_predecoding_single_avx(cf_t* y[SRSRAN_MAX_PORTS],
 
 static srsran_mimo_decoder_t mimo_decoder = SRSRAN_MIMO_DECODER_MMSE;
 
+/* 36.211 v10.3.0 Table 6.3.4.2.3-2: Householder generator u_n of each 4 antenna port codebook index */
+static const cf_t precoding_4tx_u[16][4] = {
+    {1.0f, -1.0f, -1.0f, -1.0f},
+    {1.0f, -_Complex_I, 1.0f, _Complex_I},
+    {1.0f, 1.0f, -1.0f, 1.0f},
+    {1.0f, _Complex_I, 1.0f, -_Complex_I},
+    {1.0f, (-1.0f - _Complex_I) * (float)M_SQRT1_2, -_Complex_I, (1.0f - _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, (1.0f - _Complex_I) * (float)M_SQRT1_2, _Complex_I, (-1.0f - _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, (1.0f + _Complex_I) * (float)M_SQRT1_2, -_Complex_I, (-1.0f + _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, (-1.0f + _Complex_I) * (float)M_SQRT1_2, _Complex_I, (1.0f + _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, -1.0f, 1.0f, 1.0f},
+    {1.0f, -_Complex_I, -1.0f, -_Complex_I},
+    {1.0f, 1.0f, 1.0f, -1.0f},
+    {1.0f, _Complex_I, -1.0f, _Complex_I},
+    {1.0f, -1.0f, -1.0f, 1.0f},
+    {1.0f, -1.0f, 1.0f, -1.0f},
+    {1.0f, 1.0f, -1.0f, -1.0f},
+    {1.0f, 1.0f, 1.0f, 1.0f}};
+
+/* 36.211 v10.3.0 Table 6.3.4.2.3-2: columns of W_n taken by each number of layers */
+static const char* precoding_4tx_columns[16][4] = {{"1", "14", "124", "1234"},
+                                                   {"1", "12", "123", "1234"},
+                                                   {"1", "12", "123", "3214"},
+                                                   {"1", "12", "123", "3214"},
+                                                   {"1", "14", "124", "1234"},
+                                                   {"1", "14", "124", "1234"},
+                                                   {"1", "13", "134", "1324"},
+                                                   {"1", "13", "134", "1324"},
+                                                   {"1", "12", "124", "1234"},
+                                                   {"1", "14", "134", "1234"},
+                                                   {"1", "13", "123", "1324"},
+                                                   {"1", "13", "134", "1324"},
+                                                   {"1", "12", "123", "1234"},
+                                                   {"1", "13", "123", "1324"},
+                                                   {"1", "13", "123", "3214"},
+                                                   {"1", "12", "123", "1234"}};
+
+/* Spatial multiplexing precoding matrix W[port][layer], including the normalization by the number of layers */
+static int precoding_multiplex_matrix(int  nof_ports,
+                                      int  nof_layers,
+                                      int  codebook_idx,
+                                      cf_t W[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS])
+{
+  if (nof_ports == 2 && nof_layers == 1 && codebook_idx >= 0 && codebook_idx < 4) {
+    // 36.211 Table 6.3.4.2.3-1, one layer
+    const cf_t w1[4] = {1.0f, -1.0f, _Complex_I, -_Complex_I};
+    W[0][0]          = (float)M_SQRT1_2;
+    W[1][0]          = w1[codebook_idx] * (float)M_SQRT1_2;
+    return SRSRAN_SUCCESS;
+  }
+
+  if (nof_ports == 2 && nof_layers == 2 && codebook_idx >= 0 && codebook_idx < 3) {
+    // 36.211 Table 6.3.4.2.3-1, two layers
+    if (codebook_idx == 0) {
+      W[0][0] = (float)M_SQRT1_2;
+      W[0][1] = 0.0f;
+      W[1][0] = 0.0f;
+      W[1][1] = (float)M_SQRT1_2;
+    } else {
+      cf_t w1 = codebook_idx == 1 ? 1.0f : _Complex_I;
+      W[0][0] = 0.5f;
+      W[0][1] = 0.5f;
+      W[1][0] = 0.5f * w1;
+      W[1][1] = -0.5f * w1;
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  if (nof_ports == 4 && nof_layers >= 1 && nof_layers <= 4 && codebook_idx >= 0 && codebook_idx < 16) {
+    // W_n = I - 2 u_n u_n' / (u_n' u_n), where all the elements of u_n have unit magnitude
+    const cf_t* u       = precoding_4tx_u[codebook_idx];
+    const char* columns = precoding_4tx_columns[codebook_idx][nof_layers - 1];
+    float       norm    = 1.0f / sqrtf((float)nof_layers);
+    for (int l = 0; l < nof_layers; l++) {
+      int c = columns[l] - '1';
+      for (int p = 0; p < 4; p++) {
+        cf_t w  = (p == c ? 1.0f : 0.0f) - 0.5f * u[p] * conjf(u[c]);
+        W[p][l] = w * norm;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  ERROR("Invalid multiplex combination: codebook_idx=%d, nof_layers=%d, nof_ports=%d",
+        codebook_idx,
+        nof_layers,
+        nof_ports);
+  return SRSRAN_ERROR;
+}
+
 /************************************************
  *
  * RECEIVER SIDE FUNCTIONS
@@ -1811,6 +1901,145 @@ static int srsran_predecoding_multiplex_2x1_mrc_csi(cf_t*  y[SRSRAN_MAX_PORTS],
   return SRSRAN_SUCCESS;
 }
 
+/* Writes the CSI of every layer of one RE in the codeword buffers, following the two codeword layer mapping of 36.211
+ * Table 6.3.3.2-1: the first codeword takes the first half of the layers (rounded down) and each codeword interleaves
+ * its layers.
+ */
+static inline void predecoding_multiplex_csi_put(float*      csi[SRSRAN_MAX_CODEWORDS],
+                                                 int         nof_layers,
+                                                 int         i,
+                                                 const float csi_l[SRSRAN_MAX_LAYERS])
+{
+  if (nof_layers == 1) {
+    csi[0][i] = csi_l[0];
+    return;
+  }
+
+  int nof_layers_cw0 = nof_layers / 2;
+  int nof_layers_cw1 = nof_layers - nof_layers_cw0;
+  for (int l = 0; l < nof_layers_cw0; l++) {
+    csi[0][i * nof_layers_cw0 + l] = csi_l[l];
+  }
+  for (int l = 0; l < nof_layers_cw1; l++) {
+    csi[1][i * nof_layers_cw1 + l] = csi_l[nof_layers_cw0 + l];
+  }
+}
+
+// Spatial multiplexing equalizer for up to 4 ports, 4 receive antennas and 4 layers. The effective channel of every
+// layer is built from the codebook and solved with the 4x4 ZF/MMSE solvers, which also give the CSI of every RE
+static int srsran_predecoding_multiplex_nxl(cf_t*  y[SRSRAN_MAX_PORTS],
+                                            cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                            cf_t*  x[SRSRAN_MAX_LAYERS],
+                                            float* csi[SRSRAN_MAX_CODEWORDS],
+                                            int    nof_rxant,
+                                            int    nof_ports,
+                                            int    nof_layers,
+                                            int    codebook_idx,
+                                            int    nof_symbols,
+                                            float  scaling,
+                                            float  noise_estimate)
+{
+  cf_t W[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  int  i = 0;
+
+  if (precoding_multiplex_matrix(nof_ports, nof_layers, codebook_idx, W) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // The transmit scaling is part of the effective channel
+  for (int p = 0; p < nof_ports; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      W[p][l] *= scaling;
+    }
+  }
+
+  if (mimo_decoder == SRSRAN_MIMO_DECODER_ZF) {
+    if (nof_rxant < nof_layers) {
+      ERROR("Error predecoding multiplex: ZF requires at least as many rx antennas (%d) as layers (%d)",
+            nof_rxant,
+            nof_layers);
+      return SRSRAN_ERROR;
+    }
+    noise_estimate = 0.0f;
+  }
+
+  bool  csi_en = csi != NULL && csi[0] != NULL && (nof_layers == 1 || csi[1] != NULL);
+  float csi_l[SRSRAN_MAX_LAYERS];
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  simd_cf_t _W[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  for (int p = 0; p < nof_ports; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      _W[p][l] = srsran_simd_cf_set1(W[p][l]);
+    }
+  }
+
+  for (; i < nof_symbols - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    simd_cf_t _y[4], _h[4][4], _x[4];
+    simd_f_t  _csi[4];
+
+    for (int n = 0; n < nof_rxant; n++) {
+      _y[n] = srsran_simd_cfi_load(&y[n][i]);
+
+      simd_cf_t hp[SRSRAN_MAX_PORTS];
+      for (int p = 0; p < nof_ports; p++) {
+        hp[p] = srsran_simd_cfi_load(&h[p][n][i]);
+      }
+      for (int l = 0; l < nof_layers; l++) {
+        _h[n][l] = srsran_simd_cf_prod(hp[0], _W[0][l]);
+        for (int p = 1; p < nof_ports; p++) {
+          _h[n][l] = srsran_simd_cf_add(_h[n][l], srsran_simd_cf_prod(hp[p], _W[p][l]));
+        }
+      }
+    }
+
+    srsran_mat_4x4_mmse_csi_simd(_y, _h, _x, _csi, nof_rxant, nof_layers, noise_estimate);
+
+    for (int l = 0; l < nof_layers; l++) {
+      srsran_simd_cfi_store(&x[l][i], _x[l]);
+    }
+
+    if (csi_en) {
+      srsran_simd_aligned float csi_v[SRSRAN_MAX_LAYERS][SRSRAN_SIMD_F_SIZE];
+      for (int l = 0; l < nof_layers; l++) {
+        srsran_simd_f_store(csi_v[l], _csi[l]);
+      }
+      for (int k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+        for (int l = 0; l < nof_layers; l++) {
+          csi_l[l] = csi_v[l][k];
+        }
+        predecoding_multiplex_csi_put(csi, nof_layers, i + k, csi_l);
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+  for (; i < nof_symbols; i++) {
+    cf_t _y[4], _h[4][4], _x[4];
+
+    for (int n = 0; n < nof_rxant; n++) {
+      _y[n] = y[n][i];
+      for (int l = 0; l < nof_layers; l++) {
+        _h[n][l] = 0;
+        for (int p = 0; p < nof_ports; p++) {
+          _h[n][l] += h[p][n][i] * W[p][l];
+        }
+      }
+    }
+
+    srsran_mat_4x4_mmse_csi_gen(_y, _h, _x, csi_l, nof_rxant, nof_layers, noise_estimate);
+
+    for (int l = 0; l < nof_layers; l++) {
+      x[l][i] = _x[l];
+    }
+
+    if (csi_en) {
+      predecoding_multiplex_csi_put(csi, nof_layers, i, csi_l);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 static int srsran_predecoding_multiplex(cf_t*  y[SRSRAN_MAX_PORTS],
                                         cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                         cf_t*  x[SRSRAN_MAX_LAYERS],
@@ -1849,8 +2078,9 @@ static int srsran_predecoding_multiplex(cf_t*  y[SRSRAN_MAX_PORTS],
         return srsran_predecoding_multiplex_2x1_mrc(y, h, x, codebook_idx, nof_symbols, scaling);
       }
     }
-  } else if (nof_ports == 4) {
-    ERROR("Error predecoding multiplex: not implemented for %d Tx ports", nof_ports);
+  } else if ((nof_ports == 2 || nof_ports == 4) && nof_rxant <= SRSRAN_MAX_PORTS) {
+    return srsran_predecoding_multiplex_nxl(
+        y, h, x, csi, nof_rxant, nof_ports, nof_layers, codebook_idx, nof_symbols, scaling, noise_estimate);
   } else {
     ERROR("Error predecoding multiplex: Invalid combination of ports %d and rx antennas %d", nof_ports, nof_rxant);
   }
@@ -2084,6 +2314,48 @@ int srsran_precoding_cdd(cf_t* x[SRSRAN_MAX_LAYERS],
   }
 }
 
+// Spatial multiplexing precoding for 4 antenna ports, y = W x X with the codebook of 36.211 Table 6.3.4.2.3-2
+static int srsran_precoding_multiplex_4tx(cf_t*    x[SRSRAN_MAX_LAYERS],
+                                          cf_t*    y[SRSRAN_MAX_PORTS],
+                                          int      nof_layers,
+                                          int      codebook_idx,
+                                          uint32_t nof_symbols,
+                                          float    scaling)
+{
+  cf_t W[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  if (precoding_multiplex_matrix(4, nof_layers, codebook_idx, W) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (int p = 0; p < 4; p++) {
+    for (int l = 0; l < nof_layers; l++) {
+      W[p][l] *= scaling;
+    }
+
+    uint32_t i = 0;
+#if SRSRAN_SIMD_CF_SIZE != 0
+    for (; i + SRSRAN_SIMD_CF_SIZE <= nof_symbols; i += SRSRAN_SIMD_CF_SIZE) {
+      simd_cf_t acc = srsran_simd_cf_prod(srsran_simd_cfi_load(&x[0][i]), srsran_simd_cf_set1(W[p][0]));
+      for (int l = 1; l < nof_layers; l++) {
+        simd_cf_t xl = srsran_simd_cfi_load(&x[l][i]);
+        acc          = srsran_simd_cf_add(acc, srsran_simd_cf_prod(xl, srsran_simd_cf_set1(W[p][l])));
+      }
+      srsran_simd_cfi_store(&y[p][i], acc);
+    }
+#endif /* SRSRAN_SIMD_CF_SIZE */
+
+    for (; i < nof_symbols; i++) {
+      cf_t acc = 0;
+      for (int l = 0; l < nof_layers; l++) {
+        acc += x[l][i] * W[p][l];
+      }
+      y[p][i] = acc;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_precoding_multiplex(cf_t*    x[SRSRAN_MAX_LAYERS],
                                cf_t*    y[SRSRAN_MAX_PORTS],
                                int      nof_layers,
@@ -2204,6 +2476,8 @@ int srsran_precoding_multiplex(cf_t*    x[SRSRAN_MAX_LAYERS],
     } else {
       ERROR("Not implemented");
     }
+  } else if (nof_ports == 4) {
+    return srsran_precoding_multiplex_4tx(x, y, nof_layers, codebook_idx, nof_symbols, scaling);
   } else {
     ERROR("Not implemented");
   }
@@ -76,6 +76,10 @@
 void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #endif
 
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif
+
 #define SCALE_SHORT_CONV_QPSK 100
 #define SCALE_SHORT_CONV_QAM16 400
 #define SCALE_SHORT_CONV_QAM64 700
@@ -86,6 +90,75 @@ void demod_16qam_lte_s_sse(const cf_t* symbols, short* llr, int nsymbols);
 #define SCALE_BYTE_CONV_QAM64 40
 #define SCALE_BYTE_CONV_QAM256 50
 
+#ifdef LV_HAVE_AVX2
+
+/* Loads 16 symbols and converts them to 32 bytes, in the same order as the real and imaginary parts */
+static inline __m256i demod_avx2_load_b(const cf_t* symbols, __m256 scale)
+{
+  const float* symbolsPtr = (const float*)symbols;
+
+  __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 0), scale));
+  __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 8), scale));
+  __m256i c = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 16), scale));
+  __m256i d = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 24), scale));
+
+  // The packs work within 128-bit lanes, the groups of 4 bytes are put back in order
+  __m256i abcd = _mm256_packs_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+  return _mm256_permutevar8x32_epi32(abcd, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+/* Truncates 32 floats to bytes as the scalar conversion does, keeping their order */
+static inline __m256i demod_avx2_cvtt_b(__m256 a, __m256 b, __m256 c, __m256 d)
+{
+  __m256i ab   = _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b));
+  __m256i cd   = _mm256_packs_epi32(_mm256_cvttps_epi32(c), _mm256_cvttps_epi32(d));
+  __m256i abcd = _mm256_packs_epi16(ab, cd);
+  return _mm256_permutevar8x32_epi32(abcd, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+/* Loads 8 symbols and converts them to 16 shorts, in the same order as the real and imaginary parts */
+static inline __m256i demod_avx2_load_s(const cf_t* symbols, __m256 scale)
+{
+  const float* symbolsPtr = (const float*)symbols;
+
+  __m256i a = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 0), scale));
+  __m256i b = _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_loadu_ps(symbolsPtr + 8), scale));
+
+  return _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+}
+
+/* Stores 32 LLR bytes, changing the sign of the ones with a negative scrambling sequence value if c is given */
+static inline void demod_avx2_store_b(int8_t* llr, const int8_t* c, __m256i v)
+{
+  if (c) {
+    v = _mm256_sign_epi8(v, _mm256_loadu_si256((const __m256i*)c));
+  }
+  _mm256_storeu_si256((__m256i*)llr, v);
+}
+
+/* Stores 16 LLR shorts, changing the sign of the ones with a negative scrambling sequence value if c is given */
+static inline void demod_avx2_store_s(int16_t* llr, const int16_t* c, __m256i v)
+{
+  if (c) {
+    v = _mm256_sign_epi16(v, _mm256_loadu_si256((const __m256i*)c));
+  }
+  _mm256_storeu_si256((__m256i*)llr, v);
+}
+
+/* Demodulates the last symbols with the SSE or generic implementation and descrambles them */
+#define DEMOD_AVX2_TAIL(FUNC, SUFFIX, BITS, STEP)                                                                      \
+  do {                                                                                                                 \
+    int i = STEP * (nsymbols / STEP);                                                                                  \
+    if (i < nsymbols) {                                                                                                \
+      FUNC(&symbols[i], &llr[BITS * i], nsymbols - i);                                                                 \
+      if (c) {                                                                                                         \
+        srsran_vec_neg_##SUFFIX(&llr[BITS * i], &c[BITS * i], &llr[BITS * i], BITS * (nsymbols - i));                  \
+      }                                                                                                                \
+    }                                                                                                                  \
+  } while (0)
+
+#endif
+
 void demod_bpsk_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
@@ -360,8 +433,54 @@ void demod_16qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 #endif
 
+#ifdef LV_HAVE_AVX2
+
+static void demod_16qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols, const int16_t* c)
+{
+  __m256  scale_v = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM16);
+  __m256i offset  = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM16 / sqrtf(10));
+
+  for (int i = 0; i < nsymbols / 8; i++) {
+    __m256i symbol_i   = demod_avx2_load_s(&symbols[8 * i], scale_v);
+    __m256i symbol_abs = _mm256_subs_epi16(_mm256_abs_epi16(symbol_i), offset);
+
+    // Every symbol takes two pairs of shorts, the unpacks interleave them within the 128-bit lanes
+    __m256i lo = _mm256_unpacklo_epi32(symbol_i, symbol_abs);
+    __m256i hi = _mm256_unpackhi_epi32(symbol_i, symbol_abs);
+
+    demod_avx2_store_s(&llr[32 * i], c ? &c[32 * i] : NULL, _mm256_permute2x128_si256(lo, hi, 0x20));
+    demod_avx2_store_s(&llr[32 * i + 16], c ? &c[32 * i + 16] : NULL, _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+
+  DEMOD_AVX2_TAIL(demod_16qam_lte_s_sse, sss, 4, 8);
+}
+
+static void demod_16qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols, const int8_t* c)
+{
+  __m256  scale_v = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM16);
+  __m256i offset  = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM16 / sqrtf(10));
+
+  for (int i = 0; i < nsymbols / 16; i++) {
+    __m256i symbol_i   = demod_avx2_load_b(&symbols[16 * i], scale_v);
+    __m256i symbol_abs = _mm256_subs_epi8(_mm256_abs_epi8(symbol_i), offset);
+
+    __m256i lo = _mm256_unpacklo_epi16(symbol_i, symbol_abs);
+    __m256i hi = _mm256_unpackhi_epi16(symbol_i, symbol_abs);
+
+    demod_avx2_store_b(&llr[64 * i], c ? &c[64 * i] : NULL, _mm256_permute2x128_si256(lo, hi, 0x20));
+    demod_avx2_store_b(&llr[64 * i + 32], c ? &c[64 * i + 32] : NULL, _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+
+  DEMOD_AVX2_TAIL(demod_16qam_lte_b_sse, bbb, 4, 16);
+}
+
+#endif
+
 void demod_16qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_16qam_lte_s_avx2(symbols, llr, nsymbols, NULL);
+#else
 #ifdef LV_HAVE_SSE
   demod_16qam_lte_s_sse(symbols, llr, nsymbols);
 #else
@@ -379,10 +498,14 @@ void demod_16qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_16qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_16qam_lte_b_avx2(symbols, llr, nsymbols, NULL);
+#else
 #ifdef LV_HAVE_SSE
   demod_16qam_lte_b_sse(symbols, llr, nsymbols);
 #else
@@ -400,6 +523,7 @@ void demod_16qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_64qam_lte(const cf_t* symbols, float* llr, int nsymbols)
@@ -731,8 +855,128 @@ void demod_64qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
 
 #endif
 
+#ifdef LV_HAVE_AVX2
+
+/* The 64QAM LLR of every 128-bit lane are arranged with the same shuffles as in the SSE implementation. The first lane
+ * holds the LLR of the first half of the symbols and the second lane the rest, so the halves are put back in order
+ * before storing them */
+static inline void demod_64qam_avx2_store_s(int16_t* llr, const int16_t* c, __m256i r1, __m256i r2, __m256i r3)
+{
+  demod_avx2_store_s(&llr[0], c ? &c[0] : NULL, _mm256_permute2x128_si256(r1, r2, 0x20));
+  demod_avx2_store_s(&llr[16], c ? &c[16] : NULL, _mm256_permute2x128_si256(r3, r1, 0x30));
+  demod_avx2_store_s(&llr[32], c ? &c[32] : NULL, _mm256_permute2x128_si256(r2, r3, 0x31));
+}
+
+static inline void demod_64qam_avx2_store_b(int8_t* llr, const int8_t* c, __m256i r1, __m256i r2, __m256i r3)
+{
+  demod_avx2_store_b(&llr[0], c ? &c[0] : NULL, _mm256_permute2x128_si256(r1, r2, 0x20));
+  demod_avx2_store_b(&llr[32], c ? &c[32] : NULL, _mm256_permute2x128_si256(r3, r1, 0x30));
+  demod_avx2_store_b(&llr[64], c ? &c[64] : NULL, _mm256_permute2x128_si256(r2, r3, 0x31));
+}
+
+static void demod_64qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols, const int16_t* c)
+{
+  __m256  scale_v = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM64);
+  __m256i offset1 = _mm256_set1_epi16(4 * SCALE_SHORT_CONV_QAM64 / sqrtf(42));
+  __m256i offset2 = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM64 / sqrtf(42));
+
+  __m256i shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_negated_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(11, 10, 9, 8, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4));
+  __m256i shuffle_abs_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs2_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 3, 2, 1, 0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 7, 6, 5, 4, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 13, 12, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 11, 10, 9, 8));
+
+  for (int i = 0; i < nsymbols / 8; i++) {
+    __m256i symbol_i    = demod_avx2_load_s(&symbols[8 * i], scale_v);
+    __m256i symbol_abs  = _mm256_subs_epi16(_mm256_abs_epi16(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_subs_epi16(_mm256_abs_epi16(symbol_abs), offset2);
+
+    __m256i result1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_1));
+    __m256i result2 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_2));
+    __m256i result3 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_3),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_3)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_3));
+
+    demod_64qam_avx2_store_s(&llr[48 * i], c ? &c[48 * i] : NULL, result1, result2, result3);
+  }
+
+  DEMOD_AVX2_TAIL(demod_64qam_lte_s_sse, sss, 6, 8);
+}
+
+static void demod_64qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols, const int8_t* c)
+{
+  __m256  scale_v = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM64);
+  __m256i offset1 = _mm256_set1_epi8(4 * SCALE_BYTE_CONV_QAM64 / sqrtf(42));
+  __m256i offset2 = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM64 / sqrtf(42));
+
+  __m256i shuffle_negated_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0));
+  __m256i shuffle_negated_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(11, 10, 0xff, 0xff, 0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff));
+  __m256i shuffle_negated_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff));
+
+  __m256i shuffle_abs_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(5, 4, 0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0, 0xff, 0xff));
+  __m256i shuffle_abs_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10));
+
+  __m256i shuffle_abs2_1 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 0xff, 0xff, 3, 2, 0xff, 0xff, 0xff, 0xff, 1, 0, 0xff, 0xff, 0xff, 0xff));
+  __m256i shuffle_abs2_2 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(0xff, 0xff, 9, 8, 0xff, 0xff, 0xff, 0xff, 7, 6, 0xff, 0xff, 0xff, 0xff, 5, 4));
+  __m256i shuffle_abs2_3 = _mm256_broadcastsi128_si256(
+      _mm_set_epi8(15, 14, 0xff, 0xff, 0xff, 0xff, 13, 12, 0xff, 0xff, 0xff, 0xff, 11, 10, 0xff, 0xff));
+
+  for (int i = 0; i < nsymbols / 16; i++) {
+    __m256i symbol_i    = demod_avx2_load_b(&symbols[16 * i], scale_v);
+    __m256i symbol_abs  = _mm256_subs_epi8(_mm256_abs_epi8(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_subs_epi8(_mm256_abs_epi8(symbol_abs), offset2);
+
+    __m256i result1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_1),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_1)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_1));
+    __m256i result2 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_2),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_2)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_2));
+    __m256i result3 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(symbol_i, shuffle_negated_3),
+                                                      _mm256_shuffle_epi8(symbol_abs, shuffle_abs_3)),
+                                      _mm256_shuffle_epi8(symbol_abs2, shuffle_abs2_3));
+
+    demod_64qam_avx2_store_b(&llr[96 * i], c ? &c[96 * i] : NULL, result1, result2, result3);
+  }
+
+  DEMOD_AVX2_TAIL(demod_64qam_lte_b_sse, bbb, 6, 16);
+}
+
+#endif
+
 void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_64qam_lte_s_avx2(symbols, llr, nsymbols, NULL);
+#else
 #ifdef LV_HAVE_SSE
   demod_64qam_lte_s_sse(symbols, llr, nsymbols);
 #else
@@ -752,10 +996,14 @@ void demod_64qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
+#ifdef LV_HAVE_AVX2
+  demod_64qam_lte_b_avx2(symbols, llr, nsymbols, NULL);
+#else
 #ifdef LV_HAVE_SSE
   demod_64qam_lte_b_sse(symbols, llr, nsymbols);
 #else
@@ -775,6 +1023,7 @@ void demod_64qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 #endif
 #endif
+#endif
 }
 
 void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
@@ -799,7 +1048,7 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+static void demod_256qam_lte_b_generic(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -821,7 +1070,7 @@ void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+static void demod_256qam_lte_s_generic(const cf_t* symbols, short* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -843,6 +1092,105 @@ void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 }
 
+#ifdef LV_HAVE_AVX2
+
+static void demod_256qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols, const int16_t* c)
+{
+  __m256  scale_v = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  __m256i offset1 = _mm256_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m256i offset2 = _mm256_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m256i offset3 = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+
+  for (int i = 0; i < nsymbols / 8; i++) {
+    __m256i symbol_i    = demod_avx2_load_s(&symbols[8 * i], scale_v);
+    __m256i symbol_abs  = _mm256_subs_epi16(_mm256_abs_epi16(symbol_i), offset1);
+    __m256i symbol_abs2 = _mm256_subs_epi16(_mm256_abs_epi16(symbol_abs), offset2);
+    __m256i symbol_abs3 = _mm256_subs_epi16(_mm256_abs_epi16(symbol_abs2), offset3);
+
+    // Every symbol takes four pairs of shorts, two unpack stages interleave them within the 128-bit lanes
+    __m256i lo1 = _mm256_unpacklo_epi32(symbol_i, symbol_abs);
+    __m256i hi1 = _mm256_unpackhi_epi32(symbol_i, symbol_abs);
+    __m256i lo2 = _mm256_unpacklo_epi32(symbol_abs2, symbol_abs3);
+    __m256i hi2 = _mm256_unpackhi_epi32(symbol_abs2, symbol_abs3);
+
+    __m256i e0 = _mm256_unpacklo_epi64(lo1, lo2);
+    __m256i e1 = _mm256_unpackhi_epi64(lo1, lo2);
+    __m256i e2 = _mm256_unpacklo_epi64(hi1, hi2);
+    __m256i e3 = _mm256_unpackhi_epi64(hi1, hi2);
+
+    const int16_t* c_ptr = c ? &c[64 * i] : NULL;
+    demod_avx2_store_s(&llr[64 * i], c_ptr, _mm256_permute2x128_si256(e0, e1, 0x20));
+    demod_avx2_store_s(&llr[64 * i + 16], c_ptr ? c_ptr + 16 : NULL, _mm256_permute2x128_si256(e2, e3, 0x20));
+    demod_avx2_store_s(&llr[64 * i + 32], c_ptr ? c_ptr + 32 : NULL, _mm256_permute2x128_si256(e0, e1, 0x31));
+    demod_avx2_store_s(&llr[64 * i + 48], c_ptr ? c_ptr + 48 : NULL, _mm256_permute2x128_si256(e2, e3, 0x31));
+  }
+
+  DEMOD_AVX2_TAIL(demod_256qam_lte_s_generic, sss, 8, 8);
+}
+
+static void demod_256qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols, const int8_t* c)
+{
+  // The levels are computed in float and truncated once, the byte scale is too coarse for the accumulated offsets
+  const float* symbolsPtr = (const float*)symbols;
+  __m256       scale_v    = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  __m256       sign_mask  = _mm256_set1_ps(-0.0f);
+  __m256       offset1    = _mm256_set1_ps(8.0f * SCALE_BYTE_CONV_QAM256 / sqrtf(170.0f));
+  __m256       offset2    = _mm256_set1_ps(4.0f * SCALE_BYTE_CONV_QAM256 / sqrtf(170.0f));
+  __m256       offset3    = _mm256_set1_ps(2.0f * SCALE_BYTE_CONV_QAM256 / sqrtf(170.0f));
+
+  for (int i = 0; i < nsymbols / 16; i++) {
+    __m256 l0[4], l1[4], l2[4], l3[4];
+    for (int k = 0; k < 4; k++) {
+      l0[k] = _mm256_mul_ps(_mm256_loadu_ps(&symbolsPtr[32 * i + 8 * k]), scale_v);
+      l1[k] = _mm256_sub_ps(_mm256_andnot_ps(sign_mask, l0[k]), offset1);
+      l2[k] = _mm256_sub_ps(_mm256_andnot_ps(sign_mask, l1[k]), offset2);
+      l3[k] = _mm256_sub_ps(_mm256_andnot_ps(sign_mask, l2[k]), offset3);
+    }
+    __m256i symbol_i    = demod_avx2_cvtt_b(l0[0], l0[1], l0[2], l0[3]);
+    __m256i symbol_abs  = demod_avx2_cvtt_b(l1[0], l1[1], l1[2], l1[3]);
+    __m256i symbol_abs2 = demod_avx2_cvtt_b(l2[0], l2[1], l2[2], l2[3]);
+    __m256i symbol_abs3 = demod_avx2_cvtt_b(l3[0], l3[1], l3[2], l3[3]);
+
+    __m256i lo1 = _mm256_unpacklo_epi16(symbol_i, symbol_abs);
+    __m256i hi1 = _mm256_unpackhi_epi16(symbol_i, symbol_abs);
+    __m256i lo2 = _mm256_unpacklo_epi16(symbol_abs2, symbol_abs3);
+    __m256i hi2 = _mm256_unpackhi_epi16(symbol_abs2, symbol_abs3);
+
+    __m256i e0 = _mm256_unpacklo_epi32(lo1, lo2);
+    __m256i e1 = _mm256_unpackhi_epi32(lo1, lo2);
+    __m256i e2 = _mm256_unpacklo_epi32(hi1, hi2);
+    __m256i e3 = _mm256_unpackhi_epi32(hi1, hi2);
+
+    const int8_t* c_ptr = c ? &c[128 * i] : NULL;
+    demod_avx2_store_b(&llr[128 * i], c_ptr, _mm256_permute2x128_si256(e0, e1, 0x20));
+    demod_avx2_store_b(&llr[128 * i + 32], c_ptr ? c_ptr + 32 : NULL, _mm256_permute2x128_si256(e2, e3, 0x20));
+    demod_avx2_store_b(&llr[128 * i + 64], c_ptr ? c_ptr + 64 : NULL, _mm256_permute2x128_si256(e0, e1, 0x31));
+    demod_avx2_store_b(&llr[128 * i + 96], c_ptr ? c_ptr + 96 : NULL, _mm256_permute2x128_si256(e2, e3, 0x31));
+  }
+
+  DEMOD_AVX2_TAIL(demod_256qam_lte_b_generic, bbb, 8, 16);
+}
+
+#endif
+
+void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+#ifdef LV_HAVE_AVX2
+  demod_256qam_lte_b_avx2(symbols, llr, nsymbols, NULL);
+#else
+  demod_256qam_lte_b_generic(symbols, llr, nsymbols);
+#endif
+}
+
+void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+{
+#ifdef LV_HAVE_AVX2
+  demod_256qam_lte_s_avx2(symbols, llr, nsymbols, NULL);
+#else
+  demod_256qam_lte_s_generic(symbols, llr, nsymbols);
+#endif
+}
+
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
 {
   switch (modulation) {
@@ -917,3 +1265,63 @@ int srsran_demod_soft_demodulate_b(srsran_mod_t modulation, const cf_t* symbols,
   }
   return 0;
 }
+
+int srsran_demod_soft_demodulate_s_descramble(srsran_mod_t modulation,
+                                              const cf_t*  symbols,
+                                              short*       llr,
+                                              int          nsymbols,
+                                              const short* c)
+{
+#ifdef LV_HAVE_AVX2
+  switch (modulation) {
+    case SRSRAN_MOD_16QAM:
+      demod_16qam_lte_s_avx2(symbols, llr, nsymbols, c);
+      return 0;
+    case SRSRAN_MOD_64QAM:
+      demod_64qam_lte_s_avx2(symbols, llr, nsymbols, c);
+      return 0;
+    case SRSRAN_MOD_256QAM:
+      demod_256qam_lte_s_avx2(symbols, llr, nsymbols, c);
+      return 0;
+    default:
+      break;
+  }
+#endif
+
+  // Without a fused implementation, the LLR are descrambled after the demodulation
+  if (srsran_demod_soft_demodulate_s(modulation, symbols, llr, nsymbols)) {
+    return -1;
+  }
+  srsran_vec_neg_sss(llr, c, llr, nsymbols * srsran_mod_bits_x_symbol(modulation));
+  return 0;
+}
+
+int srsran_demod_soft_demodulate_b_descramble(srsran_mod_t  modulation,
+                                              const cf_t*   symbols,
+                                              int8_t*       llr,
+                                              int           nsymbols,
+                                              const int8_t* c)
+{
+#ifdef LV_HAVE_AVX2
+  switch (modulation) {
+    case SRSRAN_MOD_16QAM:
+      demod_16qam_lte_b_avx2(symbols, llr, nsymbols, c);
+      return 0;
+    case SRSRAN_MOD_64QAM:
+      demod_64qam_lte_b_avx2(symbols, llr, nsymbols, c);
+      return 0;
+    case SRSRAN_MOD_256QAM:
+      demod_256qam_lte_b_avx2(symbols, llr, nsymbols, c);
+      return 0;
+    default:
+      break;
+  }
+#endif
+
+  // Without a fused implementation, the LLR are descrambled after the demodulation
+  if (srsran_demod_soft_demodulate_b(modulation, symbols, llr, nsymbols)) {
+    return -1;
+  }
+  srsran_vec_neg_bbb(llr, c, llr, nsymbols * srsran_mod_bits_x_symbol(modulation));
+  return 0;
+}
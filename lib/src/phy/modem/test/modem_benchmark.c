@@ -0,0 +1,221 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+static const srsran_mod_t mod_list[] =
+    {SRSRAN_MOD_BPSK, SRSRAN_MOD_QPSK, SRSRAN_MOD_16QAM, SRSRAN_MOD_64QAM, SRSRAN_MOD_256QAM};
+
+typedef enum { OUTPUT_FLOAT = 0, OUTPUT_SHORT, OUTPUT_BYTE, OUTPUT_SHORT_DESCRAMBLE, OUTPUT_BYTE_DESCRAMBLE } output_t;
+
+static const char* output_names[] = {"float", "short", "byte", "short+scr", "byte+scr"};
+
+#define NOF_OUTPUTS (sizeof(output_names) / sizeof(output_names[0]))
+
+static uint32_t nof_symbols     = 100 * SRSRAN_NRE * (SRSRAN_CP_NORM_SF_NSYMB - 2);
+static uint32_t nof_repetitions = 1000;
+static float    snr_dB          = 20.0f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nrs]\n", prog);
+  printf("\t-n Number of symbols [Default %d]\n", nof_symbols);
+  printf("\t-r nof_repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_dB);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nrs")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_symbols = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static void demodulate(output_t           output,
+                       srsran_mod_t       mod,
+                       const cf_t*        symbols,
+                       void*              llr,
+                       srsran_sequence_t* seq)
+{
+  switch (output) {
+    case OUTPUT_FLOAT:
+      srsran_demod_soft_demodulate(mod, symbols, (float*)llr, nof_symbols);
+      break;
+    case OUTPUT_SHORT:
+      srsran_demod_soft_demodulate_s(mod, symbols, (short*)llr, nof_symbols);
+      break;
+    case OUTPUT_BYTE:
+      srsran_demod_soft_demodulate_b(mod, symbols, (int8_t*)llr, nof_symbols);
+      break;
+    case OUTPUT_SHORT_DESCRAMBLE:
+      srsran_demod_soft_demodulate_s_descramble(mod, symbols, (short*)llr, nof_symbols, seq->c_short);
+      break;
+    case OUTPUT_BYTE_DESCRAMBLE:
+      srsran_demod_soft_demodulate_b_descramble(mod, symbols, (int8_t*)llr, nof_symbols, seq->c_char);
+      break;
+  }
+}
+
+/* Counts the LLR whose sign does not match the transmitted bit, after removing the scrambling */
+static uint32_t count_errors(output_t output, const uint8_t* bits, const void* llr, srsran_sequence_t* seq, uint32_t len)
+{
+  uint32_t errors = 0;
+  for (uint32_t i = 0; i < len; i++) {
+    float v = 0.0f;
+    switch (output) {
+      case OUTPUT_FLOAT:
+        v = ((const float*)llr)[i];
+        break;
+      case OUTPUT_SHORT:
+      case OUTPUT_SHORT_DESCRAMBLE:
+        v = ((const short*)llr)[i];
+        break;
+      case OUTPUT_BYTE:
+      case OUTPUT_BYTE_DESCRAMBLE:
+        v = ((const int8_t*)llr)[i];
+        break;
+    }
+    if (output == OUTPUT_SHORT_DESCRAMBLE || output == OUTPUT_BYTE_DESCRAMBLE) {
+      v *= seq->c_float[i];
+    }
+    errors += (v > 0) != (bits[i] != 0);
+  }
+  return errors;
+}
+
+int main(int argc, char** argv)
+{
+  int                  ret        = SRSRAN_ERROR;
+  srsran_random_t      random_gen = srsran_random_init(0);
+  srsran_modem_table_t modem      = {};
+  srsran_sequence_t    seq        = {};
+  uint8_t*             bits       = NULL;
+  cf_t*                symbols    = NULL;
+  float*               llr        = NULL;
+
+  parse_args(argc, argv);
+
+  uint32_t max_bits = nof_symbols * SRSRAN_MAX_QM;
+  bits              = srsran_vec_u8_malloc(max_bits);
+  symbols           = srsran_vec_cf_malloc(nof_symbols);
+  llr               = srsran_vec_f_malloc(max_bits);
+  if (bits == NULL || symbols == NULL || llr == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (srsran_sequence_LTE_pr(&seq, max_bits, 1234)) {
+    ERROR("Error initializing scrambling sequence");
+    goto clean_exit;
+  }
+
+  printf("%-6s", "mod");
+  for (uint32_t o = 0; o < NOF_OUTPUTS; o++) {
+    printf(" %10s", output_names[o]);
+  }
+  printf("   (Msymbols/s)\n");
+
+  for (uint32_t m = 0; m < sizeof(mod_list) / sizeof(mod_list[0]); m++) {
+    srsran_mod_t mod      = mod_list[m];
+    uint32_t     nof_bits = nof_symbols * srsran_mod_bits_x_symbol(mod);
+
+    if (srsran_modem_table_lte(&modem, mod)) {
+      ERROR("Error initializing modem table");
+      goto clean_exit;
+    }
+
+    for (uint32_t i = 0; i < nof_bits; i++) {
+      bits[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+    }
+    srsran_mod_modulate(&modem, bits, symbols, nof_bits);
+    srsran_modem_table_free(&modem);
+
+    // Noiseless symbols would be demodulated at the constellation points, the noise spreads the LLR values
+    srsran_ch_awgn_c(symbols, symbols, sqrtf(srsran_convert_dB_to_power(-snr_dB) / 2), nof_symbols);
+
+    printf("%-6s", srsran_mod_string(mod));
+    for (uint32_t o = 0; o < NOF_OUTPUTS; o++) {
+      // Warm up the caches
+      demodulate((output_t)o, mod, symbols, llr, &seq);
+
+      uint64_t t0 = time_ns();
+      for (uint32_t r = 0; r < nof_repetitions; r++) {
+        demodulate((output_t)o, mod, symbols, llr, &seq);
+      }
+      double t_ns = (double)(time_ns() - t0) / nof_repetitions;
+      printf(" %10.1f", 1000.0 * nof_symbols / t_ns);
+
+      // The quantized LLR must take the sign of the float ones, only a few errors are expected from the noise
+      uint32_t errors = count_errors((output_t)o, bits, llr, &seq, nof_bits);
+      if (errors > nof_bits / 10) {
+        printf("\n");
+        ERROR("Too many bit errors (%d of %d) with %s output", errors, nof_bits, output_names[o]);
+        goto clean_exit;
+      }
+    }
+    printf("\n");
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_sequence_free(&seq);
+  if (bits) {
+    free(bits);
+  }
+  if (symbols) {
+    free(symbols);
+  }
+  if (llr) {
+    free(llr);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -36,7 +36,7 @@ static srsran_mod_t modulation = SRSRAN_MOD_NITEMS;
 
 void usage(char* prog)
 {
-  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64)\n", prog);
+  printf("Usage: %s [nfv] -m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256)\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-f nof_frames [Default %d]\n", nof_frames);
   printf("\t-v srsran_verbose [Default None]\n");
@@ -118,6 +118,9 @@ int main(int argc, char** argv)
   float*               llr;
   short*               llr_s;
   int8_t*              llr_b;
+  short*               llr_s_ref;
+  int8_t*              llr_b_ref;
+  srsran_sequence_t    seq = {};
 
   parse_args(argc, argv);
 
@@ -165,6 +168,23 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
+  llr_s_ref = srsran_vec_i16_malloc(num_bits);
+  if (!llr_s_ref) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  llr_b_ref = srsran_vec_i8_malloc(num_bits);
+  if (!llr_b_ref) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  if (srsran_sequence_LTE_pr(&seq, num_bits, 1234)) {
+    ERROR("Error initializing scrambling sequence");
+    exit(-1);
+  }
+
   /* generate random data */
   srand(0);
 
@@ -232,11 +252,31 @@ int main(int argc, char** argv)
         printf("Error in bit %d\n", i);
         goto clean_exit;
       }
+      if (input[i] != (llr_s[i] > 0 ? 1 : 0) || input[i] != (llr_b[i] > 0 ? 1 : 0)) {
+        printf("Error in quantized bit %d\n", i);
+        goto clean_exit;
+      }
+    }
+
+    // The fused descrambling must give the same LLR as descrambling after demodulating
+    srsran_demod_soft_demodulate_s_descramble(modulation, symbols, llr_s, num_bits / mod.nbits_x_symbol, seq.c_short);
+    srsran_demod_soft_demodulate_b_descramble(modulation, symbols, llr_b, num_bits / mod.nbits_x_symbol, seq.c_char);
+    srsran_demod_soft_demodulate_s(modulation, symbols, llr_s_ref, num_bits / mod.nbits_x_symbol);
+    srsran_demod_soft_demodulate_b(modulation, symbols, llr_b_ref, num_bits / mod.nbits_x_symbol);
+    srsran_scrambling_s_offset(&seq, llr_s_ref, 0, num_bits);
+    srsran_scrambling_sb_offset(&seq, llr_b_ref, 0, num_bits);
+    if (memcmp(llr_s, llr_s_ref, sizeof(short) * num_bits) != 0 ||
+        memcmp(llr_b, llr_b_ref, sizeof(int8_t) * num_bits) != 0) {
+      printf("Error in descrambled LLR\n");
+      goto clean_exit;
     }
   }
   ret = 0;
 
 clean_exit:
+  srsran_sequence_free(&seq);
+  free(llr_b_ref);
+  free(llr_s_ref);
   free(llr_b);
   free(llr_s);
   free(llr);
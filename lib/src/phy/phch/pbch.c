@@ -153,6 +153,7 @@ int srsran_pbch_init(srsran_pbch_t* q)
     if (srsran_viterbi_init(&q->decoder, SRSRAN_VITERBI_37, poly, 40, true)) {
       goto clean;
     }
+    srsran_viterbi_set_wava(&q->decoder, true);
     if (srsran_crc_init(&q->crc, SRSRAN_LTE_CRC16, 16)) {
       goto clean;
     }
@@ -74,6 +74,7 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
     if (srsran_viterbi_init(&q->decoder, SRSRAN_VITERBI_37, poly, SRSRAN_DCI_MAX_BITS + 16, true)) {
       goto clean;
     }
+    srsran_viterbi_set_wava(&q->decoder, true);
 
     q->e = srsran_vec_u8_malloc(q->max_bits);
     if (!q->e) {
@@ -87,6 +88,11 @@ static int pdcch_init(srsran_pdcch_t* q, uint32_t max_prb, uint32_t nof_rx_anten
 
     srsran_vec_f_zero(q->llr, q->max_bits);
 
+    q->cce_llr_abs = srsran_vec_f_malloc(q->max_bits / 72);
+    if (!q->cce_llr_abs) {
+      goto clean;
+    }
+
     q->d = srsran_vec_cf_malloc(q->max_bits / 2);
     if (!q->d) {
       goto clean;
@@ -138,6 +144,9 @@ void srsran_pdcch_free(srsran_pdcch_t* q)
   if (q->llr) {
     free(q->llr);
   }
+  if (q->cce_llr_abs) {
+    free(q->cce_llr_abs);
+  }
   if (q->d) {
     free(q->d);
   }
@@ -367,11 +376,26 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/* Looks for a candidate with the same location and size decoded since the last LLR extraction */
+static srsran_pdcch_cached_dci_t*
+pdcch_cache_find(srsran_pdcch_t* q, const srsran_dci_location_t* location, uint32_t nof_bits)
+{
+  for (uint32_t i = 0; i < q->nof_cached_dci; i++) {
+    srsran_pdcch_cached_dci_t* c = &q->dci_cache[i];
+    if (c->location.ncce == location->ncce && c->location.L == location->L && c->nof_bits == nof_bits) {
+      return c;
+    }
+  }
+  return NULL;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
  * The decoded message is stored in msg and the CRC remainder in msg->rnti
  *
+ * Candidates with the same location and size are decoded only once per subframe, the search spaces of several RNTI
+ * and formats overlap. Candidates whose average LLR magnitude is too low to carry a DCI are skipped without decoding.
  */
 int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg)
 {
@@ -385,15 +409,55 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, msg->format);
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
+      q->search_metrics.nof_candidates++;
+
+      srsran_pdcch_cached_dci_t* cached = pdcch_cache_find(q, &msg->location, nof_bits);
+      if (cached != NULL) {
+        q->search_metrics.nof_cached++;
+        if (!cached->decoded) {
+          INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, cached", msg->location.ncce, msg->location.L, nof_bits);
+          return ret;
+        }
+        memcpy(msg->payload, cached->payload, nof_bits);
+        msg->rnti     = cached->crc_rem;
+        msg->nof_bits = nof_bits;
+        if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
+          msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
+        }
+        INFO("Decoded DCI: nCCE=%d, L=%d, format=%s, msg_len=%d, cached, crc_rem=0x%x",
+             msg->location.ncce,
+             msg->location.L,
+             srsran_dci_format_string(msg->format),
+             nof_bits,
+             msg->rnti);
+        return ret;
+      }
+
+      // The LLR magnitude of every CCE is accumulated once per subframe
       double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
+      for (uint32_t i = 0; i < (1U << msg->location.L); i++) {
+        mean += q->cce_llr_abs[msg->location.ncce + i];
       }
       mean /= e_bits;
+
+      // Remember the candidate, it is marked as decoded once the decoder succeeds
+      if (q->nof_cached_dci < SRSRAN_PDCCH_MAX_CACHED_DCI) {
+        cached           = &q->dci_cache[q->nof_cached_dci++];
+        cached->location = msg->location;
+        cached->nof_bits = nof_bits;
+        cached->decoded  = false;
+      }
+
       if (mean > 0.3) {
+        q->search_metrics.nof_decodes++;
         ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
         if (ret == SRSRAN_SUCCESS) {
           msg->nof_bits = nof_bits;
+          if (cached != NULL) {
+            cached->decoded = true;
+            cached->crc_rem = msg->rnti;
+            memcpy(cached->payload, msg->payload, nof_bits);
+          }
           // Check format differentiation
           if (msg->format == SRSRAN_DCI_FORMAT0 || msg->format == SRSRAN_DCI_FORMAT1A) {
             msg->format = (msg->payload[dci_cfg->cif_enabled ? 3 : 0] == 0) ? SRSRAN_DCI_FORMAT0 : SRSRAN_DCI_FORMAT1A;
@@ -409,6 +473,7 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
              mean,
              msg->rnti);
       } else {
+        q->search_metrics.nof_pruned++;
         INFO("Skipping DCI:  nCCE=%d, L=%d, msg_len=%d, mean=%f", msg->location.ncce, msg->location.L, nof_bits, mean);
       }
     }
@@ -481,6 +546,19 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     /* descramble */
     srsran_scrambling_f_offset(&q->seq[sf->tti % 10], q->llr, 0, e_bits);
 
+    /* LLR magnitude of every CCE, used for discarding candidates before decoding them */
+    for (i = 0; i < NOF_CCE(sf->cfi); i++) {
+      float acc = 0.0f;
+      for (uint32_t k = 0; k < 72; k++) {
+        acc += fabsf(q->llr[i * 72 + k]);
+      }
+      q->cce_llr_abs[i] = acc;
+    }
+
+    /* The candidates decoded so far belong to the previous LLRs */
+    q->nof_cached_dci = 0;
+    bzero(&q->search_metrics, sizeof(srsran_pdcch_search_metrics_t));
+
     ret = SRSRAN_SUCCESS;
   }
   return ret;
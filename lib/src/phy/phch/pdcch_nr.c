@@ -27,6 +27,7 @@
 #include "srsran/phy/modem/demod_soft.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 
 #define PDCCH_NR_POLAR_RM_IBIL 0
@@ -196,8 +197,8 @@ int srsran_pdcch_nr_init_tx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
 
   srsran_polar_encoder_type_t encoder_type = SRSRAN_POLAR_ENCODER_PIPELINED;
 
-#ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX2) {
     encoder_type = SRSRAN_POLAR_ENCODER_AVX2;
   }
 #endif // LV_HAVE_AVX2
@@ -221,8 +222,8 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
 
   srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
 
-#ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX2) {
     decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
@@ -26,9 +26,6 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include <pthread.h>
-#include <semaphore.h>
-
 #include "prb_dl.h"
 #include "srsran/phy/phch/pdsch.h"
 #include "srsran/phy/utils/debug.h"
@@ -51,34 +48,25 @@ const static srsran_mod_t modulations[5] = {SRSRAN_MOD_BPSK,
                                             SRSRAN_MOD_64QAM,
                                             SRSRAN_MOD_256QAM};
 
+/* The codewords of a grant are processed in parallel, one worker besides the calling thread is enough */
+#define PDSCH_CW_POOL_NOF_WORKERS (SRSRAN_MAX_TB - 1)
+
+/* Codeword task pool: the calling thread uses the PDSCH SCH object and every worker owns another one */
 typedef struct {
-  /* Thread identifier: they must set before thread creation */
-  pthread_t pthread;
-  uint32_t  tb_idx;
-  void*     pdsch_ptr;
-  bool*     ack;
+  srsran_task_pool_t pool;
+  srsran_sch_t       dl_sch[PDSCH_CW_POOL_NOF_WORKERS];
+} pdsch_cw_pool_t;
 
-  /* Configuration Encoder/Decoder: they must be set before posting start semaphore */
+/* Codeword jobs of an encode or decode call, one task for each transport block in tb_idx */
+typedef struct {
+  srsran_pdsch_t*     q;
   srsran_dl_sf_cfg_t* sf;
   srsran_pdsch_cfg_t* cfg;
-  srsran_sch_t        dl_sch;
-
-  /* Encoder/Decoder data pointers: they must be set before posting start semaphore  */
-  srsran_pdsch_res_t* data;
-
-  /* Execution status */
-  int ret_status;
-
-  /* Semaphores */
-  sem_t start;
-  sem_t finish;
-
-  /* Thread flags */
-  bool started;
-  bool quit;
-} srsran_pdsch_coworker_t;
-
-static void* srsran_pdsch_decode_thread(void* arg);
+  srsran_pdsch_res_t* res;
+  uint8_t**           data;
+  uint32_t            tb_idx[SRSRAN_MAX_TB];
+  int                 ret[SRSRAN_MAX_TB];
+} pdsch_cw_job_t;
 
 static inline bool pdsch_cp_skip_symbol(const srsran_cell_t*        cell,
                                         const srsran_pdsch_grant_t* grant,
@@ -350,68 +338,124 @@ int srsran_pdsch_init_enb(srsran_pdsch_t* q, uint32_t max_prb)
   return pdsch_init(q, max_prb, false, 0);
 }
 
-static void srsran_pdsch_disable_coworker(srsran_pdsch_t* q)
+static void pdsch_cw_pool_free(srsran_pdsch_t* q)
 {
-  srsran_pdsch_coworker_t* h = (srsran_pdsch_coworker_t*)q->coworker_ptr;
-  if (h) {
-    /* Stop threads */
-    h->quit = true;
-    sem_post(&h->start);
+  pdsch_cw_pool_t* p = (pdsch_cw_pool_t*)q->cw_pool_ptr;
+  if (p) {
+    srsran_task_pool_free(&p->pool);
 
-    pthread_join(h->pthread, NULL);
-    pthread_detach(h->pthread);
-
-    srsran_sch_free(&h->dl_sch);
+    for (uint32_t i = 0; i < PDSCH_CW_POOL_NOF_WORKERS; i++) {
+      srsran_sch_free(&p->dl_sch[i]);
+    }
 
-    free(h);
+    free(p);
 
-    q->coworker_ptr = NULL;
+    q->cw_pool_ptr = NULL;
   }
 }
 
-int srsran_pdsch_enable_coworker(srsran_pdsch_t* q)
+int srsran_pdsch_enable_cw_pool(srsran_pdsch_t* q)
 {
   int ret = SRSRAN_SUCCESS;
 
-  if (!q->coworker_ptr) {
-    srsran_pdsch_coworker_t* h = calloc(sizeof(srsran_pdsch_coworker_t), 1);
+  if (!q->cw_pool_ptr) {
+    pdsch_cw_pool_t* p = calloc(sizeof(pdsch_cw_pool_t), 1);
 
-    if (!h) {
-      ERROR("Allocating coworker");
+    if (!p) {
+      ERROR("Allocating codeword pool");
       ret = SRSRAN_ERROR;
       goto clean;
     }
-    q->coworker_ptr = h;
+    q->cw_pool_ptr = p;
 
-    if (srsran_sch_init(&h->dl_sch)) {
-      ERROR("Initiating DL SCH");
-      ret = SRSRAN_ERROR;
-      goto clean;
+    for (uint32_t i = 0; i < PDSCH_CW_POOL_NOF_WORKERS; i++) {
+      if (srsran_sch_init(&p->dl_sch[i])) {
+        ERROR("Initiating DL SCH");
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
+      if (srsran_sch_set_decoder_threads(&p->dl_sch[i], q->nof_decoder_threads)) {
+        ERROR("Initiating DL SCH decoder threads");
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
     }
 
-    if (sem_init(&h->start, 0, 0)) {
-      ERROR("Creating semaphore");
-      ret = SRSRAN_ERROR;
-      goto clean;
-    }
-    if (sem_init(&h->finish, 0, 0)) {
-      ERROR("Creating semaphore");
+    if (srsran_task_pool_init(&p->pool, PDSCH_CW_POOL_NOF_WORKERS)) {
+      ERROR("Creating codeword pool threads");
       ret = SRSRAN_ERROR;
       goto clean;
     }
-    pthread_create(&h->pthread, NULL, srsran_pdsch_decode_thread, (void*)h);
   }
 
 clean:
   if (ret) {
-    srsran_pdsch_disable_coworker(q);
+    pdsch_cw_pool_free(q);
   }
   return ret;
 }
 
+int srsran_pdsch_set_decoder_threads(srsran_pdsch_t* q, uint32_t nof_workers)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  q->nof_decoder_threads = nof_workers;
+  if (srsran_sch_set_decoder_threads(&q->dl_sch, nof_workers)) {
+    return SRSRAN_ERROR;
+  }
+
+  // Every codeword worker decodes its code blocks with the same number of threads
+  pdsch_cw_pool_t* p = (pdsch_cw_pool_t*)q->cw_pool_ptr;
+  if (p) {
+    for (uint32_t i = 0; i < PDSCH_CW_POOL_NOF_WORKERS; i++) {
+      if (srsran_sch_set_decoder_threads(&p->dl_sch[i], nof_workers)) {
+        return SRSRAN_ERROR;
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* SCH object used by a codeword pool worker */
+static srsran_sch_t* pdsch_cw_sch(srsran_pdsch_t* q, uint32_t worker_idx)
+{
+  pdsch_cw_pool_t* p = (pdsch_cw_pool_t*)q->cw_pool_ptr;
+  if (worker_idx == 0 || p == NULL) {
+    return &q->dl_sch;
+  }
+  return &p->dl_sch[worker_idx - 1];
+}
+
+/* Runs the codeword jobs in the pool if it is enabled, in the calling thread otherwise */
+static void pdsch_cw_run(srsran_pdsch_t* q, pdsch_cw_job_t* job, uint32_t nof_tb, srsran_task_pool_fn_t fn)
+{
+  pdsch_cw_pool_t* p = (pdsch_cw_pool_t*)q->cw_pool_ptr;
+  if (p == NULL) {
+    for (uint32_t i = 0; i < nof_tb; i++) {
+      fn(job, i, 0);
+    }
+    return;
+  }
+
+  // The workers decode with the same settings as the PDSCH SCH object
+  for (uint32_t i = 0; i < PDSCH_CW_POOL_NOF_WORKERS; i++) {
+    srsran_sch_t* sch   = &p->dl_sch[i];
+    sch->max_iterations = q->dl_sch.max_iterations;
+    sch->llr_is_8bit    = q->dl_sch.llr_is_8bit;
+    if (sch->early_stop != q->dl_sch.early_stop || sch->early_stop_llr_th != q->dl_sch.early_stop_llr_th) {
+      srsran_sch_set_early_stop(sch, q->dl_sch.early_stop, q->dl_sch.early_stop_llr_th);
+    }
+  }
+
+  srsran_task_pool_run(&p->pool, nof_tb, fn, job);
+}
+
 void srsran_pdsch_free(srsran_pdsch_t* q)
 {
-  srsran_pdsch_disable_coworker(q);
+  pdsch_cw_pool_free(q);
 
   for (int i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
     if (q->e[i]) {
@@ -653,7 +697,7 @@ static void pdsch_decode_debug(srsran_pdsch_t*     q,
         ERROR("Generating file name");
         break;
       }
-      DEBUG("SAVED FILE %s: LLR estimates after demodulation and descrambling", filename);
+      DEBUG("SAVED FILE %s: LLR estimates after demodulation, before descrambling", filename);
       srsran_vec_save_file(filename, q->e[i], cfg->grant.tb[0].nof_bits * sizeof(int16_t));
     }
   }
@@ -713,31 +757,17 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
       data[tb_idx].evm = NAN;
     }
 
-    /* Bit scrambling */
-    if (q->llr_is_8bit) {
-      srsran_sequence_pdsch_apply_c(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
-    } else {
-      srsran_sequence_pdsch_apply_s(q->e[codeword_idx],
-                                    q->e[codeword_idx],
-                                    cfg->rnti,
-                                    codeword_idx,
-                                    2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME),
-                                    q->cell.id,
-                                    cfg->grant.tb[tb_idx].nof_bits);
-    }
-
     if (cfg->csi_enable) {
       csi_correction(q, cfg, codeword_idx, tb_idx, q->e[codeword_idx]);
     }
 
+    /* Bit scrambling is removed by the rate dematching, it saves a pass over the codeword */
+    srsran_sequence_state_t seq = {};
+    srsran_sequence_pdsch_state_init(&seq, cfg->rnti, codeword_idx, 2 * (sf->tti % SRSRAN_NOF_SF_X_FRAME), q->cell.id);
+
     /* Return  */
-    ret = srsran_dlsch_decode2(dl_sch, cfg, q->e[codeword_idx], data[tb_idx].payload, tb_idx, nof_layers);
+    ret = srsran_dlsch_decode2_descramble(
+        dl_sch, cfg, q->e[codeword_idx], data[tb_idx].payload, tb_idx, nof_layers, &seq);
 
     if (ret == SRSRAN_SUCCESS) {
       *ack = true;
@@ -761,26 +791,16 @@ static int srsran_pdsch_codeword_decode(srsran_pdsch_t*     q,
   return ret;
 }
 
-static void* srsran_pdsch_decode_thread(void* arg)
+static void pdsch_cw_decode_task(void* arg, uint32_t task_idx, uint32_t worker_idx)
 {
-  srsran_pdsch_coworker_t* q = (srsran_pdsch_coworker_t*)arg;
-
-  INFO("[PDSCH Coworker] waiting for data");
-
-  sem_wait(&q->start);
-  while (!q->quit) {
-    q->ret_status = srsran_pdsch_codeword_decode(q->pdsch_ptr, q->sf, q->cfg, &q->dl_sch, q->data, q->tb_idx, q->ack);
+  pdsch_cw_job_t* job    = (pdsch_cw_job_t*)arg;
+  uint32_t        tb_idx = job->tb_idx[task_idx];
+  srsran_sch_t*   dl_sch = pdsch_cw_sch(job->q, worker_idx);
 
-    /* Post finish semaphore */
-    sem_post(&q->finish);
+  job->ret[task_idx] =
+      srsran_pdsch_codeword_decode(job->q, job->sf, job->cfg, dl_sch, job->res, tb_idx, &job->res[tb_idx].crc);
 
-    /* Wait for next loop */
-    sem_wait(&q->start);
-  }
-  sem_post(&q->finish);
-
-  pthread_exit(NULL);
-  return q;
+  job->res[tb_idx].avg_iterations_block = srsran_sch_last_noi(dl_sch);
 }
 
 /** Decodes the PDSCH from the received symbols
@@ -887,50 +907,20 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
     }
 
     /* Codeword decoding: Implementation of 3GPP 36.212 Table 5.3.3.1.5-1 and Table 5.3.3.1.5-2 */
+    pdsch_cw_job_t job         = {.q = q, .sf = sf, .cfg = cfg, .res = data};
+    uint32_t       nof_cw_jobs = 0;
     for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
       /* Decode only if transport block is enabled and the default ACK is not true */
-      if (cfg->grant.tb[tb_idx].enabled) {
-        if (!data[tb_idx].crc) {
-          int ret = SRSRAN_SUCCESS;
-          if (cfg->grant.nof_tb > 1 && tb_idx == 0 && q->coworker_ptr) {
-            srsran_pdsch_coworker_t* h = (srsran_pdsch_coworker_t*)q->coworker_ptr;
-
-            h->pdsch_ptr             = q;
-            h->cfg                   = cfg;
-            h->sf                    = sf;
-            h->data                  = &data[tb_idx];
-            h->tb_idx                = tb_idx;
-            h->ack                   = &data[tb_idx].crc;
-            h->dl_sch.max_iterations = q->dl_sch.max_iterations;
-            h->started               = true;
-            sem_post(&h->start);
-
-          } else {
-            ret = srsran_pdsch_codeword_decode(q, sf, cfg, &q->dl_sch, data, tb_idx, &data[tb_idx].crc);
-
-            data[tb_idx].avg_iterations_block = srsran_sch_last_noi(&q->dl_sch);
-          }
-
-          /* Check if there has been any execution error */
-          if (ret) {
-            /* Do Nothing */
-          }
-        }
+      if (cfg->grant.tb[tb_idx].enabled && !data[tb_idx].crc) {
+        job.tb_idx[nof_cw_jobs++] = tb_idx;
       }
     }
 
-    if (q->coworker_ptr) {
-      srsran_pdsch_coworker_t* h = (srsran_pdsch_coworker_t*)q->coworker_ptr;
-      if (h->started) {
-        int err = sem_wait(&h->finish);
-        if (err) {
-          printf("SCH coworker: %s (nof_tb=%d)\n", strerror(errno), cfg->grant.nof_tb);
-        }
-        if (h->ret_status) {
-          ERROR("PDSCH Coworker Decoder: Error decoding");
-        }
-        data[h->tb_idx].avg_iterations_block = srsran_sch_last_noi(&q->dl_sch);
-        h->started                           = false;
+    pdsch_cw_run(q, &job, nof_cw_jobs, pdsch_cw_decode_task);
+
+    for (uint32_t i = 0; i < nof_cw_jobs; i++) {
+      if (job.ret[i]) {
+        ERROR("PDSCH: Error decoding TB%d", job.tb_idx[i]);
       }
     }
 
@@ -960,6 +950,7 @@ int srsran_pdsch_decode(srsran_pdsch_t*        q,
 static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
                                         srsran_dl_sf_cfg_t*     sf,
                                         srsran_pdsch_cfg_t*     cfg,
+                                        srsran_sch_t*           dl_sch,
                                         srsran_softbuffer_tx_t* softbuffer,
                                         uint8_t*                data,
                                         uint32_t                tb_idx,
@@ -989,7 +980,7 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
     }
 
     /* Channel coding */
-    if (srsran_dlsch_encode2(&q->dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers)) {
+    if (srsran_dlsch_encode2(dl_sch, cfg, data, q->e[codeword_idx], tb_idx, nof_layers)) {
       ERROR("Error encoding (TB%d -> CW%d)", tb_idx, codeword_idx);
       return SRSRAN_ERROR;
     }
@@ -1014,6 +1005,22 @@ static int srsran_pdsch_codeword_encode(srsran_pdsch_t*         q,
   return SRSRAN_SUCCESS;
 }
 
+static void pdsch_cw_encode_task(void* arg, uint32_t task_idx, uint32_t worker_idx)
+{
+  pdsch_cw_job_t*     job    = (pdsch_cw_job_t*)arg;
+  uint32_t            tb_idx = job->tb_idx[task_idx];
+  srsran_pdsch_cfg_t* cfg    = job->cfg;
+
+  job->ret[task_idx] = srsran_pdsch_codeword_encode(job->q,
+                                                    job->sf,
+                                                    cfg,
+                                                    pdsch_cw_sch(job->q, worker_idx),
+                                                    cfg->softbuffers.tx[tb_idx],
+                                                    job->data[tb_idx],
+                                                    tb_idx,
+                                                    cfg->grant.nof_layers);
+}
+
 int srsran_pdsch_encode(srsran_pdsch_t*     q,
                         srsran_dl_sf_cfg_t* sf,
                         srsran_pdsch_cfg_t* cfg,
@@ -1057,13 +1064,20 @@ int srsran_pdsch_encode(srsran_pdsch_t*     q,
     float rho_a = apply_power_allocation(q, cfg, sf_symbols);
 
     /* Implementation of 3GPP 36.212 Table 5.3.3.1.5-1 and Table 5.3.3.1.5-2 */
+    pdsch_cw_job_t job         = {.q = q, .sf = sf, .cfg = cfg, .data = data};
+    uint32_t       nof_cw_jobs = 0;
     for (uint32_t tb_idx = 0; tb_idx < SRSRAN_MAX_TB; tb_idx++) {
       if (cfg->grant.tb[tb_idx].enabled) {
-        ret |= srsran_pdsch_codeword_encode(
-            q, sf, cfg, cfg->softbuffers.tx[tb_idx], data[tb_idx], tb_idx, cfg->grant.nof_layers);
+        job.tb_idx[nof_cw_jobs++] = tb_idx;
       }
     }
 
+    pdsch_cw_run(q, &job, nof_cw_jobs, pdsch_cw_encode_task);
+
+    for (uint32_t i = 0; i < nof_cw_jobs; i++) {
+      ret |= job.ret[i];
+    }
+
     /* Set scaling configured by Power Allocation */
     float scaling = 1.0f;
     if (rho_a != 0.0f) {
@@ -360,14 +360,15 @@ int srsran_pmch_decode(srsran_pmch_t*         q,
       srsran_vec_save_file("pmch_symbols.bin", q->d, cfg->pdsch_cfg.grant.nof_re * sizeof(cf_t));
     }
 
-    /* demodulate symbols
+    /* demodulate and descramble symbols
      * The MAX-log-MAP algorithm used in turbo decoding is unsensitive to SNR estimation,
      * thus we don't need tot set it in thde LLRs normalization
      */
-    srsran_demod_soft_demodulate_s(cfg->pdsch_cfg.grant.tb[0].mod, q->d, q->e, cfg->pdsch_cfg.grant.nof_re);
-
-    /* descramble */
-    srsran_scrambling_s_offset(&q->seqs[cfg->area_id]->seq[sf->tti % 10], q->e, 0, cfg->pdsch_cfg.grant.tb[0].nof_bits);
+    srsran_demod_soft_demodulate_s_descramble(cfg->pdsch_cfg.grant.tb[0].mod,
+                                              q->d,
+                                              q->e,
+                                              cfg->pdsch_cfg.grant.nof_re,
+                                              q->seqs[cfg->area_id]->seq[sf->tti % 10].c_short);
 
     if (SRSRAN_VERBOSE_ISDEBUG()) {
       DEBUG("SAVED FILE llr.dat: LLR estimates after demodulation and descrambling");
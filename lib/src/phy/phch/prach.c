@@ -768,20 +768,16 @@ void srsran_prach_calculate_correction_array(srsran_prach_t* p, cf_t* corr_freq)
   }
 }
 
-// This function carries out the main processing on the incomming PRACH signal
-int srsran_prach_process(srsran_prach_t* p,
-                         cf_t*           signal,
-                         uint32_t*       indices,
-                         float*          t_offsets,
-                         float*          peak_to_avg,
-                         uint32_t*       n_indices,
-                         int             cancellation_idx,
-                         uint32_t        begin,
-                         uint32_t        sig_len)
+// Carries out the main processing on the incoming PRACH bins, the correlations are transformed with zc_ifft
+static int prach_process(srsran_prach_t*    p,
+                         srsran_dft_plan_t* zc_ifft,
+                         uint32_t*          indices,
+                         float*             t_offsets,
+                         float*             peak_to_avg,
+                         uint32_t*          n_indices)
 {
-  float max_to_cancel = 0;
-  cancellation_idx    = -1;
-  int max_idx         = 0;
+  float max_to_cancel    = 0;
+  int   cancellation_idx = -1;
   srsran_vec_cf_zero(p->cross, p->N_zc);
   srsran_vec_cf_zero(p->corr_freq, p->N_zc);
   for (int i = 0; i < p->num_ra_preambles; i++) {
@@ -789,11 +785,14 @@ int srsran_prach_process(srsran_prach_t* p,
 
     srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
+    // The cross correlation is only used by the frequency domain time offset estimation
+    if (p->freq_domain_offset_calc) {
+      srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
+    }
     if (p->successive_cancellation) {
       srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
     }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+    srsran_dft_run(zc_ifft, p->corr_spec, p->corr_spec);
 
     srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
 
@@ -815,16 +814,13 @@ int srsran_prach_process(srsran_prach_t* p,
         end -= p->deadzone;
       }
       start += p->deadzone;
-      p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
-        }
+
+      // Vectorized search of the window peak
+      uint32_t k         = srsran_vec_max_fi(&p->corr[start], end - start);
+      p->peak_values[j]  = p->corr[start + k];
+      p->peak_offsets[j] = k;
+      if (p->peak_values[j] > max_peak) {
+        max_peak = p->peak_values[j];
       }
     }
     if (max_peak > (p->detect_factor * corr_ave)) {
@@ -868,6 +864,63 @@ int srsran_prach_process(srsran_prach_t* p,
   return 0;
 }
 
+// This function carries out the main processing on the PRACH bins extracted from the incoming signal
+int srsran_prach_process(srsran_prach_t* p,
+                         cf_t*           signal,
+                         uint32_t*       indices,
+                         float*          t_offsets,
+                         float*          peak_to_avg,
+                         uint32_t*       n_indices,
+                         int             cancellation_idx,
+                         uint32_t        begin,
+                         uint32_t        sig_len)
+{
+  return prach_process(p, &p->zc_ifft, indices, t_offsets, peak_to_avg, n_indices);
+}
+
+// Transforms the received signal and extracts the PRACH bins
+static int prach_extract_bins(srsran_prach_t* p, uint32_t freq_offset, cf_t* signal, uint32_t sig_len)
+{
+  if (sig_len < p->N_ifft_prach) {
+    ERROR("srsran_prach_detect: Signal length is %d and should be %d", sig_len, p->N_ifft_prach);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  bzero(&p->prach_cancel, sizeof(srsran_prach_cancellation_t));
+
+  // FFT incoming signal
+  srsran_dft_run(&p->fft, signal, p->signal_fft);
+
+  // Extract bins of interest
+  uint32_t N_rb_ul = srsran_nof_prb(p->N_ifft_ul);
+  uint32_t k_0     = freq_offset * N_RB_SC - N_rb_ul * N_RB_SC / 2 + p->N_ifft_ul / 2;
+  uint32_t K       = DELTA_F / DELTA_F_RA;
+  uint32_t begin   = PHI + (K * k_0) + (K / 2);
+
+  memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
+
+  return SRSRAN_SUCCESS;
+}
+
+// Searches the preambles in the extracted bins, several times if successive cancellation is enabled
+static void prach_search(srsran_prach_t*    p,
+                         srsran_dft_plan_t* zc_ifft,
+                         uint32_t*          indices,
+                         float*             t_offsets,
+                         float*             peak_to_avg,
+                         uint32_t*          n_indices)
+{
+  *n_indices = 0;
+
+  // if successive cancellation is enabled, we perform the entire search process p->num_ra_preambles times, removing
+  // the highest power PRACH preamble each time.
+  int loops = (p->successive_cancellation) ? SUCCESSIVE_CANCELLATION_ITS : 1;
+  for (int l = 0; l < loops; l++) {
+    if (prach_process(p, zc_ifft, indices, t_offsets, peak_to_avg, n_indices)) {
+      break;
+    }
+  }
+}
+
 int srsran_prach_detect_offset(srsran_prach_t* p,
                                uint32_t        freq_offset,
                                cf_t*           signal,
@@ -877,40 +930,55 @@ int srsran_prach_detect_offset(srsran_prach_t* p,
                                float*          peak_to_avg,
                                uint32_t*       n_indices)
 {
-  int ret = SRSRAN_ERROR;
-  if (p != NULL && signal != NULL && sig_len > 0 && indices != NULL) {
-    if (sig_len < p->N_ifft_prach) {
-      ERROR("srsran_prach_detect: Signal length is %d and should be %d", sig_len, p->N_ifft_prach);
+  if (p == NULL || signal == NULL || sig_len == 0 || indices == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  int ret = prach_extract_bins(p, freq_offset, signal, sig_len);
+  if (ret < SRSRAN_SUCCESS) {
+    return ret;
+  }
+
+  prach_search(p, &p->zc_ifft, indices, t_offsets, peak_to_avg, n_indices);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_prach_detect_batch(srsran_prach_detect_req_t* reqs, uint32_t nof_reqs)
+{
+  if (reqs == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Transform every carrier first, so the correlations of all of them run back to back
+  for (uint32_t r = 0; r < nof_reqs; r++) {
+    srsran_prach_detect_req_t* req = &reqs[r];
+    if (req->p == NULL || req->signal == NULL || req->indices == NULL || req->n_indices == NULL) {
       return SRSRAN_ERROR_INVALID_INPUTS;
     }
-    int cancellation_idx = -2;
-    bzero(&p->prach_cancel, sizeof(srsran_prach_cancellation_t));
+    *req->n_indices = 0;
 
-    // FFT incoming signal
-    srsran_dft_run(&p->fft, signal, p->signal_fft);
-
-    *n_indices = 0;
+    int ret = prach_extract_bins(req->p, req->freq_offset, req->signal, req->sig_len);
+    if (ret < SRSRAN_SUCCESS) {
+      return ret;
+    }
+  }
 
-    // Extract bins of interest
-    uint32_t N_rb_ul = srsran_nof_prb(p->N_ifft_ul);
-    uint32_t k_0     = freq_offset * N_RB_SC - N_rb_ul * N_RB_SC / 2 + p->N_ifft_ul / 2;
-    uint32_t K       = DELTA_F / DELTA_F_RA;
-    uint32_t begin   = PHI + (K * k_0) + (K / 2);
-
-    memcpy(p->prach_bins, &p->signal_fft[begin], p->N_zc * sizeof(cf_t));
-    int loops = (p->successive_cancellation) ? SUCCESSIVE_CANCELLATION_ITS : 1;
-    // if successive cancellation is enabled, we perform the entire search process p->num_ra_preambles times, removing
-    // the highest power PRACH preamble each time.
-    for (int l = 0; l < loops; l++) {
-      if (srsran_prach_process(
-              p, signal, indices, t_offsets, peak_to_avg, n_indices, cancellation_idx, begin, sig_len)) {
+  // The correlations of the carriers with the same sequence length share the ZC IFFT plan of the first of them
+  for (uint32_t r = 0; r < nof_reqs; r++) {
+    srsran_prach_detect_req_t* req     = &reqs[r];
+    srsran_dft_plan_t*         zc_ifft = &req->p->zc_ifft;
+    for (uint32_t i = 0; i < r; i++) {
+      if (reqs[i].p->zc_ifft.size == req->p->zc_ifft.size) {
+        zc_ifft = &reqs[i].p->zc_ifft;
         break;
       }
     }
 
-    ret = SRSRAN_SUCCESS;
+    prach_search(req->p, zc_ifft, req->indices, req->t_offsets, req->peak_to_avg, req->n_indices);
   }
-  return ret;
+
+  return SRSRAN_SUCCESS;
 }
 
 int srsran_prach_free(srsran_prach_t* p)
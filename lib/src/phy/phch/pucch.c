@@ -58,7 +58,7 @@ int srsran_pucch_init_(srsran_pucch_t* q, bool is_ue)
 
     q->is_ue = is_ue;
 
-    if (srsran_sequence_init(&q->seq_f2, 20)) {
+    if (srsran_sequence_cache_init(&q->seq_cache, SRSRAN_PUCCH_SEQ_CACHE_LEN, SRSRAN_PUCCH3_NOF_BITS)) {
       goto clean_exit;
     }
 
@@ -92,7 +92,7 @@ int srsran_pucch_init_enb(srsran_pucch_t* q)
 
 void srsran_pucch_free(srsran_pucch_t* q)
 {
-  srsran_sequence_free(&q->seq_f2);
+  srsran_sequence_cache_free(&q->seq_cache);
 
   srsran_uci_cqi_pucch_free(&q->cqi);
   if (q->z) {
@@ -158,11 +158,29 @@ static cf_t uci_encode_format1b(uint8_t bits[2])
   }
 }
 
+// Format 2/3 scrambling with a packed sequence from the cache, at most SRSRAN_PUCCH3_NOF_BITS long
+static void pucch_scrambling_b(const uint8_t* seq, uint8_t* bits, uint32_t len)
+{
+  uint8_t c[SRSRAN_PUCCH3_NOF_BITS];
+  srsran_bit_unpack_vector(seq, c, len);
+  srsran_vec_xor_bbb(c, bits, bits, len);
+}
+
+static void pucch_scrambling_s(const uint8_t* seq, int16_t* llr, uint32_t len)
+{
+  uint8_t c[SRSRAN_PUCCH3_NOF_BITS];
+  srsran_bit_unpack_vector(seq, c, len);
+  for (uint32_t i = 0; i < len; i++) {
+    llr[i] = c[i] ? -llr[i] : llr[i];
+  }
+}
+
 /* Encode PUCCH bits according to Table 5.4.1-1 in Section 5.4.1 of 36.211 */
 static int
 uci_mod_bits(srsran_pucch_t* q, srsran_ul_sf_cfg_t* sf, srsran_pucch_cfg_t* cfg, uint8_t bits[SRSRAN_PUCCH_MAX_BITS])
 {
-  uint8_t tmp[2];
+  uint8_t        tmp[2];
+  const uint8_t* seq = NULL;
   switch (cfg->format) {
     case SRSRAN_PUCCH_FORMAT_1:
       q->d[0] = uci_encode_format1();
@@ -178,21 +196,23 @@ uci_mod_bits(srsran_pucch_t* q, srsran_ul_sf_cfg_t* sf, srsran_pucch_cfg_t* cfg,
     case SRSRAN_PUCCH_FORMAT_2:
     case SRSRAN_PUCCH_FORMAT_2A:
     case SRSRAN_PUCCH_FORMAT_2B:
-      if (srsran_sequence_pucch(&q->seq_f2, cfg->rnti, 2 * (sf->tti % 10), q->cell.id)) {
+      seq = srsran_sequence_pucch_cache(&q->seq_cache, cfg->rnti, 2 * (sf->tti % 10), q->cell.id);
+      if (seq == NULL) {
         ERROR("Error computing PUCCH Format 2 scrambling sequence\n");
         return SRSRAN_ERROR;
       }
       srsran_vec_u8_copy(q->bits_scram, bits, SRSRAN_PUCCH2_NOF_BITS);
-      srsran_scrambling_b_offset(&q->seq_f2, q->bits_scram, 0, SRSRAN_PUCCH2_NOF_BITS);
+      pucch_scrambling_b(seq, q->bits_scram, SRSRAN_PUCCH2_NOF_BITS);
       srsran_mod_modulate(&q->mod, q->bits_scram, q->d, SRSRAN_PUCCH2_NOF_BITS);
       break;
     case SRSRAN_PUCCH_FORMAT_3:
-      if (srsran_sequence_pucch(&q->seq_f2, cfg->rnti, 2 * (sf->tti % 10), q->cell.id)) {
+      seq = srsran_sequence_pucch_cache(&q->seq_cache, cfg->rnti, 2 * (sf->tti % 10), q->cell.id);
+      if (seq == NULL) {
         ERROR("Error computing PUCCH Format 2 scrambling sequence\n");
         return SRSRAN_ERROR;
       }
       srsran_vec_u8_copy(q->bits_scram, bits, SRSRAN_PUCCH3_NOF_BITS);
-      srsran_scrambling_b_offset(&q->seq_f2, q->bits_scram, 0, SRSRAN_PUCCH3_NOF_BITS);
+      pucch_scrambling_b(seq, q->bits_scram, SRSRAN_PUCCH3_NOF_BITS);
       srsran_mod_modulate(&q->mod, q->bits_scram, q->d, SRSRAN_PUCCH3_NOF_BITS);
       break;
     default:
@@ -557,11 +577,12 @@ static int decode_signal_format3(srsran_pucch_t*     q,
 
   srsran_demod_soft_demodulate_s(SRSRAN_MOD_QPSK, q->d, q->llr, SRSRAN_PUCCH3_NOF_BITS);
 
-  if (srsran_sequence_pucch(&q->seq_f2, cfg->rnti, 2 * (sf->tti % 10), q->cell.id)) {
+  const uint8_t* seq = srsran_sequence_pucch_cache(&q->seq_cache, cfg->rnti, 2 * (sf->tti % 10), q->cell.id);
+  if (seq == NULL) {
     ERROR("Error computing PUCCH Format 2 scrambling sequence\n");
     return SRSRAN_ERROR;
   }
-  srsran_scrambling_s_offset(&q->seq_f2, q->llr, 0, SRSRAN_PUCCH3_NOF_BITS);
+  pucch_scrambling_s(seq, q->llr, SRSRAN_PUCCH3_NOF_BITS);
 
   return (int)srsran_block_decode_i16(q->llr, SRSRAN_PUCCH3_NOF_BITS, bits, SRSRAN_UCI_MAX_ACK_SR_BITS);
 }
@@ -635,7 +656,8 @@ static bool decode_signal(srsran_pucch_t*     q,
   float   corr = 0, corr_max = -1e9;
   uint8_t b_max = 0, b2_max = 0; // default bit value, eg. HI is NACK
 
-  cf_t ref[SRSRAN_PUCCH_MAX_SYMBOLS];
+  cf_t           ref[SRSRAN_PUCCH_MAX_SYMBOLS];
+  const uint8_t* seq = NULL;
 
   switch (cfg->format) {
     case SRSRAN_PUCCH_FORMAT_1:
@@ -690,7 +712,8 @@ static bool decode_signal(srsran_pucch_t*     q,
     case SRSRAN_PUCCH_FORMAT_2:
     case SRSRAN_PUCCH_FORMAT_2A:
     case SRSRAN_PUCCH_FORMAT_2B:
-      if (srsran_sequence_pucch(&q->seq_f2, cfg->rnti, 2 * (sf->tti % 10), q->cell.id)) {
+      seq = srsran_sequence_pucch_cache(&q->seq_cache, cfg->rnti, 2 * (sf->tti % 10), q->cell.id);
+      if (seq == NULL) {
         ERROR("Error computing PUCCH Format 2 scrambling sequence\n");
         return SRSRAN_ERROR;
       }
@@ -700,7 +723,7 @@ static bool decode_signal(srsran_pucch_t*     q,
         q->z[i] = srsran_vec_acc_cc(&q->z_tmp[i * SRSRAN_NRE], SRSRAN_NRE) / SRSRAN_NRE;
       }
       srsran_demod_soft_demodulate_s(SRSRAN_MOD_QPSK, q->z, llr_pucch2, SRSRAN_PUCCH2_NOF_BITS / 2);
-      srsran_scrambling_s_offset(&q->seq_f2, llr_pucch2, 0, SRSRAN_PUCCH2_NOF_BITS);
+      pucch_scrambling_s(seq, llr_pucch2, SRSRAN_PUCCH2_NOF_BITS);
 
       // Calculate the LLR RMS for normalising
       float llr_pow = srsran_vec_avg_power_sf(llr_pucch2, SRSRAN_PUCCH2_NOF_BITS);
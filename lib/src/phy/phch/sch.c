@@ -25,6 +25,8 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <math.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -197,8 +199,11 @@ clean:
   return ret;
 }
 
+static void sch_decoder_pool_free(srsran_sch_t* q);
+
 void srsran_sch_free(srsran_sch_t* q)
 {
+  sch_decoder_pool_free(q);
   srsran_rm_turbo_free_tables();
 
   if (q->cb_in) {
@@ -367,107 +372,428 @@ static int encode_tb(srsran_sch_t*           q,
   return encode_tb_off(q, soft_buffer, cb_segm, Qm, rv, nof_e_bits, data, e_bits, 0);
 }
 
-bool decode_tb_cb(srsran_sch_t*           q,
-                  srsran_softbuffer_rx_t* softbuffer,
-                  srsran_cbsegm_t*        cb_segm,
-                  uint32_t                Qm,
-                  uint32_t                rv,
-                  uint32_t                nof_e_bits,
-                  void*                   e_bits,
-                  uint8_t*                data)
+/* Computes the number of rate-matched bits of the code block cb_idx and its position rp in the codeword */
+static uint32_t cb_e_bits(srsran_cbsegm_t* cb_segm, uint32_t Qm, uint32_t nof_e_bits, uint32_t cb_idx, uint32_t* rp)
+{
+  uint32_t Gp    = nof_e_bits / Qm;
+  uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
+  uint32_t n_e   = Qm * (Gp / cb_segm->C);
+
+  *rp           = cb_idx * n_e;
+  uint32_t n_e2 = n_e;
+
+  if (cb_idx > cb_segm->C - gamma) {
+    n_e2 = n_e + Qm;
+    *rp  = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
+  }
+
+  return n_e2;
+}
+
+/* Rate-dematches and decodes a single code block. The decoded code block is written in cb_out, which must fit the whole
+ * code block including its CRC. If decode is false, the code block is only soft-combined into the soft-buffer. If
+ * cb_seq is given, the code block is descrambled with the sequence starting at that state while rate-dematching.
+ * Returns the number of turbo decoder iterations or SRSRAN_ERROR if the rate-dematching fails.
+ */
+static int decode_cb(srsran_sch_t*                  q,
+                     srsran_tdec_t*                 decoder,
+                     srsran_crc_t*                  crc_ptr,
+                     srsran_softbuffer_rx_t*        softbuffer,
+                     srsran_cbsegm_t*               cb_segm,
+                     uint32_t                       Qm,
+                     uint32_t                       rv,
+                     uint32_t                       nof_e_bits,
+                     void*                          e_bits,
+                     const srsran_sequence_state_t* cb_seq,
+                     uint32_t                       cb_idx,
+                     uint8_t*                       cb_out,
+                     bool                           decode)
 {
   int8_t*  e_bits_b = e_bits;
   int16_t* e_bits_s = e_bits;
 
-  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
-    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
-    return false;
+  uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+
+  uint32_t rlen = cb_segm->C == 1 ? cb_len : (cb_len - 24);
+  uint32_t rp   = 0;
+  uint32_t n_e2 = cb_e_bits(cb_segm, Qm, nof_e_bits, cb_idx, &rp);
+
+  // The scrambling sequence, if any, is removed while rate dematching
+  int ret = SRSRAN_SUCCESS;
+  if (cb_seq != NULL) {
+    srsran_sequence_state_t seq = *cb_seq;
+    if (q->llr_is_8bit) {
+      ret = srsran_rm_turbo_rx_lut_descramble_8bit(
+          &e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv, &seq);
+    } else {
+      ret = srsran_rm_turbo_rx_lut_descramble(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv, &seq);
+    }
+  } else if (q->llr_is_8bit) {
+    ret = srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv);
+  } else {
+    ret = srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv);
+  }
+  if (ret) {
+    ERROR("Error in rate matching");
+    return SRSRAN_ERROR;
   }
 
-  q->avg_iterations = 0;
+  if (!decode) {
+    INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, soft-combined only", cb_idx, rp, n_e2, cb_len);
+    return 0;
+  }
 
-  for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
-    /* Do not process blocks with CRC Ok */
-    if (softbuffer->cb_crc[cb_idx] == false) {
-      uint32_t cb_len     = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
-      uint32_t cb_len_idx = cb_idx < cb_segm->C1 ? cb_segm->K1_idx : cb_segm->K2_idx;
+  srsran_tdec_new_cb(decoder, cb_len);
 
-      uint32_t rlen  = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      uint32_t Gp    = nof_e_bits / Qm;
-      uint32_t gamma = cb_segm->C > 0 ? Gp % cb_segm->C : Gp;
-      uint32_t n_e   = Qm * (Gp / cb_segm->C);
+  // Run iterations and use CRC for early stopping
+  bool     early_stop = false;
+  uint32_t cb_noi     = 0;
+  uint32_t len_crc    = cb_segm->C > 1 ? cb_len : cb_segm->tbs + 24;
+  do {
+    if (q->llr_is_8bit) {
+      srsran_tdec_iteration_8bit(decoder, (int8_t*)softbuffer->buffer_f[cb_idx], cb_out);
+    } else {
+      srsran_tdec_iteration(decoder, softbuffer->buffer_f[cb_idx], cb_out);
+    }
+    cb_noi++;
 
-      uint32_t rp   = cb_idx * n_e;
-      uint32_t n_e2 = n_e;
+    // CRC is OK
+    if (!srsran_crc_checksum_byte(crc_ptr, cb_out, len_crc)) {
+      softbuffer->cb_crc[cb_idx] = true;
+      early_stop                 = true;
 
-      if (cb_idx > cb_segm->C - gamma) {
-        n_e2 = n_e + Qm;
-        rp   = (cb_segm->C - gamma) * n_e + (cb_idx - (cb_segm->C - gamma)) * n_e2;
-      }
+      // CRC is error and exceeded maximum iterations for this CB.
+      // Early stop the whole transport block.
+    } else if (srsran_tdec_early_stop(decoder, cb_out)) {
+      // The decoder will not converge to a different code word, do not waste more iterations
+      break;
+    }
 
-      if (q->llr_is_8bit) {
-        if (srsran_rm_turbo_rx_lut_8bit(&e_bits_b[rp], (int8_t*)softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
-      } else {
-        if (srsran_rm_turbo_rx_lut(&e_bits_s[rp], softbuffer->buffer_f[cb_idx], n_e2, cb_len_idx, rv)) {
-          ERROR("Error in rate matching");
-          return SRSRAN_ERROR;
-        }
+  } while (cb_noi < q->max_iterations && !early_stop);
+
+  INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
+       cb_idx,
+       rp,
+       n_e2,
+       cb_len,
+       early_stop ? "OK" : "KO",
+       rlen,
+       cb_noi,
+       q->max_iterations);
+
+  return (int)cb_noi;
+}
+
+/* Decoder context, one for each task pool worker. The context 0 belongs to the thread calling the decoder and uses
+ * the SCH object turbo decoder, the rest of contexts own their turbo decoder.
+ */
+typedef struct {
+  srsran_tdec_t* decoder;
+  srsran_tdec_t  decoder_mem;
+  srsran_crc_t   crc_cb;
+  uint8_t*       cb_out;
+  uint32_t       nof_iterations;
+  int            ret_status;
+} sch_decoder_ctx_t;
+
+typedef struct {
+  srsran_sch_t*      q;
+  srsran_task_pool_t pool;
+  sch_decoder_ctx_t* ctx;
+  uint32_t           nof_ctx;
+
+  /* Transport block parameters: they must be set before running the pool */
+  srsran_softbuffer_rx_t*        softbuffer;
+  srsran_cbsegm_t*               cb_segm;
+  uint32_t                       Qm;
+  uint32_t                       rv;
+  uint32_t                       nof_e_bits;
+  void*                          e_bits;
+  const srsran_sequence_state_t* cb_seq;
+  uint8_t*                       data;
+
+  /* Set by the first code block failing its CRC, protected by the mutex */
+  pthread_mutex_t mutex;
+  bool            tb_failed;
+} sch_decoder_pool_t;
+
+/* Task pool job: decodes the code block cb_idx with the context of the worker running it */
+static void sch_decoder_pool_task(void* arg, uint32_t cb_idx, uint32_t worker_idx)
+{
+  sch_decoder_pool_t*     pool       = (sch_decoder_pool_t*)arg;
+  sch_decoder_ctx_t*      ctx        = &pool->ctx[worker_idx];
+  srsran_softbuffer_rx_t* softbuffer = pool->softbuffer;
+  srsran_cbsegm_t*        cb_segm    = pool->cb_segm;
+
+  uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
+  uint32_t rlen   = cb_len - 24;
+
+  if (softbuffer->cb_crc[cb_idx]) {
+    // Copy decoded data from previous transmissions
+    memcpy(&pool->data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+    return;
+  }
+
+  pthread_mutex_lock(&pool->mutex);
+  bool decode = !pool->tb_failed;
+  pthread_mutex_unlock(&pool->mutex);
+
+  // Decode in a private buffer, the code block CRC would overwrite the beginning of the next code block
+  int n = decode_cb(pool->q,
+                    ctx->decoder,
+                    &ctx->crc_cb,
+                    softbuffer,
+                    cb_segm,
+                    pool->Qm,
+                    pool->rv,
+                    pool->nof_e_bits,
+                    pool->e_bits,
+                    pool->cb_seq ? &pool->cb_seq[cb_idx] : NULL,
+                    cb_idx,
+                    ctx->cb_out,
+                    decode);
+  if (n < SRSRAN_SUCCESS) {
+    ctx->ret_status = SRSRAN_ERROR;
+  } else {
+    ctx->nof_iterations += (uint32_t)n;
+  }
+
+  if (softbuffer->cb_crc[cb_idx]) {
+    memcpy(&pool->data[cb_idx * rlen / 8], ctx->cb_out, rlen / 8 * sizeof(uint8_t));
+  } else {
+    // The transport block is lost, the remaining code blocks are only soft-combined
+    pthread_mutex_lock(&pool->mutex);
+    pool->tb_failed = true;
+    pthread_mutex_unlock(&pool->mutex);
+  }
+}
+
+static void sch_decoder_pool_free(srsran_sch_t* q)
+{
+  sch_decoder_pool_t* pool = (sch_decoder_pool_t*)q->decoder_pool_ptr;
+  if (pool == NULL) {
+    return;
+  }
+
+  // Stop the workers before releasing their contexts
+  srsran_task_pool_free(&pool->pool);
+
+  if (pool->ctx) {
+    for (uint32_t i = 0; i < pool->nof_ctx; i++) {
+      sch_decoder_ctx_t* ctx = &pool->ctx[i];
+      if (i > 0 && ctx->decoder) {
+        srsran_tdec_free(ctx->decoder);
+      }
+      if (ctx->cb_out) {
+        free(ctx->cb_out);
       }
+    }
+    free(pool->ctx);
+  }
 
-      srsran_tdec_new_cb(&q->decoder, cb_len);
+  pthread_mutex_destroy(&pool->mutex);
+  free(pool);
 
-      // Run iterations and use CRC for early stopping
-      bool     early_stop = false;
-      uint32_t cb_noi     = 0;
-      do {
-        if (q->llr_is_8bit) {
-          srsran_tdec_iteration_8bit(&q->decoder, (int8_t*)softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        } else {
-          srsran_tdec_iteration(&q->decoder, softbuffer->buffer_f[cb_idx], &data[cb_idx * rlen / 8]);
-        }
-        q->avg_iterations++;
-        cb_noi++;
+  q->decoder_pool_ptr = NULL;
+}
 
-        uint32_t      len_crc;
-        srsran_crc_t* crc_ptr;
+int srsran_sch_set_decoder_threads(srsran_sch_t* q, uint32_t nof_workers)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-        if (cb_segm->C > 1) {
-          len_crc = cb_len;
-          crc_ptr = &q->crc_cb;
-        } else {
-          len_crc = cb_segm->tbs + 24;
-          crc_ptr = &q->crc_tb;
-        }
+  sch_decoder_pool_free(q);
 
-        // CRC is OK
-        if (!srsran_crc_checksum_byte(crc_ptr, &data[cb_idx * rlen / 8], len_crc)) {
-          softbuffer->cb_crc[cb_idx] = true;
-          early_stop                 = true;
+  if (nof_workers == 0) {
+    return SRSRAN_SUCCESS;
+  }
 
-          // CRC is error and exceeded maximum iterations for this CB.
-          // Early stop the whole transport block.
-        }
+  sch_decoder_pool_t* pool = calloc(1, sizeof(sch_decoder_pool_t));
+  if (pool == NULL) {
+    ERROR("Allocating decoder pool");
+    return SRSRAN_ERROR;
+  }
+  q->decoder_pool_ptr = pool;
+  pool->q             = q;
 
-      } while (cb_noi < q->max_iterations && !early_stop);
+  if (pthread_mutex_init(&pool->mutex, NULL)) {
+    ERROR("Creating mutex");
+    free(pool);
+    q->decoder_pool_ptr = NULL;
+    return SRSRAN_ERROR;
+  }
 
-      INFO("CB %d: rp=%d, n_e=%d, cb_len=%d, CRC=%s, rlen=%d, iterations=%d/%d",
-           cb_idx,
-           rp,
-           n_e2,
-           cb_len,
-           early_stop ? "OK" : "KO",
-           rlen,
-           cb_noi,
-           q->max_iterations);
+  pool->ctx = calloc(nof_workers + 1, sizeof(sch_decoder_ctx_t));
+  if (pool->ctx == NULL) {
+    ERROR("Allocating decoder contexts");
+    sch_decoder_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+  pool->nof_ctx = nof_workers + 1;
 
-    } else {
-      // Copy decoded data from previous transmissions
+  for (uint32_t i = 0; i < pool->nof_ctx; i++) {
+    sch_decoder_ctx_t* ctx = &pool->ctx[i];
+
+    ctx->cb_out = srsran_vec_u8_malloc((SRSRAN_TCOD_MAX_LEN_CB + 8) / 8);
+    if (ctx->cb_out == NULL) {
+      sch_decoder_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    if (srsran_crc_init(&ctx->crc_cb, SRSRAN_LTE_CRC24B, 24)) {
+      ERROR("Error initiating CRC");
+      sch_decoder_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+
+    // The first context is the calling thread, which uses the SCH decoder
+    if (i == 0) {
+      ctx->decoder = &q->decoder;
+      continue;
+    }
+
+    if (srsran_tdec_init(&ctx->decoder_mem, SRSRAN_TCOD_MAX_LEN_CB)) {
+      ERROR("Error initiating Turbo Decoder");
+      sch_decoder_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+    ctx->decoder = &ctx->decoder_mem;
+    srsran_tdec_set_early_stop(ctx->decoder, q->early_stop, q->early_stop_llr_th);
+  }
+
+  if (srsran_task_pool_init(&pool->pool, nof_workers)) {
+    ERROR("Creating decoder threads");
+    sch_decoder_pool_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_sch_set_early_stop(srsran_sch_t* q, srsran_tdec_early_stop_t criterion, int16_t llr_th)
+{
+  q->early_stop        = criterion;
+  q->early_stop_llr_th = llr_th;
+  srsran_tdec_set_early_stop(&q->decoder, criterion, llr_th);
+
+  // Decoder pool contexts other than the first one own their turbo decoder
+  sch_decoder_pool_t* pool = (sch_decoder_pool_t*)q->decoder_pool_ptr;
+  if (pool) {
+    for (uint32_t i = 1; i < pool->nof_ctx; i++) {
+      srsran_tdec_set_early_stop(pool->ctx[i].decoder, criterion, llr_th);
+    }
+  }
+}
+
+/* Decodes the code blocks of a transport block using the decoder pool */
+static bool decode_tb_cb_pool(srsran_sch_t*                  q,
+                              srsran_softbuffer_rx_t*        softbuffer,
+                              srsran_cbsegm_t*               cb_segm,
+                              uint32_t                       Qm,
+                              uint32_t                       rv,
+                              uint32_t                       nof_e_bits,
+                              void*                          e_bits,
+                              const srsran_sequence_state_t* cb_seq,
+                              uint8_t*                       data)
+{
+  sch_decoder_pool_t* pool = (sch_decoder_pool_t*)q->decoder_pool_ptr;
+
+  pool->softbuffer = softbuffer;
+  pool->cb_segm    = cb_segm;
+  pool->Qm         = Qm;
+  pool->rv         = rv;
+  pool->nof_e_bits = nof_e_bits;
+  pool->e_bits     = e_bits;
+  pool->cb_seq     = cb_seq;
+  pool->data       = data;
+  pool->tb_failed  = false;
+
+  for (uint32_t i = 0; i < pool->nof_ctx; i++) {
+    pool->ctx[i].nof_iterations = 0;
+    pool->ctx[i].ret_status     = SRSRAN_SUCCESS;
+  }
+
+  srsran_task_pool_run(&pool->pool, cb_segm->C, sch_decoder_pool_task, pool);
+
+  bool ret = true;
+  for (uint32_t i = 0; i < pool->nof_ctx; i++) {
+    q->avg_iterations += pool->ctx[i].nof_iterations;
+    if (pool->ctx[i].ret_status < SRSRAN_SUCCESS) {
+      ret = false;
+    }
+  }
+
+  return ret;
+}
+
+bool decode_tb_cb(srsran_sch_t*                  q,
+                  srsran_softbuffer_rx_t*        softbuffer,
+                  srsran_cbsegm_t*               cb_segm,
+                  uint32_t                       Qm,
+                  uint32_t                       rv,
+                  uint32_t                       nof_e_bits,
+                  void*                          e_bits,
+                  const srsran_sequence_state_t* seq,
+                  uint8_t*                       data)
+{
+  if (cb_segm->C > SRSRAN_MAX_CODEBLOCKS) {
+    ERROR("Error SRSRAN_MAX_CODEBLOCKS=%d", SRSRAN_MAX_CODEBLOCKS);
+    return false;
+  }
+
+  q->avg_iterations = 0;
+
+  // Sequence state at the first bit of every code block, so they can be descrambled in any order
+  srsran_sequence_state_t  cb_seq_mem[SRSRAN_MAX_CODEBLOCKS];
+  srsran_sequence_state_t* cb_seq = NULL;
+  if (seq != NULL) {
+    // The state follows the read pointer of each code block, which is not the sum of the previous code block lengths
+    srsran_sequence_state_t state   = *seq;
+    uint32_t                prev_rp = 0;
+    for (uint32_t cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
+      uint32_t rp = 0;
+      cb_e_bits(cb_segm, Qm, nof_e_bits, cb_idx, &rp);
+      srsran_sequence_state_advance(&state, rp - prev_rp);
+      cb_seq_mem[cb_idx] = state;
+      prev_rp            = rp;
+    }
+    cb_seq = cb_seq_mem;
+  }
+
+  if (q->decoder_pool_ptr && cb_segm->C > 1) {
+    if (!decode_tb_cb_pool(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, cb_seq, data)) {
+      return false;
+    }
+  } else {
+    for (int cb_idx = 0; cb_idx < cb_segm->C; cb_idx++) {
       uint32_t cb_len = cb_idx < cb_segm->C1 ? cb_segm->K1 : cb_segm->K2;
       uint32_t rlen   = cb_segm->C == 1 ? cb_len : (cb_len - 24);
-      memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+
+      /* Do not process blocks with CRC Ok */
+      if (softbuffer->cb_crc[cb_idx] == false) {
+        int n = decode_cb(q,
+                          &q->decoder,
+                          cb_segm->C > 1 ? &q->crc_cb : &q->crc_tb,
+                          softbuffer,
+                          cb_segm,
+                          Qm,
+                          rv,
+                          nof_e_bits,
+                          e_bits,
+                          cb_seq ? &cb_seq[cb_idx] : NULL,
+                          cb_idx,
+                          &data[cb_idx * rlen / 8],
+                          true);
+        if (n < SRSRAN_SUCCESS) {
+          return false;
+        }
+        q->avg_iterations += n;
+      } else {
+        // Copy decoded data from previous transmissions
+        memcpy(&data[cb_idx * rlen / 8], softbuffer->data[cb_idx], rlen / 8 * sizeof(uint8_t));
+      }
     }
   }
 
@@ -504,14 +830,15 @@ bool decode_tb_cb(srsran_sch_t*           q,
  * @param[out] data Decoded transport block
  * @return negative if error in parameters or CRC error in decoding
  */
-static int decode_tb(srsran_sch_t*           q,
-                     srsran_softbuffer_rx_t* softbuffer,
-                     srsran_cbsegm_t*        cb_segm,
-                     uint32_t                Qm,
-                     uint32_t                rv,
-                     uint32_t                nof_e_bits,
-                     int16_t*                e_bits,
-                     uint8_t*                data)
+static int decode_tb(srsran_sch_t*                  q,
+                     srsran_softbuffer_rx_t*        softbuffer,
+                     srsran_cbsegm_t*               cb_segm,
+                     uint32_t                       Qm,
+                     uint32_t                       rv,
+                     uint32_t                       nof_e_bits,
+                     int16_t*                       e_bits,
+                     const srsran_sequence_state_t* seq,
+                     uint8_t*                       data)
 {
   if (q != NULL && data != NULL && softbuffer != NULL && e_bits != NULL && cb_segm != NULL && Qm != 0) {
     if (cb_segm->tbs == 0 || cb_segm->C == 0) {
@@ -538,7 +865,7 @@ static int decode_tb(srsran_sch_t*           q,
     data[cb_segm->tbs / 8 + 2] = 0;
 
     // Process Codeblocks
-    crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, data);
+    crc_ok = decode_tb_cb(q, softbuffer, cb_segm, Qm, rv, nof_e_bits, e_bits, seq, data);
 
     if (crc_ok) {
       uint32_t par_rx = 0, par_tx = 0;
@@ -582,6 +909,17 @@ int srsran_dlsch_decode2(srsran_sch_t*       q,
                          uint8_t*            data,
                          int                 tb_idx,
                          uint32_t            nof_layers)
+{
+  return srsran_dlsch_decode2_descramble(q, cfg, e_bits, data, tb_idx, nof_layers, NULL);
+}
+
+int srsran_dlsch_decode2_descramble(srsran_sch_t*                  q,
+                                    srsran_pdsch_cfg_t*            cfg,
+                                    int16_t*                       e_bits,
+                                    uint8_t*                       data,
+                                    int                            tb_idx,
+                                    uint32_t                       nof_layers,
+                                    const srsran_sequence_state_t* seq)
 {
   uint32_t Nl = 1;
 
@@ -604,6 +942,7 @@ int srsran_dlsch_decode2(srsran_sch_t*       q,
                    cfg->grant.tb[tb_idx].rv,
                    cfg->grant.tb[tb_idx].nof_bits,
                    e_bits,
+                   seq,
                    data);
 }
 
@@ -1186,7 +1525,8 @@ int srsran_ulsch_decode(srsran_sch_t*       q,
   // Decode ULSCH
   if (cb_segm.tbs > 0) {
     uint32_t G = nb_q / Qm - Q_prime_ri - Q_prime_cqi;
-    ret        = decode_tb(q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], data);
+    ret        = decode_tb(
+        q, cfg->softbuffers.rx, &cb_segm, Qm, cfg->grant.tb.rv, G * Qm, &g_bits[e_offset], NULL, data);
   }
   return ret;
 }
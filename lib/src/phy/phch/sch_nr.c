@@ -27,6 +27,7 @@
 #include "srsran/phy/phch/ra_nr.h"
 #include "srsran/phy/utils/bit.h"
 #include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 
 #define SCH_INFO_TX(...) INFO("SCH Tx: " __VA_ARGS__)
@@ -193,17 +194,16 @@ int srsran_sch_nr_init_tx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
 
   srsran_ldpc_encoder_type_t encoder_type = SRSRAN_LDPC_ENCODER_C;
 
-#ifdef LV_HAVE_AVX512
-  if (!args->disable_simd) {
-    encoder_type = SRSRAN_LDPC_ENCODER_AVX512;
-  }
-#else // LV_HAVE_AVX512
-#ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX2) {
     encoder_type = SRSRAN_LDPC_ENCODER_AVX2;
   }
 #endif // LV_HAVE_AVX2
-#endif // LV_HAVE_AVX612
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_ISA_DISPATCH_AVX512)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX512) {
+    encoder_type = SRSRAN_LDPC_ENCODER_AVX512;
+  }
+#endif // LV_HAVE_AVX512
 
   // Iterate over all possible lifting sizes
   for (uint16_t ls = 0; ls <= MAX_LIFTSIZE; ls++) {
@@ -258,16 +258,15 @@ int srsran_sch_nr_init_rx(srsran_sch_nr_t* q, const srsran_sch_nr_args_t* args)
   srsran_ldpc_decoder_type_t decoder_type =
       args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_FLOOD : SRSRAN_LDPC_DECODER_C;
 
-#ifdef LV_HAVE_AVX512
-  if (!args->disable_simd) {
-    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
-  }
-#else // LV_HAVE_AVX512
-#ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX2) {
     decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX2_FLOOD : SRSRAN_LDPC_DECODER_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_ISA_DISPATCH_AVX512)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX512) {
+    decoder_type = args->decoder_use_flooded ? SRSRAN_LDPC_DECODER_C_AVX512_FLOOD : SRSRAN_LDPC_DECODER_C_AVX512;
+  }
 #endif // LV_HAVE_AVX512
 
   // If the scaling factor is not provided use a default value that allows decoding all possible combinations of nPRB
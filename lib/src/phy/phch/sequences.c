@@ -69,6 +69,15 @@ int srsran_sequence_pdsch(srsran_sequence_t* seq, uint16_t rnti, int q, uint32_t
   return srsran_sequence_LTE_pr(seq, len, sequence_pdsch_seed(rnti, q, nslot, cell_id));
 }
 
+void srsran_sequence_pdsch_state_init(srsran_sequence_state_t* s,
+                                      uint16_t                 rnti,
+                                      int                      q,
+                                      uint32_t                 nslot,
+                                      uint32_t                 cell_id)
+{
+  srsran_sequence_state_init(s, sequence_pdsch_seed(rnti, q, nslot, cell_id));
+}
+
 void srsran_sequence_pdsch_apply_pack(const uint8_t* in,
                                       uint8_t*       out,
                                       uint16_t       rnti,
@@ -166,9 +175,20 @@ void srsran_sequence_pusch_apply_c(const int8_t* in,
 /**
  * 36.211 5.4.2
  */
+static inline uint32_t sequence_pucch_seed(uint16_t rnti, uint32_t nslot, uint32_t cell_id)
+{
+  return ((((nslot / 2) + 1) * (2 * cell_id + 1)) << 16) + rnti;
+}
+
 int srsran_sequence_pucch(srsran_sequence_t* seq, uint16_t rnti, uint32_t nslot, uint32_t cell_id)
 {
-  return srsran_sequence_LTE_pr(seq, 12 * 4, ((((nslot / 2) + 1) * (2 * cell_id + 1)) << 16) + rnti);
+  return srsran_sequence_LTE_pr(seq, 12 * 4, sequence_pucch_seed(rnti, nslot, cell_id));
+}
+
+const uint8_t*
+srsran_sequence_pucch_cache(srsran_sequence_cache_t* cache, uint16_t rnti, uint32_t nslot, uint32_t cell_id)
+{
+  return srsran_sequence_cache_get(cache, sequence_pucch_seed(rnti, nslot, cell_id), 12 * 4);
 }
 
 int srsran_sequence_pmch(srsran_sequence_t* seq, uint32_t nslot, uint32_t mbsfn_id, uint32_t len)
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+/*
+ * Measures the DCI decoding latency and block error rate of every aggregation level with the tail-biting Viterbi
+ * decoder running over the tripled block and in wrap-around (WAVA) mode. Candidates carrying only noise are decoded
+ * too, most candidates of a blind search do not carry a DCI for the UE.
+ */
+
+#define NOF_MODES 2
+
+static const char* mode_names[NOF_MODES] = {"tripled", "wava"};
+
+static uint32_t nof_bits        = 27;
+static uint32_t nof_repetitions = 1000;
+static float    snr_dB          = 0.0f;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [brs]\n", prog);
+  printf("\t-b Number of DCI payload bits [Default %d]\n", nof_bits);
+  printf("\t-r Number of repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s SNR per coded bit in dB [Default %.1f]\n", snr_dB);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "brs")) != -1) {
+    switch (opt) {
+      case 'b':
+        nof_bits = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char** argv)
+{
+  int             ret        = SRSRAN_ERROR;
+  srsran_random_t random_gen = srsran_random_init(0);
+  srsran_pdcch_t  pdcch      = {};
+  uint8_t         payload[SRSRAN_DCI_MAX_BITS + 16];
+  uint8_t         decoded[SRSRAN_DCI_MAX_BITS + 16];
+  uint8_t*        e     = NULL;
+  float*          llr   = NULL;
+  float*          noise = NULL;
+
+  parse_args(argc, argv);
+
+  if (nof_bits >= SRSRAN_DCI_MAX_BITS) {
+    ERROR("The DCI payload must be shorter than %d bits", SRSRAN_DCI_MAX_BITS);
+    goto clean_exit;
+  }
+
+  if (srsran_pdcch_init_ue(&pdcch, SRSRAN_MAX_PRB, 1)) {
+    ERROR("Error initiating PDCCH");
+    goto clean_exit;
+  }
+
+  uint32_t max_E = 72 * 8;
+  e              = srsran_vec_u8_malloc(max_E);
+  llr            = srsran_vec_f_malloc(max_E);
+  noise          = srsran_vec_f_malloc(max_E);
+  if (e == NULL || llr == NULL || noise == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  float noise_std = srsran_convert_dB_to_amplitude(-snr_dB);
+
+  printf("%-3s %-8s %12s %12s %8s\n", "L", "mode", "dci (us)", "noise (us)", "BLER");
+  for (uint32_t l = 0; l < 4; l++) {
+    uint32_t E = 72 * (1U << l);
+
+    uint64_t t_dci[NOF_MODES]      = {};
+    uint64_t t_noise[NOF_MODES]    = {};
+    uint32_t nof_errors[NOF_MODES] = {};
+
+    for (uint32_t r = 0; r < nof_repetitions; r++) {
+      uint16_t rnti = (uint16_t)srsran_random_uniform_int_dist(random_gen, 1, 0xfff3);
+      for (uint32_t i = 0; i < nof_bits; i++) {
+        payload[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      srsran_pdcch_dci_encode(&pdcch, payload, e, nof_bits, E, rnti);
+
+      // Positive LLR for ones, as the QPSK soft demodulator gives them
+      srsran_vec_f_zero(noise, E);
+      srsran_ch_awgn_f(noise, noise, noise_std, E);
+      for (uint32_t i = 0; i < E; i++) {
+        llr[i] = (e[i] ? 1.0f : -1.0f) + noise[i];
+      }
+
+      for (uint32_t m = 0; m < NOF_MODES; m++) {
+        uint16_t crc = 0;
+
+        srsran_viterbi_set_wava(&pdcch.decoder, m == 1);
+
+        uint64_t t0 = time_ns();
+        srsran_pdcch_dci_decode(&pdcch, llr, decoded, E, nof_bits, &crc);
+        uint64_t t1 = time_ns();
+        srsran_pdcch_dci_decode(&pdcch, noise, decoded + nof_bits, E, nof_bits, NULL);
+        uint64_t t2 = time_ns();
+
+        t_dci[m] += t1 - t0;
+        t_noise[m] += t2 - t1;
+        if (crc != rnti || memcmp(payload, decoded, nof_bits) != 0) {
+          nof_errors[m]++;
+        }
+      }
+    }
+
+    for (uint32_t m = 0; m < NOF_MODES; m++) {
+      printf("%-3d %-8s %12.2f %12.2f %8.4f\n",
+             1U << l,
+             mode_names[m],
+             (double)t_dci[m] / (1000.0 * nof_repetitions),
+             (double)t_noise[m] / (1000.0 * nof_repetitions),
+             (double)nof_errors[m] / nof_repetitions);
+    }
+
+    // The wrap-around decoding falls back to the tripled block, it cannot lose more DCI than a few due to the noise
+    if (nof_errors[1] > nof_errors[0] + nof_repetitions / 100) {
+      ERROR("The WAVA decoder loses %d DCI, the tripled one %d", nof_errors[1], nof_errors[0]);
+      goto clean_exit;
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(random_gen);
+  srsran_pdcch_free(&pdcch);
+  if (e) {
+    free(e);
+  }
+  if (llr) {
+    free(llr);
+  }
+  if (noise) {
+    free(noise);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -339,6 +339,28 @@ int main(int argc, char** argv)
       }
     }
 
+    /* Decoding the same candidates again must reuse the previous results */
+    srsran_pdcch_search_metrics_t metrics = pdcch_rx.search_metrics;
+    for (i = 0; i < nof_dcis; i++) {
+      srsran_dci_msg_t dci_rx = {};
+      dci_rx.format           = testcases[i].dci_format;
+      dci_rx.location         = testcases[i].dci_location;
+      if (srsran_pdcch_decode_msg(&pdcch_rx, &dl_sf, &dci_cfg, &dci_rx)) {
+        ERROR("Error decoding DCI message");
+        goto quit;
+      }
+      if (dci_rx.rnti != testcases[i].dci_rx.rnti + 1234 ||
+          memcmp(dci_rx.payload, testcases[i].dci_rx.payload, testcases[i].dci_rx.nof_bits) != 0) {
+        printf("Error in DCI %d: Cached result does not match\n", i);
+        goto quit;
+      }
+    }
+    if (pdcch_rx.search_metrics.nof_decodes != metrics.nof_decodes ||
+        pdcch_rx.search_metrics.nof_cached != metrics.nof_cached + nof_dcis) {
+      printf("Error: %d candidates were decoded again\n", pdcch_rx.search_metrics.nof_decodes - metrics.nof_decodes);
+      goto quit;
+    }
+
     /* Compare Tx and Rx */
     for (i = 0; i < nof_dcis; i++) {
       if (memcmp(testcases[i].dci_tx.payload, testcases[i].dci_rx.payload, testcases[i].dci_tx.nof_bits)) {
@@ -49,7 +49,8 @@ static int         rv_idx[SRSRAN_MAX_CODEWORDS] = {0, 1};
 static uint16_t    rnti                         = 1234;
 static uint32_t    nof_rx_antennas              = 1;
 static bool        tb_cw_swap                   = false;
-static bool        enable_coworker              = false;
+static bool        enable_cw_pool               = false;
+static uint32_t    nof_decoder_threads          = 0;
 static uint32_t    pmi                          = 0;
 static char*       input_file                   = NULL;
 static int         M                            = 1;
@@ -75,7 +76,8 @@ void usage(char* prog)
   printf("\t-a nof_rx_antennas [Default %d]\n", nof_rx_antennas);
   printf("\t-p pmi (multiplex only)  [Default %d]\n", pmi);
   printf("\t-w Swap Transport Blocks\n");
-  printf("\t-j Enable PDSCH decoder coworker\n");
+  printf("\t-j Enable PDSCH codeword pool\n");
+  printf("\t-D Number of extra code block decoder threads [Default %d]\n", nof_decoder_threads);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
   printf("\t-q Enable/Disable 256QAM modulation (default %s)\n", enable_256qam ? "enabled" : "disabled");
 }
@@ -83,7 +85,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxj")) != -1) {
+  while ((opt = getopt(argc, argv, "fmMcsbrtRFpnqawvXxjD")) != -1) {
     switch (opt) {
       case 'f':
         input_file = argv[optind];
@@ -134,7 +136,10 @@ void parse_args(int argc, char** argv)
         tb_cw_swap = true;
         break;
       case 'j':
-        enable_coworker = true;
+        enable_cw_pool = true;
+        break;
+      case 'D':
+        nof_decoder_threads = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
       case 'v':
         srsran_verbose++;
@@ -380,6 +385,10 @@ int main(int argc, char** argv)
       ERROR("Error creating PDSCH object");
       goto quit;
     }
+    if (enable_cw_pool && srsran_pdsch_enable_cw_pool(&pdsch_tx)) {
+      ERROR("Error enabling PDSCH codeword pool");
+      goto quit;
+    }
 
     for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
       softbuffers_tx[i] = calloc(sizeof(srsran_softbuffer_tx_t), 1);
@@ -468,8 +477,14 @@ int main(int argc, char** argv)
   }
 
   int r = 0;
-  if (enable_coworker) {
-    srsran_pdsch_enable_coworker(&pdsch_rx);
+  if (enable_cw_pool && srsran_pdsch_enable_cw_pool(&pdsch_rx)) {
+    ERROR("Error enabling PDSCH codeword pool");
+    goto quit;
+  }
+
+  if (nof_decoder_threads && srsran_pdsch_set_decoder_threads(&pdsch_rx, nof_decoder_threads)) {
+    ERROR("Error enabling PDSCH decoder threads");
+    goto quit;
   }
 
   for (uint32_t i = 0; i < SRSRAN_MAX_CODEWORDS; i++) {
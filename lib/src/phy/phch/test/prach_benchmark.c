@@ -0,0 +1,270 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/random.h"
+#include "srsran/srsran.h"
+
+#define MAX_CARRIERS 4
+#define MAX_INDICES 64
+
+/*
+ * Measures the PRACH detection latency of 1 to max_carriers carriers, detecting each carrier on its own and all of
+ * them in a batch, together with the detection and false alarm rates. Carrier c uses the preamble format c % 4.
+ */
+
+static uint32_t nof_prb         = 25;
+static uint32_t max_carriers    = MAX_CARRIERS;
+static uint32_t zero_corr_zone  = 11;
+static uint32_t nof_repetitions = 100;
+static float    snr_dB          = -10.0f;
+static float    detect_factor   = 60.0f;
+
+typedef struct {
+  srsran_prach_t prach;
+  cf_t*          signal;
+  cf_t*          noise;
+  uint32_t       len;
+  uint32_t       preamble;
+  uint32_t       indices[MAX_INDICES];
+  uint32_t       nof_indices;
+  uint32_t       batch_indices[MAX_INDICES];
+  uint32_t       nof_batch_indices;
+} carrier_t;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [nczrsd]\n", prog);
+  printf("\t-n Uplink number of PRB of every carrier [Default %d]\n", nof_prb);
+  printf("\t-c Maximum number of carriers, up to %d [Default %d]\n", MAX_CARRIERS, max_carriers);
+  printf("\t-z Zero correlation zone config [Default %d]\n", zero_corr_zone);
+  printf("\t-r Number of repetitions [Default %d]\n", nof_repetitions);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_dB);
+  printf("\t-d Detection factor [Default %.1f]\n", detect_factor);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "nczrsd")) != -1) {
+    switch (opt) {
+      case 'n':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'c':
+        max_carriers = SRSRAN_MIN((uint32_t)strtol(argv[optind], NULL, 10), MAX_CARRIERS);
+        break;
+      case 'z':
+        zero_corr_zone = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      case 'd':
+        detect_factor = strtof(argv[optind], NULL);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static uint64_t time_ns()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000UL + (uint64_t)ts.tv_nsec;
+}
+
+static int carrier_init(carrier_t* c, uint32_t idx)
+{
+  srsran_prach_cfg_t cfg = {};
+  cfg.config_idx         = 16 * (idx % 4) + 3; // Formats 0 to 3
+  cfg.root_seq_idx       = 100 * idx;
+  cfg.zero_corr_zone     = zero_corr_zone;
+
+  if (srsran_prach_init(&c->prach, srsran_symbol_sz(nof_prb)) || srsran_prach_set_cfg(&c->prach, &cfg, nof_prb)) {
+    ERROR("Error initializing PRACH");
+    return SRSRAN_ERROR;
+  }
+  srsran_prach_set_detect_factor(&c->prach, detect_factor);
+
+  c->len    = c->prach.N_cp + c->prach.N_seq;
+  c->signal = srsran_vec_cf_malloc(c->len);
+  c->noise  = srsran_vec_cf_malloc(c->len);
+  if (c->signal == NULL || c->noise == NULL) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void carrier_free(carrier_t* c)
+{
+  srsran_prach_free(&c->prach);
+  if (c->signal) {
+    free(c->signal);
+  }
+  if (c->noise) {
+    free(c->noise);
+  }
+}
+
+/* Generates a random preamble in the signal buffer and receiver noise only in the noise buffer */
+static void carrier_gen(carrier_t* c, srsran_random_t random_gen)
+{
+  c->preamble = (uint32_t)srsran_random_uniform_int_dist(random_gen, 0, 63);
+  srsran_prach_gen(&c->prach, c->preamble, 0, c->signal);
+
+  float n0 = srsran_vec_avg_power_cf(c->signal, c->len) * srsran_convert_dB_to_power(-snr_dB);
+  srsran_vec_cf_zero(c->noise, c->len);
+  srsran_ch_awgn_c(c->noise, c->noise, sqrtf(n0 / 2), c->len);
+  srsran_vec_sum_ccc(c->signal, c->noise, c->signal, c->len);
+}
+
+static void batch_req(carrier_t* c, cf_t* signal, srsran_prach_detect_req_t* req)
+{
+  req->p           = &c->prach;
+  req->freq_offset = 0;
+  req->signal      = &signal[c->prach.N_cp];
+  req->sig_len     = c->prach.N_seq;
+  req->indices     = c->batch_indices;
+  req->t_offsets   = NULL;
+  req->peak_to_avg = NULL;
+  req->n_indices   = &c->nof_batch_indices;
+}
+
+int main(int argc, char** argv)
+{
+  int             ret                    = SRSRAN_ERROR;
+  srsran_random_t random_gen             = srsran_random_init(0);
+  carrier_t       carriers[MAX_CARRIERS] = {};
+  bool            mismatch               = false;
+  uint32_t        nof_detected           = 0;
+  uint32_t        nof_false_alarms       = 0;
+  uint32_t        nof_opportunities      = 0;
+  uint64_t        t_single[MAX_CARRIERS] = {};
+  uint64_t        t_batch[MAX_CARRIERS]  = {};
+
+  parse_args(argc, argv);
+
+  for (uint32_t i = 0; i < max_carriers; i++) {
+    if (carrier_init(&carriers[i], i)) {
+      goto clean_exit;
+    }
+  }
+
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    for (uint32_t i = 0; i < max_carriers; i++) {
+      carrier_gen(&carriers[i], random_gen);
+    }
+
+    for (uint32_t n = 1; n <= max_carriers; n++) {
+      srsran_prach_detect_req_t reqs[MAX_CARRIERS];
+
+      // Each carrier on its own, as every PRACH worker does
+      uint64_t t0 = time_ns();
+      for (uint32_t i = 0; i < n; i++) {
+        carrier_t* c = &carriers[i];
+        srsran_prach_detect_offset(
+            &c->prach, 0, &c->signal[c->prach.N_cp], c->prach.N_seq, c->indices, NULL, NULL, &c->nof_indices);
+      }
+      uint64_t t1 = time_ns();
+
+      // All carriers in a batch
+      for (uint32_t i = 0; i < n; i++) {
+        batch_req(&carriers[i], carriers[i].signal, &reqs[i]);
+      }
+      if (srsran_prach_detect_batch(reqs, n)) {
+        ERROR("Error detecting PRACH batch");
+        goto clean_exit;
+      }
+      uint64_t t2 = time_ns();
+
+      t_single[n - 1] += t1 - t0;
+      t_batch[n - 1] += t2 - t1;
+
+      for (uint32_t i = 0; i < n; i++) {
+        carrier_t* c = &carriers[i];
+        mismatch |= c->nof_indices != c->nof_batch_indices ||
+                    memcmp(c->indices, c->batch_indices, c->nof_indices * sizeof(uint32_t)) != 0;
+      }
+    }
+
+    // Detection and false alarm rates with the batch of all the carriers
+    srsran_prach_detect_req_t reqs[MAX_CARRIERS];
+    for (uint32_t i = 0; i < max_carriers; i++) {
+      carrier_t* c = &carriers[i];
+      for (uint32_t j = 0; j < c->nof_batch_indices; j++) {
+        if (c->batch_indices[j] == c->preamble) {
+          nof_detected++;
+        }
+      }
+      batch_req(c, c->noise, &reqs[i]);
+    }
+    if (srsran_prach_detect_batch(reqs, max_carriers)) {
+      ERROR("Error detecting PRACH batch");
+      goto clean_exit;
+    }
+    for (uint32_t i = 0; i < max_carriers; i++) {
+      nof_false_alarms += carriers[i].nof_batch_indices;
+    }
+    nof_opportunities += max_carriers;
+  }
+
+  printf("%8s %12s %12s\n", "carriers", "single (us)", "batch (us)");
+  for (uint32_t n = 0; n < max_carriers; n++) {
+    printf("%8d %12.1f %12.1f\n",
+           n + 1,
+           (double)t_single[n] / (1000.0 * nof_repetitions),
+           (double)t_batch[n] / (1000.0 * nof_repetitions));
+  }
+  printf("SNR=%.1f dB: detection rate %.3f, false alarms per opportunity %.4f\n",
+         snr_dB,
+         (double)nof_detected / nof_opportunities,
+         (double)nof_false_alarms / nof_opportunities);
+
+  if (mismatch) {
+    ERROR("The batch detection does not match the detection of every carrier on its own");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t i = 0; i < max_carriers; i++) {
+    carrier_free(&carriers[i]);
+  }
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
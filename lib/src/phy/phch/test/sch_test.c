@@ -0,0 +1,256 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/phch/ra.h"
+#include "srsran/phy/phch/sch.h"
+#include "srsran/phy/scrambling/scrambling.h"
+#include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+// Maximum number of bits for 256QAM in all the subframe REs
+#define MAX_NOF_BITS (SRSRAN_MAX_PRB * SRSRAN_NRE * 2 * SRSRAN_CP_NORM_NSYMB * 8)
+
+static uint32_t nof_prb         = 100;
+static uint32_t mcs             = 27;
+static uint32_t max_nof_threads = 4;
+static uint32_t nof_repetitions = 100;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [pmtNv]\n", prog);
+  printf("\t-p Number of PRB [Default %d]\n", nof_prb);
+  printf("\t-m MCS index (0-28) [Default %d]\n", mcs);
+  printf("\t-t Maximum number of decoder threads [Default %d]\n", max_nof_threads);
+  printf("\t-N Number of repetitions for each thread count [Default %d]\n", nof_repetitions);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "pmtNv")) != -1) {
+    switch (opt) {
+      case 'p':
+        nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'm':
+        mcs = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 't':
+        max_nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'N':
+        nof_repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'v':
+        srsran_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                    ret           = SRSRAN_ERROR;
+  srsran_sch_t           sch_tx        = {};
+  srsran_sch_t           sch_rx        = {};
+  srsran_softbuffer_tx_t softbuffer_tx = {};
+  srsran_softbuffer_rx_t softbuffer_rx = {};
+  srsran_random_t        rand_gen      = srsran_random_init(1234);
+
+  uint8_t* data_tx         = srsran_vec_u8_malloc(MAX_NOF_BITS / 8);
+  uint8_t* data_rx         = srsran_vec_u8_malloc(MAX_NOF_BITS / 8);
+  uint8_t* e_bits          = srsran_vec_u8_malloc(MAX_NOF_BITS / 8);
+  uint8_t* e_bits_unpacked = srsran_vec_u8_malloc(MAX_NOF_BITS);
+  int16_t* llr             = srsran_vec_i16_malloc(MAX_NOF_BITS);
+  int16_t* llr_scrambled   = srsran_vec_i16_malloc(MAX_NOF_BITS);
+  srsran_sequence_t seq    = {};
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (!data_tx || !data_rx || !e_bits || !e_bits_unpacked || !llr || !llr_scrambled) {
+    ERROR("Error allocating buffers");
+    goto clean_exit;
+  }
+
+  if (srsran_sch_init(&sch_tx) || srsran_sch_init(&sch_rx)) {
+    ERROR("Error initiating SCH");
+    goto clean_exit;
+  }
+
+  if (srsran_softbuffer_tx_init(&softbuffer_tx, nof_prb) || srsran_softbuffer_rx_init(&softbuffer_rx, nof_prb)) {
+    ERROR("Error initiating soft-buffers");
+    goto clean_exit;
+  }
+
+  // Prepare a PDSCH-like codeword spanning all the PRB with the control region of 2 symbols
+  srsran_pdsch_cfg_t cfg  = {};
+  cfg.grant.nof_tb        = 1;
+  cfg.grant.nof_prb       = nof_prb;
+  cfg.grant.nof_re        = nof_prb * SRSRAN_NRE * (2 * SRSRAN_CP_NORM_NSYMB - 2) - nof_prb * 16;
+  cfg.grant.tb[0].enabled  = true;
+  cfg.grant.tb[0].mcs_idx  = mcs;
+  cfg.grant.tb[0].mod      = srsran_ra_dl_mod_from_mcs(mcs, false);
+  cfg.grant.tb[0].tbs      = srsran_ra_tbs_from_idx(srsran_ra_tbs_idx_from_mcs(mcs, false, false), nof_prb);
+  cfg.grant.tb[0].nof_bits = cfg.grant.nof_re * srsran_mod_bits_x_symbol(cfg.grant.tb[0].mod);
+  cfg.grant.tb[0].rv       = 0;
+
+  srsran_cbsegm_t cb_segm = {};
+  if (srsran_cbsegm(&cb_segm, cfg.grant.tb[0].tbs)) {
+    ERROR("Error computing segmentation for TBS=%d", cfg.grant.tb[0].tbs);
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < cfg.grant.tb[0].tbs / 8; i++) {
+    data_tx[i] = (uint8_t)srsran_random_uniform_int_dist(rand_gen, 0, UINT8_MAX);
+  }
+
+  cfg.softbuffers.tx[0] = &softbuffer_tx;
+  if (srsran_dlsch_encode(&sch_tx, &cfg, data_tx, e_bits)) {
+    ERROR("Error encoding");
+    goto clean_exit;
+  }
+
+  srsran_bit_unpack_vector(e_bits, e_bits_unpacked, cfg.grant.tb[0].nof_bits);
+  for (uint32_t i = 0; i < cfg.grant.tb[0].nof_bits; i++) {
+    llr[i] = e_bits_unpacked[i] ? +100 : -100;
+  }
+
+  // Scrambled copy of the codeword, for the decoder that descrambles while rate dematching
+  const uint16_t rnti    = 0x1234;
+  const uint32_t cell_id = 1;
+  if (srsran_sequence_pdsch(&seq, rnti, 0, 0, cell_id, cfg.grant.tb[0].nof_bits)) {
+    ERROR("Error generating scrambling sequence");
+    goto clean_exit;
+  }
+  srsran_vec_i16_copy(llr_scrambled, llr, cfg.grant.tb[0].nof_bits);
+  srsran_scrambling_s_offset(&seq, llr_scrambled, 0, cfg.grant.tb[0].nof_bits);
+  srsran_sequence_state_t seq_state = {};
+  srsran_sequence_pdsch_state_init(&seq_state, rnti, 0, 0, cell_id);
+
+  // The last gamma code blocks take Qm more bits than the others
+  uint32_t Qm    = srsran_mod_bits_x_symbol(cfg.grant.tb[0].mod);
+  uint32_t gamma = (cfg.grant.tb[0].nof_bits / Qm) % cb_segm.C;
+  printf("Decoding TBS=%d bits in %d code blocks, gamma=%d (nof_prb=%d, mcs=%d)\n",
+         cfg.grant.tb[0].tbs,
+         cb_segm.C,
+         gamma,
+         nof_prb,
+         mcs);
+
+  cfg.softbuffers.rx[0] = &softbuffer_rx;
+  for (uint32_t nof_threads = 1; nof_threads <= max_nof_threads; nof_threads++) {
+    if (srsran_sch_set_decoder_threads(&sch_rx, nof_threads - 1)) {
+      ERROR("Error setting %d decoder threads", nof_threads);
+      goto clean_exit;
+    }
+
+    uint64_t t_total_us = 0;
+    uint64_t t_max_us   = 0;
+    for (uint32_t n = 0; n < nof_repetitions; n++) {
+      srsran_softbuffer_rx_reset_tbs(&softbuffer_rx, cfg.grant.tb[0].tbs);
+      memset(data_rx, 0, cfg.grant.tb[0].tbs / 8);
+
+      struct timeval t[3];
+      gettimeofday(&t[1], NULL);
+      int r = srsran_dlsch_decode(&sch_rx, &cfg, llr, data_rx);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+
+      if (r) {
+        ERROR("Error decoding with %d threads", nof_threads);
+        goto clean_exit;
+      }
+
+      if (memcmp(data_tx, data_rx, cfg.grant.tb[0].tbs / 8) != 0) {
+        ERROR("Tx/Rx data mismatch with %d threads", nof_threads);
+        goto clean_exit;
+      }
+
+      // Same decode, descrambling each code block from its own sequence state
+      srsran_softbuffer_rx_reset_tbs(&softbuffer_rx, cfg.grant.tb[0].tbs);
+      memset(data_rx, 0, cfg.grant.tb[0].tbs / 8);
+      if (srsran_dlsch_decode2_descramble(&sch_rx, &cfg, llr_scrambled, data_rx, 0, 1, &seq_state)) {
+        ERROR("Error decoding scrambled codeword with %d threads", nof_threads);
+        goto clean_exit;
+      }
+      if (memcmp(data_tx, data_rx, cfg.grant.tb[0].tbs / 8) != 0) {
+        ERROR("Tx/Rx data mismatch of scrambled codeword with %d threads", nof_threads);
+        goto clean_exit;
+      }
+
+      uint64_t t_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
+      t_total_us += t_us;
+      t_max_us = SRSRAN_MAX(t_max_us, t_us);
+    }
+
+    printf("threads=%d; TB decode latency avg=%.1f us, max=%ld us; %.1f Mbps\n",
+           nof_threads,
+           (double)t_total_us / nof_repetitions,
+           t_max_us,
+           (double)cfg.grant.tb[0].tbs * nof_repetitions / t_total_us);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_random_free(rand_gen);
+  srsran_sch_free(&sch_tx);
+  srsran_sch_free(&sch_rx);
+  srsran_softbuffer_tx_free(&softbuffer_tx);
+  srsran_softbuffer_rx_free(&softbuffer_rx);
+  if (data_tx) {
+    free(data_tx);
+  }
+  if (data_rx) {
+    free(data_rx);
+  }
+  if (e_bits) {
+    free(e_bits);
+  }
+  if (e_bits_unpacked) {
+    free(e_bits_unpacked);
+  }
+  if (llr) {
+    free(llr);
+  }
+  if (llr_scrambled) {
+    free(llr_scrambled);
+  }
+  srsran_sequence_free(&seq);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -25,6 +25,7 @@
 #include "srsran/phy/phch/csi.h"
 #include "srsran/phy/phch/uci_cfg.h"
 #include "srsran/phy/utils/bit.h"
+#include "srsran/phy/utils/isa.h"
 #include "srsran/phy/utils/vector.h"
 
 #define UCI_NR_INFO_TX(...) INFO("UCI-NR Tx: " __VA_ARGS__)
@@ -50,8 +51,8 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
 
   srsran_polar_encoder_type_t polar_encoder_type = SRSRAN_POLAR_ENCODER_PIPELINED;
   srsran_polar_decoder_type_t polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
-#ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+#if defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
+  if (!args->disable_simd && srsran_isa_get() >= SRSRAN_ISA_AVX2) {
     polar_encoder_type = SRSRAN_POLAR_ENCODER_AVX2;
     polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
@@ -0,0 +1,276 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
+
+/**
+ * Kaiser window shape parameter, it gives about 80 dB of stop band attenuation
+ */
+#define RESAMPLER_POLY_KAISER_BETA 8.0
+
+/**
+ * Number of input samples processed at a time, it bounds the size of the internal buffer
+ */
+#define RESAMPLER_POLY_BLOCK_SZ 2048
+
+static uint64_t resampler_poly_gcd(uint64_t a, uint64_t b)
+{
+  while (b != 0) {
+    uint64_t t = a % b;
+    a          = b;
+    b          = t;
+  }
+  return a;
+}
+
+// Zeroth order modified Bessel function of the first kind
+static double resampler_poly_bessel_i0(double x)
+{
+  double sum  = 1.0;
+  double term = 1.0;
+  for (uint32_t k = 1; k < 64 && term > 1e-12 * sum; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+  }
+  return sum;
+}
+
+/* Designs a Kaiser windowed sinc low pass filter at the interpolated rate with the cut-off frequency at half the lowest
+ * of the input and output rates, and splits it into its branches */
+static void resampler_poly_design(srsran_resampler_poly_t* q)
+{
+  uint32_t L     = q->interp;
+  uint32_t T     = q->nof_taps;
+  uint32_t N     = L * T;
+  double   fc    = 0.5 / SRSRAN_MAX(q->interp, q->decim);
+  double   delay = (N - 1) / 2.0;
+  double   norm  = resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA);
+
+  for (uint32_t i = 0; i < N; i++) {
+    double t = i - delay;
+    double r = (N > 1) ? (2.0 * i / (N - 1) - 1.0) : 0.0;
+    double w = resampler_poly_bessel_i0(RESAMPLER_POLY_KAISER_BETA * sqrt(SRSRAN_MAX(0.0, 1.0 - r * r))) / norm;
+    double h = (t == 0.0) ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+
+    // The interpolation gain compensates the zeros inserted between the input samples
+    float    coeff  = (float)(L * h * w);
+    uint32_t branch = i % L;
+    uint32_t tap    = T - 1 - i / L;
+
+    q->filter[2 * (branch * T + tap)]     = coeff;
+    q->filter[2 * (branch * T + tap) + 1] = coeff;
+  }
+}
+
+int srsran_resampler_poly_init(srsran_resampler_poly_t* q,
+                               double                   input_srate_hz,
+                               double                   output_srate_hz,
+                               uint32_t                 nof_taps)
+{
+  if (q == NULL || !isnormal(input_srate_hz) || !isnormal(output_srate_hz) || input_srate_hz < 0.5 ||
+      output_srate_hz < 0.5 || nof_taps == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Round up the number of taps to fill the SIMD registers
+  nof_taps = SRSRAN_CEIL(nof_taps, 4) * 4;
+
+  if (q->filter != NULL && q->input_srate_hz == input_srate_hz && q->output_srate_hz == output_srate_hz &&
+      q->nof_taps == nof_taps) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Make sure the resampler is freed
+  srsran_resampler_poly_free(q);
+
+  uint64_t in  = (uint64_t)round(input_srate_hz);
+  uint64_t out = (uint64_t)round(output_srate_hz);
+  uint64_t gcd = resampler_poly_gcd(in, out);
+  if (out / gcd > SRSRAN_RESAMPLER_POLY_MAX_PHASES || in / gcd > UINT32_MAX) {
+    ERROR("The ratio between %.0f and %.0f Hz needs too many polyphase branches", input_srate_hz, output_srate_hz);
+    return SRSRAN_ERROR_OUT_OF_BOUNDS;
+  }
+
+  q->input_srate_hz  = input_srate_hz;
+  q->output_srate_hz = output_srate_hz;
+  q->interp          = (uint32_t)(out / gcd);
+  q->decim           = (uint32_t)(in / gcd);
+  q->nof_taps        = nof_taps;
+  q->filter          = srsran_vec_f_malloc(2 * q->interp * q->nof_taps);
+  q->buffer          = srsran_vec_cf_malloc(q->nof_taps - 1 + RESAMPLER_POLY_BLOCK_SZ);
+  if (q->filter == NULL || q->buffer == NULL) {
+    ERROR("Error allocating memory");
+    srsran_resampler_poly_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  resampler_poly_design(q);
+  srsran_resampler_poly_reset_state(q);
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_resampler_poly_reset_state(srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->buffer == NULL) {
+    return;
+  }
+
+  srsran_vec_cf_zero(q->buffer, q->nof_taps - 1);
+  q->phase  = 0;
+  q->offset = 0;
+}
+
+uint32_t srsran_resampler_poly_get_nof_input(const srsran_resampler_poly_t* q, uint32_t nof_output)
+{
+  if (q == NULL || q->interp == 0 || nof_output == 0) {
+    return 0;
+  }
+
+  // The newest input of output k is offset + floor((phase + k * M) / L)
+  return q->offset + (uint32_t)(((uint64_t)q->phase + (uint64_t)(nof_output - 1) * q->decim) / q->interp) + 1;
+}
+
+uint32_t srsran_resampler_poly_get_nof_output(const srsran_resampler_poly_t* q, uint32_t nof_input)
+{
+  if (q == NULL || q->decim == 0 || nof_input <= q->offset) {
+    return 0;
+  }
+
+  // Every output k such that phase + k * M < (nof_input - offset) * L
+  uint64_t span = (uint64_t)(nof_input - q->offset) * q->interp;
+  if (span <= q->phase) {
+    return 0;
+  }
+  return (uint32_t)SRSRAN_CEIL(span - q->phase, (uint64_t)q->decim);
+}
+
+double srsran_resampler_poly_get_delay(const srsran_resampler_poly_t* q)
+{
+  if (q == NULL || q->decim == 0) {
+    return 0.0;
+  }
+
+  return (q->interp * q->nof_taps - 1) / (2.0 * q->decim);
+}
+
+// Dot product of nof_taps complex samples with a branch, the taps are duplicated for the real and imaginary parts
+static inline cf_t resampler_poly_dot_prod(const cf_t* x, const float* h, uint32_t nof_taps)
+{
+  const float* xp = (const float*)x;
+
+#ifdef LV_HAVE_AVX2
+  __m256 acc = _mm256_setzero_ps();
+  for (uint32_t i = 0; i < 2 * nof_taps; i += 8) {
+#ifdef LV_HAVE_FMA
+    acc = _mm256_fmadd_ps(_mm256_loadu_ps(&xp[i]), _mm256_load_ps(&h[i]), acc);
+#else  // LV_HAVE_FMA
+    acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(&xp[i]), _mm256_load_ps(&h[i])));
+#endif // LV_HAVE_FMA
+  }
+
+  // Add the four complex partial sums
+  __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+  sum        = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  return _mm_cvtss_f32(sum) + _mm_cvtss_f32(_mm_shuffle_ps(sum, sum, 1)) * _Complex_I;
+#else  // LV_HAVE_AVX2
+  float re = 0.0f;
+  float im = 0.0f;
+  for (uint32_t i = 0; i < 2 * nof_taps; i += 2) {
+    re += xp[i] * h[i];
+    im += xp[i + 1] * h[i + 1];
+  }
+  return re + im * _Complex_I;
+#endif // LV_HAVE_AVX2
+}
+
+uint32_t srsran_resampler_poly_run(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, uint32_t nof_input)
+{
+  if (q == NULL || q->filter == NULL) {
+    return 0;
+  }
+
+  uint32_t T         = q->nof_taps;
+  uint32_t step_int  = q->decim / q->interp;
+  uint32_t step_frac = q->decim % q->interp;
+  uint32_t count     = 0;
+
+  while (nof_input > 0) {
+    uint32_t n = SRSRAN_MIN(nof_input, RESAMPLER_POLY_BLOCK_SZ);
+
+    // Append the block to the filter memory
+    if (input != NULL) {
+      srsran_vec_cf_copy(&q->buffer[T - 1], input, n);
+      input += n;
+    } else {
+      srsran_vec_cf_zero(&q->buffer[T - 1], n);
+    }
+
+    // The newest sample of the output at offset is buffer[offset + T - 1]
+    while (q->offset < n) {
+      cf_t y = resampler_poly_dot_prod(&q->buffer[q->offset], &q->filter[2 * q->phase * T], T);
+      if (output != NULL) {
+        output[count] = y;
+      }
+      count++;
+
+      q->offset += step_int;
+      q->phase += step_frac;
+      if (q->phase >= q->interp) {
+        q->phase -= q->interp;
+        q->offset++;
+      }
+    }
+
+    // Keep the last T - 1 samples as filter memory
+    q->offset -= n;
+    memmove(q->buffer, &q->buffer[n], (T - 1) * sizeof(cf_t));
+    nof_input -= n;
+  }
+
+  return count;
+}
+
+void srsran_resampler_poly_free(srsran_resampler_poly_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->filter) {
+    free(q->filter);
+  }
+  if (q->buffer) {
+    free(q->buffer);
+  }
+  SRSRAN_MEM_ZERO(q, srsran_resampler_poly_t, 1);
+}
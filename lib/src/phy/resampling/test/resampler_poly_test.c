@@ -0,0 +1,204 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/resampling/resampler_poly.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+#include <complex.h>
+#include <getopt.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+static double   input_srate_hz  = 25e6;
+static double   output_srate_hz = 23.04e6;
+static uint32_t nof_taps        = SRSRAN_RESAMPLER_POLY_DEFAULT_TAPS;
+static uint32_t buffer_size     = 25000;
+static uint32_t repetitions     = 10;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [iotsr]\n", prog);
+  printf("\t-i Input sampling rate in Hz [Default %.0f]\n", input_srate_hz);
+  printf("\t-o Output sampling rate in Hz [Default %.0f]\n", output_srate_hz);
+  printf("\t-t Number of taps of every polyphase branch [Default %d]\n", nof_taps);
+  printf("\t-s Input buffer size [Default %d]\n", buffer_size);
+  printf("\t-r Number of repetitions [Default %d]\n", repetitions);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "iotsr")) != -1) {
+    switch (opt) {
+      case 'i':
+        input_srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 'o':
+        output_srate_hz = strtod(argv[optind], NULL);
+        break;
+      case 't':
+        nof_taps = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        buffer_size = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        repetitions = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Resamples a tone within the LTE occupied bandwidth and measures the error against the ideal tone at the output rate,
+ * delayed by the filter */
+static float test_tone(srsran_resampler_poly_t* q, const cf_t* input, cf_t* output, float freq_hz)
+{
+  srsran_resampler_poly_reset_state(q);
+  uint32_t nof_output = srsran_resampler_poly_run(q, input, output, buffer_size);
+
+  double   delay = srsran_resampler_poly_get_delay(q);
+  uint32_t start = (uint32_t)ceil(2 * delay);
+  float    error = 0.0f;
+  for (uint32_t k = start; k < nof_output; k++) {
+    double t   = (k - delay) / output_srate_hz;
+    cf_t   ref = cexpf(2.0 * M_PI * freq_hz * t * _Complex_I);
+    error += crealf((output[k] - ref) * conjf(output[k] - ref));
+  }
+
+  return srsran_convert_power_to_dB(error / (nof_output - start));
+}
+
+int main(int argc, char** argv)
+{
+  int                     ret        = SRSRAN_ERROR;
+  struct timeval          t[3]       = {};
+  srsran_resampler_poly_t q          = {};
+  srsran_random_t         random_gen = srsran_random_init(0);
+  cf_t*                   input      = NULL;
+  cf_t*                   output     = NULL;
+  cf_t*                   output_blk = NULL;
+
+  parse_args(argc, argv);
+
+  if (srsran_resampler_poly_init(&q, input_srate_hz, output_srate_hz, nof_taps)) {
+    ERROR("Error initialising resampler");
+    goto clean_exit;
+  }
+  printf("L=%d, M=%d, taps=%d, delay=%.1f samples\n",
+         q.interp,
+         q.decim,
+         q.nof_taps,
+         srsran_resampler_poly_get_delay(&q));
+
+  uint32_t max_output = srsran_resampler_poly_get_nof_output(&q, buffer_size);
+  input               = srsran_vec_cf_malloc(buffer_size);
+  output              = srsran_vec_cf_malloc(max_output);
+  output_blk          = srsran_vec_cf_malloc(max_output);
+  if (input == NULL || output == NULL || output_blk == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  // Tones at 10% and 35% of the lowest rate, the latter is at the edge of the LTE occupied bandwidth
+  double min_srate_hz = SRSRAN_MIN(input_srate_hz, output_srate_hz);
+  for (uint32_t i = 0; i < 2; i++) {
+    float freq_hz = (float)((i == 0 ? 0.10 : -0.35) * min_srate_hz);
+    srsran_vec_gen_sine(1.0f, (float)(freq_hz / input_srate_hz), input, buffer_size);
+    float error_dB = test_tone(&q, input, output, freq_hz);
+    printf("Tone %+.2f MHz: error %.1f dB\n", freq_hz / 1e6, error_dB);
+    if (error_dB > -40.0f) {
+      ERROR("Tone error exceeds -40 dB");
+      goto clean_exit;
+    }
+  }
+
+  // Resampling in blocks of random size must give the same samples as a single run
+  srsran_resampler_poly_reset_state(&q);
+  uint32_t nof_output = srsran_resampler_poly_run(&q, input, output, buffer_size);
+  srsran_resampler_poly_reset_state(&q);
+  uint32_t nof_input  = 0;
+  uint32_t nof_blk    = 0;
+  bool     count_fail = false;
+  while (nof_input < buffer_size) {
+    uint32_t n        = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, 3000);
+    n                 = SRSRAN_MIN(n, buffer_size - nof_input);
+    uint32_t expected = srsran_resampler_poly_get_nof_output(&q, n);
+    uint32_t produced = srsran_resampler_poly_run(&q, &input[nof_input], &output_blk[nof_blk], n);
+    count_fail |= (expected != produced);
+    nof_input += n;
+    nof_blk += produced;
+  }
+  if (count_fail || nof_blk != nof_output || memcmp(output, output_blk, nof_output * sizeof(cf_t)) != 0) {
+    ERROR("Block resampling does not match (%d/%d samples)", nof_blk, nof_output);
+    goto clean_exit;
+  }
+
+  // The number of input samples for a given number of output samples must produce at least them, and exactly them
+  // when decimating
+  srsran_resampler_poly_reset_state(&q);
+  for (uint32_t r = 0; r < 100; r++) {
+    uint32_t n        = (uint32_t)srsran_random_uniform_int_dist(random_gen, 1, 3000);
+    uint32_t needed   = srsran_resampler_poly_get_nof_input(&q, n);
+    uint32_t expected = srsran_resampler_poly_get_nof_output(&q, needed);
+    if (expected < n || srsran_resampler_poly_get_nof_output(&q, needed - 1) >= n ||
+        (q.decim >= q.interp && expected != n)) {
+      ERROR("Wrong number of input samples %d for %d output samples", needed, n);
+      goto clean_exit;
+    }
+    srsran_resampler_poly_run(&q, NULL, NULL, needed);
+  }
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t r = 0; r < repetitions; r++) {
+    srsran_resampler_poly_run(&q, input, output, buffer_size);
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  uint64_t duration_us = (uint64_t)(t[0].tv_sec * 1000000UL + t[0].tv_usec);
+  printf("Done %.1f Msps input, %.1f Msps output\n",
+         buffer_size * repetitions / (double)duration_us,
+         nof_output * repetitions / (double)duration_us);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_resampler_poly_free(&q);
+  srsran_random_free(random_gen);
+  if (input) {
+    free(input);
+  }
+  if (output) {
+    free(output);
+  }
+  if (output_blk) {
+    free(output_blk);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -61,6 +61,34 @@ int srsran_pss_init_N_id_2(cf_t* pss_signal_freq, cf_t* pss_signal_time, uint32_
   return ret;
 }
 
+/* Transforms the PSS replicas of every N_id_2 and integer CFO hypothesis for srsran_pss_find_pss_multi() */
+static int pss_multi_generate(srsran_pss_t* q)
+{
+  int      ret         = SRSRAN_SUCCESS;
+  uint32_t buffer_size = q->fft_size + q->frame_size + 1;
+  cf_t     pss_signal_freq[SRSRAN_PSS_LEN];
+
+  cf_t* pss_signal_time = srsran_vec_cf_malloc(buffer_size);
+  if (!pss_signal_time) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2 && ret == SRSRAN_SUCCESS; N_id_2++) {
+    for (uint32_t i = 0; i < q->nof_cfo_i && ret == SRSRAN_SUCCESS; i++) {
+      srsran_vec_cf_zero(pss_signal_time, buffer_size);
+      ret = srsran_pss_init_N_id_2(pss_signal_freq, pss_signal_time, N_id_2, q->fft_size, q->offset + q->cfo_i[i]);
+      if (ret == SRSRAN_SUCCESS) {
+        srsran_dft_run_c(&q->conv_fft.filter_plan, pss_signal_time, q->multi_signal_freq[N_id_2][i]);
+        srsran_vec_f_zero(q->multi_output_avg[N_id_2][i], buffer_size);
+      }
+    }
+  }
+
+  free(pss_signal_time);
+  return ret;
+}
+
 /* Initializes the PSS synchronization object with fft_size=128
  */
 int srsran_pss_init(srsran_pss_t* q, uint32_t frame_size)
@@ -102,6 +130,7 @@ int srsran_pss_init_fft_offset_decim(srsran_pss_t* q,
 
     q->max_fft_size   = max_fft_size;
     q->max_frame_size = max_frame_size;
+    q->offset         = offset;
 
     q->decimate         = decimate;
     uint32_t fft_size   = max_fft_size / q->decimate;
@@ -278,6 +307,12 @@ int srsran_pss_resize(srsran_pss_t* q, uint32_t frame_size, uint32_t fft_size, i
 
 #endif
 
+    q->offset = offset;
+    if (q->nof_cfo_i > 0 && pss_multi_generate(q)) {
+      ERROR("Error generating PSS replicas for fft_size=%d", fft_size);
+      return SRSRAN_ERROR;
+    }
+
     srsran_pss_reset(q);
 
     ret = SRSRAN_SUCCESS;
@@ -297,6 +332,14 @@ void srsran_pss_free(srsran_pss_t* q)
       if (q->pss_signal_freq_full[i]) {
         free(q->pss_signal_freq_full[i]);
       }
+      for (uint32_t j = 0; j < SRSRAN_PSS_MAX_CFO_I; j++) {
+        if (q->multi_signal_freq[i][j]) {
+          free(q->multi_signal_freq[i][j]);
+        }
+        if (q->multi_output_avg[i][j]) {
+          free(q->multi_output_avg[i][j]);
+        }
+      }
     }
 #ifdef CONVOLUTION_FFT
     srsran_conv_fft_cc_free(&q->conv_fft);
@@ -332,6 +375,11 @@ void srsran_pss_reset(srsran_pss_t* q)
 {
   uint32_t buffer_size = q->fft_size + q->frame_size + 1;
   srsran_vec_f_zero(q->conv_output_avg, buffer_size);
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    for (uint32_t i = 0; i < q->nof_cfo_i; i++) {
+      srsran_vec_f_zero(q->multi_output_avg[N_id_2][i], buffer_size);
+    }
+  }
 }
 
 /**
@@ -405,18 +453,18 @@ void srsran_pss_set_ema_alpha(srsran_pss_t* q, float alpha)
   q->ema_alpha = alpha;
 }
 
-float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t conv_output_len)
+static float compute_peak_sidelobe(const float* avg, uint32_t corr_peak_pos, uint32_t conv_output_len)
 {
   // Find end of peak lobe to the right
   int pl_ub = corr_peak_pos + 1;
-  while (q->conv_output_avg[pl_ub + 1] <= q->conv_output_avg[pl_ub] && pl_ub < conv_output_len) {
+  while (avg[pl_ub + 1] <= avg[pl_ub] && pl_ub < conv_output_len) {
     pl_ub++;
   }
   // Find end of peak lobe to the left
   int pl_lb;
   if (corr_peak_pos > 2) {
     pl_lb = corr_peak_pos - 1;
-    while (q->conv_output_avg[pl_lb - 1] <= q->conv_output_avg[pl_lb] && pl_lb > 1) {
+    while (avg[pl_lb - 1] <= avg[pl_lb] && pl_lb > 1) {
       pl_lb--;
     }
   } else {
@@ -429,11 +477,55 @@ float compute_peak_sidelobe(srsran_pss_t* q, uint32_t corr_peak_pos, uint32_t co
   }
   int sl_distance_left = pl_lb;
 
-  int   sl_right        = pl_ub + srsran_vec_max_fi(&q->conv_output_avg[pl_ub], sl_distance_right);
-  int   sl_left         = srsran_vec_max_fi(q->conv_output_avg, sl_distance_left);
-  float side_lobe_value = SRSRAN_MAX(q->conv_output_avg[sl_right], q->conv_output_avg[sl_left]);
+  int   sl_right        = pl_ub + srsran_vec_max_fi(&avg[pl_ub], sl_distance_right);
+  int   sl_left         = srsran_vec_max_fi(avg, sl_distance_left);
+  float side_lobe_value = SRSRAN_MAX(avg[sl_right], avg[sl_left]);
 
-  return q->conv_output_avg[corr_peak_pos] / side_lobe_value;
+  return avg[corr_peak_pos] / side_lobe_value;
+}
+
+/* Averages the power of the correlation in q->conv_output into avg and returns the position of its maximum, corrected
+ * for the decimation. The absolute value of the maximum is stored in peak_abs.
+ */
+static uint32_t
+pss_find_peak(srsran_pss_t* q, float* avg, uint32_t conv_output_len, float* corr_peak_value, float* peak_abs)
+{
+  // Compute modulus square
+  srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+
+  // If enabled, average the absolute value from previous calls
+  if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
+    srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
+    srsran_vec_sc_prod_fff(avg, 1 - q->ema_alpha, avg, conv_output_len - 1);
+
+    srsran_vec_sum_fff(q->conv_output_abs, avg, avg, conv_output_len - 1);
+  } else {
+    memcpy(avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
+  }
+
+  /* Find maximum of the absolute value of the correlation */
+  uint32_t corr_peak_pos = srsran_vec_max_fi(avg, conv_output_len - 1);
+
+  // save absolute value
+  *peak_abs = avg[corr_peak_pos];
+
+#ifdef SRSRAN_PSS_RETURN_PSR
+  if (corr_peak_value) {
+    *corr_peak_value = compute_peak_sidelobe(avg, corr_peak_pos, conv_output_len);
+  }
+#else
+  if (corr_peak_value) {
+    *corr_peak_value = avg[corr_peak_pos];
+  }
+#endif
+
+  if (q->decimate > 1) {
+    int decimation_correction = (q->filter.num_taps - 2);
+    corr_peak_pos             = corr_peak_pos - decimation_correction;
+    corr_peak_pos             = corr_peak_pos * q->decimate;
+  }
+
+  return corr_peak_pos;
 }
 
 /** Performs time-domain PSS correlation.
@@ -489,48 +581,102 @@ int srsran_pss_find_pss(srsran_pss_t* q, const cf_t* input, float* corr_peak_val
       conv_output_len = q->frame_size;
     }
 
-    // Compute modulus square
-    srsran_vec_abs_square_cf(q->conv_output, q->conv_output_abs, conv_output_len - 1);
+    corr_peak_pos = pss_find_peak(q, q->conv_output_avg, conv_output_len, corr_peak_value, &q->peak_value);
 
-    // If enabled, average the absolute value from previous calls
-    if (q->ema_alpha < 1.0 && q->ema_alpha > 0.0) {
-      srsran_vec_sc_prod_fff(q->conv_output_abs, q->ema_alpha, q->conv_output_abs, conv_output_len - 1);
-      srsran_vec_sc_prod_fff(q->conv_output_avg, 1 - q->ema_alpha, q->conv_output_avg, conv_output_len - 1);
-
-      srsran_vec_sum_fff(q->conv_output_abs, q->conv_output_avg, q->conv_output_avg, conv_output_len - 1);
+    if (q->frame_size >= q->fft_size) {
+      ret = (int)corr_peak_pos;
     } else {
-      memcpy(q->conv_output_avg, q->conv_output_abs, sizeof(float) * (conv_output_len - 1));
+      ret = (int)corr_peak_pos + q->fft_size;
     }
+  }
+  return ret;
+}
 
-    /* Find maximum of the absolute value of the correlation */
-    corr_peak_pos = srsran_vec_max_fi(q->conv_output_avg, conv_output_len - 1);
-
-    // save absolute value
-    q->peak_value = q->conv_output_avg[corr_peak_pos];
+/* Enables srsran_pss_find_pss_multi(). Besides the replica of every N_id_2, the input is correlated with the replicas
+ * shifted by each of the nof_cfo_i integer CFO hypotheses in cfo_i, given in subcarriers.
+ */
+int srsran_pss_multi_enable(srsran_pss_t* q, const int* cfo_i, uint32_t nof_cfo_i)
+{
+  if (q == NULL || cfo_i == NULL || nof_cfo_i == 0 || nof_cfo_i > SRSRAN_PSS_MAX_CFO_I) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
 
-#ifdef SRSRAN_PSS_RETURN_PSR
-    if (corr_peak_value) {
-      *corr_peak_value = compute_peak_sidelobe(q, corr_peak_pos, conv_output_len);
-    }
-#else
-    if (corr_peak_value) {
-      *corr_peak_value = q->conv_output_avg[corr_peak_pos];
+  uint32_t max_buffer_size = (q->max_fft_size + q->max_frame_size) / q->decimate + 1;
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    for (uint32_t i = 0; i < nof_cfo_i; i++) {
+      if (!q->multi_signal_freq[N_id_2][i]) {
+        q->multi_signal_freq[N_id_2][i] = srsran_vec_cf_malloc(max_buffer_size);
+      }
+      if (!q->multi_output_avg[N_id_2][i]) {
+        q->multi_output_avg[N_id_2][i] = srsran_vec_f_malloc(max_buffer_size);
+      }
+      if (!q->multi_signal_freq[N_id_2][i] || !q->multi_output_avg[N_id_2][i]) {
+        ERROR("Error allocating memory");
+        return SRSRAN_ERROR;
+      }
     }
-#endif
+  }
 
-    if (q->decimate > 1) {
-      int decimation_correction = (q->filter.num_taps - 2);
-      corr_peak_pos             = corr_peak_pos - decimation_correction;
-      corr_peak_pos             = corr_peak_pos * q->decimate;
-    }
+  q->nof_cfo_i = nof_cfo_i;
+  memcpy(q->cfo_i, cfo_i, sizeof(int) * nof_cfo_i);
 
-    if (q->frame_size >= q->fft_size) {
-      ret = (int)corr_peak_pos;
-    } else {
-      ret = (int)corr_peak_pos + q->fft_size;
+  return pss_multi_generate(q);
+}
+
+/** Correlates the input with the PSS of the three N_id_2, and with each integer CFO hypothesis set by
+ * srsran_pss_multi_enable(). The input is filtered and transformed once, every replica is applied in the frequency
+ * domain. The peak of each N_id_2 is returned in peaks, with the same meaning as srsran_pss_find_pss(). Every replica
+ * keeps its own correlation average.
+ *
+ * Input buffer must be frame_size long, and frame_size must not be shorter than fft_size.
+ */
+int srsran_pss_find_pss_multi(srsran_pss_t* q, const cf_t* input, srsran_pss_peak_t peaks[SRSRAN_NOF_NID_2])
+{
+  if (q == NULL || input == NULL || peaks == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->nof_cfo_i == 0 || q->frame_size < q->fft_size) {
+    ERROR("Error finding PSS peaks, multi N_id_2 correlation is not enabled");
+    return SRSRAN_ERROR;
+  }
+
+  memcpy(q->tmp_input, input, (q->frame_size * q->decimate) * sizeof(cf_t));
+  const cf_t* x = q->tmp_input;
+  if (q->decimate > 1) {
+    srsran_filt_decim_cc_execute(&(q->filter),
+                                 q->tmp_input,
+                                 q->filter.downsampled_input,
+                                 q->filter.filter_output,
+                                 (q->frame_size * q->decimate));
+    x = q->filter.filter_output;
+  }
+
+  // Single forward transform of the input, shared by all the replicas
+  srsran_conv_fft_cc_t* conv            = &q->conv_fft;
+  uint32_t              conv_output_len = conv->output_len - 1;
+  srsran_dft_run_c(&conv->input_plan, x, conv->input_fft);
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    peaks[N_id_2].peak_value = -1.0f;
+    for (uint32_t i = 0; i < q->nof_cfo_i; i++) {
+      srsran_vec_prod_ccc(conv->input_fft, q->multi_signal_freq[N_id_2][i], conv->output_fft, conv->output_len);
+      srsran_dft_run_c(&conv->output_plan, conv->output_fft, q->conv_output);
+
+      float    peak_value = 0.0f;
+      float    peak_abs   = 0.0f;
+      uint32_t peak_pos   = pss_find_peak(q, q->multi_output_avg[N_id_2][i], conv_output_len, &peak_value, &peak_abs);
+
+      if (peak_value > peaks[N_id_2].peak_value) {
+        peaks[N_id_2].peak_pos   = (int)peak_pos;
+        peaks[N_id_2].peak_value = peak_value;
+        peaks[N_id_2].peak_abs   = peak_abs;
+        peaks[N_id_2].cfo_i      = q->cfo_i[i];
+      }
     }
   }
-  return ret;
+
+  return SRSRAN_SUCCESS;
 }
 
 /* Computes frequency-domain channel estimation of the PSS symbol
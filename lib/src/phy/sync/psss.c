@@ -28,7 +28,6 @@
 
 #include "srsran/phy/dft/ofdm.h"
 #include "srsran/phy/utils/debug.h"
-#include "srsran/phy/utils/vector_simd.h"
 #include <srsran/phy/utils/vector.h>
 
 // Generates the sidelink sequences that are used to detect PSSS
@@ -224,7 +223,7 @@ int srsran_psss_find(srsran_psss_t* q, cf_t* input, uint32_t nof_prb, srsran_cp_
     // Peak detection
     q->corr_peak_pos = -1;
     srsran_vec_f_zero(q->shifted_output_abs, fft_size);
-    srsran_vec_abs_cf_simd(q->shifted_output, q->shifted_output_abs, fft_size);
+    srsran_vec_abs_cf(q->shifted_output, q->shifted_output_abs, fft_size);
 
     // Experimental Validation
     uint32_t symbol_sz = (uint32_t)srsran_symbol_sz(nof_prb);
@@ -351,6 +351,10 @@ void srsran_sync_cfo_reset(srsran_sync_t* q, float init_cfo_hz)
   q->cfo_cp_is_set  = false;
   q->cfo_pss_mean   = 0;
   q->cfo_pss_is_set = false;
+  for (uint32_t i = 0; i < SRSRAN_NOF_NID_2; i++) {
+    q->cfo_pss_mean_multi[i]   = 0;
+    q->cfo_pss_is_set_multi[i] = false;
+  }
 }
 
 void srsran_sync_copy_cfo(srsran_sync_t* q, srsran_sync_t* src_obj)
@@ -589,6 +593,26 @@ static float cfo_cp_estimate(srsran_sync_t* q, const cf_t* input)
   return cfo;
 }
 
+/* Updates the CP-based CFO average with the input and returns the input corrected with it, in the temporal buffer */
+static const cf_t* cfo_cp_correct(srsran_sync_t* q, const cf_t* input)
+{
+  float cfo_cp = cfo_cp_estimate(q, input);
+
+  if (!q->cfo_cp_is_set) {
+    q->cfo_cp_mean   = cfo_cp;
+    q->cfo_cp_is_set = true;
+  } else {
+    /* compute exponential moving average CFO */
+    q->cfo_cp_mean = SRSRAN_VEC_EMA(cfo_cp, q->cfo_cp_mean, q->cfo_ema_alpha);
+  }
+
+  DEBUG("CP-CFO: estimated=%f, mean=%f", cfo_cp, q->cfo_cp_mean);
+
+  /* Correct CFO with the averaged CFO estimation */
+  srsran_cfo_correct(&q->cfo_corr_frame, input, q->temp, -q->cfo_cp_mean / q->fft_size);
+  return q->temp;
+}
+
 static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset, int* peak_pos, int* cfo_i)
 {
   float         peak_value;
@@ -616,6 +640,134 @@ static int cfo_i_estimate(srsran_sync_t* q, const cf_t* input, int find_offset,
   return 0;
 }
 
+/* Estimates the CFO, SSS and CP from the PSS found at peak_pos, if the peak is over the threshold */
+static srsran_sync_find_ret_t
+sync_find_from_peak(srsran_sync_t* q, const cf_t* input_ptr, uint32_t find_offset, int peak_pos)
+{
+  srsran_sync_find_ret_t ret;
+
+  /* If peak is over threshold, compute CFO and SSS */
+  if (q->peak_value >= q->threshold || q->threshold == 0) {
+    if (q->cfo_pss_enable && peak_pos >= q->fft_size) {
+      // Filter central bands before PSS-based CFO estimation
+      const cf_t* pss_ptr = &input_ptr[find_offset + peak_pos - q->fft_size];
+      if (q->pss_filtering_enabled) {
+        srsran_pss_filter(&q->pss, pss_ptr, q->pss_filt);
+        pss_ptr = q->pss_filt;
+      }
+
+      // PSS-based CFO estimation
+      q->cfo_pss = srsran_pss_cfo_compute(&q->pss, pss_ptr);
+      if (!q->cfo_pss_is_set) {
+        q->cfo_pss_mean   = q->cfo_pss;
+        q->cfo_pss_is_set = true;
+      } else if (15000 * fabsf(q->cfo_pss) < MAX_CFO_PSS_OFFSET) {
+        q->cfo_pss_mean = SRSRAN_VEC_EMA(q->cfo_pss, q->cfo_pss_mean, q->cfo_ema_alpha);
+      }
+
+      DEBUG("PSS-CFO: filter=%s, estimated=%f, mean=%f",
+            q->pss_filtering_enabled ? "yes" : "no",
+            q->cfo_pss,
+            q->cfo_pss_mean);
+    }
+
+    // If there is enough space for CP and SSS estimation
+    if (peak_pos + find_offset >= 2 * (q->fft_size + SRSRAN_CP_LEN_EXT(q->fft_size))) {
+      // If SSS search is enabled, correlate SSS sequence
+      if (q->sss_en) {
+        int                 sss_idx;
+        uint32_t            nof_frame_type_trials;
+        srsran_frame_type_t frame_type_trials[2];
+        float               sss_corr[2] = {};
+        uint32_t            sf_idx[2], N_id_1[2];
+
+        if (q->detect_frame_type) {
+          nof_frame_type_trials = 2;
+          frame_type_trials[0]  = SRSRAN_FDD;
+          frame_type_trials[1]  = SRSRAN_TDD;
+        } else {
+          frame_type_trials[0]  = q->frame_type;
+          nof_frame_type_trials = 1;
+        }
+
+        q->sss_available = true;
+        q->sss_detected  = false;
+        for (uint32_t f = 0; f < nof_frame_type_trials; f++) {
+          if (frame_type_trials[f] == SRSRAN_FDD) {
+            sss_idx = (int)find_offset + peak_pos - 2 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
+                      SRSRAN_CP_SZ(q->fft_size, q->cp);
+          } else {
+            sss_idx = (int)find_offset + peak_pos - 4 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
+                      SRSRAN_CP_SZ(q->fft_size, q->cp);
+            ;
+          }
+
+          if (sss_idx >= 0) {
+            const cf_t* sss_ptr = &input_ptr[sss_idx];
+
+            // Correct CFO if detected in PSS
+            if (q->cfo_pss_enable) {
+              srsran_cfo_correct(&q->cfo_corr_symbol, sss_ptr, q->sss_filt, -q->cfo_pss_mean / q->fft_size);
+              // Equalize channel if estimated in PSS
+              if (q->sss_channel_equalize && q->pss.chest_on_filter && q->pss_filtering_enabled) {
+                srsran_vec_prod_ccc(&q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
+                                    q->pss.tmp_ce,
+                                    &q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
+                                    SRSRAN_PSS_LEN);
+              }
+              sss_ptr = q->sss_filt;
+            }
+
+            // Consider SSS detected if at least one trial found the SSS
+            q->sss_detected |= sync_sss_symbol(q, sss_ptr, &sf_idx[f], &N_id_1[f], &sss_corr[f]);
+          } else {
+            q->sss_available = false;
+          }
+        }
+
+        if (q->detect_frame_type) {
+          if (sss_corr[0] > sss_corr[1]) {
+            q->frame_type = SRSRAN_FDD;
+            q->sf_idx     = sf_idx[0];
+            q->N_id_1     = N_id_1[0];
+            q->sss_corr   = sss_corr[0];
+          } else {
+            q->frame_type = SRSRAN_TDD;
+            q->sf_idx     = sf_idx[1] + 1;
+            q->N_id_1     = N_id_1[1];
+            q->sss_corr   = sss_corr[1];
+          }
+          DEBUG("SYNC: Detected SSS %s, corr=%.2f/%.2f",
+                q->frame_type == SRSRAN_FDD ? "FDD" : "TDD",
+                sss_corr[0],
+                sss_corr[1]);
+        } else if (q->sss_detected) {
+          if (q->frame_type == SRSRAN_FDD) {
+            q->sf_idx = sf_idx[0];
+          } else {
+            q->sf_idx = sf_idx[0] + 1;
+          }
+          q->N_id_1   = N_id_1[0];
+          q->sss_corr = sss_corr[0];
+        }
+      }
+
+      // Detect CP length
+      if (q->detect_cp) {
+        srsran_sync_set_cp(q, srsran_sync_detect_cp(q, input_ptr, peak_pos + find_offset));
+      }
+
+      ret = SRSRAN_SYNC_FOUND;
+    } else {
+      ret = SRSRAN_SYNC_FOUND_NOSPACE;
+    }
+  } else {
+    ret = SRSRAN_SYNC_NOFOUND;
+  }
+
+  return ret;
+}
+
 /** Finds the PSS sequence previously defined by a call to srsran_sync_set_N_id_2()
  * around the position find_offset in the buffer input.
  *
@@ -666,21 +818,7 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
      * In case of multi-cell, this can lead to incorrect estimations if CFO from different cells is different
      */
     if (q->cfo_cp_enable) {
-      float cfo_cp = cfo_cp_estimate(q, input_ptr);
-
-      if (!q->cfo_cp_is_set) {
-        q->cfo_cp_mean   = cfo_cp;
-        q->cfo_cp_is_set = true;
-      } else {
-        /* compute exponential moving average CFO */
-        q->cfo_cp_mean = SRSRAN_VEC_EMA(cfo_cp, q->cfo_cp_mean, q->cfo_ema_alpha);
-      }
-
-      DEBUG("CP-CFO: estimated=%f, mean=%f", cfo_cp, q->cfo_cp_mean);
-
-      /* Correct CFO with the averaged CFO estimation */
-      srsran_cfo_correct(&q->cfo_corr_frame, input_ptr, q->temp, -q->cfo_cp_mean / q->fft_size);
-      input_ptr = q->temp;
+      input_ptr = cfo_cp_correct(q, input_ptr);
     }
 
     /* Find maximum of PSS correlation. If Integer CFO is enabled, correlation is already done
@@ -706,124 +844,7 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
       peak_pos = 0; // peak_pos + q->decimate*(2);// replace 2 with q->filter_size -2;
     }
 
-    /* If peak is over threshold, compute CFO and SSS */
-    if (q->peak_value >= q->threshold || q->threshold == 0) {
-      if (q->cfo_pss_enable && peak_pos >= q->fft_size) {
-        // Filter central bands before PSS-based CFO estimation
-        const cf_t* pss_ptr = &input_ptr[find_offset + peak_pos - q->fft_size];
-        if (q->pss_filtering_enabled) {
-          srsran_pss_filter(&q->pss, pss_ptr, q->pss_filt);
-          pss_ptr = q->pss_filt;
-        }
-
-        // PSS-based CFO estimation
-        q->cfo_pss = srsran_pss_cfo_compute(&q->pss, pss_ptr);
-        if (!q->cfo_pss_is_set) {
-          q->cfo_pss_mean   = q->cfo_pss;
-          q->cfo_pss_is_set = true;
-        } else if (15000 * fabsf(q->cfo_pss) < MAX_CFO_PSS_OFFSET) {
-          q->cfo_pss_mean = SRSRAN_VEC_EMA(q->cfo_pss, q->cfo_pss_mean, q->cfo_ema_alpha);
-        }
-
-        DEBUG("PSS-CFO: filter=%s, estimated=%f, mean=%f",
-              q->pss_filtering_enabled ? "yes" : "no",
-              q->cfo_pss,
-              q->cfo_pss_mean);
-      }
-
-      // If there is enough space for CP and SSS estimation
-      if (peak_pos + find_offset >= 2 * (q->fft_size + SRSRAN_CP_LEN_EXT(q->fft_size))) {
-        // If SSS search is enabled, correlate SSS sequence
-        if (q->sss_en) {
-          int                 sss_idx;
-          uint32_t            nof_frame_type_trials;
-          srsran_frame_type_t frame_type_trials[2];
-          float               sss_corr[2] = {};
-          uint32_t            sf_idx[2], N_id_1[2];
-
-          if (q->detect_frame_type) {
-            nof_frame_type_trials = 2;
-            frame_type_trials[0]  = SRSRAN_FDD;
-            frame_type_trials[1]  = SRSRAN_TDD;
-          } else {
-            frame_type_trials[0]  = q->frame_type;
-            nof_frame_type_trials = 1;
-          }
-
-          q->sss_available = true;
-          q->sss_detected  = false;
-          for (uint32_t f = 0; f < nof_frame_type_trials; f++) {
-            if (frame_type_trials[f] == SRSRAN_FDD) {
-              sss_idx = (int)find_offset + peak_pos - 2 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
-                        SRSRAN_CP_SZ(q->fft_size, q->cp);
-            } else {
-              sss_idx = (int)find_offset + peak_pos - 4 * SRSRAN_SYMBOL_SZ(q->fft_size, q->cp) +
-                        SRSRAN_CP_SZ(q->fft_size, q->cp);
-              ;
-            }
-
-            if (sss_idx >= 0) {
-              const cf_t* sss_ptr = &input_ptr[sss_idx];
-
-              // Correct CFO if detected in PSS
-              if (q->cfo_pss_enable) {
-                srsran_cfo_correct(&q->cfo_corr_symbol, sss_ptr, q->sss_filt, -q->cfo_pss_mean / q->fft_size);
-                // Equalize channel if estimated in PSS
-                if (q->sss_channel_equalize && q->pss.chest_on_filter && q->pss_filtering_enabled) {
-                  srsran_vec_prod_ccc(&q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
-                                      q->pss.tmp_ce,
-                                      &q->sss_filt[q->fft_size / 2 - SRSRAN_PSS_LEN / 2],
-                                      SRSRAN_PSS_LEN);
-                }
-                sss_ptr = q->sss_filt;
-              }
-
-              // Consider SSS detected if at least one trial found the SSS
-              q->sss_detected |= sync_sss_symbol(q, sss_ptr, &sf_idx[f], &N_id_1[f], &sss_corr[f]);
-            } else {
-              q->sss_available = false;
-            }
-          }
-
-          if (q->detect_frame_type) {
-            if (sss_corr[0] > sss_corr[1]) {
-              q->frame_type = SRSRAN_FDD;
-              q->sf_idx     = sf_idx[0];
-              q->N_id_1     = N_id_1[0];
-              q->sss_corr   = sss_corr[0];
-            } else {
-              q->frame_type = SRSRAN_TDD;
-              q->sf_idx     = sf_idx[1] + 1;
-              q->N_id_1     = N_id_1[1];
-              q->sss_corr   = sss_corr[1];
-            }
-            DEBUG("SYNC: Detected SSS %s, corr=%.2f/%.2f",
-                  q->frame_type == SRSRAN_FDD ? "FDD" : "TDD",
-                  sss_corr[0],
-                  sss_corr[1]);
-          } else if (q->sss_detected) {
-            if (q->frame_type == SRSRAN_FDD) {
-              q->sf_idx = sf_idx[0];
-            } else {
-              q->sf_idx = sf_idx[0] + 1;
-            }
-            q->N_id_1   = N_id_1[0];
-            q->sss_corr = sss_corr[0];
-          }
-        }
-
-        // Detect CP length
-        if (q->detect_cp) {
-          srsran_sync_set_cp(q, srsran_sync_detect_cp(q, input_ptr, peak_pos + find_offset));
-        }
-
-        ret = SRSRAN_SYNC_FOUND;
-      } else {
-        ret = SRSRAN_SYNC_FOUND_NOSPACE;
-      }
-    } else {
-      ret = SRSRAN_SYNC_NOFOUND;
-    }
+    ret = sync_find_from_peak(q, input_ptr, find_offset, peak_pos);
 
     DEBUG("SYNC ret=%d N_id_2=%d find_offset=%d frame_len=%d, pos=%d peak=%.2f threshold=%.2f CFO=%.3f kHz",
           ret,
@@ -842,9 +863,120 @@ srsran_sync_find(srsran_sync_t* q, const cf_t* input, uint32_t find_offset, uint
   return ret;
 }
 
+/** Finds the PSS of the three N_id_2 around the position find_offset in the buffer input. The three replicas are
+ * correlated with a single transform of the input (see srsran_pss_find_pss_multi()), then the CFO, SSS and CP are
+ * estimated for every N_id_2 as srsran_sync_find() does for the one set by srsran_sync_set_N_id_2().
+ *
+ * The CP-based CFO is estimated once for the whole input, while the PSS-based CFO is averaged per N_id_2. If the
+ * integer CFO estimation is enabled, the +1/0/-1 integer hypotheses are correlated for every N_id_2 too.
+ *
+ * The N_id_2, CP and frame type of the object are not modified, the results are stored in res.
+ */
+int srsran_sync_find_multi(srsran_sync_t*          q,
+                           const cf_t*             input,
+                           uint32_t                find_offset,
+                           srsran_sync_multi_res_t res[SRSRAN_NOF_NID_2])
+{
+  static const int cfo_i_list[3] = {0, -1, 1};
+
+  if (q == NULL || input == NULL || res == NULL || !fft_size_isvalid(q->fft_size)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // Generate the replicas on the first call, or after enabling or disabling the integer CFO
+  uint32_t nof_cfo_i = q->cfo_i_enable ? 3 : 1;
+  if (q->pss.nof_cfo_i != nof_cfo_i) {
+    if (srsran_pss_multi_enable(&q->pss, cfo_i_list, nof_cfo_i)) {
+      ERROR("Error enabling multi N_id_2 PSS correlation");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  const cf_t* input_ptr = input;
+  if (q->cfo_cp_enable) {
+    input_ptr = cfo_cp_correct(q, input_ptr);
+  }
+
+  srsran_pss_peak_t peaks[SRSRAN_NOF_NID_2];
+  if (srsran_pss_find_pss_multi(&q->pss, &input_ptr[find_offset], peaks)) {
+    ERROR("Error finding PSS peaks");
+    return SRSRAN_ERROR;
+  }
+
+  // Every N_id_2 is estimated from the same state, which is restored at the end
+  uint32_t            N_id_2         = q->N_id_2;
+  srsran_cp_t         cp             = q->cp;
+  srsran_frame_type_t frame_type     = q->frame_type;
+  float               cfo_pss_mean   = q->cfo_pss_mean;
+  bool                cfo_pss_is_set = q->cfo_pss_is_set;
+  int                 cfo_i_value    = q->cfo_i_value;
+  float               M_norm_avg     = q->M_norm_avg;
+  float               M_ext_avg      = q->M_ext_avg;
+
+  for (uint32_t n = 0; n < SRSRAN_NOF_NID_2; n++) {
+    // The integer CFO correction goes after the CP-corrected frame in the temporal buffer
+    const cf_t* ptr = input_ptr;
+    if (peaks[n].cfo_i != 0) {
+      cf_t* cfo_i_corr = q->cfo_i_corr[peaks[n].cfo_i < 0 ? 0 : 1];
+      srsran_vec_prod_ccc((cf_t*)input_ptr, cfo_i_corr, &q->temp[q->frame_size], q->frame_size);
+      ptr = &q->temp[q->frame_size];
+    }
+
+    q->N_id_2         = n;
+    q->frame_type     = frame_type;
+    q->peak_value     = peaks[n].peak_value;
+    q->cfo_i_value    = peaks[n].cfo_i;
+    q->cfo_pss_mean   = q->cfo_pss_mean_multi[n];
+    q->cfo_pss_is_set = q->cfo_pss_is_set_multi[n];
+    q->M_norm_avg     = q->M_norm_avg_multi[n];
+    q->M_ext_avg      = q->M_ext_avg_multi[n];
+    q->sss_detected   = false;
+    srsran_sync_set_cp(q, cp);
+    srsran_pss_set_N_id_2(&q->pss, n);
+
+    res[n].ret          = sync_find_from_peak(q, ptr, find_offset, peaks[n].peak_pos);
+    res[n].peak_pos     = (uint32_t)peaks[n].peak_pos;
+    res[n].peak_value   = peaks[n].peak_value;
+    res[n].peak_abs     = peaks[n].peak_abs;
+    res[n].sss_detected = q->sss_detected;
+    res[n].cell_id      = q->sss_detected ? srsran_sync_get_cell_id(q) : -1;
+    res[n].sf_idx       = q->sf_idx;
+    res[n].cp           = q->cp;
+    res[n].frame_type   = q->frame_type;
+    res[n].cfo          = srsran_sync_get_cfo(q);
+
+    q->cfo_pss_mean_multi[n]   = q->cfo_pss_mean;
+    q->cfo_pss_is_set_multi[n] = q->cfo_pss_is_set;
+    q->M_norm_avg_multi[n]     = q->M_norm_avg;
+    q->M_ext_avg_multi[n]      = q->M_ext_avg;
+
+    DEBUG("SYNC multi ret=%d N_id_2=%d pos=%d peak=%.2f cfo_i=%d",
+          res[n].ret,
+          n,
+          res[n].peak_pos,
+          res[n].peak_value,
+          peaks[n].cfo_i);
+  }
+
+  q->N_id_2         = N_id_2;
+  q->frame_type     = frame_type;
+  q->cfo_pss_mean   = cfo_pss_mean;
+  q->cfo_pss_is_set = cfo_pss_is_set;
+  q->cfo_i_value    = cfo_i_value;
+  q->M_norm_avg     = M_norm_avg;
+  q->M_ext_avg      = M_ext_avg;
+  srsran_sync_set_cp(q, cp);
+
+  return SRSRAN_SUCCESS;
+}
+
 void srsran_sync_reset(srsran_sync_t* q)
 {
   q->M_ext_avg  = 0;
   q->M_norm_avg = 0;
+  for (uint32_t i = 0; i < SRSRAN_NOF_NID_2; i++) {
+    q->M_ext_avg_multi[i]  = 0;
+    q->M_norm_avg_multi[i] = 0;
+  }
   srsran_pss_reset(&q->pss);
 }
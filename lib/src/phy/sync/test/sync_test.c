@@ -34,23 +34,25 @@
 int         cell_id = -1, offset = 0;
 srsran_cp_t cp      = SRSRAN_CP_NORM;
 uint32_t    nof_prb = 6;
+bool        multi   = false;
 
 #define FLEN SRSRAN_SF_LEN(fft_size)
 
 void usage(char* prog)
 {
-  printf("Usage: %s [cpoev]\n", prog);
+  printf("Usage: %s [cpoemv]\n", prog);
   printf("\t-c cell_id [Default check for all]\n");
   printf("\t-p nof_prb [Default %d]\n", nof_prb);
   printf("\t-o offset [Default %d]\n", offset);
   printf("\t-e extended CP [Default normal]\n");
+  printf("\t-m find all N_id_2 at once [Default %s]\n", multi ? "yes" : "no");
   printf("\t-v srsran_verbose\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "cpoev")) != -1) {
+  while ((opt = getopt(argc, argv, "cpoemv")) != -1) {
     switch (opt) {
       case 'c':
         cell_id = (int)strtol(argv[optind], NULL, 10);
@@ -64,6 +66,9 @@ void parse_args(int argc, char** argv)
       case 'e':
         cp = SRSRAN_CP_EXT;
         break;
+      case 'm':
+        multi = true;
+        break;
       case 'v':
         srsran_verbose++;
         break;
@@ -87,6 +92,8 @@ int main(int argc, char** argv)
   srsran_ofdm_t ifft;
   int           fft_size;
 
+  srsran_sync_multi_res_t res[SRSRAN_NOF_NID_2] = {};
+
   parse_args(argc, argv);
 
   fft_size = srsran_symbol_sz(nof_prb);
@@ -123,6 +130,12 @@ int main(int argc, char** argv)
   srsran_sync_set_threshold(&syncobj, 5.0);
   srsran_sync_set_sss_algorithm(&syncobj, SSS_PARTIAL_3);
 
+  /* Every cell is a new search without averaging, as in the cell search, which detects on every frame */
+  if (multi) {
+    srsran_sync_set_em_alpha(&syncobj, 1);
+    srsran_sync_set_threshold(&syncobj, 3.0);
+  }
+
   if (cell_id == -1) {
     cid     = 0;
     max_cid = 49;
@@ -155,11 +168,24 @@ int main(int argc, char** argv)
       }
       srsran_vec_cf_zero(fft_buffer, offset);
 
-      if (srsran_sync_find(&syncobj, fft_buffer, 0, &find_idx) < 0) {
-        ERROR("Error running srsran_sync_find");
-        exit(-1);
+      if (multi) {
+        if (srsran_sync_find_multi(&syncobj, fft_buffer, 0, res) < 0) {
+          ERROR("Error running srsran_sync_find_multi");
+          exit(-1);
+        }
+        if (res[N_id_2].ret != SRSRAN_SYNC_FOUND || res[N_id_2].cell_id != cid) {
+          printf("cell_id %d not found, ret=%d, found cell_id=%d\n", cid, res[N_id_2].ret, res[N_id_2].cell_id);
+          exit(-1);
+        }
+        find_idx = res[N_id_2].peak_pos;
+        find_sf  = res[N_id_2].sf_idx;
+      } else {
+        if (srsran_sync_find(&syncobj, fft_buffer, 0, &find_idx) < 0) {
+          ERROR("Error running srsran_sync_find");
+          exit(-1);
+        }
+        find_sf = srsran_sync_get_sf_idx(&syncobj);
       }
-      find_sf = srsran_sync_get_sf_idx(&syncobj);
       printf("cell_id: %d find: %d, offset: %d, ns=%d find_ns=%d\n", cid, find_idx, offset, sf_idx, find_sf);
       if (find_idx != offset + FLEN / 2) {
         printf("offset != find_offset: %d != %d\n", find_idx, offset + FLEN / 2);
@@ -169,7 +195,7 @@ int main(int argc, char** argv)
         printf("ns != find_ns\n");
         exit(-1);
       }
-      if (srsran_sync_get_cp(&syncobj) != cp) {
+      if ((multi ? res[N_id_2].cp : srsran_sync_get_cp(&syncobj)) != cp) {
         printf("Detected CP should be %s\n", SRSRAN_CP_ISNORM(cp) ? "Normal" : "Extended");
         exit(-1);
       }
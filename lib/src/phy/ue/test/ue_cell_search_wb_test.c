@@ -0,0 +1,284 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/enb/enb_dl.h"
+#include "srsran/phy/io/filesink.h"
+#include "srsran/phy/io/filesource.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+#define NOF_CARRIERS 3
+
+static uint32_t nof_threads = 2;
+static uint32_t nof_frames  = 8;
+static uint32_t ratio       = 4;
+static float    snr_dB      = 10.0f;
+static char*    input_file  = NULL;
+static char*    output_file = NULL;
+
+/* The last carrier is empty, it checks that no cell is found from the power of the neighbours */
+static float    freq_offset_hz[NOF_CARRIERS] = {-2.0e6f, 1.8e6f, 0.0f};
+static uint32_t cell_id[NOF_CARRIERS]        = {37, 150, 0};
+static uint32_t sfn_start[NOF_CARRIERS]      = {100, 516, 0};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-w Number of threads besides the main one [Default %d]\n", nof_threads);
+  printf("\t-f Number of radio frames in the capture [Default %d]\n", nof_frames);
+  printf("\t-r Capture sampling rate, as a multiple of 1.92 MHz [Default %d]\n", ratio);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_dB);
+  printf("\t-i Scan the capture in this file instead of a generated one [Default %s]\n", input_file);
+  printf("\t-o Save the generated capture to this file [Default %s]\n", output_file);
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "wfrsiov")) != -1) {
+    switch (opt) {
+      case 'w':
+        nof_threads = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'f':
+        nof_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        ratio = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 's':
+        snr_dB = strtof(argv[optind], NULL);
+        break;
+      case 'i':
+        input_file = argv[optind];
+        break;
+      case 'o':
+        output_file = argv[optind];
+        break;
+      case 'v':
+        srsran_verbose++;
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/* Generates the synchronization signals, reference signals and PBCH of a 6 PRB cell, interpolates them to the capture
+ * rate and adds them to the capture at freq_offset_hz */
+static int add_carrier(cf_t* capture, uint32_t nof_samples, uint32_t id, uint32_t sfn, float freq_offset_hz)
+{
+  int                    ret                   = SRSRAN_ERROR;
+  srsran_enb_dl_t        enb_dl                = {};
+  srsran_resampler_fft_t interp                = {};
+  cf_t*                  sf_buffer             = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB));
+  cf_t*                  carrier               = srsran_vec_cf_malloc(nof_samples);
+  cf_t*                  out[SRSRAN_MAX_PORTS] = {sf_buffer};
+  srsran_cell_t          cell                  = {};
+
+  cell.id         = id;
+  cell.nof_prb    = SRSRAN_CS_NOF_PRB;
+  cell.nof_ports  = 1;
+  cell.cp         = SRSRAN_CP_NORM;
+  cell.frame_type = SRSRAN_FDD;
+
+  if (sf_buffer == NULL || carrier == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (srsran_enb_dl_init(&enb_dl, out, cell.nof_prb) || srsran_enb_dl_set_cell(&enb_dl, cell)) {
+    ERROR("Error initiating eNb downlink");
+    goto clean_exit;
+  }
+
+  if (srsran_resampler_fft_init(&interp, SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating interpolator");
+    goto clean_exit;
+  }
+
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB) * ratio;
+  for (uint32_t sf = 0; sf < nof_samples / sf_len; sf++) {
+    srsran_dl_sf_cfg_t dl_sf = {};
+    dl_sf.tti                = (sfn * SRSRAN_NOF_SF_X_FRAME + sf) % 10240;
+    dl_sf.cfi                = 2;
+
+    srsran_enb_dl_put_base(&enb_dl, &dl_sf);
+    srsran_enb_dl_gen_signal(&enb_dl);
+    srsran_resampler_fft_run(&interp, sf_buffer, &carrier[sf * sf_len], SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB));
+  }
+
+  srsran_vec_apply_cfo(carrier, freq_offset_hz / (ratio * SRSRAN_CS_SAMP_FREQ), carrier, nof_samples);
+  srsran_vec_sum_ccc(capture, carrier, capture, nof_samples);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_enb_dl_free(&enb_dl);
+  srsran_resampler_fft_free(&interp);
+  if (sf_buffer) {
+    free(sf_buffer);
+  }
+  if (carrier) {
+    free(carrier);
+  }
+  return ret;
+}
+
+static int generate_capture(cf_t* capture, uint32_t nof_samples)
+{
+  srsran_vec_cf_zero(capture, nof_samples);
+  for (uint32_t i = 0; i < NOF_CARRIERS; i++) {
+    if (cell_id[i] != 0 && add_carrier(capture, nof_samples, cell_id[i], sfn_start[i], freq_offset_hz[i])) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // The noise is referred to the power of a single carrier within its 1.92 MHz band
+  float carrier_power = srsran_vec_avg_power_cf(capture, nof_samples) * ratio / (NOF_CARRIERS - 1);
+  float n0            = carrier_power * srsran_convert_dB_to_power(-snr_dB);
+  srsran_ch_awgn_c(capture, capture, sqrtf(n0 / 2), nof_samples);
+
+  if (output_file) {
+    srsran_filesink_t sink = {};
+    if (srsran_filesink_init(&sink, output_file, SRSRAN_COMPLEX_FLOAT_BIN)) {
+      ERROR("Error opening %s", output_file);
+      return SRSRAN_ERROR;
+    }
+    srsran_filesink_write(&sink, capture, nof_samples);
+    srsran_filesink_free(&sink);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static int read_capture(cf_t* capture, uint32_t nof_samples)
+{
+  srsran_filesource_t source = {};
+  if (srsran_filesource_init(&source, input_file, SRSRAN_COMPLEX_FLOAT_BIN)) {
+    ERROR("Error opening %s", input_file);
+    return SRSRAN_ERROR;
+  }
+  int n = srsran_filesource_read(&source, capture, nof_samples);
+  srsran_filesource_free(&source);
+
+  return n == (int)nof_samples ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
+
+int main(int argc, char** argv)
+{
+  int                              ret                   = SRSRAN_ERROR;
+  srsran_ue_cellsearch_wb_t        cs                    = {};
+  srsran_ue_cellsearch_wb_cfg_t    cfg                   = {};
+  srsran_ue_cellsearch_wb_result_t results[NOF_CARRIERS] = {};
+
+  parse_args(argc, argv);
+
+  uint32_t nof_samples = nof_frames * SRSRAN_NOF_SF_X_FRAME * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB) * ratio;
+  cf_t*    capture     = srsran_vec_cf_malloc(nof_samples);
+  if (capture == NULL) {
+    ERROR("Error allocating memory");
+    goto clean_exit;
+  }
+
+  if (input_file ? read_capture(capture, nof_samples) : generate_capture(capture, nof_samples)) {
+    ERROR("Error getting the capture");
+    goto clean_exit;
+  }
+
+  cfg.max_frames_pss       = 8;
+  cfg.nof_valid_pss_frames = 4;
+  cfg.max_frames_pbch      = 8;
+  if (srsran_ue_cellsearch_wb_init(&cs, ratio * SRSRAN_CS_SAMP_FREQ, nof_threads, &cfg)) {
+    ERROR("Error initiating wideband cell search");
+    goto clean_exit;
+  }
+
+  for (uint32_t i = 0; i < NOF_CARRIERS; i++) {
+    results[i].freq_offset_hz = freq_offset_hz[i];
+  }
+
+  struct timeval t[3];
+  gettimeofday(&t[1], NULL);
+  if (srsran_ue_cellsearch_wb_scan(&cs, capture, nof_samples, results, NOF_CARRIERS)) {
+    ERROR("Error scanning the capture");
+    goto clean_exit;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  for (uint32_t i = 0; i < NOF_CARRIERS; i++) {
+    srsran_ue_cellsearch_wb_result_t* r = &results[i];
+    printf("%+7.1f kHz: nof_cells=%d, cell_id=%d, mib=%s, nof_prb=%d, nof_ports=%d, sfn=%d\n",
+           r->freq_offset_hz / 1000,
+           r->nof_cells,
+           r->nof_cells > 0 ? r->cell.id : -1,
+           r->mib_found ? "yes" : "no",
+           r->cell.nof_prb,
+           r->cell.nof_ports,
+           r->sfn);
+  }
+  printf("Scanned %d carriers in %ld us\n", NOF_CARRIERS, t[0].tv_sec * 1000000 + t[0].tv_usec);
+
+  // Nothing is known about the cells of a file capture
+  if (input_file == NULL) {
+    for (uint32_t i = 0; i < NOF_CARRIERS; i++) {
+      srsran_ue_cellsearch_wb_result_t* r = &results[i];
+      if (cell_id[i] == 0) {
+        if (r->nof_cells != 0) {
+          ERROR("Found a cell in the empty carrier at %.1f kHz", r->freq_offset_hz / 1000);
+          goto clean_exit;
+        }
+        continue;
+      }
+      if (r->nof_cells <= 0 || r->cell.id != cell_id[i]) {
+        ERROR("Cell %d not found at %.1f kHz", cell_id[i], r->freq_offset_hz / 1000);
+        goto clean_exit;
+      }
+      if (!r->mib_found || r->cell.nof_prb != SRSRAN_CS_NOF_PRB || r->cell.nof_ports != 1) {
+        ERROR("MIB of cell %d not decoded", cell_id[i]);
+        goto clean_exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ue_cellsearch_wb_free(&cs);
+  if (capture) {
+    free(capture);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
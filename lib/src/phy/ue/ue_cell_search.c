@@ -66,7 +66,7 @@ int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
     q->sf_buffer[0]    = srsran_vec_cf_malloc(CELL_SEARCH_BUFFER_MAX_SAMPLES);
     q->nof_rx_antennas = 1;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), SRSRAN_NOF_NID_2 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -128,7 +128,7 @@ int srsran_ue_cellsearch_init_multi(
     }
     q->nof_rx_antennas = nof_rx_antennas;
 
-    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), max_frames);
+    q->candidates = calloc(sizeof(srsran_ue_cellsearch_result_t), SRSRAN_NOF_NID_2 * max_frames);
     if (!q->candidates) {
       perror("malloc");
       goto clean_exit;
@@ -189,7 +189,10 @@ int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_
 }
 
 /* Decide the most likely cell based on the mode */
-static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, srsran_ue_cellsearch_result_t* found_cell)
+static void get_cell(srsran_ue_cellsearch_t*              q,
+                     const srsran_ue_cellsearch_result_t* candidates,
+                     uint32_t                             nof_detected_frames,
+                     srsran_ue_cellsearch_result_t*       found_cell)
 {
   uint32_t i, j;
 
@@ -200,7 +203,7 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   for (i = 0; i < nof_detected_frames; i++) {
     uint32_t cnt = 1;
     for (j = i + 1; j < nof_detected_frames; j++) {
-      if (q->candidates[j].cell_id == q->candidates[i].cell_id && !q->mode_counted[j]) {
+      if (candidates[j].cell_id == candidates[i].cell_id && !q->mode_counted[j]) {
         q->mode_counted[j] = 1;
         cnt++;
       }
@@ -214,22 +217,22 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
       mode_pos  = i;
     }
   }
-  found_cell->cell_id = q->candidates[mode_pos].cell_id;
+  found_cell->cell_id = candidates[mode_pos].cell_id;
   /* Now in all these cell IDs, find most frequent CP and duplex mode */
   uint32_t nof_normal = 0;
   uint32_t nof_fdd    = 0;
   found_cell->peak    = 0;
   for (i = 0; i < nof_detected_frames; i++) {
-    if (q->candidates[i].cell_id == found_cell->cell_id) {
-      if (SRSRAN_CP_ISNORM(q->candidates[i].cp)) {
+    if (candidates[i].cell_id == found_cell->cell_id) {
+      if (SRSRAN_CP_ISNORM(candidates[i].cp)) {
         nof_normal++;
       }
-      if (q->candidates[i].frame_type == SRSRAN_FDD) {
+      if (candidates[i].frame_type == SRSRAN_FDD) {
         nof_fdd++;
       }
     }
     // average absolute peak value
-    found_cell->peak += q->candidates[i].peak;
+    found_cell->peak += candidates[i].peak;
   }
   found_cell->peak /= nof_detected_frames;
 
@@ -246,14 +249,16 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   found_cell->mode = (float)q->mode_ntimes[mode_pos] / nof_detected_frames;
 
   // PSR is already averaged so take the last value
-  found_cell->psr = q->candidates[nof_detected_frames - 1].psr;
+  found_cell->psr = candidates[nof_detected_frames - 1].psr;
 
   // CFO is also already averaged
-  found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
+  found_cell->cfo = candidates[nof_detected_frames - 1].cfo;
 }
 
 /** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
  * Each position in found_cell corresponds to a different N_id_2.
+ * The three N_id_2 are searched at once in every received frame, so it takes as many frames as a single
+ * srsran_ue_cellsearch_scan_N_id_2() call.
  * Saves in the pointer max_N_id_2 the N_id_2 index of the cell with the highest PSR
  * Returns the number of found cells or a negative number if error
  */
@@ -261,18 +266,62 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
                               srsran_ue_cellsearch_result_t found_cells[3],
                               uint32_t*                     max_N_id_2)
 {
-  int      ret                = 0;
-  float    max_peak_value     = -1.0;
-  uint32_t nof_detected_cells = 0;
-
-  for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
-    INFO("CELL SEARCH: Starting scan for N_id_2=%d", N_id_2);
-    ret = srsran_ue_cellsearch_scan_N_id_2(q, N_id_2, &found_cells[N_id_2]);
-    if (ret < 0) {
-      ERROR("Error searching cell");
-      return ret;
+  float                   max_peak_value                        = -1.0;
+  uint32_t                nof_detected_cells                    = 0;
+  uint32_t                nof_scanned_frames                    = 0;
+  uint32_t                nof_detected_frames[SRSRAN_NOF_NID_2] = {};
+  srsran_sync_multi_res_t res[SRSRAN_NOF_NID_2];
+
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q->candidates, sizeof(srsran_ue_cellsearch_result_t) * SRSRAN_NOF_NID_2 * q->max_frames);
+
+  srsran_ue_sync_reset(&q->ue_sync);
+  srsran_ue_sync_cfo_reset(&q->ue_sync, 0.0f);
+
+  bool done = false;
+  while (nof_scanned_frames < q->max_frames && !done) {
+    if (srsran_ue_sync_find_multi(&q->ue_sync, q->sf_buffer, CELL_SEARCH_BUFFER_MAX_SAMPLES, res)) {
+      ERROR("Error calling srsran_ue_sync_find_multi()");
+      return SRSRAN_ERROR;
+    }
+
+    done = true;
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      uint32_t n = nof_detected_frames[N_id_2];
+      if (res[N_id_2].ret == SRSRAN_SYNC_FOUND && res[N_id_2].cell_id >= 0 && n < q->nof_valid_frames) {
+        /* Save cell id, cp and peak */
+        srsran_ue_cellsearch_result_t* candidate = &q->candidates[N_id_2 * q->max_frames + n];
+        candidate->cell_id                       = (uint32_t)res[N_id_2].cell_id;
+        candidate->cp                            = res[N_id_2].cp;
+        candidate->peak                          = res[N_id_2].peak_abs;
+        candidate->psr                           = res[N_id_2].peak_value;
+        candidate->cfo                           = 15000 * res[N_id_2].cfo;
+        candidate->frame_type                    = res[N_id_2].frame_type;
+        INFO("CELL SEARCH: [%d/%d/%d]: Found peak PSR=%.3f, Cell_id: %d CP: %s, CFO=%.1f KHz",
+             n,
+             nof_scanned_frames,
+             q->nof_valid_frames,
+             candidate->psr,
+             candidate->cell_id,
+             srsran_cp_string(candidate->cp),
+             candidate->cfo / 1000);
+
+        nof_detected_frames[N_id_2]++;
+      }
+      done &= nof_detected_frames[N_id_2] >= q->nof_valid_frames;
+    }
+
+    nof_scanned_frames++;
+  }
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (nof_detected_frames[N_id_2] > 0) {
+      get_cell(q, &q->candidates[N_id_2 * q->max_frames], nof_detected_frames[N_id_2], &found_cells[N_id_2]);
+      nof_detected_cells++;
     }
-    nof_detected_cells += ret;
     if (max_N_id_2) {
       if (found_cells[N_id_2].peak > max_peak_value) {
         max_peak_value = found_cells[N_id_2].peak;
@@ -347,7 +396,7 @@ int srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t*        q,
     if (nof_detected_frames > 0) {
       ret = 1; // A cell has been found.
       if (found_cell) {
-        get_cell(q, nof_detected_frames, found_cell);
+        get_cell(q, q->candidates, nof_detected_frames, found_cell);
       }
     } else {
       ret = 0; // A cell was not found.
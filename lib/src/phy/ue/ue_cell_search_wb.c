@@ -0,0 +1,298 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+#include <strings.h>
+
+#include "srsran/phy/phch/pbch.h"
+#include "srsran/phy/ue/ue_cell_search_wb.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+
+/* Reads the samples of the carrier being processed by the worker, wrapping around at the end of the capture */
+static int recv_carrier(void* h, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nsamples, srsran_timestamp_t* t)
+{
+  srsran_ue_cellsearch_wb_worker_t* w = (srsran_ue_cellsearch_wb_worker_t*)h;
+
+  uint32_t count = 0;
+  while (count < nsamples) {
+    uint32_t n = SRSRAN_MIN(nsamples - count, w->buffer_len - w->read_idx);
+    if (data != NULL && data[0] != NULL) {
+      srsran_vec_cf_copy(&data[0][count], &w->buffer[w->read_idx], n);
+    }
+    w->read_idx = (w->read_idx + n) % w->buffer_len;
+    count += n;
+  }
+
+  if (t) {
+    bzero(t, sizeof(srsran_timestamp_t));
+  }
+
+  return (int)nsamples;
+}
+
+static int worker_init(srsran_ue_cellsearch_wb_t* q, srsran_ue_cellsearch_wb_worker_t* w)
+{
+  if (srsran_ue_cellsearch_init_multi(&w->cs, q->cfg.max_frames_pss, recv_carrier, 1, w)) {
+    ERROR("Error initiating UE cell detect");
+    return SRSRAN_ERROR;
+  }
+  if (q->cfg.nof_valid_pss_frames) {
+    srsran_ue_cellsearch_set_nof_valid_frames(&w->cs, q->cfg.nof_valid_pss_frames);
+  }
+
+  if (srsran_ue_mib_sync_init_multi(&w->ue_mib, recv_carrier, 1, w)) {
+    ERROR("Error initiating UE MIB sync");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_resampler_fft_init(&w->ddc, SRSRAN_RESAMPLER_MODE_DECIMATE, q->ratio) < SRSRAN_SUCCESS) {
+    ERROR("Error initiating decimator");
+    return SRSRAN_ERROR;
+  }
+
+  // The capture is shifted and decimated one millisecond at a time
+  w->mix_buffer = srsran_vec_cf_malloc(q->ratio * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB));
+  if (w->mix_buffer == NULL) {
+    ERROR("Error allocating memory");
+    return SRSRAN_ERROR;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static void worker_free(srsran_ue_cellsearch_wb_worker_t* w)
+{
+  srsran_ue_cellsearch_free(&w->cs);
+  srsran_ue_mib_sync_free(&w->ue_mib);
+  srsran_resampler_fft_free(&w->ddc);
+  if (w->mix_buffer) {
+    free(w->mix_buffer);
+  }
+  if (w->buffer) {
+    free(w->buffer);
+  }
+  bzero(w, sizeof(srsran_ue_cellsearch_wb_worker_t));
+}
+
+int srsran_ue_cellsearch_wb_init(srsran_ue_cellsearch_wb_t*           q,
+                                 double                               srate_hz,
+                                 uint32_t                             nof_threads,
+                                 const srsran_ue_cellsearch_wb_cfg_t* cfg)
+{
+  if (q == NULL || cfg == NULL || cfg->max_frames_pss == 0) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_ue_cellsearch_wb_t));
+
+  q->ratio = (uint32_t)round(srate_hz / SRSRAN_CS_SAMP_FREQ);
+  if (q->ratio < 2 || fabs(q->ratio * SRSRAN_CS_SAMP_FREQ - srate_hz) > 1.0) {
+    ERROR("Invalid sampling rate %.2f MHz, it must be a multiple of %.2f MHz",
+          srate_hz / 1e6,
+          SRSRAN_CS_SAMP_FREQ / 1e6);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  q->srate_hz = srate_hz;
+  q->cfg      = *cfg;
+
+  if (srsran_task_pool_init(&q->pool, nof_threads)) {
+    ERROR("Error initiating task pool");
+    return SRSRAN_ERROR;
+  }
+
+  // One set of objects for the calling thread and one for each pool thread
+  q->nof_workers = nof_threads + 1;
+  q->workers     = calloc(q->nof_workers, sizeof(srsran_ue_cellsearch_wb_worker_t));
+  if (q->workers == NULL) {
+    ERROR("Error allocating memory");
+    srsran_ue_cellsearch_wb_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < q->nof_workers; i++) {
+    if (worker_init(q, &q->workers[i])) {
+      srsran_ue_cellsearch_wb_free(q);
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_ue_cellsearch_wb_free(srsran_ue_cellsearch_wb_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  srsran_task_pool_free(&q->pool);
+  if (q->workers) {
+    for (uint32_t i = 0; i < q->nof_workers; i++) {
+      worker_free(&q->workers[i]);
+    }
+    free(q->workers);
+  }
+
+  bzero(q, sizeof(srsran_ue_cellsearch_wb_t));
+}
+
+/* Shifts the carrier at freq_offset_hz to baseband and decimates the capture into the worker buffer */
+static void wb_ddc(srsran_ue_cellsearch_wb_t* q, srsran_ue_cellsearch_wb_worker_t* w, float freq_offset_hz)
+{
+  uint32_t chunk_len = q->ratio * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB);
+  float    cfo       = (float)(-freq_offset_hz / q->srate_hz);
+
+  // srsran_vec_apply_cfo() starts every chunk with zero phase, the phase of the oscillator is kept across chunks
+  cf_t phase      = 1.0f;
+  cf_t phase_step = cexpf(_Complex_I * 2.0f * (float)M_PI * cfo * (float)chunk_len);
+
+  srsran_resampler_fft_reset_state(&w->ddc);
+
+  w->buffer_len = 0;
+  w->read_idx   = 0;
+  for (uint32_t i = 0; i + chunk_len <= q->nof_samples; i += chunk_len) {
+    srsran_vec_apply_cfo(&q->input[i], cfo, w->mix_buffer, chunk_len);
+    srsran_vec_sc_prod_ccc(w->mix_buffer, phase, w->mix_buffer, chunk_len);
+    srsran_resampler_fft_run(&w->ddc, w->mix_buffer, &w->buffer[w->buffer_len], chunk_len);
+    w->buffer_len += chunk_len / q->ratio;
+
+    phase *= phase_step;
+    phase /= cabsf(phase);
+  }
+}
+
+/* Searches the cells of one carrier with the objects of the worker running the task */
+static void wb_scan_carrier(void* arg, uint32_t task_idx, uint32_t worker_idx)
+{
+  srsran_ue_cellsearch_wb_t*        q = (srsran_ue_cellsearch_wb_t*)arg;
+  srsran_ue_cellsearch_wb_worker_t* w = &q->workers[worker_idx];
+  srsran_ue_cellsearch_wb_result_t* r = &q->results[task_idx];
+
+  bzero(r->found_cells, sizeof(r->found_cells));
+  bzero(&r->cell, sizeof(srsran_cell_t));
+  r->max_N_id_2 = 0;
+  r->mib_found  = false;
+  r->sfn        = 0;
+
+  wb_ddc(q, w, r->freq_offset_hz);
+
+  r->nof_cells = srsran_ue_cellsearch_scan(&w->cs, r->found_cells, &r->max_N_id_2);
+  if (r->nof_cells <= 0) {
+    return;
+  }
+
+  srsran_ue_cellsearch_result_t* found = &r->found_cells[r->max_N_id_2];
+  r->cell.id                           = found->cell_id;
+  r->cell.cp                           = found->cp;
+  r->cell.frame_type                   = found->frame_type;
+  r->cell.nof_prb                      = SRSRAN_CS_NOF_PRB;
+
+  INFO("CELL SEARCH WB: %.1f kHz, cell_id=%d, PSR=%.2f, CFO=%.1f kHz",
+       r->freq_offset_hz / 1000,
+       found->cell_id,
+       found->psr,
+       found->cfo / 1000);
+
+  if (q->cfg.max_frames_pbch == 0) {
+    return;
+  }
+
+  if (srsran_ue_mib_sync_set_cell(&w->ue_mib, r->cell)) {
+    ERROR("Error setting UE MIB sync cell");
+    r->nof_cells = SRSRAN_ERROR;
+    return;
+  }
+
+  // Start from the CFO estimated by the cell search, as rf_mib_decoder() does
+  w->ue_mib.ue_sync.cfo_current_value       = found->cfo / 15000;
+  w->ue_mib.ue_sync.cfo_is_copied           = true;
+  w->ue_mib.ue_sync.cfo_correct_enable_find = true;
+  srsran_sync_set_cfo_cp_enable(&w->ue_mib.ue_sync.sfind, false, 0);
+
+  uint8_t bch_payload[SRSRAN_BCH_PAYLOAD_LEN] = {};
+  int     sfn_offset                          = 0;
+  int     ret                                 = srsran_ue_mib_sync_decode(
+      &w->ue_mib, q->cfg.max_frames_pbch, bch_payload, &r->cell.nof_ports, &sfn_offset);
+  if (ret < 0) {
+    ERROR("Error decoding MIB");
+    r->nof_cells = SRSRAN_ERROR;
+  } else if (ret == SRSRAN_UE_MIB_FOUND) {
+    srsran_pbch_mib_unpack(bch_payload, &r->cell, &r->sfn);
+    r->sfn       = (r->sfn + sfn_offset) % 1024;
+    r->mib_found = true;
+  }
+}
+
+/** Searches the cells of nof_carriers carriers in the capture input, holding nof_samples samples at the rate given in
+ * srsran_ue_cellsearch_wb_init(). The offset of every carrier is read from results[i].freq_offset_hz and the rest of
+ * results[i] is written with the carrier findings.
+ *
+ * Returns SRSRAN_SUCCESS, or a negative number if the inputs are not valid. The errors of a carrier are reported in its
+ * nof_cells.
+ */
+int srsran_ue_cellsearch_wb_scan(srsran_ue_cellsearch_wb_t*        q,
+                                 const cf_t*                       input,
+                                 uint32_t                          nof_samples,
+                                 srsran_ue_cellsearch_wb_result_t* results,
+                                 uint32_t                          nof_carriers)
+{
+  if (q == NULL || input == NULL || results == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  // At least a radio frame is required for finding the PSS and SSS, even if the capture is read cyclically
+  uint32_t buffer_len = (nof_samples / q->ratio / SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB)) *
+                        SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB);
+  if (buffer_len < SRSRAN_NOF_SF_X_FRAME * SRSRAN_SF_LEN_PRB(SRSRAN_CS_NOF_PRB)) {
+    ERROR("The capture is too short (%d samples)", nof_samples);
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (uint32_t i = 0; i < q->nof_workers; i++) {
+    srsran_ue_cellsearch_wb_worker_t* w = &q->workers[i];
+    if (w->buffer_max_len < buffer_len) {
+      if (w->buffer) {
+        free(w->buffer);
+      }
+      w->buffer = srsran_vec_cf_malloc(buffer_len);
+      if (w->buffer == NULL) {
+        ERROR("Error allocating memory");
+        w->buffer_max_len = 0;
+        return SRSRAN_ERROR;
+      }
+      w->buffer_max_len = buffer_len;
+    }
+  }
+
+  q->input       = input;
+  q->nof_samples = nof_samples;
+  q->results     = results;
+
+  srsran_task_pool_run(&q->pool, nof_carriers, wb_scan_carrier, q);
+
+  q->input   = NULL;
+  q->results = NULL;
+
+  return SRSRAN_SUCCESS;
+}
@@ -824,6 +824,45 @@ int srsran_ue_sync_zerocopy(srsran_ue_sync_t* q,
   return ret;
 }
 
+/* Receives one frame and finds the PSS of every N_id_2 in it. The cell is not tracked, the object stays in find state.
+ * Returns SRSRAN_SUCCESS or a negative number on error
+ */
+int srsran_ue_sync_find_multi(srsran_ue_sync_t*       q,
+                              cf_t*                   input_buffer[SRSRAN_MAX_CHANNELS],
+                              const uint32_t          max_num_samples,
+                              srsran_sync_multi_res_t res[SRSRAN_NOF_NID_2])
+{
+  if (q == NULL || input_buffer == NULL || res == NULL || q->file_mode) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (receive_samples(q, input_buffer, max_num_samples)) {
+    ERROR("Error receiving samples");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_sync_find_multi(&q->sfind, input_buffer[0], 0, res)) {
+    ERROR("Error finding correlation peaks");
+    return SRSRAN_ERROR;
+  }
+
+  /* If any peak was found but there is not enough space for SSS/CP detection, discard a few samples */
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    if (res[N_id_2].ret == SRSRAN_SYNC_FOUND_NOSPACE) {
+      INFO("No space for SSS/CP detection of N_id_2=%d. Realigning frame...", N_id_2);
+      q->recv_callback(q->stream, dummy_offset_buffer, q->frame_len / 2, NULL);
+      srsran_sync_reset(&q->sfind);
+      break;
+    }
+  }
+
+  if (q->do_agc) {
+    srsran_agc_process(&q->agc, input_buffer[0], q->sf_len);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int srsran_ue_sync_run_find_pss_mode(srsran_ue_sync_t* q, cf_t* input_buffer[SRSRAN_MAX_CHANNELS])
 {
   int ret = SRSRAN_ERROR;
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/utils/isa.h"
+#include "srsran/phy/utils/debug.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char* isa_names[] = {"generic", "neon", "sse", "avx", "avx2", "avx512"};
+
+// Cached selection, -1 means not computed yet
+static int isa_selected = -1;
+
+srsran_isa_t srsran_isa_detect()
+{
+#ifdef HAVE_NEON
+  // NEON builds cannot run on a CPU without it
+  return SRSRAN_ISA_NEON;
+#elif defined(__x86_64__) || defined(__i386__)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SRSRAN_ISA_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return SRSRAN_ISA_AVX2;
+  }
+  if (__builtin_cpu_supports("avx")) {
+    return SRSRAN_ISA_AVX;
+  }
+  if (__builtin_cpu_supports("sse4.1")) {
+    return SRSRAN_ISA_SSE;
+  }
+  return SRSRAN_ISA_GENERIC;
+#else
+  return SRSRAN_ISA_GENERIC;
+#endif
+}
+
+srsran_isa_t srsran_isa_compiled()
+{
+#if defined(LV_HAVE_AVX512) || defined(SRSRAN_ISA_DISPATCH_AVX512)
+  return SRSRAN_ISA_AVX512;
+#elif defined(LV_HAVE_AVX2) || defined(SRSRAN_ISA_DISPATCH_AVX2)
+  return SRSRAN_ISA_AVX2;
+#elif defined(LV_HAVE_AVX)
+  return SRSRAN_ISA_AVX;
+#elif defined(LV_HAVE_SSE)
+  return SRSRAN_ISA_SSE;
+#elif defined(HAVE_NEON)
+  return SRSRAN_ISA_NEON;
+#else
+  return SRSRAN_ISA_GENERIC;
+#endif
+}
+
+static srsran_isa_t isa_select()
+{
+  srsran_isa_t isa      = srsran_isa_detect();
+  srsran_isa_t compiled = srsran_isa_compiled();
+  if (isa > compiled) {
+    isa = compiled;
+  }
+
+  // The environment can only narrow the selection, a wider ISA than the CPU supports would crash
+  const char* env = getenv("SRSRAN_ISA");
+  if (env != NULL) {
+    srsran_isa_t requested = SRSRAN_ISA_GENERIC;
+    if (srsran_isa_from_string(env, &requested) < SRSRAN_SUCCESS) {
+      ERROR("Invalid SRSRAN_ISA=%s, using %s", env, srsran_isa_to_string(isa));
+    } else if (requested < isa) {
+      isa = requested;
+    }
+  }
+
+  return isa;
+}
+
+srsran_isa_t srsran_isa_get()
+{
+  // Computed on first use, which happens from the constructors at startup before any thread is created
+  if (isa_selected < 0) {
+    isa_selected = (int)isa_select();
+  }
+  return (srsran_isa_t)isa_selected;
+}
+
+__attribute__((constructor)) static void srsran_isa_init()
+{
+  srsran_isa_get();
+}
+
+const char* srsran_isa_to_string(srsran_isa_t isa)
+{
+  if (isa < SRSRAN_ISA_GENERIC || isa > SRSRAN_ISA_AVX512) {
+    return "unknown";
+  }
+  return isa_names[isa];
+}
+
+int srsran_isa_from_string(const char* str, srsran_isa_t* isa)
+{
+  if (str == NULL || isa == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  for (int i = SRSRAN_ISA_GENERIC; i <= SRSRAN_ISA_AVX512; i++) {
+    if (strcmp(str, isa_names[i]) == 0) {
+      *isa = (srsran_isa_t)i;
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  return SRSRAN_ERROR;
+}
@@ -158,6 +158,81 @@ int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn)
   return SRSRAN_SUCCESS;
 }
 
+void srsran_mat_4x4_mmse_csi_gen(const cf_t y[4],
+                                 cf_t       h[4][4],
+                                 cf_t       x[4],
+                                 float      csi[4],
+                                 uint32_t   nof_rx,
+                                 uint32_t   nof_layers,
+                                 float      noise_estimate)
+{
+  cf_t a[4][4];
+  cf_t b[4][4];
+  cf_t z[4];
+
+  /* 1. A = H' x H + No, B = I and Z = H' x Y */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    z[i] = 0;
+    for (uint32_t n = 0; n < nof_rx; n++) {
+      z[i] += conjf(h[n][i]) * y[n];
+    }
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      a[i][j] = (i == j) ? noise_estimate : 0;
+      b[i][j] = (i == j) ? 1 : 0;
+      for (uint32_t n = 0; n < nof_rx; n++) {
+        a[i][j] += conjf(h[n][i]) * h[n][j];
+      }
+    }
+  }
+
+  /* 2. B = inv(A), by Gauss-Jordan elimination with partial pivoting */
+  for (uint32_t j = 0; j < nof_layers; j++) {
+    uint32_t p = j;
+    for (uint32_t i = j + 1; i < nof_layers; i++) {
+      if (cabsf(a[i][j]) > cabsf(a[p][j])) {
+        p = i;
+      }
+    }
+    for (uint32_t k = 0; k < nof_layers; k++) {
+      cf_t t  = a[j][k];
+      a[j][k] = a[p][k];
+      a[p][k] = t;
+      t       = b[j][k];
+      b[j][k] = b[p][k];
+      b[p][k] = t;
+    }
+
+    cf_t pivot_rcp = srsran_mat_cf_recip_gen(a[j][j]);
+    for (uint32_t k = 0; k < nof_layers; k++) {
+      a[j][k] *= pivot_rcp;
+      b[j][k] *= pivot_rcp;
+    }
+
+    for (uint32_t i = 0; i < nof_layers; i++) {
+      if (i != j) {
+        cf_t f = a[i][j];
+        for (uint32_t k = 0; k < nof_layers; k++) {
+          a[i][k] -= f * a[j][k];
+          b[i][k] -= f * b[j][k];
+        }
+      }
+    }
+  }
+
+  /* 3. X = B x Z */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    x[i] = 0;
+    for (uint32_t k = 0; k < nof_layers; k++) {
+      x[i] += b[i][k] * z[k];
+    }
+  }
+
+  /* 4. Set CSI */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    csi[i] = 1.0f / crealf(b[i][i]);
+  }
+}
+
 #ifdef LV_HAVE_SSE
 #include <smmintrin.h>
 
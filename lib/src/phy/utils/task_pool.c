@@ -0,0 +1,180 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include <stdlib.h>
+#include <strings.h>
+
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/task_pool.h"
+
+typedef struct {
+  pthread_t           pthread;
+  srsran_task_pool_t* pool;
+  uint32_t            idx;
+  bool                started;
+} task_pool_worker_t;
+
+/* Runs the tasks of the current batch until none is left to claim. It must be called with the mutex locked */
+static void task_pool_work(srsran_task_pool_t* q, uint32_t worker_idx)
+{
+  while (q->next_task < q->nof_tasks) {
+    uint32_t task_idx = q->next_task++;
+    pthread_mutex_unlock(&q->mutex);
+
+    q->fn(q->arg, task_idx, worker_idx);
+
+    pthread_mutex_lock(&q->mutex);
+    q->nof_pending--;
+    if (q->nof_pending == 0) {
+      pthread_cond_signal(&q->done_cvar);
+    }
+  }
+}
+
+static void* task_pool_thread(void* arg)
+{
+  task_pool_worker_t* w = (task_pool_worker_t*)arg;
+  srsran_task_pool_t* q = w->pool;
+
+  pthread_mutex_lock(&q->mutex);
+  uint32_t batch_id = q->batch_id;
+  while (true) {
+    while (!q->quit && q->batch_id == batch_id) {
+      pthread_cond_wait(&q->start_cvar, &q->mutex);
+    }
+    if (q->quit) {
+      break;
+    }
+
+    // A late wake up joins whichever batch is running, if any task is left
+    batch_id = q->batch_id;
+    task_pool_work(q, w->idx);
+  }
+  pthread_mutex_unlock(&q->mutex);
+
+  return NULL;
+}
+
+int srsran_task_pool_init(srsran_task_pool_t* q, uint32_t nof_workers)
+{
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  bzero(q, sizeof(srsran_task_pool_t));
+
+  if (pthread_mutex_init(&q->mutex, NULL)) {
+    ERROR("Creating mutex");
+    return SRSRAN_ERROR;
+  }
+  if (pthread_cond_init(&q->start_cvar, NULL) || pthread_cond_init(&q->done_cvar, NULL)) {
+    ERROR("Creating condition variable");
+    return SRSRAN_ERROR;
+  }
+
+  if (nof_workers == 0) {
+    return SRSRAN_SUCCESS;
+  }
+
+  task_pool_worker_t* workers = calloc(nof_workers, sizeof(task_pool_worker_t));
+  if (workers == NULL) {
+    ERROR("Allocating task pool workers");
+    return SRSRAN_ERROR;
+  }
+  q->workers_ptr = workers;
+  q->nof_workers = nof_workers;
+
+  for (uint32_t i = 0; i < nof_workers; i++) {
+    workers[i].pool = q;
+    workers[i].idx  = i + 1;
+    if (pthread_create(&workers[i].pthread, NULL, task_pool_thread, &workers[i])) {
+      ERROR("Creating task pool thread");
+      srsran_task_pool_free(q);
+      return SRSRAN_ERROR;
+    }
+    workers[i].started = true;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void srsran_task_pool_free(srsran_task_pool_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  task_pool_worker_t* workers = (task_pool_worker_t*)q->workers_ptr;
+  if (workers) {
+    pthread_mutex_lock(&q->mutex);
+    q->quit = true;
+    pthread_cond_broadcast(&q->start_cvar);
+    pthread_mutex_unlock(&q->mutex);
+
+    for (uint32_t i = 0; i < q->nof_workers; i++) {
+      if (workers[i].started) {
+        pthread_join(workers[i].pthread, NULL);
+      }
+    }
+    free(workers);
+  }
+
+  pthread_cond_destroy(&q->start_cvar);
+  pthread_cond_destroy(&q->done_cvar);
+  pthread_mutex_destroy(&q->mutex);
+  bzero(q, sizeof(srsran_task_pool_t));
+}
+
+uint32_t srsran_task_pool_nof_workers(const srsran_task_pool_t* q)
+{
+  return q->nof_workers;
+}
+
+void srsran_task_pool_run(srsran_task_pool_t* q, uint32_t nof_tasks, srsran_task_pool_fn_t fn, void* arg)
+{
+  if (q == NULL || fn == NULL || nof_tasks == 0) {
+    return;
+  }
+
+  // Nothing to share, skip the synchronization
+  if (q->nof_workers == 0 || nof_tasks == 1) {
+    for (uint32_t i = 0; i < nof_tasks; i++) {
+      fn(arg, i, 0);
+    }
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  q->fn          = fn;
+  q->arg         = arg;
+  q->nof_tasks   = nof_tasks;
+  q->next_task   = 0;
+  q->nof_pending = nof_tasks;
+  q->batch_id++;
+  pthread_cond_broadcast(&q->start_cvar);
+
+  // The calling thread runs tasks too, then waits for the ones still running in the workers
+  task_pool_work(q, 0);
+  while (q->nof_pending > 0) {
+    pthread_cond_wait(&q->done_cvar, &q->mutex);
+  }
+  pthread_mutex_unlock(&q->mutex);
+}
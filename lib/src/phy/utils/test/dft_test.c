@@ -154,6 +154,53 @@ clean_exit:
   return res;
 }
 
+// Plans of the same transform are shared, each object keeps its own buffers
+int test_dft_shared(cf_t* in)
+{
+  int              res  = -1;
+  srsran_dft_dir_t dir  = forward ? SRSRAN_DFT_FORWARD : SRSRAN_DFT_BACKWARD;
+  cf_t*            out1 = srsran_vec_cf_malloc(N);
+  cf_t*            out2 = srsran_vec_cf_malloc(N);
+
+  srsran_dft_plan_t plan1 = {};
+  srsran_dft_plan_t plan2 = {};
+
+  if (srsran_dft_plan_cache_warm(N, dir, SRSRAN_DFT_COMPLEX) != SRSRAN_SUCCESS) {
+    ERROR("Error warming DFT plan");
+    goto clean_exit;
+  }
+  uint32_t nof_plans = srsran_dft_plan_cache_nof_plans();
+
+  if (srsran_dft_plan(&plan1, N, dir, SRSRAN_DFT_COMPLEX) != SRSRAN_SUCCESS ||
+      srsran_dft_plan(&plan2, N, dir, SRSRAN_DFT_COMPLEX) != SRSRAN_SUCCESS) {
+    ERROR("Error in DFT plan");
+    goto clean_exit;
+  }
+
+  if (srsran_dft_plan_cache_nof_plans() != nof_plans || plan1.p != plan2.p || plan1.in == plan2.in) {
+    ERROR("DFT plans of the same size are not shared");
+    goto clean_exit;
+  }
+
+  srsran_dft_run(&plan1, in, out1);
+  srsran_dft_run(&plan2, in, out2);
+
+  res = 0;
+  for (int i = 0; i < N; i++) {
+    if (cabsf(out1[i] - out2[i]) > 1e-6f) {
+      res = -1;
+    }
+  }
+
+clean_exit:
+  srsran_dft_plan_free(&plan1);
+  srsran_dft_plan_free(&plan2);
+  free(out1);
+  free(out2);
+
+  return res;
+}
+
 int main(int argc, char** argv)
 {
   srsran_random_t random_gen = srsran_random_init(0x1234);
@@ -165,6 +212,9 @@ int main(int argc, char** argv)
   if (test_dft(in) != 0)
     return -1;
 
+  if (test_dft_shared(in) != 0)
+    return -1;
+
   free(in);
   srsran_random_free(random_gen);
   printf("Done\n");
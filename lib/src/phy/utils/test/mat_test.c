@@ -30,11 +30,12 @@
 #include "srsran/phy/utils/mat.h"
 #include "srsran/phy/utils/vector.h"
 #include "srsran/phy/utils/vector_simd.h"
-static bool            inverter    = false;
-static bool            zf_solver   = false;
-static bool            mmse_solver = false;
-static bool            verbose     = false;
-static srsran_random_t random_gen  = NULL;
+static bool            inverter      = false;
+static bool            zf_solver     = false;
+static bool            mmse_solver   = false;
+static bool            solver_4x4    = false;
+static bool            verbose       = false;
+static srsran_random_t random_gen    = NULL;
 
 #define MAXIMUM_ERROR (1e-6f)
 #define RANDOM_F() srsran_random_uniform_real_dist(random_gen, -1.0f, +1.0f)
@@ -72,9 +73,10 @@ double elapsed_us(struct timeval* ts_start, struct timeval* ts_end)
 
 void usage(char* prog)
 {
-  printf("Usage: %s [mzvh]\n", prog);
+  printf("Usage: %s [mz4vh]\n", prog);
   printf("\t-m Test Minimum Mean Squared Error (MMSE) solver\n");
   printf("\t-z Test Zero Forcing (ZF) solver\n");
+  printf("\t-4 Test 4x4 and 4x2 ZF and MMSE solvers\n");
   printf("\t-v Verbose\n");
   printf("\t-h Show this message\n");
 }
@@ -82,7 +84,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "imzvh")) != -1) {
+  while ((opt = getopt(argc, argv, "imz4vh")) != -1) {
     switch (opt) {
       case 'i':
         inverter = true;
@@ -93,6 +95,9 @@ void parse_args(int argc, char** argv)
       case 'z':
         zf_solver = true;
         break;
+      case '4':
+        solver_4x4 = true;
+        break;
       case 'v':
         verbose = true;
         break;
@@ -250,6 +255,125 @@ static bool test_mmse_solver_simd(void)
 
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
+/* Well conditioned random channel, the solvers are compared at float precision */
+static void random_channel_4x4(cf_t h[4][4], uint32_t nof_rx, uint32_t nof_layers)
+{
+  for (uint32_t n = 0; n < nof_rx; n++) {
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      h[n][l] = 0.5f * RANDOM_CF() + (n == l ? 2.0f : 0.0f);
+    }
+  }
+}
+
+static bool test_4x4_zf_solver_gen(void)
+{
+  cf_t  h[4][4], x_gold[4], y[4], x[4];
+  float csi[4];
+  float error = 0.0f;
+
+  random_channel_4x4(h, 4, 4);
+  for (uint32_t l = 0; l < 4; l++) {
+    x_gold[l] = RANDOM_CF();
+  }
+  for (uint32_t n = 0; n < 4; n++) {
+    y[n] = 0;
+    for (uint32_t l = 0; l < 4; l++) {
+      y[n] += h[n][l] * x_gold[l];
+    }
+  }
+
+  srsran_mat_4x4_mmse_csi_gen(y, h, x, csi, 4, 4, 0.0f);
+
+  for (uint32_t l = 0; l < 4; l++) {
+    error += cabsf(x[l] - x_gold[l]) * cabsf(x[l] - x_gold[l]);
+  }
+
+  return (error < MAXIMUM_ERROR);
+}
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+
+/* Compares the SIMD solver with the generic reference for every lane */
+static bool test_4x4_solver_simd(uint32_t nof_rx, uint32_t nof_layers, float noise_estimate)
+{
+  srsran_simd_aligned cf_t  y[4][SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned cf_t  h[4][4][SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned cf_t  x[4][SRSRAN_SIMD_CF_SIZE];
+  srsran_simd_aligned float csi[4][SRSRAN_SIMD_F_SIZE];
+
+  simd_cf_t _y[4], _h[4][4], _x[4];
+  simd_f_t  _csi[4];
+
+  for (uint32_t k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    cf_t h_k[4][4];
+    random_channel_4x4(h_k, nof_rx, nof_layers);
+    for (uint32_t n = 0; n < nof_rx; n++) {
+      y[n][k] = RANDOM_CF();
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        h[n][l][k] = h_k[n][l];
+      }
+    }
+  }
+
+  for (uint32_t n = 0; n < nof_rx; n++) {
+    _y[n] = srsran_simd_cfi_load(y[n]);
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      _h[n][l] = srsran_simd_cfi_load(h[n][l]);
+    }
+  }
+
+  srsran_mat_4x4_mmse_csi_simd(_y, _h, _x, _csi, nof_rx, nof_layers, noise_estimate);
+
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    srsran_simd_cfi_store(x[l], _x[l]);
+    srsran_simd_f_store(csi[l], _csi[l]);
+  }
+
+  float error = 0.0f;
+  for (uint32_t k = 0; k < SRSRAN_SIMD_CF_SIZE; k++) {
+    cf_t  y_k[4], h_k[4][4], x_k[4];
+    float csi_k[4];
+    for (uint32_t n = 0; n < nof_rx; n++) {
+      y_k[n] = y[n][k];
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        h_k[n][l] = h[n][l][k];
+      }
+    }
+
+    srsran_mat_4x4_mmse_csi_gen(y_k, h_k, x_k, csi_k, nof_rx, nof_layers, noise_estimate);
+
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      error += cabsf(x[l][k] - x_k[l]) * cabsf(x[l][k] - x_k[l]);
+      error += (csi[l][k] - csi_k[l]) * (csi[l][k] - csi_k[l]) / (csi_k[l] * csi_k[l]);
+    }
+  }
+  error /= SRSRAN_SIMD_CF_SIZE;
+
+  return (error < MAXIMUM_ERROR);
+}
+
+static bool test_4x4_zf_solver_simd(void)
+{
+  return test_4x4_solver_simd(4, 4, 0.0f);
+}
+
+static bool test_4x4_mmse_solver_simd(void)
+{
+  return test_4x4_solver_simd(4, 4, 0.1f);
+}
+
+static bool test_4x2_zf_solver_simd(void)
+{
+  return test_4x4_solver_simd(4, 2, 0.0f);
+}
+
+static bool test_4x2_mmse_solver_simd(void)
+{
+  return test_4x4_solver_simd(4, 2, 0.1f);
+}
+
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
 static bool test_vec_dot_prod_ccc(void)
 {
   __attribute__((aligned(256))) cf_t a[14];
@@ -318,6 +442,17 @@ int main(int argc, char** argv)
 #endif /* SRSRAN_SIMD_CF_SIZE != 0*/
   }
 
+  if (solver_4x4) {
+    RUN_TEST(test_4x4_zf_solver_gen);
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+    RUN_TEST(test_4x4_zf_solver_simd);
+    RUN_TEST(test_4x4_mmse_solver_simd);
+    RUN_TEST(test_4x2_zf_solver_simd);
+    RUN_TEST(test_4x2_mmse_solver_simd);
+#endif /* SRSRAN_SIMD_CF_SIZE != 0*/
+  }
+
   if (inverter) {
     RUN_TEST(test_matrix_inv);
   }
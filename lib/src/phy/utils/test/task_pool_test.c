@@ -0,0 +1,174 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/common/test_common.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+#include <unistd.h>
+
+#include "srsran/phy/utils/task_pool.h"
+
+#define MAX_TASKS 64
+
+static uint32_t nof_workers = 3;
+static uint32_t nof_batches = 1000;
+
+struct batch_args_t {
+  srsran_task_pool_t* nested;
+  uint32_t            nof_workers;
+  uint32_t            count[MAX_TASKS];
+  uint32_t            bad_worker;
+  uint32_t            nested_count[MAX_TASKS][MAX_TASKS];
+};
+
+static void usage(char* prog)
+{
+  printf("Usage: %s\n", prog);
+  printf("\t-w Number of worker threads [Default %d]\n", nof_workers);
+  printf("\t-b Number of batches [Default %d]\n", nof_batches);
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "wb")) != -1) {
+    switch (opt) {
+      case 'w':
+        nof_workers = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'b':
+        nof_batches = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+static void count_task(void* arg, uint32_t task_idx, uint32_t worker_idx)
+{
+  struct batch_args_t* args = (struct batch_args_t*)arg;
+
+  // Every task has its own counter, no synchronization is required
+  args->count[task_idx]++;
+  if (worker_idx > args->nof_workers) {
+    args->bad_worker++;
+  }
+}
+
+static uint32_t nested_task_idx = 0;
+
+static void nested_count_task(void* arg, uint32_t task_idx, uint32_t worker_idx)
+{
+  struct batch_args_t* args = (struct batch_args_t*)arg;
+  args->nested_count[nested_task_idx][task_idx]++;
+}
+
+static void nested_task(void* arg, uint32_t task_idx, uint32_t worker_idx)
+{
+  struct batch_args_t* args = (struct batch_args_t*)arg;
+
+  // Only the first task submits to the nested pool, which can only be used by one thread at a time
+  if (task_idx == 0) {
+    for (uint32_t i = 0; i < MAX_TASKS; i++) {
+      nested_task_idx = i;
+      srsran_task_pool_run(args->nested, i + 1, nested_count_task, args);
+    }
+  }
+  count_task(arg, task_idx, worker_idx);
+}
+
+static int test_batches(srsran_task_pool_t* pool)
+{
+  struct batch_args_t args = {};
+  args.nof_workers         = srsran_task_pool_nof_workers(pool);
+
+  for (uint32_t b = 0; b < nof_batches; b++) {
+    uint32_t nof_tasks = 1 + b % MAX_TASKS;
+
+    bzero(args.count, sizeof(args.count));
+    srsran_task_pool_run(pool, nof_tasks, count_task, &args);
+
+    for (uint32_t i = 0; i < MAX_TASKS; i++) {
+      TESTASSERT(args.count[i] == (i < nof_tasks ? 1 : 0));
+    }
+  }
+  TESTASSERT(args.bad_worker == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+static int test_nested(srsran_task_pool_t* pool, srsran_task_pool_t* nested)
+{
+  struct batch_args_t args = {};
+  args.nof_workers         = srsran_task_pool_nof_workers(pool);
+  args.nested              = nested;
+
+  srsran_task_pool_run(pool, MAX_TASKS, nested_task, &args);
+
+  for (uint32_t i = 0; i < MAX_TASKS; i++) {
+    TESTASSERT(args.count[i] == 1);
+    for (uint32_t j = 0; j < MAX_TASKS; j++) {
+      TESTASSERT(args.nested_count[i][j] == (j <= i ? 1 : 0));
+    }
+  }
+  TESTASSERT(args.bad_worker == 0);
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int                ret    = SRSRAN_ERROR;
+  srsran_task_pool_t pool   = {};
+  srsran_task_pool_t nested = {};
+  srsran_task_pool_t serial = {};
+
+  parse_args(argc, argv);
+
+  if (srsran_task_pool_init(&pool, nof_workers) || srsran_task_pool_init(&nested, nof_workers) ||
+      srsran_task_pool_init(&serial, 0)) {
+    printf("Error initiating task pools\n");
+    goto clean_exit;
+  }
+
+  if (test_batches(&pool) || test_batches(&serial)) {
+    printf("Error running batches\n");
+    goto clean_exit;
+  }
+
+  if (test_nested(&pool, &nested)) {
+    printf("Error running nested batches\n");
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_task_pool_free(&pool);
+  srsran_task_pool_free(&nested);
+  srsran_task_pool_free(&serial);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -31,6 +31,33 @@
 #include "srsran/phy/utils/vector.h"
 #include "srsran/phy/utils/vector_simd.h"
 
+#ifdef SRSRAN_ISA_DISPATCH
+#include "srsran/phy/utils/isa.h"
+#define SRSRAN_VEC_SIMD_DISPATCH_CALLS
+#include "vector_simd_dispatch.h"
+
+// Kernels used until the constructor below has run, they are valid on any CPU the library runs on
+const srsran_vec_simd_table_t* srsran_vec_simd_table = &srsran_vec_simd_table_base;
+
+__attribute__((constructor)) static void srsran_vec_simd_select()
+{
+  srsran_isa_t isa = srsran_isa_get();
+#ifdef SRSRAN_ISA_DISPATCH_AVX512
+  if (isa >= SRSRAN_ISA_AVX512) {
+    srsran_vec_simd_table = &srsran_vec_simd_table_avx512;
+    return;
+  }
+#endif /* SRSRAN_ISA_DISPATCH_AVX512 */
+#ifdef SRSRAN_ISA_DISPATCH_AVX2
+  if (isa >= SRSRAN_ISA_AVX2) {
+    srsran_vec_simd_table = &srsran_vec_simd_table_avx2;
+    return;
+  }
+#endif /* SRSRAN_ISA_DISPATCH_AVX2 */
+  srsran_vec_simd_table = &srsran_vec_simd_table_base;
+}
+#endif /* SRSRAN_ISA_DISPATCH */
+
 void srsran_vec_xor_bbb(const uint8_t* x, const uint8_t* y, uint8_t* z, const uint32_t len)
 {
   srsran_vec_xor_bbb_simd(x, y, z, len);
@@ -30,6 +30,10 @@
 #include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector_simd.h"
 
+#ifdef SRSRAN_ISA_DISPATCH
+#include "vector_simd_dispatch.h"
+#endif /* SRSRAN_ISA_DISPATCH */
+
 void srsran_vec_xor_bbb_simd(const uint8_t* x, const uint8_t* y, uint8_t* z, const int len)
 {
   int i = 0;
@@ -1782,3 +1786,9 @@ float srsran_vec_estimate_frequency_simd(const cf_t* x, int len)
   // Extract argument and divide by (-2·PI)
   return -cargf(sum) * M_1_PI * 0.5f;
 }
+
+#ifdef SRSRAN_ISA_DISPATCH
+#define SRSRAN_VEC_SIMD_ENTRY(NAME, FUNC) .NAME = FUNC,
+const srsran_vec_simd_table_t SRSRAN_VEC_SIMD_TABLE = {SRSRAN_VEC_SIMD_FOREACH(SRSRAN_VEC_SIMD_ENTRY)};
+#undef SRSRAN_VEC_SIMD_ENTRY
+#endif /* SRSRAN_ISA_DISPATCH */
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * Runtime dispatch of the vector SIMD kernels (ENABLE_ISA_DISPATCH builds only).
+ *
+ * vector_simd.c is compiled once with the baseline flags and once more for every extra ISA level by a small wrapper
+ * (vector_simd_avx2.c, vector_simd_avx512.c) that defines SRSRAN_VEC_SIMD_ISA before including this header, so that
+ * every kernel gets an ISA suffix. Each copy exports a table with its kernels and vector.c calls them through the
+ * table selected at startup, which it requests by defining SRSRAN_VEC_SIMD_DISPATCH_CALLS.
+ */
+
+#ifndef SRSRAN_VECTOR_SIMD_DISPATCH_H
+#define SRSRAN_VECTOR_SIMD_DISPATCH_H
+
+#include "srsran/phy/utils/vector_simd.h"
+
+#define SRSRAN_VEC_SIMD_FOREACH(F)                                                                                     \
+  F(xor_bbb, srsran_vec_xor_bbb_simd)                                                                                  \
+  F(sum_sss, srsran_vec_sum_sss_simd)                                                                                  \
+  F(sub_sss, srsran_vec_sub_sss_simd)                                                                                  \
+  F(sub_bbb, srsran_vec_sub_bbb_simd)                                                                                  \
+  F(acc_ff, srsran_vec_acc_ff_simd)                                                                                    \
+  F(acc_cc, srsran_vec_acc_cc_simd)                                                                                    \
+  F(add_fff, srsran_vec_add_fff_simd)                                                                                  \
+  F(sub_fff, srsran_vec_sub_fff_simd)                                                                                  \
+  F(sc_prod_cfc, srsran_vec_sc_prod_cfc_simd)                                                                          \
+  F(sc_prod_fcc, srsran_vec_sc_prod_fcc_simd)                                                                          \
+  F(sc_prod_fff, srsran_vec_sc_prod_fff_simd)                                                                          \
+  F(sc_prod_ccc, srsran_vec_sc_prod_ccc_simd)                                                                          \
+  F(sc_prod_ccc2, srsran_vec_sc_prod_ccc_simd2)                                                                        \
+  F(prod_ccc_split, srsran_vec_prod_ccc_split_simd)                                                                    \
+  F(prod_sss, srsran_vec_prod_sss_simd)                                                                                \
+  F(neg_sss, srsran_vec_neg_sss_simd)                                                                                  \
+  F(neg_bbb, srsran_vec_neg_bbb_simd)                                                                                  \
+  F(prod_cfc, srsran_vec_prod_cfc_simd)                                                                                \
+  F(prod_fff, srsran_vec_prod_fff_simd)                                                                                \
+  F(prod_ccc, srsran_vec_prod_ccc_simd)                                                                                \
+  F(prod_conj_ccc, srsran_vec_prod_conj_ccc_simd)                                                                      \
+  F(div_ccc, srsran_vec_div_ccc_simd)                                                                                  \
+  F(div_cfc, srsran_vec_div_cfc_simd)                                                                                  \
+  F(div_fff, srsran_vec_div_fff_simd)                                                                                  \
+  F(dot_prod_conj_ccc, srsran_vec_dot_prod_conj_ccc_simd)                                                              \
+  F(dot_prod_ccc, srsran_vec_dot_prod_ccc_simd)                                                                        \
+  F(dot_prod_sss, srsran_vec_dot_prod_sss_simd)                                                                        \
+  F(abs_cf, srsran_vec_abs_cf_simd)                                                                                    \
+  F(abs_square_cf, srsran_vec_abs_square_cf_simd)                                                                      \
+  F(lut_sss, srsran_vec_lut_sss_simd)                                                                                  \
+  F(lut_bbb, srsran_vec_lut_bbb_simd)                                                                                  \
+  F(convert_if, srsran_vec_convert_if_simd)                                                                            \
+  F(convert_fi, srsran_vec_convert_fi_simd)                                                                            \
+  F(convert_conj_cs, srsran_vec_convert_conj_cs_simd)                                                                  \
+  F(convert_fb, srsran_vec_convert_fb_simd)                                                                            \
+  F(interleave, srsran_vec_interleave_simd)                                                                            \
+  F(interleave_add, srsran_vec_interleave_add_simd)                                                                    \
+  F(gen_sine, srsran_vec_gen_sine_simd)                                                                                \
+  F(apply_cfo, srsran_vec_apply_cfo_simd)                                                                              \
+  F(estimate_frequency, srsran_vec_estimate_frequency_simd)                                                            \
+  F(max_fi, srsran_vec_max_fi_simd)                                                                                    \
+  F(max_abs_fi, srsran_vec_max_abs_fi_simd)                                                                            \
+  F(max_ci, srsran_vec_max_ci_simd)
+
+#define SRSRAN_VEC_SIMD_MEMBER(NAME, FUNC) __typeof__(FUNC)* NAME;
+typedef struct {
+  SRSRAN_VEC_SIMD_FOREACH(SRSRAN_VEC_SIMD_MEMBER)
+} srsran_vec_simd_table_t;
+#undef SRSRAN_VEC_SIMD_MEMBER
+
+extern const srsran_vec_simd_table_t srsran_vec_simd_table_base;
+#ifdef SRSRAN_ISA_DISPATCH_AVX2
+extern const srsran_vec_simd_table_t srsran_vec_simd_table_avx2;
+#endif /* SRSRAN_ISA_DISPATCH_AVX2 */
+#ifdef SRSRAN_ISA_DISPATCH_AVX512
+extern const srsran_vec_simd_table_t srsran_vec_simd_table_avx512;
+#endif /* SRSRAN_ISA_DISPATCH_AVX512 */
+
+#define SRSRAN_VEC_SIMD_CAT_(A, B) A##_##B
+#define SRSRAN_VEC_SIMD_CAT(A, B) SRSRAN_VEC_SIMD_CAT_(A, B)
+
+#if defined(SRSRAN_VEC_SIMD_ISA)
+// Kernels and table of an extra ISA level get its suffix, e.g. srsran_vec_acc_ff_simd_avx2
+#define SRSRAN_VEC_SIMD_SYMBOL(NAME, FUNC) SRSRAN_VEC_SIMD_CAT(FUNC, SRSRAN_VEC_SIMD_ISA)
+#define SRSRAN_VEC_SIMD_TABLE SRSRAN_VEC_SIMD_CAT(srsran_vec_simd_table, SRSRAN_VEC_SIMD_ISA)
+#elif defined(SRSRAN_VEC_SIMD_DISPATCH_CALLS)
+// Calls go through the table selected at startup
+extern const srsran_vec_simd_table_t* srsran_vec_simd_table;
+#define SRSRAN_VEC_SIMD_SYMBOL(NAME, FUNC) (srsran_vec_simd_table->NAME)
+#else
+#define SRSRAN_VEC_SIMD_TABLE srsran_vec_simd_table_base
+#endif
+
+#ifdef SRSRAN_VEC_SIMD_SYMBOL
+#define srsran_vec_xor_bbb_simd SRSRAN_VEC_SIMD_SYMBOL(xor_bbb, srsran_vec_xor_bbb_simd)
+#define srsran_vec_sum_sss_simd SRSRAN_VEC_SIMD_SYMBOL(sum_sss, srsran_vec_sum_sss_simd)
+#define srsran_vec_sub_sss_simd SRSRAN_VEC_SIMD_SYMBOL(sub_sss, srsran_vec_sub_sss_simd)
+#define srsran_vec_sub_bbb_simd SRSRAN_VEC_SIMD_SYMBOL(sub_bbb, srsran_vec_sub_bbb_simd)
+#define srsran_vec_acc_ff_simd SRSRAN_VEC_SIMD_SYMBOL(acc_ff, srsran_vec_acc_ff_simd)
+#define srsran_vec_acc_cc_simd SRSRAN_VEC_SIMD_SYMBOL(acc_cc, srsran_vec_acc_cc_simd)
+#define srsran_vec_add_fff_simd SRSRAN_VEC_SIMD_SYMBOL(add_fff, srsran_vec_add_fff_simd)
+#define srsran_vec_sub_fff_simd SRSRAN_VEC_SIMD_SYMBOL(sub_fff, srsran_vec_sub_fff_simd)
+#define srsran_vec_sc_prod_cfc_simd SRSRAN_VEC_SIMD_SYMBOL(sc_prod_cfc, srsran_vec_sc_prod_cfc_simd)
+#define srsran_vec_sc_prod_fcc_simd SRSRAN_VEC_SIMD_SYMBOL(sc_prod_fcc, srsran_vec_sc_prod_fcc_simd)
+#define srsran_vec_sc_prod_fff_simd SRSRAN_VEC_SIMD_SYMBOL(sc_prod_fff, srsran_vec_sc_prod_fff_simd)
+#define srsran_vec_sc_prod_ccc_simd SRSRAN_VEC_SIMD_SYMBOL(sc_prod_ccc, srsran_vec_sc_prod_ccc_simd)
+#define srsran_vec_sc_prod_ccc_simd2 SRSRAN_VEC_SIMD_SYMBOL(sc_prod_ccc2, srsran_vec_sc_prod_ccc_simd2)
+#define srsran_vec_prod_ccc_split_simd SRSRAN_VEC_SIMD_SYMBOL(prod_ccc_split, srsran_vec_prod_ccc_split_simd)
+#define srsran_vec_prod_sss_simd SRSRAN_VEC_SIMD_SYMBOL(prod_sss, srsran_vec_prod_sss_simd)
+#define srsran_vec_neg_sss_simd SRSRAN_VEC_SIMD_SYMBOL(neg_sss, srsran_vec_neg_sss_simd)
+#define srsran_vec_neg_bbb_simd SRSRAN_VEC_SIMD_SYMBOL(neg_bbb, srsran_vec_neg_bbb_simd)
+#define srsran_vec_prod_cfc_simd SRSRAN_VEC_SIMD_SYMBOL(prod_cfc, srsran_vec_prod_cfc_simd)
+#define srsran_vec_prod_fff_simd SRSRAN_VEC_SIMD_SYMBOL(prod_fff, srsran_vec_prod_fff_simd)
+#define srsran_vec_prod_ccc_simd SRSRAN_VEC_SIMD_SYMBOL(prod_ccc, srsran_vec_prod_ccc_simd)
+#define srsran_vec_prod_conj_ccc_simd SRSRAN_VEC_SIMD_SYMBOL(prod_conj_ccc, srsran_vec_prod_conj_ccc_simd)
+#define srsran_vec_div_ccc_simd SRSRAN_VEC_SIMD_SYMBOL(div_ccc, srsran_vec_div_ccc_simd)
+#define srsran_vec_div_cfc_simd SRSRAN_VEC_SIMD_SYMBOL(div_cfc, srsran_vec_div_cfc_simd)
+#define srsran_vec_div_fff_simd SRSRAN_VEC_SIMD_SYMBOL(div_fff, srsran_vec_div_fff_simd)
+#define srsran_vec_dot_prod_conj_ccc_simd SRSRAN_VEC_SIMD_SYMBOL(dot_prod_conj_ccc, srsran_vec_dot_prod_conj_ccc_simd)
+#define srsran_vec_dot_prod_ccc_simd SRSRAN_VEC_SIMD_SYMBOL(dot_prod_ccc, srsran_vec_dot_prod_ccc_simd)
+#define srsran_vec_dot_prod_sss_simd SRSRAN_VEC_SIMD_SYMBOL(dot_prod_sss, srsran_vec_dot_prod_sss_simd)
+#define srsran_vec_abs_cf_simd SRSRAN_VEC_SIMD_SYMBOL(abs_cf, srsran_vec_abs_cf_simd)
+#define srsran_vec_abs_square_cf_simd SRSRAN_VEC_SIMD_SYMBOL(abs_square_cf, srsran_vec_abs_square_cf_simd)
+#define srsran_vec_lut_sss_simd SRSRAN_VEC_SIMD_SYMBOL(lut_sss, srsran_vec_lut_sss_simd)
+#define srsran_vec_lut_bbb_simd SRSRAN_VEC_SIMD_SYMBOL(lut_bbb, srsran_vec_lut_bbb_simd)
+#define srsran_vec_convert_if_simd SRSRAN_VEC_SIMD_SYMBOL(convert_if, srsran_vec_convert_if_simd)
+#define srsran_vec_convert_fi_simd SRSRAN_VEC_SIMD_SYMBOL(convert_fi, srsran_vec_convert_fi_simd)
+#define srsran_vec_convert_conj_cs_simd SRSRAN_VEC_SIMD_SYMBOL(convert_conj_cs, srsran_vec_convert_conj_cs_simd)
+#define srsran_vec_convert_fb_simd SRSRAN_VEC_SIMD_SYMBOL(convert_fb, srsran_vec_convert_fb_simd)
+#define srsran_vec_interleave_simd SRSRAN_VEC_SIMD_SYMBOL(interleave, srsran_vec_interleave_simd)
+#define srsran_vec_interleave_add_simd SRSRAN_VEC_SIMD_SYMBOL(interleave_add, srsran_vec_interleave_add_simd)
+#define srsran_vec_gen_sine_simd SRSRAN_VEC_SIMD_SYMBOL(gen_sine, srsran_vec_gen_sine_simd)
+#define srsran_vec_apply_cfo_simd SRSRAN_VEC_SIMD_SYMBOL(apply_cfo, srsran_vec_apply_cfo_simd)
+#define srsran_vec_estimate_frequency_simd                                                                             \
+  SRSRAN_VEC_SIMD_SYMBOL(estimate_frequency, srsran_vec_estimate_frequency_simd)
+#define srsran_vec_max_fi_simd SRSRAN_VEC_SIMD_SYMBOL(max_fi, srsran_vec_max_fi_simd)
+#define srsran_vec_max_abs_fi_simd SRSRAN_VEC_SIMD_SYMBOL(max_abs_fi, srsran_vec_max_abs_fi_simd)
+#define srsran_vec_max_ci_simd SRSRAN_VEC_SIMD_SYMBOL(max_ci, srsran_vec_max_ci_simd)
+#endif /* SRSRAN_VEC_SIMD_SYMBOL */
+
+#endif // SRSRAN_VECTOR_SIMD_DISPATCH_H
@@ -29,6 +29,16 @@
 
 namespace srsran {
 
+/**
+ * Rate ratios which are not integer are converted by the polyphase resampler. As with the integer ratios, only radio
+ * rates greater than the baseband rate are resampled
+ */
+static bool is_resampler_ratio(double radio_srate, double srate)
+{
+  double ratio = radio_srate / srate;
+  return ratio > 1.0 && std::abs(ratio - std::round(ratio)) > 1e-6 * ratio;
+}
+
 radio::radio() : zeros(nullptr)
 {
   zeros = srsran_vec_cf_malloc(SRSRAN_SF_LEN_MAX);
@@ -59,6 +69,14 @@ radio::~radio()
   for (srsran_resampler_fft_t& q : decimators) {
     srsran_resampler_fft_free(&q);
   }
+
+  for (srsran_resampler_poly_t& q : tx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
+
+  for (srsran_resampler_poly_t& q : rx_resamplers) {
+    srsran_resampler_poly_free(&q);
+  }
 }
 
 int radio::init(const rf_args_t& args, phy_interface_radio* phy_)
@@ -292,25 +310,30 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
 
   // Extract decimation ratio. As the decimation may take some time to set a new ratio, deactivate the decimation and
   // keep receiving samples to avoid stalling the RX stream
-  uint32_t ratio = 1; // No decimation by default
+  uint32_t ratio    = 1; // No decimation by default
+  bool     resample = false;
   if (decimator_busy) {
     lock.unlock();
   } else if (decimators[0].ratio > 1) {
     ratio = decimators[0].ratio;
+  } else if (rx_resamplers[0].interp > 0) {
+    resample = true;
   }
 
   // Calculate number of samples, considering the decimation ratio
-  uint32_t nof_samples = buffer.get_nof_samples() * ratio;
+  uint32_t nof_samples = resample ? srsran_resampler_poly_get_nof_input(&rx_resamplers[0], buffer.get_nof_samples())
+                                  : buffer.get_nof_samples() * ratio;
 
   // Check decimation buffer protection
-  if (ratio > 1 && nof_samples > rx_buffer[0].size()) {
+  bool decimate = ratio > 1 || resample;
+  if (decimate && nof_samples > rx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Rx number of samples ({}/{}) exceeds buffer size ({})",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_samples,
                    rx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
@@ -324,7 +347,7 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
   // If the interpolator have been set, interpolate
   for (uint32_t ch = 0; ch < nof_channels; ch++) {
     // Use rx buffer if decimator is required
-    buffer_rx.set(ch, ratio > 1 ? rx_buffer[ch].data() : buffer.get(ch));
+    buffer_rx.set(ch, decimate ? rx_buffer[ch].data() : buffer.get(ch));
   }
 
   if (not radio_is_streaming) {
@@ -352,6 +375,11 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
         srsran_resampler_fft_run(&decimators[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
       }
     }
+  } else if (resample) {
+    // All channels are resampled, even without output buffer, so they keep the same phase
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      srsran_resampler_poly_run(&rx_resamplers[ch], buffer_rx.get(ch), buffer.get(ch), buffer_rx.get_nof_samples());
+    }
   }
 
   return ret;
@@ -418,25 +446,34 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 {
   bool                         ret = true;
   std::unique_lock<std::mutex> lock(tx_mutex);
-  uint32_t                     ratio = interpolators[0].ratio;
+  uint32_t                     ratio    = interpolators[0].ratio;
+  bool                         resample = tx_resamplers[0].interp > 0;
 
   // Get number of samples at the low rate
   uint32_t nof_samples = buffer.get_nof_samples();
 
+  // Get number of samples at the high rate
+  uint32_t nof_tx_samples =
+      resample ? srsran_resampler_poly_get_nof_output(&tx_resamplers[0], nof_samples) : nof_samples * ratio;
+
   // Check that number of the interpolated samples does not exceed the buffer size
-  if (ratio > 1 && nof_samples * ratio > tx_buffer[0].size()) {
+  if ((ratio > 1 || resample) && nof_tx_samples > tx_buffer[0].size()) {
     // This is a corner case that could happen during sample rate change transitions, as it does not have a negative
     // impact, log it as info.
     fmt::memory_buffer buff;
     fmt::format_to(buff,
                    "Tx number of samples ({}/{}) exceeds buffer size ({})\n",
                    buffer.get_nof_samples(),
-                   buffer.get_nof_samples() * ratio,
+                   nof_tx_samples,
                    tx_buffer[0].size());
     logger.info("%s", to_c_str(buff));
 
     // Limit number of samples to transmit
-    nof_samples = tx_buffer[0].size() / ratio;
+    if (resample) {
+      nof_samples = (uint32_t)((uint64_t)tx_buffer[0].size() * tx_resamplers[0].decim / tx_resamplers[0].interp);
+    } else {
+      nof_samples = tx_buffer[0].size() / ratio;
+    }
   }
 
   // If the interpolator have been set, interpolate
@@ -451,6 +488,16 @@ bool radio::tx(rf_buffer_interface& buffer, const rf_timestamp_interface& tx_tim
 
     // Set buffer size after applying the interpolation
     buffer.set_nof_samples(nof_samples * ratio);
+  } else if (resample) {
+    for (uint32_t ch = 0; ch < nof_channels; ch++) {
+      nof_tx_samples = srsran_resampler_poly_run(&tx_resamplers[ch], buffer.get(ch), tx_buffer[ch].data(), nof_samples);
+
+      // Set the buffer pointer
+      buffer.set(ch, tx_buffer[ch].data());
+    }
+
+    // Set buffer size after applying the resampling
+    buffer.set_nof_samples(nof_tx_samples);
   }
 
   for (uint32_t device_idx = 0; device_idx < (uint32_t)rf_devices.size(); device_idx++) {
@@ -701,10 +748,16 @@ void radio::set_rx_srate(const double& srate)
       }
     }
 
-    // Update decimators
-    uint32_t ratio = (uint32_t)ceil(cur_rx_srate / srate);
+    // Update decimators, the ratios which are not integer are decimated by the polyphase resampler
+    uint32_t ratio    = (uint32_t)ceil(cur_rx_srate / srate);
+    bool     resample = is_resampler_ratio(cur_rx_srate, srate);
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, ratio);
+      srsran_resampler_fft_init(&decimators[ch], SRSRAN_RESAMPLER_MODE_DECIMATE, resample ? 1 : ratio);
+      if (resample) {
+        srsran_resampler_poly_init(&rx_resamplers[ch], cur_rx_srate, srate, SRSRAN_RESAMPLER_POLY_DEFAULT_TAPS);
+      } else {
+        srsran_resampler_poly_free(&rx_resamplers[ch]);
+      }
     }
 
     decimator_busy = false;
@@ -937,10 +990,16 @@ void radio::set_tx_srate(const double& srate)
       }
     }
 
-    // Update interpolators
-    uint32_t ratio = (uint32_t)ceil(cur_tx_srate / srate);
+    // Update interpolators, the ratios which are not integer are interpolated by the polyphase resampler
+    uint32_t ratio    = (uint32_t)ceil(cur_tx_srate / srate);
+    bool     resample = is_resampler_ratio(cur_tx_srate, srate);
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
-      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, ratio);
+      srsran_resampler_fft_init(&interpolators[ch], SRSRAN_RESAMPLER_MODE_INTERPOLATE, resample ? 1 : ratio);
+      if (resample) {
+        srsran_resampler_poly_init(&tx_resamplers[ch], srate, cur_tx_srate, SRSRAN_RESAMPLER_POLY_DEFAULT_TAPS);
+      } else {
+        srsran_resampler_poly_free(&tx_resamplers[ch]);
+      }
     }
   } else {
     for (srsran_rf_t& rf_device : rf_devices) {
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/flat_id_map.h"
+#include "srsran/common/test_common.h"
+#include <map>
+#include <memory>
+#include <random>
+
+namespace srsran {
+
+void test_flat_id_map()
+{
+  flat_id_map<uint16_t, std::string> myobj;
+  TESTASSERT(myobj.size() == 0 and myobj.empty());
+  TESTASSERT(myobj.begin() == myobj.end());
+
+  TESTASSERT(not myobj.contains(0));
+  TESTASSERT(myobj.insert(0, "obj0"));
+  TESTASSERT(myobj.contains(0) and myobj[0] == "obj0");
+  TESTASSERT(myobj.size() == 1 and not myobj.empty());
+  TESTASSERT(myobj.begin() != myobj.end());
+
+  TESTASSERT(not myobj.insert(0, "obj0"));
+  TESTASSERT(myobj.insert(1, "obj1"));
+  TESTASSERT(myobj.contains(0) and myobj.contains(1) and myobj[1] == "obj1");
+  TESTASSERT(myobj.size() == 2 and myobj.count(1) == 1 and myobj.count(2) == 0);
+
+  TESTASSERT(myobj.find(1) != myobj.end());
+  TESTASSERT(myobj.find(1)->first == 1);
+  TESTASSERT(myobj.find(1)->second == "obj1");
+  TESTASSERT(myobj.find(2) == myobj.end());
+
+  // TEST: iteration in insertion order
+  uint32_t count = 0;
+  for (std::pair<uint16_t, std::string>& obj : myobj) {
+    TESTASSERT(obj.second == "obj" + std::to_string(count++));
+  }
+
+  // TEST: erasure moves the last object to the erased position
+  TESTASSERT(myobj.insert(2, "obj2"));
+  TESTASSERT(myobj.erase(0));
+  TESTASSERT(not myobj.erase(0));
+  TESTASSERT(myobj.begin()->first == 2 and myobj.size() == 2);
+  TESTASSERT(myobj[1] == "obj1" and myobj[2] == "obj2");
+
+  auto it = myobj.erase(myobj.find(2));
+  TESTASSERT(it != myobj.end() and it->first == 1);
+  it = myobj.erase(it);
+  TESTASSERT(it == myobj.end() and myobj.empty());
+
+  TESTASSERT(myobj.insert(0, "obj0"));
+  TESTASSERT(myobj.insert(1, "obj1"));
+  myobj.clear();
+  TESTASSERT(myobj.size() == 0 and myobj.empty() and not myobj.contains(0));
+}
+
+void test_flat_id_map_unique_ptr()
+{
+  flat_id_map<uint16_t, std::unique_ptr<int> > myobj;
+
+  auto ret = myobj.insert(0x46, std::unique_ptr<int>(new int{5}));
+  TESTASSERT(ret.has_value() and ret.value()->first == 0x46);
+
+  // TEST: the object is returned when the ID already exists
+  ret = myobj.insert(0x46, std::unique_ptr<int>(new int{6}));
+  TESTASSERT(not ret.has_value() and *ret.error() == 6);
+
+  // TEST: the objects keep their address when stored by pointer
+  int* ptr = myobj[0x46].get();
+  for (uint16_t rnti = 0x47; rnti < 0x47 + 1000; ++rnti) {
+    TESTASSERT(myobj.insert(rnti, std::unique_ptr<int>(new int{rnti})).has_value());
+  }
+  TESTASSERT(myobj[0x46].get() == ptr and *ptr == 5);
+  TESTASSERT(myobj.size() == 1001);
+}
+
+struct C {
+  explicit C(uint32_t id_) : id(id_) { count++; }
+  ~C() { count--; }
+  C(C&& other) noexcept : id(other.id) { count++; }
+  C(const C&) = delete;
+  C& operator=(C&&) = delete;
+
+  const uint32_t id;
+  static size_t  count;
+};
+size_t C::count = 0;
+
+void test_flat_id_map_random()
+{
+  std::mt19937 rgen(0);
+  TESTASSERT(C::count == 0);
+  {
+    // The IDs are taken from a small range, so that the probe sequences collide and wrap around
+    flat_id_map<uint32_t, C>  mymap(4);
+    std::map<uint32_t, bool> expected;
+    for (uint32_t i = 0; i < 20000; ++i) {
+      uint32_t id = std::uniform_int_distribution<uint32_t>{0, 255}(rgen) * 64;
+      if (std::uniform_int_distribution<uint32_t>{0, 2}(rgen) != 0) {
+        bool inserted = mymap.insert(id, C{id}).has_value();
+        TESTASSERT(inserted == (expected.count(id) == 0));
+        expected[id] = true;
+      } else {
+        TESTASSERT(mymap.erase(id) == (expected.erase(id) > 0));
+      }
+      TESTASSERT(mymap.size() == expected.size());
+      TESTASSERT(C::count == expected.size());
+    }
+
+    for (auto& e : expected) {
+      TESTASSERT(mymap.contains(e.first) and mymap[e.first].id == e.first);
+    }
+    for (auto& obj : mymap) {
+      TESTASSERT(expected.count(obj.first) == 1 and obj.second.id == obj.first);
+    }
+  }
+  TESTASSERT(C::count == 0);
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_flat_id_map();
+  srsran::test_flat_id_map_unique_ptr();
+  srsran::test_flat_id_map_random();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/adt/mpsc_queue.h"
+#include "srsran/common/test_common.h"
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace srsran {
+
+void test_mpsc_queue()
+{
+  mpsc_queue<int> queue(3);
+  TESTASSERT(queue.capacity() == 4);
+
+  int val = 0;
+  TESTASSERT(not queue.try_pop(val));
+  for (int i = 0; i < 4; ++i) {
+    val = i;
+    TESTASSERT(queue.try_push(val));
+  }
+
+  // TEST: push to a full queue fails
+  val = 4;
+  TESTASSERT(not queue.try_push(val));
+  TESTASSERT(val == 4);
+
+  // TEST: objects are popped in FIFO order, also after the indexes wrap around
+  for (int i = 0; i < 4; ++i) {
+    TESTASSERT(queue.try_pop(val) and val == i);
+    val = i + 4;
+    TESTASSERT(queue.try_push(val));
+  }
+  for (int i = 4; i < 8; ++i) {
+    TESTASSERT(queue.try_pop(val) and val == i);
+  }
+  TESTASSERT(not queue.try_pop(val));
+}
+
+void test_mpsc_queue_unique_ptr()
+{
+  mpsc_queue<std::unique_ptr<int> > queue(16);
+
+  std::unique_ptr<int> ptr(new int{5});
+  TESTASSERT(queue.try_push(ptr));
+  TESTASSERT(ptr == nullptr);
+
+  std::unique_ptr<int> ptr2;
+  TESTASSERT(queue.try_pop(ptr2));
+  TESTASSERT(*ptr2 == 5);
+}
+
+void test_mpsc_queue_multiple_producers()
+{
+  const uint32_t nof_producers = 4, nof_pushes = 100000;
+
+  // Each object carries the producer index in the upper bits
+  mpsc_queue<uint32_t>     queue(64);
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < nof_producers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (uint32_t i = 0; i < nof_pushes; ++i) {
+        uint32_t val = (p << 24u) | i;
+        while (not queue.try_push(val)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // TEST: every object is popped once, and each producer's objects keep their order
+  std::vector<uint32_t> next_idx(nof_producers, 0);
+  for (uint32_t count = 0; count < nof_producers * nof_pushes;) {
+    uint32_t val;
+    if (not queue.try_pop(val)) {
+      std::this_thread::yield();
+      continue;
+    }
+    uint32_t p = val >> 24u;
+    TESTASSERT(p < nof_producers);
+    TESTASSERT((val & 0xffffffu) == next_idx[p]);
+    next_idx[p]++;
+    count++;
+  }
+
+  for (auto& t : producers) {
+    t.join();
+  }
+  uint32_t val;
+  TESTASSERT(not queue.try_pop(val));
+}
+
+} // namespace srsran
+
+int main(int argc, char** argv)
+{
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::info);
+
+  srsran::test_init(argc, argv);
+
+  srsran::test_mpsc_queue();
+  srsran::test_mpsc_queue_unique_ptr();
+  srsran::test_mpsc_queue_multiple_producers();
+
+  printf("Success\n");
+  return SRSRAN_SUCCESS;
+}
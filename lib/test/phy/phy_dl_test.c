@@ -258,24 +258,7 @@ check_softbits(srsran_enb_dl_t* enb_dl, srsran_ue_dl_t* ue_dl, srsran_ue_dl_cfg_
 {
   int ret = SRSRAN_SUCCESS;
 
-  // Scramble
-  if (ue_dl->pdsch.llr_is_8bit) {
-    srsran_sequence_pdsch_apply_c(ue_dl->pdsch.e[tb],
-                                  ue_dl->pdsch.e[tb],
-                                  rnti,
-                                  ue_dl_cfg->cfg.pdsch.grant.tb[tb].cw_idx,
-                                  2 * (sf_idx % 10),
-                                  cell.id,
-                                  ue_dl_cfg->cfg.pdsch.grant.tb[tb].nof_bits);
-  } else {
-    srsran_sequence_pdsch_apply_s(ue_dl->pdsch.e[tb],
-                                  ue_dl->pdsch.e[tb],
-                                  rnti,
-                                  ue_dl_cfg->cfg.pdsch.grant.tb[tb].cw_idx,
-                                  2 * (sf_idx % 10),
-                                  cell.id,
-                                  ue_dl_cfg->cfg.pdsch.grant.tb[tb].nof_bits);
-  }
+  // The PDSCH descrambles the soft bits while rate dematching, they are still scrambled as the transmitted ones
   int16_t* rx       = ue_dl->pdsch.e[tb];
   uint8_t* rx_bytes = ue_dl->pdsch.e[tb];
   for (int i = 0, k = 0; i < ue_dl_cfg->cfg.pdsch.grant.tb[tb].nof_bits / 8; i++) {
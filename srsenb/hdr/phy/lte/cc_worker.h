@@ -22,9 +22,12 @@
 #ifndef SRSENB_CC_WORKER_H
 #define SRSENB_CC_WORKER_H
 
+#include <atomic>
+#include <condition_variable>
 #include <string.h>
 
 #include "../phy_common.h"
+#include "srsran/common/threads.h"
 #include "srsran/srslog/srslog.h"
 
 #define LOG_EXECTIME
@@ -67,11 +70,48 @@ private:
   constexpr static float PUSCH_RL_SNR_DB_TH = 1.0f;
   constexpr static float PUCCH_RL_CORR_TH   = 0.15f;
 
+  // Turbo decoder iterations granted to every PUSCH even when the subframe iteration budget is exhausted. Iterations
+  // are counted in half iterations as pusch_max_its, 2 is one full iteration through both constituent decoders
+  constexpr static uint32_t PUSCH_MIN_ITS = 2;
+
+  // PUSCH helper threads run with the same priority as the PHY workers
+  constexpr static int PUSCH_HELPER_THREAD_PRIO = 2;
+
+  // Outcome of decoding a PUSCH grant, kept until it is reported to the stack
+  struct pusch_decode_t {
+    srsran_ul_cfg_t       ul_cfg       = {};
+    srsran_pusch_res_t    pusch_res    = {};
+    srsran_chest_ul_res_t chest_res    = {}; // Only the measurements, the channel estimates are not kept
+    bool                  ue_found     = false; // Snapshot of ue_db taken by the worker, helpers do not access it
+    bool                  decoded      = false;
+    bool                  uci_required = false;
+  };
+
+  // Decodes PUSCH grants of the current subframe together with the worker, using its own PUSCH receiver
+  class pusch_helper : public srsran::thread
+  {
+  public:
+    explicit pusch_helper(cc_worker* parent_) : thread("PUSCH_HELPER"), parent(parent_) {}
+    srsran_enb_ul_pusch_t rx   = {};
+    srsran_cell_t         cell = {}; // Cell the receiver is configured for, nof_prb is 0 until it is set
+
+  private:
+    void       run_thread() override;
+    cc_worker* parent = nullptr;
+  };
+
   int  encode_pdsch(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
   int  encode_pmch(stack_interface_phy_lte::dl_sched_grant_t* grant, srsran_mbsfn_cfg_t* mbsfn_cfg);
+  bool set_pusch_decoder(srsran_pusch_t* pusch);
+  bool init_pusch_helpers(uint32_t nof_helpers, uint32_t nof_prb);
+  bool set_pusch_helpers_cell();
+  void stop_pusch_helpers();
+  bool wait_pusch_grants(uint32_t& round);
+  void decode_pusch_grants(srsran_enb_ul_pusch_t* rx);
   void decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                         srsran_ul_cfg_t&                           ul_cfg,
-                         srsran_pusch_res_t&                        pusch_res);
+                         pusch_decode_t&                            dec,
+                         srsran_enb_ul_pusch_t*                     rx);
+  void report_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_decode_t& dec);
   void decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch);
   int  encode_phich(stack_interface_phy_lte::ul_sched_ack_t* acks, uint32_t nof_acks);
   int  encode_pdcch_dl(stack_interface_phy_lte::dl_sched_grant_t* grants, uint32_t nof_grants);
@@ -123,6 +163,21 @@ private:
   // Each worker keeps a local copy of the user database. Uses more memory but more efficient to manage concurrency
   std::map<uint16_t, ue*> ue_db;
   std::mutex              mutex;
+
+  // PUSCH grants of the subframe being decoded. The worker and the helpers take them in pusch_order from pusch_next and
+  // the results, indexed by grant, are reported to the stack in the scheduler order once all of them are decoded
+  std::vector<std::unique_ptr<pusch_helper> >                     pusch_helpers;
+  std::array<pusch_decode_t, stack_interface_phy_lte::MAX_GRANTS> pusch_decodes    = {};
+  std::array<uint32_t, stack_interface_phy_lte::MAX_GRANTS>       pusch_order      = {};
+  stack_interface_phy_lte::ul_sched_grant_t*                      pusch_grants     = nullptr;
+  uint32_t                                                        pusch_nof_grants = 0;
+  std::atomic<uint32_t>                                           pusch_next       = {0};
+  std::atomic<uint32_t>                                           pusch_its_budget = {0};
+  std::mutex                                                      pusch_mutex;
+  std::condition_variable                                         pusch_cvar;
+  uint32_t                                                        pusch_round    = 0;
+  uint32_t                                                        pusch_nof_busy = 0;
+  bool                                                            pusch_running  = false;
 };
 
 } // namespace lte
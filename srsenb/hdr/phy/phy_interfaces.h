@@ -60,18 +60,24 @@ struct phy_args_t {
   std::string            type;
   srsran::phy_log_args_t log;
 
-  float       max_prach_offset_us = 10;
-  int         pusch_max_its       = 10;
-  bool        pusch_8bit_decoder  = false;
-  float       tx_amplitude        = 1.0f;
-  uint32_t    nof_phy_threads     = 1;
-  std::string equalizer_mode      = "mmse";
-  float       estimator_fil_w     = 1.0f;
-  bool        pusch_meas_epre     = true;
-  bool        pusch_meas_evm      = false;
-  bool        pusch_meas_ta       = true;
-  bool        pucch_meas_ta       = true;
-  uint32_t    nof_prach_threads   = 1;
+  float       max_prach_offset_us     = 10;
+  int         pusch_max_its           = 10;
+  uint32_t    pusch_its_budget        = 0;
+  std::string pusch_early_stop        = "crc";
+  int         pusch_early_stop_llr_th = 1000;
+  bool        pusch_8bit_decoder      = false;
+  float       tx_amplitude            = 1.0f;
+  uint32_t    nof_phy_threads         = 1;
+  std::string equalizer_mode          = "mmse";
+  float       estimator_fil_w         = 1.0f;
+  bool        pusch_meas_epre         = true;
+  bool        pusch_meas_evm          = false;
+  bool        pusch_meas_ta           = true;
+  bool        pucch_meas_ta           = true;
+  uint32_t    nof_prach_threads       = 1;
+  uint32_t    nof_pusch_threads       = 1;
+  bool        pdsch_cw_pool           = false;
+  uint32_t    pusch_decoder_threads   = 0;
 
   srsran::channel::args_t dl_channel_args;
   srsran::channel::args_t ul_channel_args;
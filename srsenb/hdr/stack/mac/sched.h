@@ -24,8 +24,12 @@
 
 #include "sched_grid.h"
 #include "sched_ue.h"
+#include "srsran/adt/move_callback.h"
+#include "srsran/adt/mpsc_queue.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/sched_interface.h"
 #include <atomic>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <queue>
@@ -91,16 +95,22 @@ public:
 protected:
   void new_tti(srsran::tti_point tti_rx);
   bool is_generated(srsran::tti_point, uint32_t enb_cc_idx) const;
+  void generate_tti_results_parallel(srsran::tti_point tti_rx);
+  void apply_pending_feedback();
   // Helper methods
   template <typename Func>
   int ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  template <typename Func>
+  int ue_db_access(uint16_t rnti, Func&& f, const char* func_name = nullptr, bool log_fail = true);
+  template <typename Func>
+  int ue_db_access_deferred(uint16_t rnti, Func&& f, const char* func_name);
 
   // args
   rrc_interface_mac*               rrc       = nullptr;
   sched_args_t                     sched_cfg = {};
   std::vector<sched_cell_params_t> sched_cell_params;
 
-  std::map<uint16_t, std::unique_ptr<sched_ue> > ue_db;
+  sched_ue_list ue_db;
 
   // independent schedulers for each carrier
   std::vector<std::unique_ptr<carrier_sched> > carrier_schedulers;
@@ -111,6 +121,23 @@ protected:
   srsran::tti_point last_tti;
   std::mutex        sched_mutex;
   bool              configured;
+
+  /// Workers that allocate the UE data of carriers 1..N-1 when parallel_carrier_sched is enabled. Carrier 0 is
+  /// allocated by the thread that requested the scheduling decision
+  std::unique_ptr<srsran::task_thread_pool> cc_workers;
+  std::mutex                                cc_workers_mutex;
+  std::condition_variable                   cc_workers_cvar;
+  uint32_t                                  nof_pending_cc_allocs = 0;
+
+  /// UE feedback (HARQ, CSI, BSRs...) queued by the PHY/stack threads, and applied by the scheduler when it next
+  /// takes sched_mutex. The producers do not wait for the scheduling decisions
+  using feedback_callback = srsran::move_callback<void(sched_ue&), srsran::default_move_callback_buffer_size, true>;
+  struct ue_feedback {
+    uint16_t          rnti      = 0;
+    const char*       func_name = nullptr;
+    feedback_callback apply;
+  };
+  srsran::mpsc_queue<ue_feedback> feedback_queue{4096};
 };
 
 } // namespace srsenb
@@ -34,10 +34,10 @@ class ra_sched;
 class sched::carrier_sched
 {
 public:
-  explicit carrier_sched(rrc_interface_mac*                              rrc_,
-                         std::map<uint16_t, std::unique_ptr<sched_ue> >* ue_db_,
-                         uint32_t                                        enb_cc_idx_,
-                         sched_result_ringbuffer*                        sched_results_);
+  explicit carrier_sched(rrc_interface_mac*       rrc_,
+                         sched_ue_list*           ue_db_,
+                         uint32_t                 enb_cc_idx_,
+                         sched_result_ringbuffer* sched_results_);
   ~carrier_sched();
   void                   reset();
   void                   carrier_cfg(const sched_cell_params_t& sched_params_);
@@ -45,6 +45,11 @@ public:
   const cc_sched_result& generate_tti_result(srsran::tti_point tti_rx);
   int                    dl_rach_info(dl_sched_rar_info_t rar_info);
 
+  // Steps of generate_tti_result. Only alloc_users() may run concurrently with other carriers
+  void                   start_tti(srsran::tti_point tti_rx);
+  void                   alloc_users(srsran::tti_point tti_rx);
+  const cc_sched_result& finish_tti(srsran::tti_point tti_rx);
+
   // getters
   const ra_sched* get_ra_sched() const { return ra_sched_ptr.get(); }
   //! Get a subframe result for a given tti
@@ -59,11 +64,11 @@ private:
   sf_sched* get_sf_sched(srsran::tti_point tti_rx);
 
   // args
-  const sched_cell_params_t*                      cc_cfg = nullptr;
-  srslog::basic_logger&                           logger;
-  rrc_interface_mac*                              rrc   = nullptr;
-  std::map<uint16_t, std::unique_ptr<sched_ue> >* ue_db = nullptr;
-  const uint32_t                                  enb_cc_idx;
+  const sched_cell_params_t* cc_cfg = nullptr;
+  srslog::basic_logger&      logger;
+  rrc_interface_mac*         rrc   = nullptr;
+  sched_ue_list*             ue_db = nullptr;
+  const uint32_t             enb_cc_idx;
 
   // Subframe scheduling logic
   srsran::circular_array<sf_sched, TTIMOD_SZ> sf_scheds;
@@ -25,6 +25,8 @@
 #include "srsran/adt/bounded_bitset.h"
 #include "srsran/common/tti_point.h"
 #include "srsran/interfaces/sched_interface.h"
+#include <algorithm>
+#include <vector>
 
 namespace srsenb {
 
@@ -51,6 +53,57 @@ using cce_sf_position_table = std::array<std::array<cce_position_list, NOF_AGGR_
 /// Map {sf, cfi, L} -> list of CCE positions
 using cce_frame_position_table = std::array<cce_sf_position_table, SRSRAN_NOF_SF_X_FRAME>;
 
+/// Map {CQI, RE class, nof_prb - 1} -> TBS in bytes of a UE grant with dynamic MCS, for a given max MCS and TBS table.
+/// For each nof PRBs, it is the TBS that cqi_to_tbs_dl/ul() would derive for an unbounded number of required bytes.
+/// The TBS does not always grow with the nof PRBs, due to the coderate limits. The running maximum of the TBS is also
+/// stored, and it works as the inverse table that maps required bytes to the lowest nof PRBs
+class prb_tbs_table
+{
+public:
+  static const uint32_t nof_cqis = 16;
+
+  prb_tbs_table() = default;
+  prb_tbs_table(uint32_t max_mcs_, bool alt_table_, uint32_t nof_re_classes_, uint32_t nof_prb_) :
+    max_mcs(max_mcs_),
+    alt_table(alt_table_),
+    nof_re_classes(nof_re_classes_),
+    nof_prb(nof_prb_),
+    tbs(nof_cqis * nof_re_classes_ * nof_prb_, -1),
+    max_tbs(tbs.size(), -1)
+  {}
+
+  /// Sets the TBS of a grant with nof_prbs. Each {CQI, RE class} row has to be filled in increasing nof_prbs order
+  void set_tbs(uint32_t cqi, uint32_t re_class, uint32_t nof_prbs, int tbs_bytes)
+  {
+    size_t idx   = index(cqi, re_class, nof_prbs);
+    tbs[idx]     = tbs_bytes;
+    max_tbs[idx] = nof_prbs > 1 ? std::max(max_tbs[idx - 1], tbs_bytes) : tbs_bytes;
+  }
+  int get_tbs(uint32_t cqi, uint32_t re_class, uint32_t nof_prbs) const { return tbs[index(cqi, re_class, nof_prbs)]; }
+
+  /// Finds the lowest nof PRBs in {1, ..., max_prbs} whose TBS is equal or higher than req_bytes
+  /// @return nof PRBs, or max_prbs + 1 if none of the TBS values reaches req_bytes
+  uint32_t get_min_prbs(uint32_t cqi, uint32_t re_class, uint32_t max_prbs, int req_bytes) const
+  {
+    auto row_begin = max_tbs.begin() + index(cqi, re_class, 1);
+    return std::lower_bound(row_begin, row_begin + max_prbs, req_bytes) - row_begin + 1;
+  }
+
+  uint32_t max_mcs   = 0;
+  bool     alt_table = false; ///< DL: use the alternative TBS table (256QAM). UL: 64QAM enabled
+
+private:
+  size_t index(uint32_t cqi, uint32_t re_class, uint32_t nof_prbs) const
+  {
+    return (cqi * nof_re_classes + re_class) * nof_prb + nof_prbs - 1;
+  }
+
+  uint32_t         nof_re_classes = 0;
+  uint32_t         nof_prb        = 0;
+  std::vector<int> tbs;
+  std::vector<int> max_tbs;
+};
+
 /// structs to bundle together all the sched arguments, and share them with all the sched sub-components
 class sched_cell_params_t
 {
@@ -67,6 +120,8 @@ public:
   uint32_t nof_prb() const { return cfg.cell.nof_prb; }
   uint32_t get_dl_lb_nof_re(tti_point tti_tx_dl, uint32_t nof_prbs_alloc) const;
   uint32_t get_dl_nof_res(srsran::tti_point tti_tx_dl, const srsran_dci_dl_t& dci, uint32_t cfi) const;
+  const prb_tbs_table* get_dl_tbs_table(uint32_t max_mcs, bool use_tbs_index_alt) const;
+  const prb_tbs_table* get_ul_tbs_table(uint32_t max_mcs, bool ulqam64_enabled) const;
 
   uint32_t                                     enb_cc_idx       = 0;
   sched_interface::cell_cfg_t                  cfg              = {};
@@ -88,6 +143,10 @@ public:
   dl_nof_re_table nof_re_table;
   /// Cached computation of Lower bound of nof REs
   dl_lb_nof_re_table nof_re_lb_table;
+  /// Map {sf_idx} -> RE class. Subframes of the same class have the same lower bound of nof REs for any nof PRBs
+  std::array<uint32_t, SRSRAN_NOF_SF_X_FRAME> dl_sf_re_class = {};
+  /// TBS tables for each max MCS and TBS table that UEs of this cell may be configured with
+  std::vector<prb_tbs_table> dl_tbs_tables, ul_tbs_tables;
 };
 
 //! Bitmask used for CCE allocations
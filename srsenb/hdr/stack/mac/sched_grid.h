@@ -234,6 +234,7 @@ private:
   void set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_result,
                            sched_interface::ul_sched_res_t*        ul_result,
                            sched_ue_list&                          ue_list);
+  void release_dci(const srsran_dci_location_t& dci_pos);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
@@ -21,6 +21,7 @@
 
 #include "../sched_common.h"
 #include "sched_result.h"
+#include <bitset>
 
 #ifndef SRSRAN_PDCCH_SCHED_H
 #define SRSRAN_PDCCH_SCHED_H
@@ -29,11 +30,39 @@ namespace srsenb {
 
 class sched_ue;
 
-/// Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+/**
+ * Class responsible for managing a PDCCH CCE grid, namely CCE allocs, and avoid collisions.
+ * The DCI positions are found with a DFS over the DCI records, which first tries to fit the new DCI in the current
+ * solution, and only backtracks to other positions of the past DCIs when the new one does not fit. The collision
+ * checks are word-level operations over CCE/PUCCH masks, precomputed for each DCI candidate position. The DFS prunes
+ * positions that leave no room for the DCIs of the next levels (checked as CCE and PUCCH matchings), and memoizes the
+ * DFS states known to have no solution. The DFS of a TTI visits at most max_dfs_nodes nodes, plus one per alloc_dci()
+ * call: once the budget is spent, a new DCI is only placed next to the past DCIs, without moving them
+ */
 class sf_cch_allocator
 {
+  /// Word-level masks of the CCEs and PUCCH PRBs taken by one DCI or by a set of DCIs
+  struct cch_mask {
+    const static size_t nof_cce_words   = (sched_interface::max_cce - 1) / 64 + 1;
+    const static size_t nof_pucch_words = (SRSRAN_MAX_PRB - 1) / 64 + 1;
+
+    std::array<uint64_t, nof_cce_words>   cces  = {};
+    std::array<uint64_t, nof_pucch_words> pucch = {};
+
+    void      set_cces(uint32_t start, uint32_t stop);
+    void      set_pucch_prb(uint32_t prb) { pucch[prb / 64] |= 1ULL << (prb % 64); }
+    bool      collides(const cch_mask& other, bool pucch_mux_enabled) const;
+    uint32_t  nof_cces() const;
+    cch_mask& operator&=(const cch_mask& other);
+    cch_mask& operator|=(const cch_mask& other);
+    bool      operator==(const cch_mask& other) const { return cces == other.cces and pucch == other.pucch; }
+  };
+
 public:
   const static uint32_t MAX_CFI = 3;
+  /// Maximum number of DFS nodes visited by the alloc_dci() calls of one TTI to move the past DCIs. It bounds the
+  /// latency of a TTI when the PDCCH is overloaded
+  const static uint32_t MAX_DFS_NODES = 1U << 10;
   struct tree_node {
     int8_t                pucch_n_prb = -1; ///< this PUCCH resource identifier
     uint16_t              rnti        = SRSRAN_INVALID_RNTI;
@@ -42,13 +71,18 @@ public:
     srsran_dci_location_t dci_pos     = {0, 0};
     /// Accumulation of all PDCCH masks for the current solution (DFS path)
     pdcch_mask_t total_mask, current_mask;
-    prbmask_t    total_pucch_mask;
+    /// Accumulation of all CCE and PUCCH masks for the current solution, in the format used by the DFS
+    cch_mask total_cch_mask;
   };
-  using alloc_result_t = srsran::bounded_vector<const tree_node*, 16>;
+  /// Every DCI takes at least one CCE, so the number of CCEs bounds the number of allocations
+  using alloc_result_t = srsran::bounded_vector<const tree_node*, sched_interface::max_cce>;
 
   sf_cch_allocator() : logger(srslog::fetch_basic_logger("MAC")) {}
 
-  void init(const sched_cell_params_t& cell_params_);
+  /**
+   * @param max_dfs_nodes_ Maximum number of DFS nodes visited by the alloc_dci() calls of one TTI to move past DCIs
+   */
+  void init(const sched_cell_params_t& cell_params_, uint32_t max_dfs_nodes_ = MAX_DFS_NODES);
   void new_tti(tti_point tti_rx_);
   /**
    * Allocates DCI space in PDCCH and PUCCH, avoiding in the process collisions with other users
@@ -67,26 +101,74 @@ public:
   void        get_allocs(alloc_result_t* vec = nullptr, pdcch_mask_t* tot_mask = nullptr, size_t idx = 0) const;
   uint32_t    nof_cces() const { return cc_cfg->nof_cce_table[current_cfix]; }
   size_t      nof_allocs() const { return dci_record_list.size(); }
+  uint32_t    nof_dfs_nodes() const { return nof_tti_dfs_nodes; }
   std::string result_to_string(bool verbose = false) const;
 
 private:
+  /// CCE position of a DCI, which does not collide with the UE SR, and its PDCCH mask and PUCCH resource
+  struct dci_candidate {
+    uint32_t     ncce        = 0;
+    int8_t       pucch_n_prb = -1;
+    pdcch_mask_t mask;
+    cch_mask     cch;
+  };
+  /// Same capacity as cce_position_list
+  using dci_candidate_list = srsran::bounded_vector<dci_candidate, 6>;
   /// DCI allocation parameters
   struct alloc_record {
     bool         pusch_uci;
     uint32_t     aggr_idx;
     alloc_type_t alloc_type;
     sched_ue*    user;
+    /// DCI candidates of each CFI, computed once per TTI the first time the DFS visits that CFI
+    std::array<dci_candidate_list, MAX_CFI> dci_cands;
+    std::array<bool, MAX_CFI>               dci_cands_ready = {};
+  };
+  /// DFS state, defined by the CFI, the DFS level (index of the next DCI record) and the CCEs and PUCCH PRBs taken by
+  /// the DCIs above it, restricted to the ones that the DCIs of this level and below could use
+  struct dfs_state {
+    uint32_t cfix;
+    uint32_t level;
+    cch_mask mask;
+    bool     operator==(const dfs_state& other) const
+    {
+      return cfix == other.cfix and level == other.level and mask == other.mask;
+    }
+    size_t hash() const;
   };
+  /// Fixed-capacity cache of DFS states. A state is stored in one of the max_probes slots that follow its hash, and
+  /// replaces the state of the first of them when they are all taken. As it is used as a memo of failed states,
+  /// forgetting a state only costs search time
+  class dfs_state_cache
+  {
+  public:
+    const static uint32_t capacity   = 1024;
+    const static uint32_t max_probes = 4;
+
+    bool contains(const dfs_state& state) const;
+    void insert(const dfs_state& state);
+    void clear() { used.reset(); }
+
+  private:
+    std::array<dfs_state, capacity> states;
+    std::bitset<capacity>           used;
+  };
+
   const cce_cfi_position_table* get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uint32_t cfix) const;
+  const dci_candidate_list&     get_dci_candidates(alloc_record& record);
 
   // PDCCH allocation algorithm
-  bool alloc_dfs_node(const alloc_record& record, uint32_t start_child_idx);
-  bool get_next_dfs();
+  bool      alloc_dfs_node(uint32_t record_idx, uint32_t start_child_idx);
+  bool      get_next_dfs();
+  bool      remaining_records_fit(uint32_t record_idx, const cch_mask& total_mask);
+  dfs_state get_dfs_state(uint32_t level, const cch_mask& total_mask);
+  bool      is_failed_dfs_state(uint32_t level, const cch_mask& total_mask);
 
   // consts
   const sched_cell_params_t* cc_cfg = nullptr;
   srslog::basic_logger&      logger;
   srsran_pucch_cfg_t         pucch_cfg_common = {};
+  uint32_t                   max_dfs_nodes    = MAX_DFS_NODES;
 
   // tti vars
   tti_point                 tti_rx;
@@ -94,6 +176,14 @@ private:
   uint32_t                  current_max_cfix = 0;
   std::vector<tree_node>    last_dci_dfs, temp_dci_dfs;
   std::vector<alloc_record> dci_record_list; ///< Keeps a record of all the PDCCH allocations done so far
+  /// DFS states whose subtrees were fully searched without a solution for the current DCI records
+  dfs_state_cache failed_dfs_states;
+  /// DFS levels whose search started before the current alloc_dci() call. Their exhaustion is not recorded as failure
+  uint32_t nof_resumed_levels = 0;
+  uint32_t nof_tti_dfs_nodes  = 0; ///< DFS nodes visited by the alloc_dci() calls of the current TTI
+  /// Scratch space of the CCE and PUCCH PRB matchings of remaining_records_fit()
+  std::vector<std::array<uint64_t, cch_mask::nof_cce_words> >   cce_reach;
+  std::vector<std::array<uint64_t, cch_mask::nof_pucch_words> > pucch_reach;
 };
 
 // Helper methods
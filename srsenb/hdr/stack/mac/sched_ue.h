@@ -23,8 +23,8 @@
 #define SRSENB_SCHEDULER_UE_H
 
 #include "sched_common.h"
+#include "srsran/adt/flat_id_map.h"
 #include "srsran/srslog/srslog.h"
-#include <map>
 #include <vector>
 
 #include "sched_ue_ctrl/sched_lch.h"
@@ -220,7 +220,8 @@ private:
   std::vector<sched_ue_cell> cells; ///< List of eNB cells that may be configured/activated/deactivated for the UE
 };
 
-using sched_ue_list = std::map<uint16_t, std::unique_ptr<sched_ue> >;
+/// UE table, iterated contiguously by the carrier schedulers every TTI
+using sched_ue_list = srsran::flat_id_map<uint16_t, std::unique_ptr<sched_ue> >;
 
 } // namespace srsenb
 
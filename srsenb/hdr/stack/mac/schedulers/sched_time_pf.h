@@ -24,15 +24,13 @@
 
 #include "sched_base.h"
 #include "srsenb/hdr/common/common_enb.h"
-#include "srsran/adt/circular_map.h"
+#include "srsran/adt/flat_id_map.h"
 #include <queue>
 
 namespace srsenb {
 
 class sched_time_pf final : public sched_base
 {
-  using ue_cit_t = sched_ue_list::const_iterator;
-
 public:
   sched_time_pf(const sched_cell_params_t& cell_params_, const sched_interface::sched_args_t& sched_args);
   void sched_dl_users(sched_ue_list& ue_db, sf_sched* tti_sched) override;
@@ -73,7 +71,7 @@ private:
     uint32_t ul_nof_samples = 0;
   };
 
-  srsran::static_circular_map<uint16_t, ue_ctxt, SRSENB_MAX_UES> ue_history_db;
+  srsran::flat_id_map<uint16_t, ue_ctxt> ue_history_db;
 
   struct ue_dl_prio_compare {
     bool operator()(const ue_ctxt* lhs, const ue_ctxt* rhs) const;
@@ -183,6 +183,10 @@ public:
   void metrics_dl_cqi(uint32_t dl_cqi);
   void metrics_cnt();
 
+  /// The TBS of the DL grants are kept until their HARQ-ACK is received, to be counted in the metrics
+  void     save_dl_tbs(uint32_t enb_cc_idx, uint32_t tti_tx_dl, uint32_t tb_idx, uint32_t tbs);
+  uint32_t get_acked_dl_tbs(uint32_t enb_cc_idx, uint32_t tti_rx, uint32_t tb_idx) const;
+
   int read_pdu(uint32_t lcid, uint8_t* payload, uint32_t requested_bytes) final;
 
 private:
@@ -209,6 +213,8 @@ private:
   uint32_t         dl_pmi_counter = 0;
   mac_ue_metrics_t ue_metrics     = {};
 
+  std::array<std::array<std::array<uint32_t, SRSRAN_MAX_TB>, TTIMOD_SZ>, SRSRAN_MAX_CARRIERS> dl_tx_tbs = {};
+
   srsran::obj_pool_itf<ue_cc_softbuffers>* softbuffer_pool = nullptr;
 
   srsran::block_queue<uint32_t> pending_ta_commands;
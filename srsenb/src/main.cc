@@ -157,6 +157,7 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("scheduler.max_nof_ctrl_symbols", bpo::value<uint32_t>(&args->stack.mac.sched.max_nof_ctrl_symbols)->default_value(3), "Number of control symbols")
     ("scheduler.min_nof_ctrl_symbols", bpo::value<uint32_t>(&args->stack.mac.sched.min_nof_ctrl_symbols)->default_value(1), "Minimum number of control symbols")
     ("scheduler.pucch_multiplex_enable", bpo::value<bool>(&args->stack.mac.sched.pucch_mux_enabled)->default_value(false), "Enable PUCCH multiplexing")
+    ("scheduler.parallel_carrier_sched", bpo::value<bool>(&args->stack.mac.sched.parallel_carrier_sched)->default_value(false), "Run the data scheduling of each carrier in a separate thread")
 
 
     /* Downlink Channel emulator section */
@@ -203,10 +204,16 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("expert.metrics_csv_enable",  bpo::value<bool>(&args->general.metrics_csv_enable)->default_value(false), "Write metrics to CSV file")
     ("expert.metrics_csv_filename", bpo::value<string>(&args->general.metrics_csv_filename)->default_value("/tmp/enb_metrics.csv"), "Metrics CSV filename")
     ("expert.pusch_max_its", bpo::value<int>(&args->phy.pusch_max_its)->default_value(8), "Maximum number of turbo decoder iterations")
+    ("expert.pusch_its_budget", bpo::value<uint32_t>(&args->phy.pusch_its_budget)->default_value(0), "Maximum number of turbo decoder iterations per subframe and carrier for all the UEs (0 for unlimited)")
+    ("expert.pusch_early_stop", bpo::value<string>(&args->phy.pusch_early_stop)->default_value("crc"), "Turbo decoder early stopping criterion: crc, hd (hard decision stability) or llr (LLR magnitude)")
+    ("expert.pusch_early_stop_llr_th", bpo::value<int>(&args->phy.pusch_early_stop_llr_th)->default_value(1000), "LLR magnitude threshold for the llr turbo decoder early stopping criterion")
     ("expert.pusch_8bit_decoder", bpo::value<bool>(&args->phy.pusch_8bit_decoder)->default_value(false), "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental)")
     ("expert.pusch_meas_evm", bpo::value<bool>(&args->phy.pusch_meas_evm)->default_value(false), "Enable/Disable PUSCH EVM measure")
     ("expert.tx_amplitude", bpo::value<float>(&args->phy.tx_amplitude)->default_value(0.6), "Transmit amplitude factor")
     ("expert.nof_phy_threads", bpo::value<uint32_t>(&args->phy.nof_phy_threads)->default_value(3), "Number of PHY threads")
+    ("expert.nof_pusch_threads", bpo::value<uint32_t>(&args->phy.nof_pusch_threads)->default_value(1), "Number of threads decoding the PUSCH of a subframe and carrier in parallel")
+    ("expert.pusch_decoder_threads", bpo::value<uint32_t>(&args->phy.pusch_decoder_threads)->default_value(0), "Number of extra threads decoding the code blocks of a PUSCH transport block in parallel (0 for serial)")
+    ("expert.pdsch_cw_pool", bpo::value<bool>(&args->phy.pdsch_cw_pool)->default_value(false), "Encode the two PDSCH codewords of a grant in parallel, with one extra thread per PHY thread and carrier")
     ("expert.nof_prach_threads", bpo::value<uint32_t>(&args->phy.nof_prach_threads)->default_value(1), "Number of PRACH workers per carrier. Only 1 or 0 is supported")
     ("expert.max_prach_offset_us", bpo::value<float>(&args->phy.max_prach_offset_us)->default_value(30), "Maximum allowed RACH offset (in us)")
     ("expert.equalizer_mode", bpo::value<string>(&args->phy.equalizer_mode)->default_value("mmse"), "Equalizer mode")
@@ -19,6 +19,10 @@
  *
  */
 
+#include <algorithm>
+#include <array>
+#include <numeric>
+
 #include "srsran/common/threads.h"
 #include "srsran/srsran.h"
 
@@ -61,6 +65,7 @@ cc_worker::cc_worker(srslog::basic_logger& logger) : logger(logger)
 
 cc_worker::~cc_worker()
 {
+  stop_pusch_helpers();
   srsran_softbuffer_tx_free(&temp_mbsfn_softbuffer);
   srsran_enb_dl_free(&enb_dl);
   srsran_enb_ul_free(&enb_ul);
@@ -115,6 +120,10 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
     ERROR("Error initiating ENB DL (cc=%d)", cc_idx);
     return;
   }
+  if (phy->params.pdsch_cw_pool and srsran_pdsch_enable_cw_pool(&enb_dl.pdsch)) {
+    ERROR("Error initiating PDSCH codeword pool (cc=%d)", cc_idx);
+    return;
+  }
   if (srsran_enb_ul_init(&enb_ul, signal_buffer_rx[0], nof_prb)) {
     ERROR("Error initiating ENB UL");
     return;
@@ -145,9 +154,14 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
 
   Info("Component Carrier Worker %d configured cell %d PRB", cc_idx, nof_prb);
 
-  if (phy->params.pusch_8bit_decoder) {
-    enb_ul.pusch.llr_is_8bit        = true;
-    enb_ul.pusch.ul_sch.llr_is_8bit = true;
+  if (not set_pusch_decoder(&enb_ul.pusch)) {
+    ERROR("Error initiating PUSCH decoder threads");
+    return;
+  }
+
+  if (phy->params.nof_pusch_threads > 1 and not init_pusch_helpers(phy->params.nof_pusch_threads - 1, nof_prb)) {
+    ERROR("Error initiating PUSCH helpers");
+    return;
   }
   initiated = true;
 
@@ -156,6 +170,105 @@ void cc_worker::init(phy_common* phy_, uint32_t cc_idx_)
 #endif
 }
 
+bool cc_worker::set_pusch_decoder(srsran_pusch_t* pusch)
+{
+  if (phy->params.pusch_8bit_decoder) {
+    pusch->llr_is_8bit        = true;
+    pusch->ul_sch.llr_is_8bit = true;
+  }
+
+  // Turbo decoder early stopping criterion, the code block CRC is always checked
+  if (phy->params.pusch_early_stop == "hd") {
+    srsran_sch_set_early_stop(&pusch->ul_sch, SRSRAN_TDEC_EARLY_STOP_HD, 0);
+  } else if (phy->params.pusch_early_stop == "llr") {
+    srsran_sch_set_early_stop(
+        &pusch->ul_sch, SRSRAN_TDEC_EARLY_STOP_LLR, (int16_t)phy->params.pusch_early_stop_llr_th);
+  } else if (phy->params.pusch_early_stop != "crc") {
+    Warning("Invalid PUSCH early stop criterion '%s', using crc", phy->params.pusch_early_stop.c_str());
+  }
+
+  // Parallel code block decoding
+  return srsran_sch_set_decoder_threads(&pusch->ul_sch, phy->params.pusch_decoder_threads) == SRSRAN_SUCCESS;
+}
+
+bool cc_worker::init_pusch_helpers(uint32_t nof_helpers, uint32_t nof_prb)
+{
+  pusch_running = true;
+  for (uint32_t i = 0; i < nof_helpers; i++) {
+    std::unique_ptr<pusch_helper> h(new pusch_helper(this));
+    if (srsran_enb_ul_pusch_init(&h->rx, nof_prb)) {
+      return false;
+    }
+    if (not set_pusch_decoder(&h->rx.pusch)) {
+      srsran_enb_ul_pusch_free(&h->rx);
+      return false;
+    }
+    h->start(PUSCH_HELPER_THREAD_PRIO);
+    pusch_helpers.push_back(std::move(h));
+  }
+
+  if (not set_pusch_helpers_cell()) {
+    return false;
+  }
+
+  Info("Component Carrier Worker %d decodes PUSCH with %d helper threads", cc_idx, nof_helpers);
+  return true;
+}
+
+bool cc_worker::set_pusch_helpers_cell()
+{
+  // Helper receivers follow the worker one, they are reconfigured while idle whenever the worker cell changes
+  for (auto& h : pusch_helpers) {
+    if (h->cell.id == enb_ul.cell.id and h->cell.nof_prb == enb_ul.cell.nof_prb) {
+      continue;
+    }
+    if (srsran_enb_ul_pusch_set_cell(&h->rx, enb_ul.cell, &phy->dmrs_pusch_cfg)) {
+      ERROR("Error setting PUSCH helper cell (cc=%d)", cc_idx);
+      h->cell = {};
+      return false;
+    }
+    h->cell = enb_ul.cell;
+  }
+  return true;
+}
+
+void cc_worker::stop_pusch_helpers()
+{
+  {
+    std::lock_guard<std::mutex> lock(pusch_mutex);
+    pusch_running = false;
+  }
+  pusch_cvar.notify_all();
+
+  for (auto& h : pusch_helpers) {
+    h->wait_thread_finish();
+    srsran_enb_ul_pusch_free(&h->rx);
+  }
+  pusch_helpers.clear();
+}
+
+void cc_worker::pusch_helper::run_thread()
+{
+  uint32_t round = 0;
+  while (parent->wait_pusch_grants(round)) {
+    parent->decode_pusch_grants(&rx);
+
+    std::lock_guard<std::mutex> lock(parent->pusch_mutex);
+    parent->pusch_nof_busy--;
+    if (parent->pusch_nof_busy == 0) {
+      parent->pusch_cvar.notify_all();
+    }
+  }
+}
+
+bool cc_worker::wait_pusch_grants(uint32_t& round)
+{
+  std::unique_lock<std::mutex> lock(pusch_mutex);
+  pusch_cvar.wait(lock, [this, round]() { return not pusch_running or pusch_round != round; });
+  round = pusch_round;
+  return pusch_running;
+}
+
 void cc_worker::reset()
 {
   initiated = false;
@@ -265,10 +378,12 @@ void cc_worker::work_dl(const srsran_dl_sf_cfg_t&            dl_sf_cfg,
 }
 
 void cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant,
-                                  srsran_ul_cfg_t&                           ul_cfg,
-                                  srsran_pusch_res_t&                        pusch_res)
+                                  pusch_decode_t&                            dec,
+                                  srsran_enb_ul_pusch_t*                     rx)
 {
-  uint16_t rnti = ul_grant.dci.rnti;
+  uint16_t            rnti      = ul_grant.dci.rnti;
+  srsran_ul_cfg_t&    ul_cfg    = dec.ul_cfg;
+  srsran_pusch_res_t& pusch_res = dec.pusch_res;
 
   // Invalid RNTI
   if (rnti == SRSRAN_INVALID_RNTI) {
@@ -276,7 +391,7 @@ void cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // RNTI does not exist
-  if (ue_db.count(rnti) == 0) {
+  if (not dec.ue_found) {
     return;
   }
 
@@ -287,7 +402,7 @@ void cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
   }
 
   // Fill UCI configuration
-  bool uci_required =
+  dec.uci_required =
       phy->ue_db.fill_uci_cfg(tti_rx, cc_idx, rnti, ul_grant.dci.cqi_request, true, ul_cfg.pusch.uci_cfg);
 
   // Compute UL grant
@@ -318,71 +433,145 @@ void cc_worker::decode_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_
     Error("Error setting last UL TB for RNTI %x, CC %d, PID %d", rnti, cc_idx, ul_grant.pid);
   }
 
-  // Run PUSCH decoder
+  // Limit the turbo decoder iterations of every code block to what is left of the subframe budget
+  srsran_cbsegm_t cb_segm = {};
+  if (phy->params.pusch_its_budget > 0 and ul_grant.data != nullptr and
+      srsran_cbsegm(&cb_segm, grant.tb.tbs) == SRSRAN_SUCCESS and cb_segm.C > 0) {
+    uint32_t its_budget             = pusch_its_budget;
+    uint32_t max_its                = SRSRAN_MIN(ul_cfg.pusch.max_nof_iterations, its_budget / cb_segm.C);
+    ul_cfg.pusch.max_nof_iterations = SRSRAN_MAX(max_its, SRSRAN_MIN(PUSCH_MIN_ITS, ul_cfg.pusch.max_nof_iterations));
+  }
+
+  // Run PUSCH decoder, with the worker receiver or the helper one
   ul_cfg.pusch.softbuffers.rx = ul_grant.softbuffer_rx;
   pusch_res.data              = ul_grant.data;
   if (pusch_res.data) {
-    if (srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res)) {
+    int ret = SRSRAN_SUCCESS;
+    if (rx == nullptr) {
+      ret           = srsran_enb_ul_get_pusch(&enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res);
+      dec.chest_res = enb_ul.chest_res;
+    } else {
+      ret           = srsran_enb_ul_pusch_decode(rx, &enb_ul, &ul_sf, &ul_cfg.pusch, &pusch_res);
+      dec.chest_res = rx->chest_res;
+    }
+    if (ret) {
       Error("Decoding PUSCH for RNTI %x", rnti);
       return;
     }
+
+    // Iterations saved by early stopping are left for the next grants
+    if (phy->params.pusch_its_budget > 0) {
+      uint32_t used_its = (uint32_t)roundf(pusch_res.avg_iterations_block * cb_segm.C);
+      uint32_t its_left = pusch_its_budget;
+      while (not pusch_its_budget.compare_exchange_weak(its_left, its_left - SRSRAN_MIN(used_its, its_left))) {
+      }
+    }
   }
-  // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
-  ue_db[rnti]->phich_grant.n_prb_lowest = grant.n_prb_tilde[0];
-  ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
 
-  float snr_db = enb_ul.chest_res.snr_db;
+  dec.decoded = true;
+}
+
+void cc_worker::report_pusch_rnti(stack_interface_phy_lte::ul_sched_grant_t& ul_grant, pusch_decode_t& dec)
+{
+  uint16_t            rnti      = ul_grant.dci.rnti;
+  srsran_ul_cfg_t&    ul_cfg    = dec.ul_cfg;
+  srsran_pusch_res_t& pusch_res = dec.pusch_res;
+
+  if (dec.decoded) {
+    // Save PHICH scheduling for this user. Each user can have just 1 PUSCH dci per TTI
+    ue_db[rnti]->phich_grant.n_prb_lowest = ul_cfg.pusch.grant.n_prb_tilde[0];
+    ue_db[rnti]->phich_grant.n_dmrs       = ul_grant.dci.n_dmrs;
+
+    float snr_db = dec.chest_res.snr_db;
 
-  // Notify MAC of RL status
-  if (snr_db >= PUSCH_RL_SNR_DB_TH) {
-    // Notify MAC UL channel quality
-    phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
+    // Notify MAC of RL status
+    if (snr_db >= PUSCH_RL_SNR_DB_TH) {
+      // Notify MAC UL channel quality
+      phy->stack->snr_info(ul_sf.tti, rnti, cc_idx, snr_db, mac_interface_phy_lte::PUSCH);
 
-    // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
-    if (ul_cfg.pusch.meas_ta_en and not std::isnan(enb_ul.chest_res.ta_us) and not std::isinf(enb_ul.chest_res.ta_us)) {
-      phy->stack->ta_info(ul_sf.tti, rnti, enb_ul.chest_res.ta_us);
+      // Notify MAC of Time Alignment only if it enabled and valid measurement, ignore value otherwise
+      if (ul_cfg.pusch.meas_ta_en and not std::isnan(dec.chest_res.ta_us) and not std::isinf(dec.chest_res.ta_us)) {
+        phy->stack->ta_info(ul_sf.tti, rnti, dec.chest_res.ta_us);
+      }
     }
-  }
 
-  // Send UCI data to MAC
-  if (uci_required) {
-    phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
+    // Send UCI data to MAC
+    if (dec.uci_required) {
+      phy->ue_db.send_uci_data(tti_rx, rnti, cc_idx, ul_cfg.pusch.uci_cfg, pusch_res.uci);
+    }
+
+    // Save statistics only if data was provided
+    if (ul_grant.data != nullptr) {
+      // Save metrics stats
+      ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx, 0, dec.chest_res.snr_db, pusch_res.avg_iterations_block);
+    }
   }
 
-  // Save statistics only if data was provided
+  // Notify MAC new received data and HARQ Indication value
   if (ul_grant.data != nullptr) {
-    // Save metrics stats
-    ue_db[rnti]->metrics_ul(ul_grant.dci.tb.mcs_idx, 0, enb_ul.chest_res.snr_db, pusch_res.avg_iterations_block);
+    // Inform MAC about the CRC result
+    phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
+    // Push PDU buffer
+    phy->stack->push_pdu(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
+    // Logging
+    if (logger.info.enabled()) {
+      char str[512];
+      srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &dec.chest_res, str, sizeof(str));
+      logger.info("PUSCH: cc=%d, %s", cc_idx, str);
+    }
+  }
+}
+
+void cc_worker::decode_pusch_grants(srsran_enb_ul_pusch_t* rx)
+{
+  for (uint32_t i = pusch_next++; i < pusch_nof_grants; i = pusch_next++) {
+    uint32_t idx = pusch_order[i];
+    decode_pusch_rnti(pusch_grants[idx], pusch_decodes[idx], rx);
   }
 }
 
 void cc_worker::decode_pusch(stack_interface_phy_lte::ul_sched_grant_t* grants, uint32_t nof_pusch)
 {
-  // Iterate over all the grants, all the grants need to report MAC the CRC status
+  // When the turbo decoder iterations are limited, HARQ retransmissions are decoded first as they are closer to the
+  // maximum number of transmissions and more likely to succeed thanks to soft-combining. This only changes which grant
+  // gets the iterations first, the results are reported to the stack in the scheduler order
+  nof_pusch = SRSRAN_MIN(nof_pusch, (uint32_t)pusch_order.size());
+  std::iota(pusch_order.begin(), pusch_order.begin() + nof_pusch, 0);
+  if (phy->params.pusch_its_budget > 0) {
+    std::stable_sort(pusch_order.begin(), pusch_order.begin() + nof_pusch, [grants](uint32_t a, uint32_t b) {
+      return grants[a].current_tx_nb > grants[b].current_tx_nb;
+    });
+  }
   for (uint32_t i = 0; i < nof_pusch; i++) {
-    // Get grant itself and RNTI
-    stack_interface_phy_lte::ul_sched_grant_t& ul_grant = grants[i];
-    uint16_t                                   rnti     = ul_grant.dci.rnti;
+    pusch_decodes[i]          = {};
+    pusch_decodes[i].ue_found = ue_db.count(grants[i].dci.rnti) > 0;
+  }
+  pusch_grants     = grants;
+  pusch_nof_grants = nof_pusch;
+  pusch_next       = 0;
+  pusch_its_budget = phy->params.pusch_its_budget;
+
+  // Grants are decoded in the above order, by the helpers as well if there is more than one. With a limited number of
+  // iterations, which grant gets the iterations saved by another depends on the decoding times
+  if (nof_pusch > 1 and not pusch_helpers.empty() and set_pusch_helpers_cell()) {
+    {
+      std::lock_guard<std::mutex> lock(pusch_mutex);
+      pusch_nof_busy = pusch_helpers.size();
+      pusch_round++;
+    }
+    pusch_cvar.notify_all();
 
-    srsran_pusch_res_t pusch_res = {};
-    srsran_ul_cfg_t    ul_cfg    = {};
+    decode_pusch_grants(nullptr);
 
-    // Decodes PUSCH for the given grant
-    decode_pusch_rnti(ul_grant, ul_cfg, pusch_res);
+    std::unique_lock<std::mutex> lock(pusch_mutex);
+    pusch_cvar.wait(lock, [this]() { return pusch_nof_busy == 0; });
+  } else {
+    decode_pusch_grants(nullptr);
+  }
 
-    // Notify MAC new received data and HARQ Indication value
-    if (ul_grant.data != nullptr) {
-      // Inform MAC about the CRC result
-      phy->stack->crc_info(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Push PDU buffer
-      phy->stack->push_pdu(tti_rx, rnti, cc_idx, ul_cfg.pusch.grant.tb.tbs / 8, pusch_res.crc);
-      // Logging
-      if (logger.info.enabled()) {
-        char str[512];
-        srsran_pusch_rx_info(&ul_cfg.pusch, &pusch_res, &enb_ul.chest_res, str, sizeof(str));
-        logger.info("PUSCH: cc=%d, %s", cc_idx, str);
-      }
-    }
+  // Iterate over all the grants, all the grants need to report MAC the CRC status
+  for (uint32_t i = 0; i < nof_pusch; i++) {
+    report_pusch_rnti(grants[i], pusch_decodes[i]);
   }
 }
 
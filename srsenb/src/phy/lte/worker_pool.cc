@@ -19,14 +19,67 @@
  *
  */
 #include "srsenb/hdr/phy/lte/worker_pool.h"
+#include <set>
 
 namespace srsenb {
 namespace lte {
 
 worker_pool::worker_pool(uint32_t max_workers) : pool(max_workers) {}
 
+/* Builds the DL and UL objects of every configured PRB count once, so the DFT plans they need are created a single
+ * time in the process-wide plan cache and all the workers below only take references to them. The buffers come from
+ * the same allocator as the workers' ones, which gives the plans the same alignment. */
+static bool warm_dft_plans(phy_common* common, srslog::basic_logger& log)
+{
+  std::set<uint32_t> nof_prb_set;
+  for (uint32_t cc = 0; cc < common->get_nof_carriers_lte(); cc++) {
+    uint32_t nof_prb = common->get_nof_prb(cc);
+    if (not nof_prb_set.insert(nof_prb).second) {
+      continue;
+    }
+
+    srsran_cell_t   cell                        = common->get_cell(cc);
+    uint32_t        sf_len                      = SRSRAN_SF_LEN_PRB(nof_prb);
+    cf_t*           buffer_tx[SRSRAN_MAX_PORTS] = {};
+    cf_t*           buffer_rx                   = srsran_vec_cf_malloc(2 * sf_len);
+    srsran_enb_dl_t enb_dl                      = {};
+    srsran_enb_ul_t enb_ul                      = {};
+    bool            ret                         = buffer_rx != nullptr;
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      buffer_tx[p] = srsran_vec_cf_malloc(2 * sf_len);
+      ret          = ret and buffer_tx[p] != nullptr;
+    }
+
+    if (ret) {
+      ret = srsran_enb_dl_init(&enb_dl, buffer_tx, nof_prb) == SRSRAN_SUCCESS and
+            srsran_enb_dl_set_cell(&enb_dl, cell) == SRSRAN_SUCCESS and
+            srsran_enb_ul_init(&enb_ul, buffer_rx, nof_prb) == SRSRAN_SUCCESS and
+            srsran_enb_ul_set_cell(&enb_ul, cell, &common->dmrs_pusch_cfg, nullptr) == SRSRAN_SUCCESS;
+    }
+
+    srsran_enb_dl_free(&enb_dl);
+    srsran_enb_ul_free(&enb_ul);
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      free(buffer_tx[p]);
+    }
+    free(buffer_rx);
+
+    if (not ret) {
+      log.error("Error warming the DFT plans for %d PRB", nof_prb);
+      return false;
+    }
+  }
+
+  log.info("DFT plan cache holds %d plans", srsran_dft_plan_cache_nof_plans());
+  return true;
+}
+
 bool worker_pool::init(const phy_args_t& args, phy_common* common, srslog::sink& log_sink, int prio)
 {
+  if (not warm_dft_plans(common, srslog::fetch_basic_logger("PHY", log_sink))) {
+    return false;
+  }
+
   // Add workers to workers pool and start threads.
   srslog::basic_levels log_level = srslog::str_to_basic_level(args.log.phy_level);
   for (uint32_t i = 0; i < args.nof_phy_threads; i++) {
@@ -309,8 +309,8 @@ int mac::ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t
     return SRSRAN_ERROR;
   }
 
-  int nof_bytes = scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
-  ue_db[rnti]->metrics_tx(ack, nof_bytes);
+  scheduler.dl_ack_info(tti_rx, rnti, enb_cc_idx, tb_idx, ack);
+  ue_db[rnti]->metrics_tx(ack, ue_db[rnti]->get_acked_dl_tbs(enb_cc_idx, tti_rx, tb_idx));
 
   rrc_h->set_radiolink_dl_state(rnti, ack);
 
@@ -630,6 +630,8 @@ int mac::get_dl_sched(uint32_t tti_tx_dl, dl_sched_list_t& dl_sched_res_list)
           dl_sched_res->pdsch[n].dci = sched_result.data[i].dci;
 
           for (uint32_t tb = 0; tb < SRSRAN_MAX_TB; tb++) {
+            ue_db[rnti]->save_dl_tbs(enb_cc_idx, tti_tx_dl, tb, sched_result.data[i].tbs[tb]);
+
             dl_sched_res->pdsch[n].softbuffer_tx[tb] =
                 ue_db[rnti]->get_tx_softbuffer(sched_result.data[i].dci.ue_cc_idx, sched_result.data[i].dci.pid, tb);
 
@@ -22,6 +22,7 @@
 #include <srsenb/hdr/stack/mac/sched_ue.h>
 #include <string.h>
 
+#include "srsenb/hdr/common/common_enb.h"
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsenb/hdr/stack/mac/sched_carrier.h"
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
@@ -48,6 +49,7 @@ void sched::init(rrc_interface_mac* rrc_, const sched_args_t& sched_cfg_)
 {
   rrc       = rrc_;
   sched_cfg = sched_cfg_;
+  ue_db.reserve(SRSENB_MAX_UES);
 
   // Initialize first carrier scheduler
   carrier_schedulers.emplace_back(new carrier_sched{rrc, &ue_db, 0, &sched_results});
@@ -61,6 +63,10 @@ int sched::reset()
   for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
     c->reset();
   }
+  // discard the feedback of the removed users
+  ue_feedback fb;
+  while (feedback_queue.try_pop(fb)) {
+  }
   ue_db.clear();
   return 0;
 }
@@ -91,6 +97,15 @@ int sched::cell_cfg(const std::vector<sched_interface::cell_cfg_t>& cell_cfg)
     carrier_schedulers[i]->carrier_cfg(sched_cell_params[i]);
   }
 
+  // Create the workers for the parallel scheduling of carriers 1..N-1
+  if (sched_cfg.parallel_carrier_sched and carrier_schedulers.size() > 1) {
+    if (cc_workers == nullptr) {
+      cc_workers.reset(new srsran::task_thread_pool(carrier_schedulers.size() - 1));
+    } else if (cc_workers->nof_workers() < carrier_schedulers.size() - 1) {
+      cc_workers->set_nof_workers(carrier_schedulers.size() - 1);
+    }
+  }
+
   configured = true;
   return 0;
 }
@@ -106,7 +121,8 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   {
     // config existing user
     std::lock_guard<std::mutex> lock(sched_mutex);
-    auto                        it = ue_db.find(rnti);
+    apply_pending_feedback();
+    auto it = ue_db.find(rnti);
     if (it != ue_db.end()) {
       it->second->set_cfg(ue_cfg);
       return SRSRAN_SUCCESS;
@@ -116,16 +132,15 @@ int sched::ue_cfg(uint16_t rnti, const sched_interface::ue_cfg_t& ue_cfg)
   // Add new user case
   std::unique_ptr<sched_ue>   ue{new sched_ue(rnti, sched_cell_params, ue_cfg)};
   std::lock_guard<std::mutex> lock(sched_mutex);
-  ue_db.insert(std::make_pair(rnti, std::move(ue)));
+  ue_db.insert(rnti, std::move(ue));
   return SRSRAN_SUCCESS;
 }
 
 int sched::ue_rem(uint16_t rnti)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  if (ue_db.count(rnti) > 0) {
-    ue_db.erase(rnti);
-  } else {
+  apply_pending_feedback();
+  if (not ue_db.erase(rnti)) {
     Error("User rnti=0x%x not found", rnti);
     return SRSRAN_ERROR;
   }
@@ -176,46 +191,56 @@ uint32_t sched::get_ul_buffer(uint16_t rnti)
 
 int sched::dl_rlc_buffer_state(uint16_t rnti, uint32_t lc_id, uint32_t tx_queue, uint32_t retx_queue)
 {
-  return ue_db_access_locked(rnti, [&](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, retx_queue); });
+  return ue_db_access_deferred(
+      rnti,
+      [lc_id, tx_queue, retx_queue](sched_ue& ue) { ue.dl_buffer_state(lc_id, tx_queue, retx_queue); },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::dl_mac_buffer_state(uint16_t rnti, uint32_t ce_code, uint32_t nof_cmds)
 {
-  return ue_db_access_locked(rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); });
+  return ue_db_access_deferred(
+      rnti, [ce_code, nof_cmds](sched_ue& ue) { ue.mac_buffer_state(ce_code, nof_cmds); }, __PRETTY_FUNCTION__);
 }
 
 int sched::dl_ack_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, uint32_t tb_idx, bool ack)
 {
-  int ret = -1;
-  ue_db_access_locked(
+  return ue_db_access_deferred(
       rnti,
-      [&](sched_ue& ue) { ret = ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
+      [tti_rx, enb_cc_idx, tb_idx, ack](sched_ue& ue) { ue.set_ack_info(tti_point{tti_rx}, enb_cc_idx, tb_idx, ack); },
       __PRETTY_FUNCTION__);
-  return ret;
 }
 
 int sched::ul_crc_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, bool crc)
 {
-  return ue_db_access_locked(
-      rnti, [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); });
+  return ue_db_access_deferred(
+      rnti,
+      [tti_rx, enb_cc_idx, crc](sched_ue& ue) { ue.set_ul_crc(tti_point{tti_rx}, enb_cc_idx, crc); },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::dl_ri_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t ri_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); });
+  return ue_db_access_deferred(
+      rnti,
+      [tti, enb_cc_idx, ri_value](sched_ue& ue) { ue.set_dl_ri(tti_point{tti}, enb_cc_idx, ri_value); },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::dl_pmi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t pmi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); });
+  return ue_db_access_deferred(
+      rnti,
+      [tti, enb_cc_idx, pmi_value](sched_ue& ue) { ue.set_dl_pmi(tti_point{tti}, enb_cc_idx, pmi_value); },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::dl_cqi_info(uint32_t tti, uint16_t rnti, uint32_t enb_cc_idx, uint32_t cqi_value)
 {
-  return ue_db_access_locked(
-      rnti, [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); });
+  return ue_db_access_deferred(
+      rnti,
+      [tti, enb_cc_idx, cqi_value](sched_ue& ue) { ue.set_dl_cqi(tti_point{tti}, enb_cc_idx, cqi_value); },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
@@ -226,29 +251,35 @@ int sched::dl_rach_info(uint32_t enb_cc_idx, dl_sched_rar_info_t rar_info)
 
 int sched::ul_snr_info(uint32_t tti_rx, uint16_t rnti, uint32_t enb_cc_idx, float snr, uint32_t ul_ch_code)
 {
-  return ue_db_access_locked(rnti,
-                             [&](sched_ue& ue) { ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code); });
+  return ue_db_access_deferred(
+      rnti,
+      [tti_rx, enb_cc_idx, snr, ul_ch_code](sched_ue& ue) {
+        ue.set_ul_snr(tti_point{tti_rx}, enb_cc_idx, snr, ul_ch_code);
+      },
+      __PRETTY_FUNCTION__);
 }
 
 int sched::ul_bsr(uint16_t rnti, uint32_t lcg_id, uint32_t bsr)
 {
-  return ue_db_access_locked(rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); });
+  return ue_db_access_deferred(
+      rnti, [lcg_id, bsr](sched_ue& ue) { ue.ul_buffer_state(lcg_id, bsr); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_buffer_add(uint16_t rnti, uint32_t lcid, uint32_t bytes)
 {
-  return ue_db_access_locked(rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); });
+  return ue_db_access_deferred(
+      rnti, [lcid, bytes](sched_ue& ue) { ue.ul_buffer_add(lcid, bytes); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_phr(uint16_t rnti, int phr)
 {
-  return ue_db_access_locked(
+  return ue_db_access_deferred(
       rnti, [phr](sched_ue& ue) { ue.ul_phr(phr); }, __PRETTY_FUNCTION__);
 }
 
 int sched::ul_sr_info(uint32_t tti, uint16_t rnti)
 {
-  return ue_db_access_locked(
+  return ue_db_access_deferred(
       rnti, [](sched_ue& ue) { ue.set_sr(); }, __PRETTY_FUNCTION__);
 }
 
@@ -344,6 +375,14 @@ void sched::new_tti(tti_point tti_rx)
 {
   last_tti = std::max(last_tti, tti_rx);
 
+  // Apply the UE feedback received since the last decision
+  apply_pending_feedback();
+
+  if (cc_workers != nullptr and not is_generated(tti_rx, 0)) {
+    generate_tti_results_parallel(tti_rx);
+    return;
+  }
+
   // Generate sched results for all CCs, if not yet generated
   for (size_t cc_idx = 0; cc_idx < carrier_schedulers.size(); ++cc_idx) {
     if (not is_generated(tti_rx, cc_idx)) {
@@ -353,18 +392,99 @@ void sched::new_tti(tti_point tti_rx)
   }
 }
 
+/// Generate the scheduling decision of all CCs, with the UE data allocations of each CC running in a separate thread.
+/// The steps that modify the state shared by the carriers run sequentially, before and after the allocations:
+/// - the UE refresh, PHICH, broadcast and RAR/Msg3 scheduling run first, for all the CCs.
+/// - the UE DL/UL allocations run concurrently. They only read the UE state (buffers, HARQs, CQIs).
+/// - the DCI generation runs last, in CC order. This is where the conflicts between CCs are reconciled: the UCI is
+///   placed in the PUSCH of the lowest UE CC, and the grants left without data by a lower CC are dropped.
+/// NOTE: The CCs do not see each other's PUSCH grants when allocating DL data, so the PUCCH resources for HARQ-ACKs
+///       are reserved even if the UCI ends up multiplexed in another CC's PUSCH.
+void sched::generate_tti_results_parallel(tti_point tti_rx)
+{
+  for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
+    c->start_tti(tti_rx);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(cc_workers_mutex);
+    nof_pending_cc_allocs = carrier_schedulers.size() - 1;
+  }
+  for (uint32_t cc_idx = 1; cc_idx < carrier_schedulers.size(); ++cc_idx) {
+    cc_workers->push_task([this, cc_idx, tti_rx]() {
+      carrier_schedulers[cc_idx]->alloc_users(tti_rx);
+      std::lock_guard<std::mutex> lock(cc_workers_mutex);
+      if (--nof_pending_cc_allocs == 0) {
+        cc_workers_cvar.notify_one();
+      }
+    });
+  }
+  carrier_schedulers[0]->alloc_users(tti_rx);
+  {
+    std::unique_lock<std::mutex> lock(cc_workers_mutex);
+    while (nof_pending_cc_allocs > 0) {
+      cc_workers_cvar.wait(lock);
+    }
+  }
+
+  for (std::unique_ptr<carrier_sched>& c : carrier_schedulers) {
+    c->finish_tti(tti_rx);
+  }
+}
+
 /// Check if TTI result is generated
 bool sched::is_generated(srsran::tti_point tti_rx, uint32_t enb_cc_idx) const
 {
   return sched_results.has_sf(tti_rx) and sched_results.get_sf(tti_rx)->is_generated(enb_cc_idx);
 }
 
+/// Apply the queued UE feedback, in the order it was received. The sched_mutex must be held
+void sched::apply_pending_feedback()
+{
+  ue_feedback fb;
+  while (feedback_queue.try_pop(fb)) {
+    // The RNTI is validated here, as the deferred calls already returned to their caller
+    auto it = ue_db.find(fb.rnti);
+    if (it == ue_db.end()) {
+      Error("SCHED: User rnti=0x%x not found. Dropped the feedback of %s.", fb.rnti, fb.func_name);
+      continue;
+    }
+    fb.apply(*it->second);
+  }
+}
+
 // Common way to access ue_db elements in a read locking way
 template <typename Func>
 int sched::ue_db_access_locked(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
 {
   std::lock_guard<std::mutex> lock(sched_mutex);
-  auto                        it = ue_db.find(rnti);
+  apply_pending_feedback();
+  return ue_db_access(rnti, std::forward<Func>(f), func_name, log_fail);
+}
+
+// Queues an access to a ue_db element, to be run by the scheduler. The caller does not take the sched_mutex, unless
+// the queue is full. Unknown RNTIs are only detected, and logged, when the queue is drained
+template <typename Func>
+int sched::ue_db_access_deferred(uint16_t rnti, Func&& f, const char* func_name)
+{
+  ue_feedback fb;
+  fb.rnti      = rnti;
+  fb.func_name = func_name;
+  fb.apply     = feedback_callback{std::forward<Func>(f)};
+  if (feedback_queue.try_push(fb)) {
+    return SRSRAN_SUCCESS;
+  }
+
+  // Apply the feedback directly, after the one already queued
+  std::lock_guard<std::mutex> lock(sched_mutex);
+  apply_pending_feedback();
+  return ue_db_access(rnti, fb.apply, func_name);
+}
+
+template <typename Func>
+int sched::ue_db_access(uint16_t rnti, Func&& f, const char* func_name, bool log_fail)
+{
+  auto it = ue_db.find(rnti);
   if (it != ue_db.end()) {
     f(*it->second);
   } else {
@@ -382,9 +382,16 @@ void sched::carrier_sched::set_dl_tti_mask(uint8_t* tti_mask, uint32_t nof_sfs)
 
 const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_rx)
 {
-  sf_sched*        tti_sched = get_sf_sched(tti_rx);
-  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
-  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
+  start_tti(tti_rx);
+  alloc_users(tti_rx);
+  return finish_tti(tti_rx);
+}
+
+/// Refreshes the UE state and schedules PHICH, broadcast and RAR/Msg3. These steps modify state shared with the other
+/// carriers (e.g. UE HARQ timers, RRC paging), so they must not run concurrently with other carriers
+void sched::carrier_sched::start_tti(tti_point tti_rx)
+{
+  sf_sched* tti_sched = get_sf_sched(tti_rx);
 
   bool dl_active = sf_dl_mask[tti_sched->get_tti_tx_dl().to_uint() % sf_dl_mask.size()] == 0;
 
@@ -412,6 +419,13 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
     sf_sched* sf_msg3_sched = get_sf_sched(tti_rx + MSG3_DELAY_MS);
     ra_sched_ptr->ul_sched(tti_sched, sf_msg3_sched);
   }
+}
+
+/// Allocates the UE DL and UL data in this carrier's grid. The UE state shared with other carriers is only read, so
+/// the allocations of different carriers can run concurrently
+void sched::carrier_sched::alloc_users(tti_point tti_rx)
+{
+  sf_sched* tti_sched = &sf_scheds[tti_rx.to_uint()];
 
   /* Prioritize PDCCH scheduling for DL and UL data in a RoundRobin fashion */
   if ((tti_rx.to_uint() % 2) == 0) {
@@ -424,6 +438,15 @@ const cc_sched_result& sched::carrier_sched::generate_tti_result(tti_point tti_r
   if ((tti_rx.to_uint() % 2) == 1) {
     alloc_ul_users(tti_sched);
   }
+}
+
+/// Generates the DCIs and updates the UE HARQs and buffers. Carriers must be finished in order of enb_cc_idx, as the
+/// UCI placement depends on the results of the lower carriers
+const cc_sched_result& sched::carrier_sched::finish_tti(tti_point tti_rx)
+{
+  sf_sched*        tti_sched = &sf_scheds[tti_rx.to_uint()];
+  sf_sched_result* sf_result = prev_sched_results->get_sf(tti_rx);
+  cc_sched_result* cc_result = sf_result->get_cc(enb_cc_idx);
 
   /* Select the winner DCI allocation combination, store all the scheduling results */
   tti_sched->generate_sched_results(*ue_db);
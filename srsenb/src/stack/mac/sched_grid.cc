@@ -659,13 +659,6 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
                                         sched_ue_list&                          ue_list)
 {
   for (const auto& data_alloc : data_allocs) {
-    dl_result->data.emplace_back();
-    sched_interface::dl_sched_data_t* data = &dl_result->data.back();
-
-    // Assign NCCE/L
-    data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
-
-    // Generate DCI Format1/2/2A
     auto ue_it = ue_list.find(data_alloc.rnti);
     if (ue_it == ue_list.end()) {
       continue;
@@ -675,6 +668,20 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
     const dl_harq_proc& dl_harq     = user->get_dl_harq(data_alloc.pid, cc_cfg->enb_cc_idx);
     bool                is_newtx    = dl_harq.is_empty();
 
+    if (cc_cfg->sched_cfg->parallel_carrier_sched and is_newtx and data_before == 0) {
+      // The pending data was taken by a lower carrier, allocated in parallel with this one
+      logger.debug("SCHED: DL tx rnti=0x%x, cc=%d dropped. No pending data left", user->get_rnti(), get_enb_cc_idx());
+      release_dci(dci_result[data_alloc.dci_idx]->dci_pos);
+      continue;
+    }
+
+    dl_result->data.emplace_back();
+    sched_interface::dl_sched_data_t* data = &dl_result->data.back();
+
+    // Assign NCCE/L
+    data->dci.location = dci_result[data_alloc.dci_idx]->dci_pos;
+
+    // Generate DCI Format1/2/2A
     int tbs = user->generate_dl_dci_format(
         data_alloc.pid, data, get_tti_tx_dl(), cc_cfg->enb_cc_idx, tti_alloc.get_cfi(), data_alloc.user_mask);
 
@@ -689,6 +696,11 @@ void sf_sched::set_dl_data_sched_result(const sf_cch_allocator::alloc_result_t&
                      tbs,
                      user->get_pending_dl_bytes(cc_cfg->enb_cc_idx));
       logger.warning("%s", srsran::to_c_str(str_buffer));
+      if (cc_cfg->sched_cfg->parallel_carrier_sched) {
+        // Leave the CCEs to the carriers allocated in parallel with this one
+        release_dci(data->dci.location);
+        dl_result->data.pop_back();
+      }
       continue;
     }
 
@@ -819,6 +831,14 @@ void sf_sched::set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_r
     // If UCI is encoded in the current carrier
     uci_pusch_t uci_type = is_uci_included(this, *cc_results, user, cc_cfg->enb_cc_idx);
 
+    if (cc_cfg->sched_cfg->parallel_carrier_sched and ul_alloc.type == ul_alloc_t::NEWTX and not ul_alloc.is_msg3 and
+        uci_type == UCI_PUSCH_NONE and user->get_pending_ul_new_data(get_tti_tx_ul(), cc_cfg->enb_cc_idx) == 0) {
+      // The pending data (or the UCI) was placed in a lower carrier, allocated in parallel with this one
+      logger.debug("SCHED: UL tx rnti=0x%x, cc=%d dropped. No pending data left", user->get_rnti(), get_enb_cc_idx());
+      release_dci(cce_range);
+      continue;
+    }
+
     /* Generate DCI Format1A */
     ul_result->pusch.emplace_back();
     sched_interface::ul_sched_data_t& pusch = ul_result->pusch.back();
@@ -848,6 +868,9 @@ void sf_sched::set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_r
                      ul_alloc.alloc,
                      new_pending_bytes);
       logger.warning("%s", srsran::to_c_str(str_buffer));
+      if (ul_alloc.needs_pdcch()) {
+        release_dci(cce_range);
+      }
       ul_result->pusch.pop_back();
       continue;
     }
@@ -878,6 +901,12 @@ void sf_sched::set_ul_sched_result(const sf_cch_allocator::alloc_result_t& dci_r
   }
 }
 
+/// Clears the CCEs of a DCI that was allocated but not included in the final result
+void sf_sched::release_dci(const srsran_dci_location_t& dci_pos)
+{
+  cc_results->get_cc(cc_cfg->enb_cc_idx)->pdcch_mask.fill(dci_pos.ncce, dci_pos.ncce + (1u << dci_pos.L), false);
+}
+
 alloc_result sf_sched::alloc_msg3(sched_ue* user, const sched_interface::dl_sched_rar_grant_t& rargrant)
 {
   // Derive PRBs from allocated RAR grants
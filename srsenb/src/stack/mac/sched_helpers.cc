@@ -20,11 +20,13 @@
  */
 
 #include "srsenb/hdr/stack/mac/sched_helpers.h"
+#include "srsenb/hdr/stack/mac/sched_phy_ch/sched_dci.h"
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/string_helpers.h"
 #include "srsran/mac/pdu.h"
 #include "srsran/srslog/bundled/fmt/format.h"
 #include <array>
+#include <limits>
 
 #define Debug(fmt, ...) get_mac_logger().debug(fmt, ##__VA_ARGS__)
 #define Info(fmt, ...) get_mac_logger().info(fmt, ##__VA_ARGS__)
@@ -259,6 +261,50 @@ sched_cell_params_t::dl_lb_nof_re_table get_lb_nof_re_x_prb(const sched_cell_par
   return ret;
 }
 
+/// Groups subframes with the same lower bound of nof REs for all nof PRBs
+uint32_t generate_sf_re_classes(const sched_cell_params_t::dl_lb_nof_re_table& lb_table,
+                                std::array<uint32_t, SRSRAN_NOF_SF_X_FRAME>&   sf_re_class)
+{
+  uint32_t nof_classes = 0;
+  for (uint32_t sf_idx = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; ++sf_idx) {
+    sf_re_class[sf_idx] = nof_classes;
+    for (uint32_t prev_sf = 0; prev_sf < sf_idx; ++prev_sf) {
+      if (std::equal(lb_table[sf_idx].begin(), lb_table[sf_idx].end(), lb_table[prev_sf].begin())) {
+        sf_re_class[sf_idx] = sf_re_class[prev_sf];
+        break;
+      }
+    }
+    if (sf_re_class[sf_idx] == nof_classes) {
+      nof_classes++;
+    }
+  }
+  return nof_classes;
+}
+
+/// Fills the TBS table with the same MCS derivation of cqi_to_tbs_dl/ul() with dynamic MCS
+template <typename NofREFunc>
+void fill_tbs_table(prb_tbs_table& table, uint32_t nof_prb, uint32_t re_class, bool is_ul, const NofREFunc& get_nof_re)
+{
+  bool ulqam64_enabled   = is_ul and table.alt_table;
+  bool use_tbs_index_alt = not is_ul and table.alt_table;
+  for (uint32_t cqi = 0; cqi < prb_tbs_table::nof_cqis; ++cqi) {
+    for (uint32_t n = 1; n <= nof_prb; ++n) {
+      tbs_info tb = compute_min_mcs_and_tbs_from_required_bytes(n,
+                                                                get_nof_re(n),
+                                                                cqi,
+                                                                table.max_mcs,
+                                                                std::numeric_limits<uint32_t>::max(),
+                                                                is_ul,
+                                                                ulqam64_enabled,
+                                                                use_tbs_index_alt);
+      if (tb.tbs_bytes < 0) {
+        tb.tbs_bytes = get_tbs_bytes(0, n, use_tbs_index_alt, is_ul);
+      }
+      table.set_tbs(cqi, re_class, n, tb.tbs_bytes);
+    }
+  }
+}
+
 void sched_cell_params_t::regs_deleter::operator()(srsran_regs_t* p)
 {
   if (p != nullptr) {
@@ -355,6 +401,48 @@ bool sched_cell_params_t::set_cfg(uint32_t                             enb_cc_id
   nof_re_table    = generate_nof_re_table(cfg.cell);
   nof_re_lb_table = get_lb_nof_re_x_prb(nof_re_table);
 
+  // precompute the TBS of UE grants for each max MCS and TBS table combination set in sched_ue_cell::set_ue_cfg
+  uint32_t nof_re_classes = generate_sf_re_classes(nof_re_lb_table, dl_sf_re_class);
+  uint32_t max_mcs_dl     = sched_cfg->pdsch_max_mcs >= 0 ? std::min(sched_cfg->pdsch_max_mcs, 28) : 28U;
+  uint32_t max_mcs_dl_alt = std::min(max_mcs_dl, 27U);
+  // Note: UEs with use_tbs_index_alt use the normal TBS table for DCI format 1A
+  std::array<std::pair<uint32_t, bool>, 3> dl_mcs_cfgs{
+      {{max_mcs_dl, false}, {max_mcs_dl_alt, false}, {max_mcs_dl_alt, true}}};
+  dl_tbs_tables.clear();
+  for (const auto& mcs_cfg : dl_mcs_cfgs) {
+    if (get_dl_tbs_table(mcs_cfg.first, mcs_cfg.second) != nullptr) {
+      continue;
+    }
+    dl_tbs_tables.emplace_back(mcs_cfg.first, mcs_cfg.second, nof_re_classes, nof_prb());
+    for (uint32_t sf_idx = 0, next_class = 0; sf_idx < SRSRAN_NOF_SF_X_FRAME; ++sf_idx) {
+      if (dl_sf_re_class[sf_idx] != next_class) {
+        // RE class already computed
+        continue;
+      }
+      const auto& lb_nof_re = nof_re_lb_table[sf_idx];
+      fill_tbs_table(dl_tbs_tables.back(), nof_prb(), next_class++, false, [&lb_nof_re](uint32_t n) {
+        return lb_nof_re[n - 1];
+      });
+    }
+  }
+
+  using ul64qam_cap = sched_interface::ue_cfg_t::ul64qam_cap;
+  static const std::array<uint32_t, 3> max_64qam_mcs{20, 24, 28};
+  uint32_t max_mcs_ul      = sched_cfg->pusch_max_mcs >= 0 ? sched_cfg->pusch_max_mcs : 28U;
+  uint32_t nof_ul_re_x_prb = (2 * (SRSRAN_CP_NSYMB(cfg.cell.cp) - 1)) * SRSRAN_NRE;
+  ul_tbs_tables.clear();
+  for (ul64qam_cap cap : {ul64qam_cap::undefined, ul64qam_cap::disabled, ul64qam_cap::enabled}) {
+    uint32_t max_mcs = cfg.enable_64qam ? std::min(max_mcs_ul, max_64qam_mcs[(size_t)cap]) : max_mcs_ul;
+    bool     qam64   = cap == ul64qam_cap::enabled;
+    if (get_ul_tbs_table(max_mcs, qam64) != nullptr) {
+      continue;
+    }
+    ul_tbs_tables.emplace_back(max_mcs, qam64, 1, nof_prb());
+    fill_tbs_table(ul_tbs_tables.back(), nof_prb(), 0, true, [nof_ul_re_x_prb](uint32_t n) {
+      return nof_ul_re_x_prb * n;
+    });
+  }
+
   return true;
 }
 
@@ -372,6 +460,26 @@ uint32_t sched_cell_params_t::get_dl_lb_nof_re(tti_point tti_tx_dl, uint32_t nof
   return nof_re;
 }
 
+const prb_tbs_table* sched_cell_params_t::get_dl_tbs_table(uint32_t max_mcs, bool use_tbs_index_alt) const
+{
+  for (const prb_tbs_table& t : dl_tbs_tables) {
+    if (t.max_mcs == max_mcs and t.alt_table == use_tbs_index_alt) {
+      return &t;
+    }
+  }
+  return nullptr;
+}
+
+const prb_tbs_table* sched_cell_params_t::get_ul_tbs_table(uint32_t max_mcs, bool ulqam64_enabled) const
+{
+  for (const prb_tbs_table& t : ul_tbs_tables) {
+    if (t.max_mcs == max_mcs and t.alt_table == ulqam64_enabled) {
+      return &t;
+    }
+  }
+  return nullptr;
+}
+
 uint32_t
 sched_cell_params_t::get_dl_nof_res(srsran::tti_point tti_tx_dl, const srsran_dci_dl_t& dci, uint32_t cfi) const
 {
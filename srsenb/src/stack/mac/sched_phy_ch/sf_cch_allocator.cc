@@ -25,6 +25,55 @@
 
 namespace srsenb {
 
+namespace {
+
+/// Assigns to each row a different column of its bitmask, using augmenting paths
+template <size_t N>
+class bitmask_matcher
+{
+public:
+  using row_mask = std::array<uint64_t, N>;
+
+  explicit bitmask_matcher(const std::vector<row_mask>& rows_) : rows(rows_) { col_owner.fill(-1); }
+
+  /// Returns false if there is no assignment that covers all the rows
+  bool match_all_rows()
+  {
+    for (uint32_t r = 0; r < rows.size(); ++r) {
+      visited = {};
+      if (not augment(r)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  bool augment(uint32_t r)
+  {
+    for (uint32_t w = 0; w < N; ++w) {
+      uint64_t free_cols = rows[r][w] & ~visited[w];
+      while (free_cols != 0) {
+        uint32_t bit = __builtin_ctzll(free_cols);
+        free_cols &= free_cols - 1;
+        visited[w] |= 1ULL << bit;
+        int& owner = col_owner[w * 64 + bit];
+        if (owner < 0 or augment(owner)) {
+          owner = r;
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  const std::vector<row_mask>& rows;
+  row_mask                     visited;
+  std::array<int, N * 64>      col_owner;
+};
+
+} // namespace
+
 bool is_pucch_sr_collision(const srsran_pucch_cfg_t& ue_pucch_cfg, tti_point tti_tx_dl_ack, uint32_t n1_pucch)
 {
   if (ue_pucch_cfg.sr_configured && srsran_ue_ul_sr_send_tti(&ue_pucch_cfg, tti_tx_dl_ack.to_uint())) {
@@ -33,10 +82,108 @@ bool is_pucch_sr_collision(const srsran_pucch_cfg_t& ue_pucch_cfg, tti_point tti
   return false;
 }
 
-void sf_cch_allocator::init(const sched_cell_params_t& cell_params_)
+void sf_cch_allocator::cch_mask::set_cces(uint32_t start, uint32_t stop)
+{
+  for (uint32_t i = start; i < stop; ++i) {
+    cces[i / 64] |= 1ULL << (i % 64);
+  }
+}
+
+bool sf_cch_allocator::cch_mask::collides(const cch_mask& other, bool pucch_mux_enabled) const
+{
+  for (size_t i = 0; i < cces.size(); ++i) {
+    if ((cces[i] & other.cces[i]) != 0) {
+      return true;
+    }
+  }
+  if (not pucch_mux_enabled) {
+    for (size_t i = 0; i < pucch.size(); ++i) {
+      if ((pucch[i] & other.pucch[i]) != 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+uint32_t sf_cch_allocator::cch_mask::nof_cces() const
+{
+  uint32_t count = 0;
+  for (uint64_t w : cces) {
+    count += __builtin_popcountll(w);
+  }
+  return count;
+}
+
+sf_cch_allocator::cch_mask& sf_cch_allocator::cch_mask::operator&=(const cch_mask& other)
+{
+  for (size_t i = 0; i < cces.size(); ++i) {
+    cces[i] &= other.cces[i];
+  }
+  for (size_t i = 0; i < pucch.size(); ++i) {
+    pucch[i] &= other.pucch[i];
+  }
+  return *this;
+}
+
+sf_cch_allocator::cch_mask& sf_cch_allocator::cch_mask::operator|=(const cch_mask& other)
+{
+  for (size_t i = 0; i < cces.size(); ++i) {
+    cces[i] |= other.cces[i];
+  }
+  for (size_t i = 0; i < pucch.size(); ++i) {
+    pucch[i] |= other.pucch[i];
+  }
+  return *this;
+}
+
+size_t sf_cch_allocator::dfs_state::hash() const
+{
+  size_t h = cfix * 31 + level;
+  for (uint64_t w : mask.cces) {
+    h = h * 0x9e3779b97f4a7c15ULL + w;
+  }
+  for (uint64_t w : mask.pucch) {
+    h = h * 0x9e3779b97f4a7c15ULL + w;
+  }
+  return h ^ (h >> 32);
+}
+
+bool sf_cch_allocator::dfs_state_cache::contains(const dfs_state& state) const
+{
+  size_t h = state.hash();
+  for (uint32_t i = 0; i < max_probes; ++i) {
+    uint32_t slot = (h + i) % capacity;
+    if (not used.test(slot)) {
+      return false;
+    }
+    if (states[slot] == state) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void sf_cch_allocator::dfs_state_cache::insert(const dfs_state& state)
+{
+  size_t   h    = state.hash();
+  uint32_t slot = h % capacity;
+  for (uint32_t i = 0; i < max_probes; ++i) {
+    uint32_t probe = (h + i) % capacity;
+    if (not used.test(probe) or states[probe] == state) {
+      slot = probe;
+      break;
+    }
+  }
+  states[slot] = state;
+  used.set(slot);
+}
+
+void sf_cch_allocator::init(const sched_cell_params_t& cell_params_, uint32_t max_dfs_nodes_)
 {
   cc_cfg           = &cell_params_;
   pucch_cfg_common = cc_cfg->pucch_cfg_common;
+  max_dfs_nodes    = max_dfs_nodes_;
   dci_record_list.reserve(16);
   last_dci_dfs.reserve(16);
   temp_dci_dfs.reserve(16);
@@ -48,6 +195,8 @@ void sf_cch_allocator::new_tti(tti_point tti_rx_)
 
   dci_record_list.clear();
   last_dci_dfs.clear();
+  failed_dfs_states.clear();
+  nof_tti_dfs_nodes = 0;
   current_cfix     = cc_cfg->sched_cfg->min_nof_ctrl_symbols - 1;
   current_max_cfix = cc_cfg->sched_cfg->max_nof_ctrl_symbols - 1;
 }
@@ -72,7 +221,15 @@ sf_cch_allocator::get_cce_loc_table(alloc_type_t alloc_type, sched_ue* user, uin
 
 bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool has_pusch_grant)
 {
-  temp_dci_dfs.clear();
+  // The DCIs cannot fit if they take more CCEs than the highest CFI has. Checked before any DFS
+  uint32_t nof_dci_cces = 1U << aggr_idx;
+  for (const alloc_record& r : dci_record_list) {
+    nof_dci_cces += 1U << r.aggr_idx;
+  }
+  if (nof_dci_cces > cc_cfg->nof_cce_table[current_max_cfix]) {
+    return false;
+  }
+
   uint32_t start_cfix = current_cfix;
 
   alloc_record record;
@@ -98,26 +255,33 @@ bool sf_cch_allocator::alloc_dci(alloc_type_t alloc_type, uint32_t aggr_idx, sch
   }
 
   // Try to allocate grant. If it fails, attempt the same grant, but using a different permutation of past grant DCI
-  // positions
-  do {
-    bool success = alloc_dfs_node(record, 0);
-    if (success) {
-      // DCI record allocation successful
-      dci_record_list.push_back(record);
-
-      if (is_dl_ctrl_alloc(alloc_type)) {
-        // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
-        current_max_cfix = current_cfix;
-      }
-      return true;
+  // positions, unless the DFS budget of the TTI is spent
+  dci_record_list.push_back(record);
+  nof_resumed_levels = last_dci_dfs.size();
+  bool success       = alloc_dfs_node(dci_record_list.size() - 1, 0);
+  bool backtrack     = not success and nof_tti_dfs_nodes < max_dfs_nodes;
+  if (backtrack) {
+    temp_dci_dfs = last_dci_dfs;
+    if (not remaining_records_fit(0, cch_mask{})) {
+      // No permutation of the past DCI positions fits all DCIs in this CFI. Move to the next CFI
+      last_dci_dfs.clear();
     }
-    if (temp_dci_dfs.empty()) {
-      temp_dci_dfs = last_dci_dfs;
+    success = get_next_dfs();
+  }
+  if (success) {
+    if (is_dl_ctrl_alloc(alloc_type)) {
+      // Dynamic CFI not yet supported for DL control allocations, as coderate can be exceeded
+      current_max_cfix = current_cfix;
     }
-  } while (get_next_dfs());
+    return true;
+  }
 
   // Revert steps to initial state, before dci record allocation was attempted
-  last_dci_dfs.swap(temp_dci_dfs);
+  dci_record_list.pop_back();
+  failed_dfs_states.clear();
+  if (backtrack) {
+    last_dci_dfs.swap(temp_dci_dfs);
+  }
   current_cfix = start_cfix;
   return false;
 }
@@ -132,82 +296,176 @@ bool sf_cch_allocator::get_next_dfs()
       if (current_cfix > current_max_cfix) {
         return false;
       }
+      nof_resumed_levels = 0;
+      if (not remaining_records_fit(0, cch_mask{})) {
+        continue;
+      }
     } else {
       // Attempt to re-add last tree node, but with a higher node child index
       start_child_idx = last_dci_dfs.back().dci_pos_idx + 1;
       last_dci_dfs.pop_back();
+      // The levels below get new parent nodes
+      nof_resumed_levels = std::min(nof_resumed_levels, (uint32_t)last_dci_dfs.size() + 1);
     }
-    while (last_dci_dfs.size() < dci_record_list.size() and
-           alloc_dfs_node(dci_record_list[last_dci_dfs.size()], start_child_idx)) {
+    while (last_dci_dfs.size() < dci_record_list.size() and nof_tti_dfs_nodes < max_dfs_nodes and
+           alloc_dfs_node(last_dci_dfs.size(), start_child_idx)) {
       start_child_idx = 0;
     }
+    if (last_dci_dfs.size() < dci_record_list.size() and nof_tti_dfs_nodes >= max_dfs_nodes) {
+      // Give up on the DCI rather than exceeding the search latency budget of the TTI
+      return false;
+    }
   } while (last_dci_dfs.size() < dci_record_list.size());
 
   // Finished computation of next DFS node
   return true;
 }
 
-bool sf_cch_allocator::alloc_dfs_node(const alloc_record& record, uint32_t start_dci_idx)
+const sf_cch_allocator::dci_candidate_list& sf_cch_allocator::get_dci_candidates(alloc_record& record)
 {
-  // Get DCI Location Table
-  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
-  if (dci_locs == nullptr or (*dci_locs)[record.aggr_idx].empty()) {
-    return false;
-  }
-  const cce_position_list& dci_pos_list = (*dci_locs)[record.aggr_idx];
-  if (start_dci_idx >= dci_pos_list.size()) {
-    return false;
+  dci_candidate_list& dci_cands = record.dci_cands[current_cfix];
+  if (record.dci_cands_ready[current_cfix]) {
+    return dci_cands;
   }
+  record.dci_cands_ready[current_cfix] = true;
 
-  tree_node node;
-  node.dci_pos_idx = start_dci_idx;
-  node.dci_pos.L   = record.aggr_idx;
-  node.rnti        = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
-  node.current_mask.resize(nof_cces());
-  // get cumulative pdcch & pucch masks
-  if (not last_dci_dfs.empty()) {
-    node.total_mask       = last_dci_dfs.back().total_mask;
-    node.total_pucch_mask = last_dci_dfs.back().total_pucch_mask;
-  } else {
-    node.total_mask.resize(nof_cces());
-    node.total_pucch_mask.resize(cc_cfg->nof_prb());
+  // Get DCI Location Table
+  const cce_cfi_position_table* dci_locs = get_cce_loc_table(record.alloc_type, record.user, current_cfix);
+  if (dci_locs == nullptr) {
+    return dci_cands;
   }
-
-  for (; node.dci_pos_idx < dci_pos_list.size(); ++node.dci_pos_idx) {
-    node.dci_pos.ncce = dci_pos_list[node.dci_pos_idx];
-
+  for (uint32_t ncce : (*dci_locs)[record.aggr_idx]) {
+    dci_candidate cand;
+    cand.ncce = ncce;
     if (record.alloc_type == alloc_type_t::DL_DATA and not record.pusch_uci) {
       // The UE needs to allocate space in PUCCH for HARQ-ACK
-      pucch_cfg_common.n_pucch = node.dci_pos.ncce + pucch_cfg_common.N_pucch_1;
+      pucch_cfg_common.n_pucch = ncce + pucch_cfg_common.N_pucch_1;
 
       if (is_pucch_sr_collision(record.user->get_ue_cfg().pucch_cfg, to_tx_dl_ack(tti_rx), pucch_cfg_common.n_pucch)) {
         // avoid collision of HARQ-ACK with own SR n(1)_pucch
         continue;
       }
+      cand.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
+      cand.cch.set_pucch_prb(cand.pucch_n_prb);
+    }
+    cand.mask.resize(nof_cces());
+    cand.mask.fill(ncce, ncce + (1U << record.aggr_idx));
+    cand.cch.set_cces(ncce, ncce + (1U << record.aggr_idx));
+    dci_cands.push_back(cand);
+  }
+  return dci_cands;
+}
 
-      node.pucch_n_prb = srsran_pucch_n_prb(&cc_cfg->cfg.cell, &pucch_cfg_common, 0);
-      if (not cc_cfg->sched_cfg->pucch_mux_enabled and node.total_pucch_mask.test(node.pucch_n_prb)) {
-        // PUCCH allocation would collide with other PUCCH/PUSCH grants. Try another CCE position
-        continue;
+sf_cch_allocator::dfs_state sf_cch_allocator::get_dfs_state(uint32_t level, const cch_mask& total_mask)
+{
+  // Only the CCEs and PUCCH PRBs that the DCIs of this level and below can take matter for their allocation
+  cch_mask used_mask;
+  for (uint32_t i = level; i < dci_record_list.size(); ++i) {
+    for (const dci_candidate& cand : get_dci_candidates(dci_record_list[i])) {
+      used_mask |= cand.cch;
+    }
+  }
+  if (cc_cfg->sched_cfg->pucch_mux_enabled) {
+    used_mask.pucch = {};
+  }
+  used_mask &= total_mask;
+  return dfs_state{current_cfix, level, used_mask};
+}
+
+bool sf_cch_allocator::is_failed_dfs_state(uint32_t level, const cch_mask& total_mask)
+{
+  return failed_dfs_states.contains(get_dfs_state(level, total_mask));
+}
+
+bool sf_cch_allocator::remaining_records_fit(uint32_t record_idx, const cch_mask& total_mask)
+{
+  // The remaining DCIs cannot take more CCEs than the ones left
+  uint32_t nof_free_cces = nof_cces() - total_mask.nof_cces();
+  for (uint32_t i = record_idx; i < dci_record_list.size(); ++i) {
+    uint32_t nof_dci_cces = 1U << dci_record_list[i].aggr_idx;
+    if (nof_dci_cces > nof_free_cces) {
+      return false;
+    }
+    nof_free_cces -= nof_dci_cces;
+  }
+
+  // Each remaining DCI needs free CCEs and, if it carries an HARQ-ACK, a free PUCCH PRB that no other remaining DCI
+  // takes. Checked as two bipartite matchings over the CCEs and PUCCH PRBs of the positions that are still free
+  bool pucch_mux = cc_cfg->sched_cfg->pucch_mux_enabled;
+  cce_reach.clear();
+  pucch_reach.clear();
+  for (uint32_t i = record_idx; i < dci_record_list.size(); ++i) {
+    const dci_candidate_list& dci_cands = get_dci_candidates(dci_record_list[i]);
+    cch_mask                  reach;
+    bool                      needs_pucch = true;
+    for (const dci_candidate& cand : dci_cands) {
+      if (not cand.cch.collides(total_mask, pucch_mux)) {
+        reach |= cand.cch;
+        needs_pucch &= cand.pucch_n_prb >= 0;
       }
     }
+    if (reach.nof_cces() == 0) {
+      return false;
+    }
+    // A DCI takes 2^L CCEs, so it takes 2^L rows of the CCE matching
+    cce_reach.insert(cce_reach.end(), 1U << dci_record_list[i].aggr_idx, reach.cces);
+    if (needs_pucch and not pucch_mux) {
+      pucch_reach.push_back(reach.pucch);
+    }
+  }
+  return bitmask_matcher<cch_mask::nof_cce_words>(cce_reach).match_all_rows() and
+         bitmask_matcher<cch_mask::nof_pucch_words>(pucch_reach).match_all_rows();
+}
+
+bool sf_cch_allocator::alloc_dfs_node(uint32_t record_idx, uint32_t start_dci_idx)
+{
+  alloc_record&             record      = dci_record_list[record_idx];
+  const dci_candidate_list& dci_cands   = get_dci_candidates(record);
+  const tree_node*          parent_node = last_dci_dfs.empty() ? nullptr : &last_dci_dfs.back();
+  cch_mask                  parent_mask = parent_node != nullptr ? parent_node->total_cch_mask : cch_mask{};
+  nof_tti_dfs_nodes++;
+  if (is_failed_dfs_state(record_idx, parent_mask)) {
+    return false;
+  }
 
-    node.current_mask.reset();
-    node.current_mask.fill(node.dci_pos.ncce, node.dci_pos.ncce + (1U << record.aggr_idx));
-    if ((node.total_mask & node.current_mask).any()) {
-      // there is a PDCCH collision. Try another CCE position
+  bool pucch_mux = cc_cfg->sched_cfg->pucch_mux_enabled;
+  for (uint32_t dci_idx = start_dci_idx; dci_idx < dci_cands.size(); ++dci_idx) {
+    const dci_candidate& cand = dci_cands[dci_idx];
+    if (cand.cch.collides(parent_mask, pucch_mux)) {
+      // there is a PDCCH or PUCCH collision. Try another CCE position
+      continue;
+    }
+    cch_mask total_mask = parent_mask;
+    total_mask |= cand.cch;
+    if (record_idx + 1 < dci_record_list.size() and
+        (is_failed_dfs_state(record_idx + 1, total_mask) or not remaining_records_fit(record_idx + 1, total_mask))) {
+      // The DCIs of the next DFS levels would not fit with this CCE position. Try another CCE position
       continue;
     }
 
     // Allocation successful
-    node.total_mask |= node.current_mask;
-    if (node.pucch_n_prb >= 0) {
-      node.total_pucch_mask.set(node.pucch_n_prb);
+    tree_node node;
+    node.pucch_n_prb  = cand.pucch_n_prb;
+    node.rnti         = record.user != nullptr ? record.user->get_rnti() : SRSRAN_INVALID_RNTI;
+    node.record_idx   = record_idx;
+    node.dci_pos_idx  = dci_idx;
+    node.dci_pos.L    = record.aggr_idx;
+    node.dci_pos.ncce = cand.ncce;
+    node.current_mask = cand.mask;
+    if (parent_node != nullptr) {
+      node.total_mask = parent_node->total_mask | cand.mask;
+    } else {
+      node.total_mask = cand.mask;
     }
+    node.total_cch_mask = total_mask;
     last_dci_dfs.push_back(node);
     return true;
   }
 
+  if (record_idx >= nof_resumed_levels) {
+    // All the positions of this level were tried since its parent node was added
+    failed_dfs_states.insert(get_dfs_state(record_idx, parent_mask));
+  }
   return false;
 }
 
@@ -218,6 +476,7 @@ void sf_cch_allocator::rem_last_dci()
   // Remove DCI record
   last_dci_dfs.pop_back();
   dci_record_list.pop_back();
+  failed_dfs_states.clear();
 }
 
 void sf_cch_allocator::get_allocs(alloc_result_t* vec, pdcch_mask_t* tot_mask, size_t idx) const
@@ -160,76 +160,27 @@ void sched_ue_cell::set_dl_cqi(tti_point tti_rx, uint32_t dl_cqi_)
  ************************************************************/
 
 /**
- * Implementation of false position method to iteratively find zero of given monotonic discrete function
- * @tparam YType type of y axis
- * @tparam Callable callable with interface "YType function(int)"
- * @tparam ErrorDetect callable with interface "bool function(YType)"
- * @param x1 min x value of input interval
- * @param x2 max x value of input interval
- * @param y0 target y value
- * @param f monotonic function "YType f(int)" that crosses zero within [x1, x2]
- * @param is_error returns true if an error has been detected
- * @return solution of false position. It contains the interval when "f(x)" crossed y0. In case,
- *         - f(x2) <= y0 -> return is tuple(x2, y2, x2, y2)
- *         - f(x1) >= y0 -> return is tuple(x1, x1, x1, x1)
- *         - x' in ]x1, x2[, such that f(x') < y0 and f(x'+1) > y0 -> return is tuple(x', f(x'), x'+1, f(x'+1))
- *         - x' in ]x1, x2[, such that f(x') == y0 -> return is tuple(x', f(x'), x', f(x'))
+ * Binary search of the lowest nof PRBs whose TBS reaches the required nof bytes, for the cases not covered by the
+ * precomputed TBS tables of the cell
+ * @tparam Callable callable with interface "int function(uint32_t nof_prb)" that returns the TBS in bytes. The TBS
+ *                  is assumed to be non-decreasing with the nof PRBs
+ * @param max_prbs upper bound of the search interval {1, ..., max_prbs}
+ * @param req_bytes required TBS in bytes
+ * @return lowest nof PRBs with TBS >= req_bytes, or max_prbs + 1 if the TBS of max_prbs is still below req_bytes
  */
-template <typename YType, typename Callable, typename ErrorDetect>
-std::tuple<int, YType, int, YType>
-false_position_method(int x1, int x2, YType y0, const Callable& f, const ErrorDetect& is_error)
+template <typename Callable>
+uint32_t find_min_prbs(uint32_t max_prbs, int req_bytes, const Callable& compute_tbs)
 {
-  static_assert(std::is_same<YType, decltype(f(x1))>::value,
-                "The type of the final result and callable return do not match");
-  YType y1 = f(x1);
-  if (is_error(y1) or y1 >= y0) {
-    return std::make_tuple(x1, y1, x1, y1);
-  }
-  YType y2 = f(x2);
-  if (is_error(y2) or y2 <= y0) {
-    return std::make_tuple(x2, y2, x2, y2);
-  }
-  YType y3;
-  while (x2 > x1 + 1) {
-    int x3 = round(x1 - ((x2 - x1) * (y1 - y0) / (float)(y2 - y1)));
-    if (x3 == x2) {
-      y3 = y2;
-      // check if in frontier
-      YType y3_1 = f(x3 - 1);
-      if (not is_error(y3_1) and y3_1 < y0) {
-        return std::make_tuple(x3 - 1, y3_1, x3, y3);
-      }
-      x3--;
-      y3 = y3_1;
-    } else if (x3 == x1) {
-      y3 = y1;
-      // check if in frontier
-      YType y3_1 = f(x3 + 1);
-      if (not is_error(y3_1) and y3_1 >= y0) {
-        return std::make_tuple(x3, y3, x3 + 1, y3_1);
-      }
-      x3++;
-      y3 = y3_1;
-    } else {
-      y3 = f(x3);
-      if (is_error(y3) or y3 == y0) {
-        return std::make_tuple(x3, y3, x3, y3);
-      }
-    }
-    if (y3 < y0) {
-      x1 = x3;
-      y1 = y3;
+  uint32_t lo = 1, hi = max_prbs + 1;
+  while (lo < hi) {
+    uint32_t mid = (lo + hi) / 2;
+    if (compute_tbs(mid) < req_bytes) {
+      lo = mid + 1;
     } else {
-      x2 = x3;
-      y2 = y3;
+      hi = mid;
     }
   }
-  return std::make_tuple(x1, y1, x2, y2);
-}
-template <typename YType, typename Callable>
-std::tuple<int, YType, int, YType> false_position_method(int x1, int x2, YType y0, const Callable& f)
-{
-  return false_position_method(x1, x2, y0, f, [](int x) { return false; });
+  return lo;
 }
 
 tbs_info cqi_to_tbs_dl(const sched_ue_cell& cell,
@@ -292,38 +243,54 @@ int get_required_prb_dl(const sched_ue_cell& cell,
                         srsran_dci_format_t  dci_format,
                         uint32_t             req_bytes)
 {
-  auto compute_tbs_approx = [tti_tx_dl, &cell, dci_format](uint32_t nof_prb) {
-    uint32_t nof_re = cell.cell_cfg->get_dl_lb_nof_re(tti_tx_dl, nof_prb);
-    tbs_info tb     = cqi_to_tbs_dl(cell, nof_prb, nof_re, dci_format, -1);
-    return tb.tbs_bytes;
-  };
-
-  std::tuple<uint32_t, int, uint32_t, int> ret = false_position_method(
-      1U, cell.cell_cfg->nof_prb(), (int)req_bytes, compute_tbs_approx, [](int y) { return y == SRSRAN_ERROR; });
-  int      upper_tbs  = std::get<3>(ret);
-  uint32_t upper_nprb = std::get<2>(ret);
-  return (upper_tbs < 0) ? 0 : ((upper_tbs < (int)req_bytes) ? -1 : static_cast<int>(upper_nprb));
+  const prb_tbs_table* tbs_table = nullptr;
+  if ((cell.fixed_mcs_dl < 0 or not cell.dl_cqi_rx) and cell.dl_cqi < prb_tbs_table::nof_cqis) {
+    bool use_tbs_index_alt = cell.get_ue_cfg()->use_tbs_index_alt and dci_format != SRSRAN_DCI_FORMAT1A;
+    tbs_table              = cell.cell_cfg->get_dl_tbs_table(cell.max_mcs_dl, use_tbs_index_alt);
+  }
+  uint32_t nof_prbs;
+  if (tbs_table != nullptr) {
+    uint32_t re_class = cell.cell_cfg->dl_sf_re_class[tti_tx_dl.sf_idx()];
+    nof_prbs          = tbs_table->get_min_prbs(cell.dl_cqi, re_class, cell.cell_cfg->nof_prb(), (int)req_bytes);
+  } else {
+    // Fixed MCS or UE configuration not covered by the cell TBS tables
+    auto compute_tbs_approx = [tti_tx_dl, &cell, dci_format](uint32_t nof_prb) {
+      uint32_t nof_re = cell.cell_cfg->get_dl_lb_nof_re(tti_tx_dl, nof_prb);
+      return cqi_to_tbs_dl(cell, nof_prb, nof_re, dci_format, -1).tbs_bytes;
+    };
+    nof_prbs = find_min_prbs(cell.cell_cfg->nof_prb(), (int)req_bytes, compute_tbs_approx);
+  }
+  return nof_prbs > cell.cell_cfg->nof_prb() ? -1 : static_cast<int>(nof_prbs);
 }
 
 uint32_t get_required_prb_ul(const sched_ue_cell& cell, uint32_t req_bytes)
 {
+  using ul64qam_cap                = sched_interface::ue_cfg_t::ul64qam_cap;
   const static int MIN_ALLOC_BYTES = 10;
   if (req_bytes == 0) {
     return 0;
   }
-  auto compute_tbs_approx = [&cell](uint32_t nof_prb) {
+  const prb_tbs_table* tbs_table = nullptr;
+  if (cell.fixed_mcs_ul < 0 and cell.ul_cqi < prb_tbs_table::nof_cqis) {
+    bool ulqam64_enabled = cell.get_ue_cfg()->support_ul64qam == ul64qam_cap::enabled;
+    tbs_table            = cell.cell_cfg->get_ul_tbs_table(cell.max_mcs_ul, ulqam64_enabled);
+  }
+  auto compute_tbs_approx = [&cell, tbs_table](uint32_t nof_prb) {
+    if (tbs_table != nullptr) {
+      return tbs_table->get_tbs(cell.ul_cqi, 0, nof_prb);
+    }
     const uint32_t N_srs  = 0;
     uint32_t       nof_re = (2 * (SRSRAN_CP_NSYMB(cell.cell_cfg->cfg.cell.cp) - 1) - N_srs) * nof_prb * SRSRAN_NRE;
     return cqi_to_tbs_ul(cell, nof_prb, nof_re, -1).tbs_bytes;
   };
 
   // find nof prbs that lead to a tbs just above req_bytes
-  int                                      target_tbs = std::max(static_cast<int>(req_bytes) + 4, MIN_ALLOC_BYTES);
-  uint32_t                                 max_prbs   = std::min(cell.tpc_fsm.max_ul_prbs(), cell.cell_cfg->nof_prb());
-  std::tuple<uint32_t, int, uint32_t, int> ret =
-      false_position_method(1U, max_prbs, target_tbs, compute_tbs_approx, [](int y) { return y == SRSRAN_ERROR; });
-  uint32_t req_prbs  = std::get<2>(ret);
-  uint32_t final_tbs = std::get<3>(ret);
+  int      target_tbs = std::max(static_cast<int>(req_bytes) + 4, MIN_ALLOC_BYTES);
+  uint32_t max_prbs   = std::min(cell.tpc_fsm.max_ul_prbs(), cell.cell_cfg->nof_prb());
+  uint32_t req_prbs   = tbs_table != nullptr ? tbs_table->get_min_prbs(cell.ul_cqi, 0, max_prbs, target_tbs)
+                                             : find_min_prbs(max_prbs, target_tbs, compute_tbs_approx);
+  req_prbs            = std::min(req_prbs, max_prbs);
+  int      final_tbs  = compute_tbs_approx(req_prbs);
   while (final_tbs < MIN_ALLOC_BYTES and req_prbs < cell.cell_cfg->nof_prb()) {
     // Note: If PHR<0 is limiting the max nof PRBs per UL grant, the UL grant may become too small to fit any
     //       data other than headers + BSR. Besides, forcing unnecessary segmentation, it may additionally
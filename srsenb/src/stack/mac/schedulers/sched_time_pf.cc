@@ -33,6 +33,8 @@ sched_time_pf::sched_time_pf(const sched_cell_params_t& cell_params_, const sche
     fairness_coeff = std::stof(sched_args.sched_policy_args);
   }
 
+  ue_history_db.reserve(SRSENB_MAX_UES);
+
   std::vector<ue_ctxt *> dl_storage;
   dl_storage.reserve(SRSENB_MAX_UES);
   dl_queue = ue_dl_queue_t(ue_dl_prio_compare{}, std::move(dl_storage));
@@ -53,18 +55,21 @@ void sched_time_pf::new_tti(sched_ue_list& ue_db, sf_sched* tti_sched)
       ++it;
     }
   }
-  // add new users to history db, and update priority queues
-  for (auto& u : ue_db) {
-    auto it = ue_history_db.find(u.first);
-    if (it == ue_history_db.end()) {
-      it = ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff}).value();
+  // add new users to history db
+  if (ue_history_db.size() != ue_db.size()) {
+    for (auto& u : ue_db) {
+      ue_history_db.insert(u.first, ue_ctxt{u.first, fairness_coeff});
     }
-    it->second.new_tti(*cc_cfg, *u.second, tti_sched);
-    if (it->second.dl_newtx_h != nullptr or it->second.dl_retx_h != nullptr) {
-      dl_queue.push(&it->second);
+  }
+  // update priority queues. Insertions move the history entries, so the pointers are only taken once all are added
+  for (auto& ctxt : ue_history_db) {
+    ue_ctxt& ue = ctxt.second;
+    ue.new_tti(*cc_cfg, *ue_db[ue.rnti], tti_sched);
+    if (ue.dl_newtx_h != nullptr or ue.dl_retx_h != nullptr) {
+      dl_queue.push(&ue);
     }
-    if (it->second.ul_h != nullptr) {
-      ul_queue.push(&it->second);
+    if (ue.ul_h != nullptr) {
+      ul_queue.push(&ue);
     }
   }
 }
@@ -727,6 +727,17 @@ void ue::metrics_tx(bool crc, uint32_t tbs)
   ue_metrics.tx_pkts++;
 }
 
+void ue::save_dl_tbs(uint32_t enb_cc_idx, uint32_t tti_tx_dl, uint32_t tb_idx, uint32_t tbs)
+{
+  dl_tx_tbs[enb_cc_idx][tti_tx_dl % TTIMOD_SZ][tb_idx] = tbs;
+}
+
+uint32_t ue::get_acked_dl_tbs(uint32_t enb_cc_idx, uint32_t tti_rx, uint32_t tb_idx) const
+{
+  tti_point tti_tx_dl = tti_point{tti_rx} - FDD_HARQ_DELAY_DL_MS;
+  return dl_tx_tbs[enb_cc_idx][tti_tx_dl.to_uint() % TTIMOD_SZ][tb_idx];
+}
+
 void ue::metrics_cnt()
 {
   ue_metrics.nof_tti++;
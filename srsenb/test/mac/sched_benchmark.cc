@@ -23,7 +23,9 @@
 #include "srsenb/hdr/stack/mac/sched.h"
 #include "srsran/adt/accumulators.h"
 #include "srsran/common/common_lte.h"
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 namespace srsenb {
 
@@ -33,6 +35,9 @@ struct run_params {
   uint32_t    nof_ttis;
   uint32_t    cqi;
   const char* sched_policy;
+  bool        feedback_thread;
+  uint32_t    nof_carriers;
+  bool        parallel_carrier_sched;
 };
 
 struct run_params_range {
@@ -41,13 +46,19 @@ struct run_params_range {
   uint32_t                 nof_ttis     = 10000;
   std::vector<uint32_t>    cqi          = {5, 10, 15};
   std::vector<const char*> sched_policy = {"time_rr", "time_pf"};
+  bool                     feedback_thread = false; ///< whether the CSI feedback is sent from a separate thread
+  uint32_t                 nof_carriers    = 1;     ///< number of carriers configured in every UE
+  bool                     parallel_carrier_sched = false; ///< whether the carriers are scheduled in separate threads
 
   size_t     nof_runs() const { return nof_prbs.size() * nof_ues.size() * cqi.size() * sched_policy.size(); }
   run_params get_params(size_t idx) const
   {
-    run_params r = {};
-    r.nof_ttis   = nof_ttis;
-    r.nof_prbs   = nof_prbs[idx % nof_prbs.size()];
+    run_params r             = {};
+    r.nof_ttis               = nof_ttis;
+    r.feedback_thread        = feedback_thread;
+    r.nof_carriers           = nof_carriers;
+    r.parallel_carrier_sched = parallel_carrier_sched;
+    r.nof_prbs               = nof_prbs[idx % nof_prbs.size()];
     idx /= nof_prbs.size();
     r.nof_ues = nof_ues[idx % nof_ues.size()];
     idx /= nof_ues.size();
@@ -90,7 +101,7 @@ public:
 
   struct throughput_stats {
     srsran::rolling_average<float> mean_dl_tbs, mean_ul_tbs, avg_dl_mcs, avg_ul_mcs;
-    srsran::rolling_average<float> avg_latency;
+    srsran::rolling_average<float> avg_latency, avg_tti_latency;
   };
   throughput_stats total_stats;
 
@@ -100,6 +111,7 @@ public:
     mac_logger.set_context(tti_rx.to_uint());
     new_tti(tti_rx);
 
+    std::chrono::nanoseconds tti_dur{0};
     for (uint32_t cc = 0; cc < get_cell_params().size(); ++cc) {
       std::chrono::time_point<std::chrono::steady_clock> tp = std::chrono::steady_clock::now();
       TESTASSERT(sched_ptr->dl_sched(to_tx_dl(tti_rx).to_uint(), cc, dl_result[cc]) == SRSRAN_SUCCESS);
@@ -107,7 +119,9 @@ public:
       std::chrono::time_point<std::chrono::steady_clock> tp2 = std::chrono::steady_clock::now();
       std::chrono::nanoseconds tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(tp2 - tp);
       total_stats.avg_latency.push(tdur.count());
+      tti_dur += tdur;
     }
+    total_stats.avg_tti_latency.push(tti_dur.count());
 
     sf_output_res_t sf_out{get_cell_params(), tti_rx, ul_result, dl_result};
     update(sf_out);
@@ -164,14 +178,30 @@ struct run_data {
   float                     avg_dl_mcs;
   float                     avg_ul_mcs;
   std::chrono::microseconds avg_latency;
+  std::chrono::microseconds avg_tti_latency;
+  std::chrono::nanoseconds  avg_feedback_latency;
+  std::chrono::nanoseconds  max_feedback_latency;
 };
 
 int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results)
 {
-  std::vector<sched_interface::cell_cfg_t> cell_list(1, generate_default_cell_cfg(params.nof_prbs));
+  std::vector<sched_interface::cell_cfg_t> cell_list(params.nof_carriers, generate_default_cell_cfg(params.nof_prbs));
   sched_interface::ue_cfg_t                ue_cfg_default = generate_default_ue_cfg();
   sched_interface::sched_args_t            sched_args     = {};
   sched_args.sched_policy                                 = params.sched_policy;
+  sched_args.parallel_carrier_sched                       = params.parallel_carrier_sched;
+
+  // Every cell is an SCell candidate of the other cells
+  for (uint32_t cc = 0; cc < cell_list.size(); ++cc) {
+    cell_list[cc].cell.id += cc;
+    for (uint32_t scell_idx = 0; scell_idx < cell_list.size(); ++scell_idx) {
+      if (scell_idx != cc) {
+        cell_list[cc].scell_list.emplace_back();
+        cell_list[cc].scell_list.back().enb_cc_idx = scell_idx;
+        cell_list[cc].scell_list.back().ul_allowed = true;
+      }
+    }
+  }
 
   sched     sched_obj;
   rrc_dummy rrc{};
@@ -202,11 +232,64 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
     tester.advance_tti();
     ue_db_ctxt = tester.get_enb_ctxt().ue_db;
   }
+
+  // Activate the SCells. They are used once a positive CQI is received for them
+  if (params.nof_carriers > 1) {
+    sched_interface::ue_cfg_t ue_cfg_ca = ue_cfg_default;
+    ue_cfg_ca.supported_cc_list.resize(params.nof_carriers, ue_cfg_default.supported_cc_list[0]);
+    for (uint32_t cc = 0; cc < params.nof_carriers; ++cc) {
+      ue_cfg_ca.supported_cc_list[cc].enb_cc_idx                            = cc;
+      ue_cfg_ca.supported_cc_list[cc].dl_cfg.cqi_report.periodic_configured = true;
+      ue_cfg_ca.supported_cc_list[cc].dl_cfg.cqi_report.pmi_idx             = 37 + cc;
+    }
+    for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
+      TESTASSERT(tester.ue_recfg(0x46 + ue_idx, ue_cfg_ca) == SRSRAN_SUCCESS);
+    }
+    for (uint32_t count = 0; count < 100; ++count) {
+      tester.advance_tti();
+    }
+  }
   tester.total_stats = {};
 
+  // The PHY workers report the CSI of every UE once per TTI, while the scheduler is running
+  std::atomic<bool>              stop_feedback{false};
+  std::atomic<uint32_t>          feedback_tti{tester.get_tti_rx().to_uint()};
+  srsran::rolling_average<float> feedback_latency;
+  std::chrono::nanoseconds       max_feedback_latency{0};
+  std::thread                    feedback_thread;
+  if (params.feedback_thread) {
+    feedback_thread = std::thread([&]() {
+      uint32_t last_tti = feedback_tti;
+      while (not stop_feedback) {
+        uint32_t tti = feedback_tti;
+        if (tti == last_tti) {
+          std::this_thread::yield();
+          continue;
+        }
+        last_tti = tti;
+        for (uint32_t ue_idx = 0; ue_idx < params.nof_ues; ++ue_idx) {
+          uint16_t rnti = 0x46 + ue_idx;
+          auto     tp   = std::chrono::steady_clock::now();
+          sched_obj.dl_cqi_info(tti, rnti, 0, params.cqi);
+          sched_obj.ul_snr_info(tti, rnti, 0, 40, 0);
+          std::chrono::nanoseconds tdur =
+              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+          feedback_latency.push(tdur.count());
+          max_feedback_latency = std::max(max_feedback_latency, tdur);
+        }
+      }
+    });
+  }
+
   // Run benchmark
   for (uint32_t count = 0; count < params.nof_ttis; ++count) {
     tester.advance_tti();
+    feedback_tti = tester.get_tti_rx().to_uint();
+  }
+
+  if (feedback_thread.joinable()) {
+    stop_feedback = true;
+    feedback_thread.join();
   }
 
   run_data run_result          = {};
@@ -216,6 +299,10 @@ int run_benchmark_scenario(run_params params, std::vector<run_data>& run_results
   run_result.avg_dl_mcs        = tester.total_stats.avg_dl_mcs.value();
   run_result.avg_ul_mcs        = tester.total_stats.avg_ul_mcs.value();
   run_result.avg_latency = std::chrono::microseconds(static_cast<int>(tester.total_stats.avg_latency.value() / 1000));
+  run_result.avg_tti_latency =
+      std::chrono::microseconds(static_cast<int>(tester.total_stats.avg_tti_latency.value() / 1000));
+  run_result.avg_feedback_latency = std::chrono::nanoseconds(static_cast<int>(feedback_latency.value()));
+  run_result.max_feedback_latency = max_feedback_latency;
   run_results.push_back(run_result);
 
   return SRSRAN_SUCCESS;
@@ -288,6 +375,44 @@ void print_benchmark_results(const std::vector<run_data>& run_results)
   }
 }
 
+void print_feedback_benchmark_results(const std::vector<run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("run | Nprb | sched pol | Nue | latency [usec] | feedback call avg/max [nsec]\n");
+  fmt::print("---------------------------------------------------------------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>6d}{:>12}{:>6d}{:>17d}{:>15d}/{:<10d}\n",
+               i,
+               r.params.nof_prbs,
+               r.params.sched_policy,
+               r.params.nof_ues,
+               r.avg_latency.count(),
+               r.avg_feedback_latency.count(),
+               r.max_feedback_latency.count());
+  }
+}
+
+void print_carrier_benchmark_results(const std::vector<run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("run | Nprb | sched pol | Nue | Ncc | parallel | DL/UL [Mbps] | TTI latency [usec]\n");
+  fmt::print("------------------------------------------------------------------------------\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>6d}{:>12}{:>6d}{:>6d}{:>11}{:>9.2f}/{:<6.2f}{:>16d}\n",
+               i,
+               r.params.nof_prbs,
+               r.params.sched_policy,
+               r.params.nof_ues,
+               r.params.nof_carriers,
+               r.params.parallel_carrier_sched ? "yes" : "no",
+               r.avg_dl_throughput / 1e6,
+               r.avg_ul_throughput / 1e6,
+               r.avg_tti_latency.count());
+  }
+}
+
 int run_rate_test()
 {
   fmt::print("\n====== Scheduler Rate Test ======\n\n");
@@ -386,6 +511,87 @@ int run_benchmark()
   return SRSRAN_SUCCESS;
 }
 
+int run_ue_scaling_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis = 10000;
+  run_param_list.nof_prbs = {100};
+  run_param_list.cqi      = {15};
+  run_param_list.nof_ues  = {256, 512, 1024};
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running UE scaling Benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+int run_feedback_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis        = 10000;
+  run_param_list.nof_prbs        = {100};
+  run_param_list.cqi             = {15};
+  run_param_list.nof_ues         = {32, 256};
+  run_param_list.feedback_thread = true;
+
+  std::vector<run_data> run_results;
+  size_t                nof_runs = run_param_list.nof_runs();
+  fmt::print("Running Feedback Benchmark\n");
+  for (size_t r = 0; r < nof_runs; ++r) {
+    run_params runparams = run_param_list.get_params(r);
+
+    mac_logger.info("\n### New run {} ###\n", r);
+    TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+  }
+
+  print_feedback_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
+int run_carrier_benchmark()
+{
+  run_params_range      run_param_list{};
+  srslog::basic_logger& mac_logger = srslog::fetch_basic_logger("MAC");
+
+  run_param_list.nof_ttis = 10000;
+  run_param_list.nof_prbs = {100};
+  run_param_list.cqi      = {15};
+  run_param_list.nof_ues  = {32, 128};
+
+  std::vector<run_data> run_results;
+  fmt::print("Running Carrier Aggregation Benchmark\n");
+  for (uint32_t nof_carriers : {2, 4}) {
+    for (bool parallel : {false, true}) {
+      run_param_list.nof_carriers           = nof_carriers;
+      run_param_list.parallel_carrier_sched = parallel;
+      for (size_t r = 0; r < run_param_list.nof_runs(); ++r) {
+        run_params runparams = run_param_list.get_params(r);
+
+        mac_logger.info("\n### New run {} ###\n", run_results.size());
+        TESTASSERT(run_benchmark_scenario(runparams, run_results) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+
+  print_carrier_benchmark_results(run_results);
+
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main(int argc, char* argv[])
@@ -416,6 +622,12 @@ int main(int argc, char* argv[])
     TESTASSERT(srsenb::run_rate_test() == SRSRAN_SUCCESS);
   } else if (strcmp(argv[1], "benchmark") == 0) {
     TESTASSERT(srsenb::run_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "ue_scaling") == 0) {
+    TESTASSERT(srsenb::run_ue_scaling_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "feedback") == 0) {
+    TESTASSERT(srsenb::run_feedback_benchmark() == SRSRAN_SUCCESS);
+  } else if (strcmp(argv[1], "carriers") == 0) {
+    TESTASSERT(srsenb::run_carrier_benchmark() == SRSRAN_SUCCESS);
   } else {
     TESTASSERT(srsenb::run_all() == SRSRAN_SUCCESS);
   }
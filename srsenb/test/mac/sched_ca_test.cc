@@ -84,7 +84,8 @@ sim_sched_args generate_default_sim_args(uint32_t nof_prb, uint32_t nof_ccs)
 }
 
 struct test_scell_activation_params {
-  uint32_t pcell_idx = 0;
+  uint32_t pcell_idx              = 0;
+  bool     parallel_carrier_sched = false;
 };
 
 int test_scell_activation(uint32_t sim_number, test_scell_activation_params params)
@@ -111,8 +112,9 @@ int test_scell_activation(uint32_t sim_number, test_scell_activation_params para
   std::iter_swap(cc_idxs.begin(), std::find(cc_idxs.begin(), cc_idxs.end(), params.pcell_idx));
 
   /* Setup simulation arguments struct */
-  sim_sched_args sim_args = generate_default_sim_args(nof_prb, nof_ccs);
-  sim_args.start_tti      = start_tti;
+  sim_sched_args sim_args                    = generate_default_sim_args(nof_prb, nof_ccs);
+  sim_args.start_tti                         = start_tti;
+  sim_args.sched_args.parallel_carrier_sched = params.parallel_carrier_sched;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list.resize(1);
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].active                                = true;
   sim_args.default_ue_sim_cfg.ue_cfg.supported_cc_list[0].enb_cc_idx                            = cc_idxs[0];
@@ -280,6 +282,12 @@ int main()
     p           = {};
     p.pcell_idx = 1;
     TESTASSERT(test_scell_activation(n * 2 + 1, p) == SRSRAN_SUCCESS);
+
+    // Carriers scheduled in separate threads
+    p                        = {};
+    p.pcell_idx              = n % 2;
+    p.parallel_carrier_sched = true;
+    TESTASSERT(test_scell_activation(N_runs * 2 + n, p) == SRSRAN_SUCCESS);
   }
 
   srslog::flush();
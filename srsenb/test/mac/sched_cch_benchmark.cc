@@ -0,0 +1,175 @@
+/**
+ * Copyright 2013-2021 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "sched_test_common.h"
+#include "sched_test_utils.h"
+#include "srsenb/hdr/stack/mac/sched_phy_ch/sf_cch_allocator.h"
+#include "srsenb/hdr/stack/mac/sched_ue.h"
+#include "srsran/adt/accumulators.h"
+#include "srsran/common/test_common.h"
+#include <chrono>
+#include <random>
+
+namespace srsenb {
+
+struct cch_run_params {
+  uint32_t nof_prbs;
+  uint32_t nof_ues;
+  uint32_t max_aggr_idx;
+  uint32_t nof_ttis;
+};
+
+struct cch_run_data {
+  cch_run_params           params;
+  float                    avg_nof_dcis;
+  float                    avg_nof_failed_dcis;
+  std::chrono::nanoseconds avg_tti_latency;
+  std::chrono::nanoseconds max_tti_latency;
+};
+
+/// Checks that the DCIs allocated do not overlap, and that the total PDCCH mask accounts for all of them
+int check_pdcch_allocs(const sf_cch_allocator& pdcch)
+{
+  sf_cch_allocator::alloc_result_t allocs;
+  pdcch_mask_t                     total_mask, union_mask(pdcch.nof_cces());
+  pdcch.get_allocs(&allocs, &total_mask);
+  TESTASSERT(allocs.size() == pdcch.nof_allocs());
+  for (const sf_cch_allocator::tree_node* node : allocs) {
+    TESTASSERT(node->current_mask.count() == (1U << node->dci_pos.L));
+    TESTASSERT((union_mask & node->current_mask).none());
+    union_mask |= node->current_mask;
+  }
+  TESTASSERT(union_mask == total_mask);
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * Worst case for the PDCCH allocator. Every UE attempts a DL and an UL DCI in every TTI, which goes on after the PDCCH
+ * is full. Each DCI that does not fit leads to a search over the CCE positions of all the past DCIs, for all CFIs
+ */
+int run_cch_benchmark_scenario(const cch_run_params& params, std::vector<cch_run_data>& run_results)
+{
+  std::mt19937 rand_gen(params.nof_prbs * 1000 + params.nof_ues);
+
+  std::vector<sched_cell_params_t> cell_params(1);
+  sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(params.nof_prbs);
+  sched_interface::sched_args_t    sched_args{};
+  sched_args.min_nof_ctrl_symbols = params.nof_prbs == 6 ? 2 : 1;
+  sched_args.max_nof_ctrl_symbols = 3;
+  TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+  std::vector<std::unique_ptr<sched_ue> > ues;
+  for (uint32_t i = 0; i < params.nof_ues; ++i) {
+    sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+    ue_cfg.pucch_cfg.n_pucch_sr      = i;
+    ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+  }
+
+  sf_cch_allocator pdcch;
+  pdcch.init(cell_params[0]);
+
+  srsran::rolling_average<float> avg_nof_dcis, avg_nof_failed_dcis, avg_tti_latency;
+  std::chrono::nanoseconds       max_tti_latency{0};
+  std::uniform_int_distribution<uint32_t> aggr_dist{0, params.max_aggr_idx};
+  for (uint32_t tti_count = 0; tti_count < params.nof_ttis; ++tti_count) {
+    tti_point tti_rx{tti_count};
+    pdcch.new_tti(tti_rx);
+
+    uint32_t nof_failed = 0;
+    auto     tp         = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < params.nof_ues; ++i) {
+      sched_ue* user = ues[(i + tti_count) % params.nof_ues].get();
+      nof_failed += pdcch.alloc_dci(alloc_type_t::UL_DATA, aggr_dist(rand_gen), user) ? 0 : 1;
+      nof_failed += pdcch.alloc_dci(alloc_type_t::DL_DATA, aggr_dist(rand_gen), user, false) ? 0 : 1;
+    }
+    auto tdur = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tp);
+
+    TESTASSERT(check_pdcch_allocs(pdcch) == SRSRAN_SUCCESS);
+    avg_nof_dcis.push(pdcch.nof_allocs());
+    avg_nof_failed_dcis.push(nof_failed);
+    avg_tti_latency.push(tdur.count());
+    max_tti_latency = std::max(max_tti_latency, tdur);
+  }
+
+  cch_run_data run_result        = {};
+  run_result.params              = params;
+  run_result.avg_nof_dcis        = avg_nof_dcis.value();
+  run_result.avg_nof_failed_dcis = avg_nof_failed_dcis.value();
+  run_result.avg_tti_latency     = std::chrono::nanoseconds(static_cast<int>(avg_tti_latency.value()));
+  run_result.max_tti_latency     = max_tti_latency;
+  run_results.push_back(run_result);
+  return SRSRAN_SUCCESS;
+}
+
+void print_cch_benchmark_results(const std::vector<cch_run_data>& run_results)
+{
+  srslog::flush();
+  fmt::print("run | Nprb | Nue | max L | #DCIs | #failed DCIs | avg TTI latency [usec] | max TTI latency [usec]\n");
+  for (uint32_t i = 0; i < run_results.size(); ++i) {
+    const cch_run_data& r = run_results[i];
+    fmt::print("{:>3d}{:>6d}{:>6d}{:>8d}{:>8.1f}{:>15.1f}{:>25.1f}{:>25.1f}\n",
+               i,
+               r.params.nof_prbs,
+               r.params.nof_ues,
+               1U << r.params.max_aggr_idx,
+               r.avg_nof_dcis,
+               r.avg_nof_failed_dcis,
+               r.avg_tti_latency.count() / 1000.0,
+               r.max_tti_latency.count() / 1000.0);
+  }
+}
+
+int run_cch_benchmark(uint32_t nof_ttis)
+{
+  std::vector<cch_run_data> run_results;
+  for (uint32_t nof_prbs : {6U, 25U, 50U, 100U}) {
+    for (uint32_t nof_ues : {8U, 16U, 32U}) {
+      for (uint32_t max_aggr_idx : {0U, 1U, 3U}) {
+        cch_run_params params{nof_prbs, nof_ues, max_aggr_idx, nof_ttis};
+        TESTASSERT(run_cch_benchmark_scenario(params, run_results) == SRSRAN_SUCCESS);
+      }
+    }
+  }
+  print_cch_benchmark_results(run_results);
+  return SRSRAN_SUCCESS;
+}
+
+} // namespace srsenb
+
+int main(int argc, char* argv[])
+{
+  auto& mac_log = srslog::fetch_basic_logger("MAC");
+  mac_log.set_level(srslog::basic_levels::warning);
+  auto& test_log = srslog::fetch_basic_logger("TEST");
+  test_log.set_level(srslog::basic_levels::warning);
+
+  // Start the log backend.
+  srslog::init();
+
+  uint32_t nof_ttis = 100;
+  if (argc > 1 and strcmp(argv[1], "benchmark") == 0) {
+    nof_ttis = 2000;
+  }
+  TESTASSERT(srsenb::run_cch_benchmark(nof_ttis) == SRSRAN_SUCCESS);
+
+  printf("Success\n");
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include "sched_test_utils.h"
 #include "srsenb/hdr/stack/mac/sched_common.h"
 #include "srsenb/hdr/stack/mac/sched_phy_ch/sched_dci.h"
+#include "srsenb/hdr/stack/mac/sched_ue_ctrl/sched_ue_cell.h"
 #include "srsran/common/common_lte.h"
 #include "srsran/common/test_common.h"
 
@@ -280,6 +281,159 @@ int test_min_mcs_tbs_specific()
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * Reference derivation of the required nof PRBs, based on the false position method over cqi_to_tbs_dl/ul(). It was
+ * used by the scheduler before the precomputed TBS tables of sched_cell_params_t
+ */
+template <typename Callable>
+std::tuple<int, int, int, int> false_position_method(int x1, int x2, int y0, const Callable& f)
+{
+  int y1 = f(x1);
+  if (y1 >= y0) {
+    return std::make_tuple(x1, y1, x1, y1);
+  }
+  int y2 = f(x2);
+  if (y2 <= y0) {
+    return std::make_tuple(x2, y2, x2, y2);
+  }
+  int y3;
+  while (x2 > x1 + 1) {
+    int x3 = round(x1 - ((x2 - x1) * (y1 - y0) / (float)(y2 - y1)));
+    if (x3 == x2) {
+      y3       = y2;
+      int y3_1 = f(x3 - 1);
+      if (y3_1 < y0) {
+        return std::make_tuple(x3 - 1, y3_1, x3, y3);
+      }
+      x3--;
+      y3 = y3_1;
+    } else if (x3 == x1) {
+      y3       = y1;
+      int y3_1 = f(x3 + 1);
+      if (y3_1 >= y0) {
+        return std::make_tuple(x3, y3, x3 + 1, y3_1);
+      }
+      x3++;
+      y3 = y3_1;
+    } else {
+      y3 = f(x3);
+      if (y3 == y0) {
+        return std::make_tuple(x3, y3, x3, y3);
+      }
+    }
+    if (y3 < y0) {
+      x1 = x3;
+      y1 = y3;
+    } else {
+      x2 = x3;
+      y2 = y3;
+    }
+  }
+  return std::make_tuple(x1, y1, x2, y2);
+}
+
+int ref_required_prb_dl(const sched_ue_cell& cell, tti_point tti_tx_dl, srsran_dci_format_t fmt, uint32_t req_bytes)
+{
+  auto compute_tbs = [tti_tx_dl, &cell, fmt](int nof_prb) {
+    uint32_t nof_re = cell.cell_cfg->get_dl_lb_nof_re(tti_tx_dl, nof_prb);
+    return cqi_to_tbs_dl(cell, nof_prb, nof_re, fmt, -1).tbs_bytes;
+  };
+  auto ret = false_position_method(1, cell.cell_cfg->nof_prb(), (int)req_bytes, compute_tbs);
+  return std::get<3>(ret) < (int)req_bytes ? -1 : std::get<2>(ret);
+}
+
+uint32_t ref_required_prb_ul(const sched_ue_cell& cell, uint32_t req_bytes)
+{
+  if (req_bytes == 0) {
+    return 0;
+  }
+  auto compute_tbs = [&cell](int nof_prb) {
+    uint32_t nof_re = (2 * (SRSRAN_CP_NSYMB(cell.cell_cfg->cfg.cell.cp) - 1)) * nof_prb * SRSRAN_NRE;
+    return cqi_to_tbs_ul(cell, nof_prb, nof_re, -1).tbs_bytes;
+  };
+  int      target_tbs = std::max((int)req_bytes + 4, 10);
+  uint32_t max_prbs   = std::min(cell.tpc_fsm.max_ul_prbs(), cell.cell_cfg->nof_prb());
+  auto     ret        = false_position_method(1, max_prbs, target_tbs, compute_tbs);
+  uint32_t req_prbs   = std::get<2>(ret);
+  int      final_tbs  = std::get<3>(ret);
+  while (final_tbs < 10 and req_prbs < cell.cell_cfg->nof_prb()) {
+    final_tbs = compute_tbs(++req_prbs);
+  }
+  while (not srsran_dft_precoding_valid_prb(req_prbs) and req_prbs < cell.cell_cfg->nof_prb()) {
+    req_prbs++;
+  }
+  return req_prbs;
+}
+
+/// Verify that the nof PRBs derived from the precomputed TBS tables is the lowest nof PRBs whose TBS reaches the
+/// required bytes, and that it never exceeds the nof PRBs derived with the false position method
+int test_required_prbs_all()
+{
+  using ul64qam_cap = sched_interface::ue_cfg_t::ul64qam_cap;
+  const std::array<srsran_dci_format_t, 2> dci_formats{SRSRAN_DCI_FORMAT1, SRSRAN_DCI_FORMAT1A};
+  const std::array<uint32_t, 4>            sf_idxs{0, 1, 5, 6};
+
+  for (auto& nof_prb_cell : srsran::lte_cell_nof_prbs) {
+    for (int fixed_mcs : {-1, 10}) {
+      for (uint32_t ue_idx = 0; ue_idx < 3; ++ue_idx) {
+        sched_interface::sched_args_t sched_args = {};
+        sched_args.pdsch_mcs                     = fixed_mcs;
+        sched_args.pusch_mcs                     = fixed_mcs;
+        sched_args.pdsch_max_mcs                 = 28 - ue_idx;
+        sched_interface::cell_cfg_t cell_cfg     = generate_default_cell_cfg(nof_prb_cell);
+        cell_cfg.enable_64qam                    = ue_idx > 0;
+        sched_cell_params_t cell_params          = {};
+        TESTASSERT(cell_params.set_cfg(0, cell_cfg, sched_args));
+
+        sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+        ue_cfg.use_tbs_index_alt         = ue_idx > 0;
+        ue_cfg.support_ul64qam           = ue_idx == 2 ? ul64qam_cap::enabled : ul64qam_cap::disabled;
+        sched_ue_cell ue_cell(0x46, cell_params, tti_point{0});
+        ue_cell.set_ue_cfg(ue_cfg);
+        if (fixed_mcs < 0) {
+          // TEST: All UE configurations are covered by the cell TBS tables
+          TESTASSERT(cell_params.get_dl_tbs_table(ue_cell.max_mcs_dl, ue_cfg.use_tbs_index_alt) != nullptr);
+          TESTASSERT(cell_params.get_ul_tbs_table(ue_cell.max_mcs_ul, ue_idx == 2) != nullptr);
+        }
+
+        for (uint32_t cqi = 0; cqi < prb_tbs_table::nof_cqis; ++cqi) {
+          ue_cell.dl_cqi    = cqi;
+          ue_cell.ul_cqi    = cqi;
+          ue_cell.dl_cqi_rx = true;
+
+          for (uint32_t sf_idx : sf_idxs) {
+            for (srsran_dci_format_t fmt : dci_formats) {
+              tti_point        tti_tx_dl{sf_idx};
+              std::vector<int> tbs_list(nof_prb_cell + 1, -1);
+              for (uint32_t nof_prb = 1; nof_prb <= nof_prb_cell; ++nof_prb) {
+                uint32_t nof_re   = cell_params.get_dl_lb_nof_re(tti_tx_dl, nof_prb);
+                tbs_list[nof_prb] = cqi_to_tbs_dl(ue_cell, nof_prb, nof_re, fmt, -1).tbs_bytes;
+              }
+
+              // Test all required bytes up to the max TBS of the cell bandwidth
+              int max_tbs = *std::max_element(tbs_list.begin(), tbs_list.end());
+              for (int req_bytes = 0; req_bytes <= max_tbs + 1; ++req_bytes) {
+                auto is_enough = [req_bytes](int tbs) { return tbs >= req_bytes; };
+                auto it        = std::find_if(tbs_list.begin() + 1, tbs_list.end(), is_enough);
+                int  min_prbs  = it == tbs_list.end() ? -1 : (int)(it - tbs_list.begin());
+                int  nof_prbs  = get_required_prb_dl(ue_cell, tti_tx_dl, fmt, req_bytes);
+                int  ref_prbs  = ref_required_prb_dl(ue_cell, tti_tx_dl, fmt, req_bytes);
+                TESTASSERT(nof_prbs == min_prbs);
+                TESTASSERT(ref_prbs < 0 or nof_prbs <= ref_prbs);
+              }
+            }
+          }
+
+          for (uint32_t req_bytes = 0; req_bytes <= 10000; ++req_bytes) {
+            TESTASSERT(get_required_prb_ul(ue_cell, req_bytes) <= ref_required_prb_ul(ue_cell, req_bytes));
+          }
+        }
+      }
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 } // namespace srsenb
 
 int main()
@@ -295,6 +449,7 @@ int main()
   TESTASSERT(srsenb::test_mcs_lookup_specific() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_mcs_tbs_consistency_all() == SRSRAN_SUCCESS);
   TESTASSERT(srsenb::test_min_mcs_tbs_specific() == SRSRAN_SUCCESS);
+  TESTASSERT(srsenb::test_required_prbs_all() == SRSRAN_SUCCESS);
 
   printf("Success\n");
   return 0;
@@ -251,6 +251,126 @@ int test_6prbs()
   return SRSRAN_SUCCESS;
 }
 
+/**
+ * The DFS node budget must not make the PDCCH allocator fail DCIs that fit. The DCI sequences of the scheduler (SIB,
+ * RAR, and a DL and an UL DCI per UE with the aggregation level of its CQI) are allocated by two allocators, with the
+ * default budget and without budget, which must give the same results
+ */
+int test_pdcch_dfs_budget()
+{
+  using rand_uint = std::uniform_int_distribution<uint32_t>;
+
+  for (uint32_t nof_prb : srsran::lte_cell_nof_prbs) {
+    std::vector<sched_cell_params_t> cell_params(1);
+    sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+    sched_interface::sched_args_t    sched_args{};
+    sched_args.pucch_mux_enabled    = rand_uint{0, 1}(get_rand_gen()) == 0;
+    sched_args.min_nof_ctrl_symbols = nof_prb == 6 ? 2 : 1;
+    TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+    std::vector<std::unique_ptr<sched_ue> > ues;
+    for (uint32_t i = 0; i < 16; ++i) {
+      sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+      ue_cfg.pucch_cfg.n_pucch_sr      = i;
+      ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+    }
+
+    sf_cch_allocator pdcch, pdcch_nobudget;
+    pdcch.init(cell_params[0]);
+    pdcch_nobudget.init(cell_params[0], std::numeric_limits<uint32_t>::max());
+
+    auto alloc_dci = [&pdcch, &pdcch_nobudget](alloc_type_t alloc_type, uint32_t aggr_idx, sched_ue* user, bool pusch) {
+      bool success          = pdcch.alloc_dci(alloc_type, aggr_idx, user, pusch);
+      bool success_nobudget = pdcch_nobudget.alloc_dci(alloc_type, aggr_idx, user, pusch);
+      if (pdcch_nobudget.nof_dfs_nodes() >= sf_cch_allocator::MAX_DFS_NODES) {
+        // The allocators only search the same nodes until the budget of the TTI is spent
+        return;
+      }
+      TESTASSERT(success == success_nobudget);
+      TESTASSERT(pdcch.get_cfi() == pdcch_nobudget.get_cfi());
+      sf_cch_allocator::alloc_result_t result, result_nobudget;
+      pdcch.get_allocs(&result);
+      pdcch_nobudget.get_allocs(&result_nobudget);
+      TESTASSERT(result.size() == result_nobudget.size());
+      for (uint32_t i = 0; i < result.size(); ++i) {
+        TESTASSERT(result[i]->dci_pos.ncce == result_nobudget[i]->dci_pos.ncce);
+      }
+    };
+
+    for (uint32_t tti_count = 0; tti_count < 200; ++tti_count) {
+      tti_point tti_rx{rand_uint{0, 10239}(get_rand_gen())};
+      pdcch.new_tti(tti_rx);
+      pdcch_nobudget.new_tti(tti_rx);
+
+      if (rand_uint{0, 3}(get_rand_gen()) == 0) {
+        alloc_dci(alloc_type_t::DL_BC, 2, nullptr, false);
+      }
+      if (rand_uint{0, 3}(get_rand_gen()) == 0) {
+        alloc_dci(alloc_type_t::DL_RAR, 2, nullptr, false);
+      }
+      uint32_t nof_ues = rand_uint{1, (uint32_t)ues.size()}(get_rand_gen());
+      for (uint32_t i = 0; i < nof_ues; ++i) {
+        sched_ue& user = *ues[(tti_count + i) % ues.size()];
+        user.set_dl_cqi(to_tx_dl(tti_rx), 0, rand_uint{1, 15}(get_rand_gen()));
+        uint32_t aggr_idx = get_aggr_level(user, 0, cell_params);
+        bool     pusch    = rand_uint{0, 1}(get_rand_gen()) == 0;
+        alloc_dci(alloc_type_t::UL_DATA, aggr_idx, &user, false);
+        alloc_dci(alloc_type_t::DL_DATA, aggr_idx, &user, pusch);
+        if (pdcch.nof_allocs() > 0 and pdcch_nobudget.nof_allocs() > 0 and rand_uint{0, 7}(get_rand_gen()) == 0) {
+          // The scheduler reverts the last DCI when the data allocation fails
+          pdcch.rem_last_dci();
+          pdcch_nobudget.rem_last_dci();
+        }
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * Worst case for the PDCCH allocator: every UE attempts a DL and an UL DCI with a low aggregation level, which goes on
+ * after the PDCCH is full. The DFS of a TTI must not visit more nodes than its budget, plus one per DCI
+ */
+int test_pdcch_dfs_tti_budget()
+{
+  using rand_uint = std::uniform_int_distribution<uint32_t>;
+
+  for (uint32_t nof_prb : srsran::lte_cell_nof_prbs) {
+    std::vector<sched_cell_params_t> cell_params(1);
+    sched_interface::cell_cfg_t      cell_cfg = generate_default_cell_cfg(nof_prb);
+    sched_interface::sched_args_t    sched_args{};
+    sched_args.pucch_mux_enabled    = rand_uint{0, 1}(get_rand_gen()) == 0;
+    sched_args.min_nof_ctrl_symbols = nof_prb == 6 ? 2 : 1;
+    TESTASSERT(cell_params[0].set_cfg(0, cell_cfg, sched_args));
+
+    std::vector<std::unique_ptr<sched_ue> > ues;
+    for (uint32_t i = 0; i < 32; ++i) {
+      sched_interface::ue_cfg_t ue_cfg = generate_default_ue_cfg();
+      ue_cfg.pucch_cfg.n_pucch_sr      = i;
+      ues.emplace_back(new sched_ue(0x46 + i, cell_params, ue_cfg));
+    }
+
+    sf_cch_allocator pdcch;
+    pdcch.init(cell_params[0]);
+
+    for (uint32_t tti_count = 0; tti_count < 20; ++tti_count) {
+      tti_point tti_rx{rand_uint{0, 10239}(get_rand_gen())};
+      pdcch.new_tti(tti_rx);
+
+      uint32_t nof_dcis = 0;
+      for (auto& user : ues) {
+        pdcch.alloc_dci(alloc_type_t::UL_DATA, rand_uint{0, 1}(get_rand_gen()), user.get());
+        pdcch.alloc_dci(alloc_type_t::DL_DATA, rand_uint{0, 1}(get_rand_gen()), user.get(), false);
+        nof_dcis += 2;
+        TESTASSERT(pdcch.nof_dfs_nodes() <= sf_cch_allocator::MAX_DFS_NODES + nof_dcis);
+      }
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 int main()
 {
   srsenb::set_randseed(seed);
@@ -265,6 +385,8 @@ int main()
   TESTASSERT(test_pdcch_one_ue() == SRSRAN_SUCCESS);
   TESTASSERT(test_pdcch_ue_and_sibs() == SRSRAN_SUCCESS);
   TESTASSERT(test_6prbs() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_dfs_budget() == SRSRAN_SUCCESS);
+  TESTASSERT(test_pdcch_dfs_tti_budget() == SRSRAN_SUCCESS);
 
   srslog::flush();
 
@@ -357,11 +357,10 @@ int sched_sim_base::apply_tti_events(sim_ue_ctxt_t& ue_ctxt, const ue_tti_events
                     cc_feedback.dl_pid);
       }
 
-      // update scheduler
-      if (sched_ptr->dl_ack_info(
-              events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.tb, cc_feedback.dl_ack) < 0) {
-        logger.error("The ACKed DL Harq pid=%d does not exist.", cc_feedback.dl_pid);
-        error_counter++;
+      // update scheduler. The feedback is only applied when the scheduler drains its queue
+      sched_ptr->dl_ack_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.tb, cc_feedback.dl_ack);
+      if (cc_feedback.dl_ack) {
+        tti_acks.push_back({ue_ctxt.rnti, enb_cc_idx, true, cc_feedback.dl_pid, cc_feedback.tb, events.tti_rx});
       }
 
       // update UE sim context
@@ -380,10 +379,10 @@ int sched_sim_base::apply_tti_events(sim_ue_ctxt_t& ue_ctxt, const ue_tti_events
                     cc_feedback.ul_pid);
       }
 
-      // update scheduler
-      if (sched_ptr->ul_crc_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.ul_ack) < 0) {
-        logger.error("The ACKed UL Harq pid=%d does not exist.", cc_feedback.ul_pid);
-        error_counter++;
+      // update scheduler. The feedback is only applied when the scheduler drains its queue
+      sched_ptr->ul_crc_info(events.tti_rx.to_uint(), ue_ctxt.rnti, enb_cc_idx, cc_feedback.ul_ack);
+      if (cc_feedback.ul_ack) {
+        tti_acks.push_back({ue_ctxt.rnti, enb_cc_idx, false, cc_feedback.ul_pid, 0, events.tti_rx});
       }
     }
 
@@ -425,6 +424,7 @@ int sched_sim_base::apply_tti_events(sim_ue_ctxt_t& ue_ctxt, const ue_tti_events
 void sched_sim_base::new_tti(srsran::tti_point tti_rx)
 {
   current_tti_rx = tti_rx;
+  tti_acks.clear();
   for (auto& ue : ue_db) {
     ue_tti_events events;
     set_default_tti_events(ue.second.get_ctxt(), events);
@@ -79,6 +79,15 @@ struct ue_tti_events {
   srsran::tti_point    tti_rx;
   std::vector<cc_data> cc_list;
 };
+/// HARQ ACK passed to the scheduler. It only takes effect once the scheduler drains its feedback queue
+struct sim_harq_ack_t {
+  uint16_t          rnti;
+  uint32_t          enb_cc_idx;
+  bool              is_dl;
+  int               pid;
+  int               tb;
+  srsran::tti_point tti_rx;
+};
 
 class ue_sim
 {
@@ -143,6 +152,7 @@ public:
   sched_interface*                        get_sched() { return sched_ptr; }
   srsran::const_span<sched_cell_params_t> get_cell_params() { return cell_params; }
   tti_point                               get_tti_rx() const { return current_tti_rx; }
+  const std::vector<sim_harq_ack_t>&      get_tti_acks() const { return tti_acks; }
 
   std::map<uint16_t, ue_sim>::iterator begin() { return ue_db.begin(); }
   std::map<uint16_t, ue_sim>::iterator end() { return ue_db.end(); }
@@ -161,7 +171,7 @@ private:
   srsran::tti_point                             current_tti_rx;
   std::map<uint16_t, ue_sim>                    ue_db;
   std::map<uint16_t, sched_interface::ue_cfg_t> final_ue_cfg;
-  uint32_t                                      error_counter = 0;
+  std::vector<sim_harq_ack_t>                   tti_acks;
 };
 
 } // namespace srsenb
@@ -257,6 +257,27 @@ int common_sched_tester::process_tti_events(const tti_ev& tti_ev)
   return SRSRAN_SUCCESS;
 }
 
+int common_sched_tester::test_applied_acks()
+{
+  // The ACKs were queued by the simulated UEs. Once drained, the ACKed HARQs must be empty
+  for (const sim_harq_ack_t& ack : sched_sim->get_tti_acks()) {
+    auto it = ue_db.find(ack.rnti);
+    if (it == ue_db.end()) {
+      continue;
+    }
+    if (ack.is_dl) {
+      CONDERROR(not it->second->get_dl_harq(ack.pid, ack.enb_cc_idx).is_empty(ack.tb),
+                "rnti=0x%x DL ACK for pid=%d was not applied",
+                ack.rnti,
+                ack.pid);
+    } else {
+      const ul_harq_proc* h = it->second->get_ul_harq(ack.tti_rx, ack.enb_cc_idx);
+      CONDERROR(h != nullptr and not h->is_empty(0), "rnti=0x%x UL ACK for pid=%d was not applied", ack.rnti, ack.pid);
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
 int common_sched_tester::run_tti(const tti_ev& tti_events)
 {
   new_test_tti();
@@ -264,6 +285,12 @@ int common_sched_tester::run_tti(const tti_ev& tti_events)
 
   sched_sim->new_tti(tti_rx);
   process_tti_events(tti_events);
+  {
+    // The UE state is checked before the scheduler applies the feedback of the previous TTIs
+    std::lock_guard<std::mutex> lock(sched_mutex);
+    apply_pending_feedback();
+  }
+  TESTASSERT(test_applied_acks() == SRSRAN_SUCCESS);
   before_sched();
 
   // Call scheduler for all carriers
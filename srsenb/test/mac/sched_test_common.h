@@ -116,6 +116,7 @@ public:
   int run_tti(const tti_ev& tti_events);
 
   int run_ue_ded_tests_and_update_ctxt(const sf_output_res_t& sf_out);
+  int test_applied_acks();
 
   // args
   sim_sched_args        sim_args0; ///< arguments used to generate TTI events
@@ -77,8 +77,9 @@ private:
                            mac_interface_phy_lte::mac_grant_ul_t* mac_grant);
 
   /* Methods for DL... */
-  int decode_pdcch_ul();
-  int decode_pdcch_dl();
+  int  decode_pdcch_ul();
+  int  decode_pdcch_dl();
+  void update_pdcch_metrics();
 
   void decode_phich();
   int  decode_pdsch(srsran_pdsch_ack_resource_t            ack_resource,
@@ -141,6 +141,34 @@ private:
   uint32_t count = 0;
 };
 
+struct pdcch_metrics_t {
+  typedef std::array<pdcch_metrics_t, SRSRAN_MAX_CARRIERS> array_t;
+
+  // Average per searched subframe
+  float nof_candidates;
+  float nof_decodes;
+  float nof_decodes_saved;
+
+  void set(const pdcch_metrics_t& other)
+  {
+    count++;
+    PHY_METRICS_SET(nof_candidates);
+    PHY_METRICS_SET(nof_decodes);
+    PHY_METRICS_SET(nof_decodes_saved);
+  }
+
+  void reset()
+  {
+    count             = 0;
+    nof_candidates    = 0.0f;
+    nof_decodes       = 0.0f;
+    nof_decodes_saved = 0.0f;
+  }
+
+private:
+  uint32_t count = 0;
+};
+
 struct ul_metrics_t {
   typedef std::array<ul_metrics_t, SRSRAN_MAX_CARRIERS> array_t;
 
@@ -168,12 +196,13 @@ private:
 #undef PHY_METRICS_SET
 
 struct phy_metrics_t {
-  info_metrics_t::array_t info          = {};
-  sync_metrics_t::array_t sync          = {};
-  ch_metrics_t::array_t   ch            = {};
-  dl_metrics_t::array_t   dl            = {};
-  ul_metrics_t::array_t   ul            = {};
-  uint32_t                nof_active_cc = 0;
+  info_metrics_t::array_t  info          = {};
+  sync_metrics_t::array_t  sync          = {};
+  ch_metrics_t::array_t    ch            = {};
+  dl_metrics_t::array_t    dl            = {};
+  pdcch_metrics_t::array_t pdcch         = {};
+  ul_metrics_t::array_t    ul            = {};
+  uint32_t                 nof_active_cc = 0;
 };
 
 } // namespace srsue
@@ -379,6 +379,14 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
        bpo::value<bool>(&args->phy.pdsch_8bit_decoder)->default_value(false),
        "Use 8-bit for LLR representation and turbo decoder trellis computation (Experimental)")
 
+    ("phy.pdsch_cw_pool",
+       bpo::value<bool>(&args->phy.pdsch_cw_pool)->default_value(false),
+       "Decode the two PDSCH codewords of a grant in parallel, with one extra thread per PHY thread and carrier")
+
+    ("phy.pdsch_decoder_threads",
+       bpo::value<uint32_t>(&args->phy.pdsch_decoder_threads)->default_value(0),
+       "Number of extra threads decoding the code blocks of a PDSCH or PMCH transport block in parallel (0 for serial)")
+
     ("phy.force_ul_amplitude",
        bpo::value<float>(&args->phy.force_ul_amplitude)->default_value(0.0),
        "Forces the peak amplitude in the PUCCH, PUSCH and SRS (set 0.0 to 1.0, set to 0 or negative for disabling)")
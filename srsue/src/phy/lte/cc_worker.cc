@@ -76,6 +76,19 @@ cc_worker::cc_worker(uint32_t cc_idx_, uint32_t max_prb, srsue::phy_common* phy_
     return;
   }
 
+  if (phy->args->pdsch_cw_pool && srsran_pdsch_enable_cw_pool(&ue_dl.pdsch)) {
+    Error("Initiating PDSCH codeword pool");
+    return;
+  }
+
+  if (phy->args->pdsch_decoder_threads > 0) {
+    if (srsran_pdsch_set_decoder_threads(&ue_dl.pdsch, phy->args->pdsch_decoder_threads) ||
+        srsran_sch_set_decoder_threads(&ue_dl.pmch.dl_sch, phy->args->pdsch_decoder_threads)) {
+      Error("Initiating PDSCH decoder threads");
+      return;
+    }
+  }
+
   if (srsran_ue_ul_init(&ue_ul, signal_buffer_tx[0], max_prb)) {
     Error("Initiating UE UL");
     return;
@@ -254,6 +267,7 @@ bool cc_worker::work_dl_regular()
     if (phy->cell_state.is_active(cc_idx, sf_cfg_dl.tti) and (cc_idx != 0 or not ue_dl_cfg.cfg.dci.cif_present)) {
       found_dl_grant = decode_pdcch_dl() > 0;
       decode_pdcch_ul();
+      update_pdcch_metrics();
     }
   }
 
@@ -334,6 +348,7 @@ bool cc_worker::work_dl_mbsfn(srsran_mbsfn_cfg_t mbsfn_cfg)
   if (phy->cell_state.is_active(cc_idx, sf_cfg_dl.tti) and (cc_idx != 0 or not ue_dl_cfg.cfg.dci.cif_present)) {
     decode_pdcch_dl();
     decode_pdcch_ul();
+    update_pdcch_metrics();
   }
 
   if (mbsfn_cfg.enable) {
@@ -380,6 +395,22 @@ void cc_worker::dl_phy_to_mac_grant(srsran_pdsch_grant_t*
   }
 }
 
+void cc_worker::update_pdcch_metrics()
+{
+  const srsran_pdcch_search_metrics_t& search = ue_dl.pdcch.search_metrics;
+
+  // Only the subframes with a blind search are accounted
+  if (search.nof_candidates == 0) {
+    return;
+  }
+
+  pdcch_metrics_t pdcch_metrics   = {};
+  pdcch_metrics.nof_candidates    = search.nof_candidates;
+  pdcch_metrics.nof_decodes       = search.nof_decodes;
+  pdcch_metrics.nof_decodes_saved = search.nof_pruned + search.nof_cached;
+  phy->set_pdcch_metrics(cc_idx, pdcch_metrics);
+}
+
 int cc_worker::decode_pdcch_dl()
 {
   int nof_grants = 0;
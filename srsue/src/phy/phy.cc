@@ -214,6 +214,7 @@ void phy::get_metrics(const srsran::srsran_rat_t& rat, phy_metrics_t* m)
 
     common.get_ch_metrics(m->ch);
     common.get_dl_metrics(m->dl);
+    common.get_pdcch_metrics(m->pdcch);
     common.get_ul_metrics(m->ul);
     common.get_sync_metrics(m->sync);
     m->nof_active_cc = args.nof_lte_carriers;
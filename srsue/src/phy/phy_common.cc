@@ -814,6 +814,22 @@ void phy_common::get_dl_metrics(dl_metrics_t::array_t& m)
   }
 }
 
+void phy_common::set_pdcch_metrics(uint32_t cc_idx, const pdcch_metrics_t& m)
+{
+  std::unique_lock<std::mutex> lock(metrics_mutex);
+  pdcch_metrics[cc_idx].set(m);
+}
+
+void phy_common::get_pdcch_metrics(pdcch_metrics_t::array_t& m)
+{
+  std::unique_lock<std::mutex> lock(metrics_mutex);
+
+  for (uint32_t i = 0; i < args->nof_lte_carriers; i++) {
+    m[i] = pdcch_metrics[i];
+    pdcch_metrics[i].reset();
+  }
+}
+
 void phy_common::set_ch_metrics(uint32_t cc_idx, const ch_metrics_t& m)
 {
   std::unique_lock<std::mutex> lock(metrics_mutex);